@@ -26,6 +26,14 @@ public:
     cpp2::ErrorCode execute(folly::StringPiece stmt,
                             cpp2::ExecutionResponse& resp);
 
+    // Prepare the statement with parameters `?', which are bound in executePrepared()
+    cpp2::ErrorCode prepare(folly::StringPiece stmt,
+                            cpp2::PrepareResponse& resp);
+
+    cpp2::ErrorCode executePrepared(int64_t statementId,
+                                    std::vector<cpp2::ColumnValue> params,
+                                    cpp2::ExecutionResponse& resp);
+
 private:
     std::unique_ptr<cpp2::GraphServiceAsyncClient> client_;
     const std::string addr_;
@@ -0,0 +1,489 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_BASE_CONCURRENTCLOCKCACHE_H_
+#define COMMON_BASE_CONCURRENTCLOCKCACHE_H_
+
+#include "base/Base.h"
+#include "base/StatusOr.h"
+#include "stats/StatsManager.h"
+#include <list>
+#include <folly/SharedMutex.h>
+#include <boost/optional.hpp>
+#include <gtest/gtest_prod.h>
+
+namespace nebula {
+
+namespace cache {
+
+/**
+ * The bytes one key or value takes in the cache.
+ * */
+template<typename T>
+size_t weigh(const T&) {
+    return sizeof(T);
+}
+
+inline size_t weigh(const std::string& s) {
+    return sizeof(std::string) + s.size();
+}
+
+template<typename A, typename B>
+size_t weigh(const std::pair<A, B>& p) {
+    return weigh(p.first) + weigh(p.second);
+}
+
+/**
+ * Approximate the access frequency of keys with a count-min sketch of 4-bit
+ * counters (TinyLFU), 16 of them are packed in one word. All the counters are
+ * halved by reset() once sampleSize accesses are recorded, so the history fades
+ * out. The owner calls it on its write path, the readers only increment.
+ *
+ * The counters are updated with relaxed atomics and without any lock, a few
+ * increments might be lost under contention, which is fine for an estimation.
+ * */
+class FrequencySketch final {
+public:
+    explicit FrequencySketch(size_t width) {
+        width_ = kCountersPerWord;
+        while (width_ < width) {
+            width_ <<= 1;
+        }
+        sampleSize_ = width_ * 10;
+        counters_ = std::vector<std::atomic<uint64_t>>(width_ * kDepth / kCountersPerWord);
+    }
+
+    void increment(uint64_t hash) {
+        for (size_t i = 0; i < kDepth; i++) {
+            auto pos = i * width_ + index(hash, i);
+            auto& word = counters_[pos / kCountersPerWord];
+            auto shift = (pos % kCountersPerWord) * kCounterBits;
+            auto v = word.load(std::memory_order_relaxed);
+            // Not to carry into the next counter when it is saturated
+            while (((v >> shift) & kMaxCount) < kMaxCount &&
+                   !word.compare_exchange_weak(v, v + (1ULL << shift),
+                                               std::memory_order_relaxed)) {
+            }
+        }
+        additions_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint8_t estimate(uint64_t hash) const {
+        uint8_t freq = kMaxCount;
+        for (size_t i = 0; i < kDepth; i++) {
+            auto pos = i * width_ + index(hash, i);
+            auto v = counters_[pos / kCountersPerWord].load(std::memory_order_relaxed);
+            auto shift = (pos % kCountersPerWord) * kCounterBits;
+            freq = std::min(freq, static_cast<uint8_t>((v >> shift) & kMaxCount));
+        }
+        return freq;
+    }
+
+    bool needsReset() const {
+        return additions_.load(std::memory_order_relaxed) >= sampleSize_;
+    }
+
+    // Halve all the counters, it walks the whole sketch
+    void reset() {
+        for (auto& word : counters_) {
+            word.store((word.load(std::memory_order_relaxed) >> 1) & kHalfMask,
+                       std::memory_order_relaxed);
+        }
+        additions_.store(additions_.load(std::memory_order_relaxed) / 2,
+                         std::memory_order_relaxed);
+    }
+
+    // The bytes taken by the counters
+    size_t size() const {
+        return counters_.size() * sizeof(uint64_t);
+    }
+
+private:
+    size_t index(uint64_t hash, size_t i) const {
+        static const uint64_t kSeeds[kDepth] = {
+            0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL,
+            0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL,
+        };
+        return folly::hash::twang_mix64(hash + kSeeds[i]) & (width_ - 1);
+    }
+
+private:
+    static constexpr size_t kDepth = 4;
+    static constexpr size_t kCounterBits = 4;
+    static constexpr size_t kCountersPerWord = 64 / kCounterBits;
+    static constexpr uint64_t kMaxCount = 15;
+    // Clear the bit shifted into each counter from the higher one
+    static constexpr uint64_t kHalfMask = 0x7777777777777777ULL;
+
+    size_t width_;
+    size_t sampleSize_;
+    std::atomic<size_t> additions_{0};
+    std::vector<std::atomic<uint64_t>> counters_;
+};
+
+}  // namespace cache
+
+
+/**
+ * A sharded cache bounded by bytes instead of the number of keys.
+ *
+ * Each shard evicts with the CLOCK algorithm: a hit only sets the reference
+ * bit of the entry, so reads share the lock of the shard and never block each
+ * other. A new key is admitted only if it has been accessed more often than the
+ * entry it would evict (TinyLFU), so one large scan could not flush the hot
+ * entries out of the cache.
+ *
+ * The interface is the same as ConcurrentLRUCache.
+ * */
+template<typename K, typename V>
+class ConcurrentClockCache final {
+    FRIEND_TEST(ConcurrentClockCacheTest, SimpleTest);
+
+public:
+    // The bytes taken by the bookkeeping of each entry, besides the key and the value
+    static constexpr size_t kEntryOverhead = 64;
+
+    /**
+     * capacity is in bytes, shared evenly by 1 << bucketsExp shards.
+     * */
+    explicit ConcurrentClockCache(size_t capacity, uint32_t bucketsExp = 4)
+        : bucketsNum_(1 << bucketsExp)
+        , bucketsExp_(bucketsExp) {
+        CHECK(capacity > bucketsNum_ && bucketsNum_ > 0);
+        auto capPerBucket = capacity >> bucketsExp;
+        auto left = capacity;
+        for (uint32_t i = 0; i < bucketsNum_ - 1; i++) {
+            buckets_.emplace_back(std::make_unique<Bucket>(capPerBucket));
+            left -= capPerBucket;
+        }
+        CHECK_GT(left, 0);
+        buckets_.emplace_back(std::make_unique<Bucket>(left));
+    }
+
+    /**
+     * Export the hits, misses, evicts and rejected inserts as
+     * <prefix>_hits, <prefix>_misses, <prefix>_evicts and <prefix>_rejects.
+     * */
+    void registerStats(folly::StringPiece prefix) {
+        hitsStat_ = stats::StatsManager::registerStats(folly::to<std::string>(prefix, "_hits"));
+        missesStat_ = stats::StatsManager::registerStats(
+                folly::to<std::string>(prefix, "_misses"));
+        evictsStat_ = stats::StatsManager::registerStats(
+                folly::to<std::string>(prefix, "_evicts"));
+        rejectsStat_ = stats::StatsManager::registerStats(
+                folly::to<std::string>(prefix, "_rejects"));
+    }
+
+    /**
+     * Types other than the ones above could provide their own weigh() in their
+     * namespace, which is found by argument-dependent lookup.
+     * */
+    static size_t charge(const K& key, const V& val) {
+        using cache::weigh;
+        return kEntryOverhead + weigh(key) + weigh(val);
+    }
+
+    bool contains(const K& key, int32_t hint = -1) {
+        return bucketOfKey(key, hint).contains(key);
+    }
+
+    /**
+     * The key is not inserted if it is less frequently used than the entries
+     * in the cache.
+     * */
+    void insert(K key, V val, int32_t hint = -1) {
+        auto hash = std::hash<K>()(key);
+        auto& b = bucketOfHash(hash, hint);
+        auto evicts = b.insert(hash, std::move(key), std::move(val));
+        onInserted(evicts);
+    }
+
+    StatusOr<V> get(const K& key, int32_t hint = -1) {
+        auto hash = std::hash<K>()(key);
+        auto v = bucketOfHash(hash, hint).get(hash, key);
+        if (v == boost::none) {
+            addStat(missesStat_);
+            return Status::Error();
+        }
+        addStat(hitsStat_);
+        return std::move(v).value();
+    }
+
+    /**
+     * Insert the {key, val} if key not existed, and return Status::Inserted.
+     * Otherwise, just return the value for the existed key.
+     * */
+    StatusOr<V> putIfAbsent(K key, V val, int32_t hint = -1) {
+        auto hash = std::hash<K>()(key);
+        auto& b = bucketOfHash(hash, hint);
+        auto v = b.get(hash, key);
+        if (v != boost::none) {
+            addStat(hitsStat_);
+            return std::move(v).value();
+        }
+        addStat(missesStat_);
+        auto evicts = b.insert(hash, std::move(key), std::move(val));
+        onInserted(evicts);
+        if (evicts < 0) {
+            return Status::Error("Rejected by the cache");
+        }
+        return Status::Inserted();
+    }
+
+    void evict(const K& key, int32_t hint = -1) {
+        if (bucketOfKey(key, hint).evict(key)) {
+            addStat(evictsStat_);
+        }
+    }
+
+    void clear() {
+        for (auto& b : buckets_) {
+            b->clear();
+        }
+    }
+
+    uint64_t total() {
+        uint64_t total = 0;
+        for (auto& b : buckets_) {
+            total += b->total_;
+        }
+        return total;
+    }
+
+    uint64_t hits() {
+        uint64_t hits = 0;
+        for (auto& b : buckets_) {
+            hits += b->hits_;
+        }
+        return hits;
+    }
+
+    uint64_t evicts() {
+        uint64_t evicts = 0;
+        for (auto& b : buckets_) {
+            evicts += b->evicts_;
+        }
+        return evicts;
+    }
+
+    uint64_t rejects() {
+        uint64_t rejects = 0;
+        for (auto& b : buckets_) {
+            rejects += b->rejects_;
+        }
+        return rejects;
+    }
+
+    // Bytes taken by the entries in the cache
+    uint64_t usage() {
+        uint64_t usage = 0;
+        for (auto& b : buckets_) {
+            usage += b->usage();
+        }
+        return usage;
+    }
+
+private:
+    class Bucket {
+    public:
+        explicit Bucket(size_t capacity)
+            : capacity_(capacity)
+            // One counter for each entry the bucket could hold at most, every entry
+            // takes kEntryOverhead bytes at least. The sketch is 2 bytes per counter
+            // (kDepth rows of 4 bits), i.e. about 1/32 of the capacity besides it.
+            , sketch_(std::min<size_t>(std::max<size_t>(capacity / kEntryOverhead, 4096),
+                                       1 << 24)) {
+            hand_ = clock_.end();
+        }
+
+        bool contains(const K& key) {
+            folly::SharedMutex::ReadHolder rh(lock_);
+            return map_.find(key) != map_.end();
+        }
+
+        boost::optional<V> get(uint64_t hash, const K& key) {
+            sketch_.increment(hash);
+            total_++;
+            folly::SharedMutex::ReadHolder rh(lock_);
+            auto it = map_.find(key);
+            if (it == map_.end()) {
+                VLOG(3) << key << " not found!";
+                return boost::none;
+            }
+            it->second->ref_.store(true, std::memory_order_relaxed);
+            hits_++;
+            return it->second->val_;
+        }
+
+        /**
+         * Return the number of entries evicted, or -1 if the key is rejected.
+         * */
+        int32_t insert(uint64_t hash, K&& key, V&& val) {
+            auto c = charge(key, val);
+            if (c > capacity_) {
+                VLOG(3) << "The entry of " << c << " bytes is too large";
+                rejects_++;
+                return -1;
+            }
+            folly::SharedMutex::WriteHolder wh(lock_);
+            if (map_.find(key) != map_.end()) {
+                return 0;
+            }
+            // Age the history here rather than in get(), the readers never walk the sketch
+            if (sketch_.needsReset()) {
+                sketch_.reset();
+            }
+            int32_t evicted = 0;
+            while (used_ + c > capacity_) {
+                auto victim = nextVictim();
+                if (evicted == 0
+                        && sketch_.estimate(hash)
+                                <= sketch_.estimate(std::hash<K>()(victim->key_))) {
+                    VLOG(3) << "Reject key " << key << ", it is less frequent than "
+                            << victim->key_;
+                    rejects_++;
+                    return -1;
+                }
+                VLOG(3) << "Evict key " << victim->key_;
+                remove(victim);
+                evicted++;
+            }
+            // The new entry is placed right behind the hand, so it is checked last
+            auto it = clock_.emplace(hand_, std::move(key), std::move(val), c);
+            map_.emplace(it->key_, it);
+            used_ += c;
+            evicts_ += evicted;
+            return evicted;
+        }
+
+        bool evict(const K& key) {
+            folly::SharedMutex::WriteHolder wh(lock_);
+            auto it = map_.find(key);
+            if (it == map_.end()) {
+                return false;
+            }
+            remove(it->second);
+            evicts_++;
+            return true;
+        }
+
+        void clear() {
+            folly::SharedMutex::WriteHolder wh(lock_);
+            map_.clear();
+            clock_.clear();
+            hand_ = clock_.end();
+            used_ = 0;
+            total_ = 0;
+            hits_ = 0;
+            evicts_ = 0;
+            rejects_ = 0;
+        }
+
+        size_t usage() {
+            folly::SharedMutex::ReadHolder rh(lock_);
+            return used_;
+        }
+
+    private:
+        struct Entry {
+            Entry(K&& key, V&& val, size_t c)
+                : key_(std::move(key))
+                , val_(std::move(val))
+                , charge_(c) {}
+
+            K                 key_;
+            V                 val_;
+            size_t            charge_;
+            std::atomic<bool> ref_{false};
+        };
+
+        using Clock = std::list<Entry>;
+
+        // Move the hand until an entry not referenced since the last round,
+        // the reference bits passed by are cleared.
+        typename Clock::iterator nextVictim() {
+            DCHECK(!clock_.empty());
+            while (true) {
+                if (hand_ == clock_.end()) {
+                    hand_ = clock_.begin();
+                }
+                if (!hand_->ref_.exchange(false, std::memory_order_relaxed)) {
+                    return hand_;
+                }
+                ++hand_;
+            }
+        }
+
+        void remove(typename Clock::iterator it) {
+            used_ -= it->charge_;
+            map_.erase(it->key_);
+            if (it == hand_) {
+                hand_ = clock_.erase(it);
+            } else {
+                clock_.erase(it);
+            }
+        }
+
+    public:
+        std::atomic_uint64_t total_{0};
+        std::atomic_uint64_t hits_{0};
+        std::atomic_uint64_t evicts_{0};
+        std::atomic_uint64_t rejects_{0};
+
+    private:
+        folly::SharedMutex lock_;
+        size_t capacity_;
+        size_t used_{0};
+        Clock clock_;
+        typename Clock::iterator hand_;
+        std::unordered_map<K, typename Clock::iterator> map_;
+        cache::FrequencySketch sketch_;
+    };
+
+private:
+    /**
+     * If hint is specified, we could use it to cal the bucket index directly without hash key.
+     * */
+    uint32_t bucketIndex(uint64_t hash, int32_t hint = -1) {
+        return hint >= 0 ? (hint & ((1 << bucketsExp_) - 1))
+                         : (hash & ((1 << bucketsExp_) - 1));
+    }
+
+    Bucket& bucketOfHash(uint64_t hash, int32_t hint) {
+        return *buckets_[bucketIndex(hash, hint)];
+    }
+
+    Bucket& bucketOfKey(const K& key, int32_t hint) {
+        return bucketOfHash(hint >= 0 ? 0 : std::hash<K>()(key), hint);
+    }
+
+    void onInserted(int32_t evicts) {
+        if (evicts < 0) {
+            addStat(rejectsStat_);
+        } else if (evicts > 0) {
+            addStat(evictsStat_, evicts);
+        }
+    }
+
+    static void addStat(int32_t index, int64_t value = 1) {
+        if (index >= 0) {
+            stats::StatsManager::addValue(index, value);
+        }
+    }
+
+private:
+    std::vector<std::unique_ptr<Bucket>> buckets_;
+    uint32_t bucketsNum_ = 1;
+    uint32_t bucketsExp_ = 0;
+    int32_t hitsStat_{-1};
+    int32_t missesStat_{-1};
+    int32_t evictsStat_{-1};
+    int32_t rejectsStat_{-1};
+};
+
+}  // namespace nebula
+
+#endif  // COMMON_BASE_CONCURRENTCLOCKCACHE_H_
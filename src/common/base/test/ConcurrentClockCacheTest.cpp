@@ -0,0 +1,204 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "base/ConcurrentClockCache.h"
+#include <gtest/gtest.h>
+
+namespace nebula {
+
+using Cache = ConcurrentClockCache<int32_t, std::string>;
+
+TEST(ConcurrentClockCacheTest, SimpleTest) {
+    Cache cache(1024 * 1024);
+    cache.insert(10, "ten");
+    {
+        auto v = cache.get(10);
+        EXPECT_TRUE(v.ok());
+        EXPECT_EQ("ten", v.value());
+    }
+
+    {
+        auto v = cache.get(5);
+        EXPECT_FALSE(v.ok());
+    }
+
+    EXPECT_EQ(5, cache.bucketIndex(100, 5));
+    EXPECT_EQ(11, cache.bucketIndex(100, 11));
+    EXPECT_EQ(0, cache.bucketIndex(100, 0));
+    EXPECT_EQ(1024 % 16, cache.bucketIndex(100, 1024));
+    EXPECT_EQ(std::hash<int32_t>()(100) % 16, cache.bucketIndex(std::hash<int32_t>()(100), -1));
+
+    EXPECT_EQ(0, cache.evicts());
+    EXPECT_EQ(1, cache.hits());
+    EXPECT_EQ(2, cache.total());
+    EXPECT_EQ(Cache::charge(10, "ten"), cache.usage());
+
+    {
+        auto v = cache.putIfAbsent(10, "ele");
+        EXPECT_TRUE(v.ok());
+        EXPECT_EQ("ten", v.value());
+    }
+    {
+        auto v = cache.putIfAbsent(11, "eleven");
+        EXPECT_EQ(Status::Inserted(), v.status());
+    }
+    cache.evict(10);
+    EXPECT_FALSE(cache.contains(10));
+    EXPECT_TRUE(cache.contains(11));
+    EXPECT_EQ(1, cache.evicts());
+    EXPECT_EQ(Cache::charge(11, "eleven"), cache.usage());
+
+    cache.clear();
+    EXPECT_FALSE(cache.contains(11));
+    EXPECT_EQ(0, cache.usage());
+    EXPECT_EQ(0, cache.total());
+}
+
+TEST(ConcurrentClockCacheTest, CapacityTest) {
+    auto val = [] (int32_t i) {
+        return folly::stringPrintf("%04d_str", i);
+    };
+    auto charge = Cache::charge(0, val(0));
+    Cache cache(10 * charge, 0);
+    for (auto i = 0; i < 10; i++) {
+        cache.insert(i, val(i));
+    }
+    EXPECT_EQ(10 * charge, cache.usage());
+    for (auto i = 0; i < 10; i++) {
+        EXPECT_TRUE(cache.get(i).ok());
+    }
+
+    // The new key has never been accessed, it is rejected
+    cache.insert(10, val(10));
+    EXPECT_FALSE(cache.contains(10));
+    EXPECT_EQ(1, cache.rejects());
+    EXPECT_EQ(0, cache.evicts());
+
+    // Accessed more than the entries in the cache, it is admitted
+    EXPECT_FALSE(cache.get(10).ok());
+    EXPECT_FALSE(cache.get(10).ok());
+    cache.insert(10, val(10));
+    EXPECT_TRUE(cache.contains(10));
+    EXPECT_EQ(1, cache.evicts());
+    EXPECT_EQ(10 * charge, cache.usage());
+
+    // One value of 2 entries evicts 2 entries
+    for (auto i = 0; i < 5; i++) {
+        EXPECT_FALSE(cache.get(100).ok());
+    }
+    auto large = std::string(charge + val(0).size(), 'x');
+    cache.insert(100, large);
+    EXPECT_TRUE(cache.contains(100));
+    EXPECT_EQ(3, cache.evicts());
+    EXPECT_EQ(8 * charge + Cache::charge(100, large), cache.usage());
+    EXPECT_GE(10 * charge, cache.usage());
+
+    // Larger than the whole cache
+    cache.insert(101, std::string(10 * charge, 'x'));
+    EXPECT_FALSE(cache.contains(101));
+    EXPECT_EQ(2, cache.rejects());
+}
+
+TEST(ConcurrentClockCacheTest, ScanResistanceTest) {
+    auto val = [] (int32_t i) {
+        return folly::stringPrintf("%04d_str", i);
+    };
+    Cache cache(100 * Cache::charge(0, val(0)), 0);
+    for (auto round = 0; round < 3; round++) {
+        for (auto i = 0; i < 100; i++) {
+            if (!cache.get(i).ok()) {
+                cache.insert(i, val(i));
+            }
+        }
+    }
+    EXPECT_EQ(200, cache.hits());
+
+    // Scan a lot of keys once
+    for (auto i = 1000; i < 2000; i++) {
+        if (!cache.get(i).ok()) {
+            cache.insert(i, val(i));
+        }
+    }
+    EXPECT_EQ(0, cache.evicts());
+    EXPECT_EQ(1000, cache.rejects());
+
+    // The hot keys are still in the cache
+    for (auto i = 0; i < 100; i++) {
+        auto v = cache.get(i);
+        EXPECT_TRUE(v.ok());
+        EXPECT_EQ(val(i), v.value());
+    }
+    EXPECT_EQ(300, cache.hits());
+    EXPECT_EQ(1400, cache.total());
+}
+
+TEST(ConcurrentClockCacheTest, FrequencySketchTest) {
+    cache::FrequencySketch sketch(4096);
+    // 4 rows of 4096 counters in 4 bits
+    EXPECT_EQ(4096 * 4 / 2, sketch.size());
+
+    // The counter is saturated, without carrying into the others
+    for (auto i = 0; i < 20; i++) {
+        sketch.increment(1);
+    }
+    EXPECT_EQ(15, sketch.estimate(1));
+    EXPECT_EQ(0, sketch.estimate(2));
+
+    // The counters are not halved by the increments, until reset is called
+    auto i = 20;
+    while (!sketch.needsReset()) {
+        sketch.increment(1);
+        i++;
+    }
+    EXPECT_EQ(4096 * 10, i);
+    EXPECT_EQ(15, sketch.estimate(1));
+    sketch.reset();
+    EXPECT_FALSE(sketch.needsReset());
+    EXPECT_EQ(7, sketch.estimate(1));
+    EXPECT_EQ(0, sketch.estimate(2));
+}
+
+TEST(ConcurrentClockCacheTest, StatsTest) {
+    Cache cache(1024 * 1024);
+    cache.registerStats("clock_cache_test");
+    cache.insert(1, "one");
+    cache.get(1);
+    cache.get(2);
+    cache.get(3);
+    cache.evict(1);
+    EXPECT_EQ(1, stats::StatsManager::readValue("clock_cache_test_hits.sum.60").value());
+    EXPECT_EQ(2, stats::StatsManager::readValue("clock_cache_test_misses.sum.60").value());
+    EXPECT_EQ(1, stats::StatsManager::readValue("clock_cache_test_evicts.sum.60").value());
+}
+
+TEST(ConcurrentClockCacheTest, MultiThreadsTest) {
+    Cache cache(64 * 1024);
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < 4; t++) {
+        threads.emplace_back([&cache, t] () {
+            for (auto i = 0; i < 10000; i++) {
+                auto key = (i * (t + 1)) % 2000;
+                auto v = cache.get(key);
+                if (v.ok()) {
+                    EXPECT_EQ(folly::to<std::string>(key), v.value());
+                } else {
+                    cache.insert(key, folly::to<std::string>(key));
+                }
+                if (i % 100 == 0) {
+                    cache.evict(key);
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_GE(64 * 1024, cache.usage());
+    EXPECT_EQ(40000, cache.total());
+}
+
+}  // namespace nebula
@@ -689,6 +689,15 @@ public:
 
     Status MUST_USE_RESULT prepare() override;
 
+    const VariantType& value() const {
+        return operand_;
+    }
+
+    // To bind the value of a parameter
+    void setValue(VariantType val) {
+        operand_ = std::move(val);
+    }
+
 private:
     void encode(ICord<> &cord) const override;
 
@@ -842,6 +851,10 @@ public:
         return operand_.get();
     }
 
+    Operator op() const {
+        return op_;
+    }
+
 private:
     void encode(ICord<> &cord) const override;
 
@@ -939,6 +952,10 @@ public:
         return right_.get();
     }
 
+    Operator op() const {
+        return op_;
+    }
+
 private:
     void encode(ICord<> &cord) const override;
 
@@ -515,8 +515,13 @@ FunctionManager::FunctionManager() {
     {
         auto &attr = functions_["near"];
         attr.minArity_ = 2;
-        attr.maxArity_ = 2;
-        attr.body_ = [] (const auto &args) {
+        attr.maxArity_ = 3;
+        attr.body_ = [] (const auto &args) -> VariantType {
+            if (args.size() == 3) {
+                // near(location, center, distance), which is served by the geo index
+                auto result = geo::GeoFilter::isNear(args);
+                return result.ok() && result.value();
+            }
             auto result = geo::GeoFilter::near(args);
             if (!result.ok()) {
                 return std::string("");
@@ -525,6 +530,16 @@ FunctionManager::FunctionManager() {
             }
         };
     }
+    {
+        // within(location, polygon), which is served by the geo index
+        auto &attr = functions_["within"];
+        attr.minArity_ = 2;
+        attr.maxArity_ = 2;
+        attr.body_ = [] (const auto &args) {
+            auto result = geo::GeoFilter::within(args);
+            return result.ok() && result.value();
+        };
+    }
     {
         auto &attr = functions_["cos_similarity"];
         attr.minArity_ = 2;
@@ -12,8 +12,6 @@
 #include "filter/geo/GeoIndex.h"
 #include <s2/s2cell_id.h>
 #include <s2/s2latlng.h>
-#include <s2/s2cap.h>
-#include <s2/s2region_coverer.h>
 
 namespace nebula {
 namespace geo {
@@ -26,23 +24,21 @@ StatusOr<std::string> GeoFilter::near(const std::vector<VariantType> &args) {
     // we might use it when we support geo with index.
     // auto predicate = args[0];
 
-    std::string pointWkt = kWktPointPrefix;
-    pointWkt.append(boost::get<std::string>(args[0]));
-    Point loc;
-    boost::geometry::read_wkt(pointWkt, loc);
+    if (args[0].which() != VAR_STR) {
+        return Status::Error("The location should be a string.");
+    }
+    auto loc = parsePoint(boost::get<std::string>(args[0]));
+    if (!loc.ok()) {
+        return loc.status();
+    }
 
     auto dist = Expression::toDouble(args[1]);
     if (dist < 0) {
         return Status::Error("Distance should be a positive number.");
     }
 
-    const auto sll = S2LatLng::FromDegrees(loc.x(), loc.y());
-    S1Angle radius = S1Angle::Radians(dist / kEarthRadiusMeters);
-    S2Cap cap(sll.ToPoint(), std::move(radius));
-
-    RegionCoverParams rcParams;
-    S2RegionCoverer rc(rcParams.regionCovererOpts());
-    auto cover = rc.GetCovering(cap);
+    std::vector<S2CellId> cover;
+    GeoIndex().coverCap(loc.value(), dist, cover);
 
     std::string s;
     for (auto &cellId : cover) {
@@ -52,5 +48,104 @@ StatusOr<std::string> GeoFilter::near(const std::vector<VariantType> &args) {
     s.pop_back();
     return s;
 }
+
+StatusOr<bool> GeoFilter::isNear(const std::vector<VariantType> &args) {
+    if (args.size() != 3) {
+        return Status::Error("Function `near' should be given 3 args.");
+    }
+    if (args[0].which() != VAR_STR || args[1].which() != VAR_STR) {
+        return Status::Error("The locations should be strings.");
+    }
+    auto loc = parsePoint(boost::get<std::string>(args[0]));
+    if (!loc.ok()) {
+        return loc.status();
+    }
+    auto center = parsePoint(boost::get<std::string>(args[1]));
+    if (!center.ok()) {
+        return center.status();
+    }
+    auto dist = Expression::toDouble(args[2]);
+    if (dist < 0) {
+        return Status::Error("Distance should be a positive number.");
+    }
+    return distance(loc.value(), center.value()) <= dist;
+}
+
+StatusOr<bool> GeoFilter::within(const std::vector<VariantType> &args) {
+    if (args.size() != 2) {
+        return Status::Error("Function `within' should be given 2 args.");
+    }
+    if (args[0].which() != VAR_STR || args[1].which() != VAR_STR) {
+        return Status::Error("The location and the polygon should be strings.");
+    }
+    auto loc = parsePoint(boost::get<std::string>(args[0]));
+    if (!loc.ok()) {
+        return loc.status();
+    }
+    auto polygon = parsePolygon(boost::get<std::string>(args[1]));
+    if (!polygon.ok()) {
+        return polygon.status();
+    }
+    // The edges are geodesic as the ones covered by the geo index, not planar in degrees
+    auto point = S2LatLng::FromDegrees(loc.value().x(), loc.value().y()).ToPoint();
+    auto outer = GeoIndex::toLoop(polygon.value().outer());
+    if (!outer.ok()) {
+        return outer.status();
+    }
+    if (!outer.value()->Contains(point)) {
+        return false;
+    }
+    for (auto &inner : polygon.value().inners()) {
+        auto hole = GeoIndex::toLoop(inner);
+        if (!hole.ok()) {
+            return hole.status();
+        }
+        if (hole.value()->Contains(point)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+StatusOr<Point> GeoFilter::parsePoint(const std::string &wkt) {
+    std::string pointWkt;
+    if (wkt.compare(0, sizeof(kWktPointPrefix) - 1, kWktPointPrefix) != 0) {
+        pointWkt = kWktPointPrefix;
+    }
+    pointWkt.append(wkt);
+    Point loc;
+    try {
+        boost::geometry::read_wkt(pointWkt, loc);
+    } catch (const std::exception &e) {
+        return Status::Error("Bad point `%s': %s", wkt.c_str(), e.what());
+    }
+    return loc;
+}
+
+StatusOr<Polygon> GeoFilter::parsePolygon(const std::string &wkt) {
+    std::string polygonWkt;
+    if (wkt.compare(0, sizeof(kWktPolygonPrefix) - 1, kWktPolygonPrefix) != 0) {
+        polygonWkt = kWktPolygonPrefix;
+    }
+    polygonWkt.append(wkt);
+    Polygon polygon;
+    try {
+        boost::geometry::read_wkt(polygonWkt, polygon);
+    } catch (const std::exception &e) {
+        return Status::Error("Bad polygon `%s': %s", wkt.c_str(), e.what());
+    }
+    // Close the rings and fix their orientation
+    boost::geometry::correct(polygon);
+    if (polygon.outer().size() < 4) {
+        return Status::Error("Bad polygon `%s': less than 3 vertices", wkt.c_str());
+    }
+    return polygon;
+}
+
+double GeoFilter::distance(const Point &a, const Point &b) {
+    auto from = S2LatLng::FromDegrees(a.x(), a.y());
+    auto to = S2LatLng::FromDegrees(b.x(), b.y());
+    return from.GetDistance(to).radians() * kEarthRadiusMeters;
+}
 }  // namespace geo
 }  // namespace nebula
@@ -9,6 +9,7 @@
 
 #include "base/Base.h"
 #include "base/StatusOr.h"
+#include "filter/geo/GeoParams.h"
 
 namespace nebula {
 namespace geo {
@@ -25,6 +26,30 @@ public:
      * geo code coressponding to the given [lat, lng].
      */
     static StatusOr<std::string> near(const std::vector<VariantType> &args);
+
+    /**
+     * near(location, center, distance) as a predicate, whether the location
+     * is within the distance in meters of the center.
+     */
+    static StatusOr<bool> isNear(const std::vector<VariantType> &args);
+
+    /**
+     * within(location, polygon) as a predicate, whether the location
+     * is inside the polygon, whose edges are geodesic.
+     */
+    static StatusOr<bool> within(const std::vector<VariantType> &args);
+
+    /**
+     * Parse the point in WKT, in the order of latitude and longitude.
+     * The prefix `POINT' could be omitted, e.g. "(30.28243 120.01198)".
+     */
+    static StatusOr<Point> parsePoint(const std::string &wkt);
+
+    // Parse the polygon in WKT, the prefix `POLYGON' could be omitted.
+    static StatusOr<Polygon> parsePolygon(const std::string &wkt);
+
+    // The distance in meters of two points on the earth
+    static double distance(const Point &a, const Point &b);
 };
 }  // namespace geo
 }  // namespace nebula
@@ -11,6 +11,8 @@
 #include <s2/s2cell_id.h>
 #include <s2/s2latlng.h>
 #include <s2/s2polyline.h>
+#include <s2/s2cap.h>
+#include <s2/s2loop.h>
 
 namespace nebula {
 namespace geo {
@@ -70,5 +72,42 @@ Status GeoIndex::indexCellsForPolygon(const Polygon &polygon, std::vector<S2Cell
     // 2. No intersect in loops
     return Status::OK();
 }
+
+// static
+S2CellId GeoIndex::pointCell(const Point &p) {
+    return S2CellId(S2LatLng::FromDegrees(p.x(), p.y()));
+}
+
+void GeoIndex::coverCap(const Point &center, double radius, std::vector<S2CellId> &cells) {
+    const auto sll = S2LatLng::FromDegrees(center.x(), center.y());
+    S2Cap cap(sll.ToPoint(), S1Angle::Radians(radius / kEarthRadiusMeters));
+    S2RegionCoverer rc(rcParams_.regionCovererOpts());
+    rc.GetCovering(cap, &cells);
+}
+
+Status GeoIndex::coverPolygon(const Polygon &polygon, std::vector<S2CellId> &cells) {
+    auto loop = toLoop(polygon.outer());
+    if (!loop.ok()) {
+        return loop.status();
+    }
+    S2RegionCoverer rc(rcParams_.regionCovererOpts());
+    rc.GetCovering(*loop.value(), &cells);
+    return Status::OK();
+}
+
+// static
+StatusOr<std::unique_ptr<S2Loop>> GeoIndex::toLoop(const Polygon::ring_type &ring) {
+    std::vector<S2Point> vertices;
+    // The ring is closed, the last point is the same as the first one
+    for (size_t i = 0; i + 1 < ring.size(); i++) {
+        vertices.emplace_back(S2LatLng::FromDegrees(ring[i].x(), ring[i].y()).ToPoint());
+    }
+    auto loop = std::make_unique<S2Loop>(vertices, S2Debug::DISABLE);
+    if (!loop->IsValid()) {
+        return Status::Error("Invalid polygon");
+    }
+    loop->Normalize();
+    return loop;
+}
 }  // namespace geo
 }  // namespace nebula
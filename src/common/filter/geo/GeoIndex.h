@@ -9,8 +9,10 @@
 
 #include "base/Base.h"
 #include "base/Status.h"
+#include "base/StatusOr.h"
 #include "filter/geo/GeoParams.h"
 #include <s2/s2cell_id.h>
+#include <s2/s2loop.h>
 
 namespace nebula {
 namespace geo {
@@ -23,6 +25,27 @@ public:
     Status indexCellsForLineString(const LineString &line, std::vector<S2CellId> &cells);
 
     Status indexCellsForPolygon(const Polygon &polygon, std::vector<S2CellId> &cells);
+
+    /**
+     * The leaf cell of the point, by which the point is keyed in the geo index.
+     * The leaves of a cell are in the range [range_min, range_max] of its id,
+     * so a covering of a region is scanned as the ranges of its cells.
+     */
+    static S2CellId pointCell(const Point &p);
+
+    // Cover the cap of the radius in meters around the center
+    void coverCap(const Point &center, double radius, std::vector<S2CellId> &cells);
+
+    // Cover the outer ring of the polygon, the holes are left to the exact check
+    Status coverPolygon(const Polygon &polygon, std::vector<S2CellId> &cells);
+
+    /**
+     * The loop of the ring with geodesic edges, the smaller side of the ring
+     * is taken as the inside, whatever its orientation. Both the covering and
+     * the exact check of within are on it, so they agree on the region.
+     */
+    static StatusOr<std::unique_ptr<S2Loop>> toLoop(const Polygon::ring_type &ring);
+
 private:
     RegionCoverParams    rcParams_;
 };
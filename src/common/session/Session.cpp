@@ -24,5 +24,27 @@ void Session::charge() {
 uint64_t Session::idleSeconds() const {
     return idleDuration_.elapsedInSec();
 }
+
+bool Session::addPrepared(int64_t id, std::string query, size_t max) {
+    if (max == 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> g(preparedLock_);
+    while (prepared_.size() >= max) {
+        prepared_.erase(prepared_.begin());
+    }
+    prepared_.emplace(id, std::move(query));
+    return true;
+}
+
+bool Session::getPrepared(int64_t id, std::string *query) const {
+    std::lock_guard<std::mutex> g(preparedLock_);
+    auto it = prepared_.find(id);
+    if (it == prepared_.end()) {
+        return false;
+    }
+    *query = it->second;
+    return true;
+}
 }  // namespace session
 }  // namespace nebula
@@ -106,6 +106,14 @@ public:
 
     void charge();
 
+    /**
+     * Keep the query of a prepared statement, the oldest one is dropped
+     * when there are `max' ones. Return false if none could be kept.
+     */
+    bool addPrepared(int64_t id, std::string query, size_t max);
+
+    bool getPrepared(int64_t id, std::string *query) const;
+
 private:
     Session() = default;
     explicit Session(int64_t id);
@@ -123,6 +131,9 @@ private:
      * But a user has only one role in one space
      */
     std::unordered_map<GraphSpaceID, Role> roles_;
+    // The prepared statements by id, which increases, so the first is the oldest
+    mutable std::mutex                     preparedLock_;
+    std::map<int64_t, std::string>         prepared_;
 };
 
 }  // namespace session
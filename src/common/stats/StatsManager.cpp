@@ -9,9 +9,16 @@
 #include <folly/stats/MultiLevelTimeSeries-defs.h>
 #include <folly/stats/TimeseriesHistogram-defs.h>
 
+DEFINE_bool(stats_thread_local_shard, true,
+            "Record the stats values in the thread local buckets, "
+            "which are merged when the second changes or when read");
+
 namespace nebula {
 namespace stats {
 
+// The most histogram values a thread keeps before merging them
+static constexpr size_t kMaxPendingValues = 64;
+
 // static
 StatsManager& StatsManager::get() {
     static StatsManager sm;
@@ -121,6 +128,44 @@ void StatsManager::addValue(int32_t index, VT value) {
     CHECK_NE(index, 0);
 
     auto& sm = get();
+    if (FLAGS_stats_thread_local_shard) {
+        auto now = time::WallClock::fastNowInSec();
+        auto& shard = *sm.shards_;
+        std::lock_guard<folly::SpinLock> g(shard.lock);
+        if (index > 0) {
+            // Stats
+            --index;
+            DCHECK_LT(index, sm.stats_.size());
+            if (shard.stats.size() <= static_cast<size_t>(index)) {
+                shard.stats.resize(sm.stats_.size());
+            }
+            auto& pending = shard.stats[index];
+            if (pending.count > 0 && pending.sec != now) {
+                sm.flushStats(index, pending);
+            }
+            pending.sec = now;
+            pending.sum += value;
+            pending.count++;
+        } else {
+            // Histogram
+            index = - (index + 1);
+            DCHECK_LT(index, sm.histograms_.size());
+            if (shard.histograms.size() <= static_cast<size_t>(index)) {
+                shard.histograms.resize(sm.histograms_.size());
+            }
+            auto& pending = shard.histograms[index];
+            if (!pending.values.empty() && pending.sec != now) {
+                sm.flushHisto(index, pending);
+            }
+            pending.sec = now;
+            pending.values.emplace_back(value);
+            if (pending.values.size() >= kMaxPendingValues) {
+                sm.flushHisto(index, pending);
+            }
+        }
+        return;
+    }
+
     if (index > 0) {
         // Stats
         --index;
@@ -137,6 +182,68 @@ void StatsManager::addValue(int32_t index, VT value) {
 }
 
 
+StatsManager::Shard::~Shard() {
+    // The thread exits, merge what it has recorded
+    auto& sm = get();
+    std::lock_guard<folly::SpinLock> g(lock);
+    for (size_t i = 0; i < stats.size(); i++) {
+        sm.flushStats(i, stats[i]);
+    }
+    for (size_t i = 0; i < histograms.size(); i++) {
+        sm.flushHisto(i, histograms[i]);
+    }
+}
+
+
+void StatsManager::flushStats(size_t index, PendingStats& pending) {
+    using std::chrono::seconds;
+    if (pending.count == 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> g(*(stats_[index].first));
+        stats_[index].second->addValueAggregated(seconds(pending.sec),
+                                                 pending.sum,
+                                                 pending.count);
+    }
+    pending.sum = 0;
+    pending.count = 0;
+}
+
+
+void StatsManager::flushHisto(size_t index, PendingHisto& pending) {
+    using std::chrono::seconds;
+    if (pending.values.empty()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> g(*(histograms_[index].first));
+        for (auto value : pending.values) {
+            histograms_[index].second->addValue(seconds(pending.sec), value);
+        }
+    }
+    pending.values.clear();
+}
+
+
+void StatsManager::flushShards(int32_t index) {
+    for (auto& shard : shards_.accessAllThreads()) {
+        std::lock_guard<folly::SpinLock> g(shard.lock);
+        if (index > 0) {
+            size_t i = index - 1;
+            if (i < shard.stats.size()) {
+                flushStats(i, shard.stats[i]);
+            }
+        } else {
+            size_t i = - (index + 1);
+            if (i < shard.histograms.size()) {
+                flushHisto(i, shard.histograms[i]);
+            }
+        }
+    }
+}
+
+
 // static
 StatusOr<StatsManager::VT> StatsManager::readValue(folly::StringPiece metricName) {
     std::vector<std::string> parts;
@@ -294,6 +401,7 @@ StatusOr<StatsManager::VT> StatsManager::readStats(int32_t index,
         return Status::Error("Invalid stats");
     }
 
+    sm.flushShards(index);
     if (index > 0) {
         // stats
         --index;
@@ -357,10 +465,11 @@ StatusOr<StatsManager::VT> StatsManager::readHisto(const std::string& counterNam
     if (index >= 0) {
         return Status::Error("Invalid stats");
     }
-    index = - (index + 1);
-    if (static_cast<size_t>(index) >= sm.histograms_.size()) {
+    if (static_cast<size_t>(- (index + 1)) >= sm.histograms_.size()) {
         return Status::Error("Invalid stats");
     }
+    sm.flushShards(index);
+    index = - (index + 1);
 
     std::lock_guard<std::mutex> g(*(sm.histograms_[index].first));
     sm.histograms_[index].second->update(seconds(time::WallClock::fastNowInSec()));
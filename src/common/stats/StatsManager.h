@@ -11,9 +11,12 @@
 #include "time/WallClock.h"
 #include "base/StatusOr.h"
 #include <folly/RWSpinLock.h>
+#include <folly/SpinLock.h>
 #include <folly/stats/MultiLevelTimeSeries.h>
 #include <folly/stats/TimeseriesHistogram.h>
 
+DECLARE_bool(stats_thread_local_shard);
+
 namespace nebula {
 namespace stats {
 
@@ -39,6 +42,12 @@ namespace stats {
  *   latency.p9999.60   -- The latency that slower than 99.99% of all queries
  *                           in the last one minute
  *   error.count.600    -- Total number of errors in the last ten minutes
+ *
+ * When FLAGS_stats_thread_local_shard is on, addValue() records the values
+ * into the pending buckets of the calling thread, which are only merged into
+ * the shared counter when the second changes, when too many values are
+ * pending, or when the counter is read. So the threads recording the same
+ * counter don't contend on its lock for every value.
  */
 class StatsManager final {
     using VT = int64_t;
@@ -100,6 +109,35 @@ private:
     template<class StatsHolder>
     static VT readValue(StatsHolder& stats, TimeRange range, StatsMethod method);
 
+    // The values of a stats recorded by one thread in the same second
+    struct PendingStats {
+        int64_t sec{0};
+        VT sum{0};
+        int64_t count{0};
+    };
+
+    // The values of a histogram recorded by one thread in the same second
+    struct PendingHisto {
+        int64_t sec{0};
+        std::vector<VT> values;
+    };
+
+    // The pending values recorded by one thread, indexed as stats_ and histograms_
+    struct Shard {
+        ~Shard();
+
+        folly::SpinLock lock;
+        std::vector<PendingStats> stats;
+        std::vector<PendingHisto> histograms;
+    };
+    struct ShardTag {};
+
+    // Merge the pending values into the shared counter, the shard should be locked
+    void flushStats(size_t index, PendingStats& pending);
+    void flushHisto(size_t index, PendingHisto& pending);
+    // Merge the pending values of the counter in all threads
+    void flushShards(int32_t index);
+
 
 private:
     std::string domain_;
@@ -125,6 +163,9 @@ private:
                   std::unique_ptr<HistogramType>
         >
     > histograms_;
+
+    // Declared last, so the shards are flushed before the counters are destroyed
+    folly::ThreadLocal<Shard, ShardTag> shards_;
 };
 
 }  // namespace stats
@@ -14,7 +14,8 @@ const int32_t kCounterStats = StatsManager::registerStats("stats");
 const int32_t kCounterHisto = StatsManager::registerHisto("histogram", 10, 1, 100);
 
 
-void statsBM(int32_t counterId, uint32_t numThreads, uint32_t iters) {
+void statsBM(int32_t counterId, uint32_t numThreads, uint32_t iters, bool sharded) {
+    FLAGS_stats_thread_local_shard = sharded;
     std::vector<std::thread> threads;
     for (uint32_t i = 0; i < numThreads; i++) {
         auto itersInThread = i == 0 ? iters - (iters / numThreads) * (numThreads - 1)
@@ -35,29 +36,69 @@ void statsBM(int32_t counterId, uint32_t numThreads, uint32_t iters) {
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK(add_stats_value_1t, iters) {
-    statsBM(kCounterStats, 1, iters);
+    statsBM(kCounterStats, 1, iters, false);
+}
+
+BENCHMARK_RELATIVE(add_stats_value_1t_sharded, iters) {
+    statsBM(kCounterStats, 1, iters, true);
 }
 
 BENCHMARK(add_stats_value_4t, iters) {
-    statsBM(kCounterStats, 4, iters);
+    statsBM(kCounterStats, 4, iters, false);
+}
+
+BENCHMARK_RELATIVE(add_stats_value_4t_sharded, iters) {
+    statsBM(kCounterStats, 4, iters, true);
 }
 
 BENCHMARK(add_stats_value_8t, iters) {
-    statsBM(kCounterStats, 8, iters);
+    statsBM(kCounterStats, 8, iters, false);
+}
+
+BENCHMARK_RELATIVE(add_stats_value_8t_sharded, iters) {
+    statsBM(kCounterStats, 8, iters, true);
+}
+
+BENCHMARK(add_stats_value_32t, iters) {
+    statsBM(kCounterStats, 32, iters, false);
+}
+
+BENCHMARK_RELATIVE(add_stats_value_32t_sharded, iters) {
+    statsBM(kCounterStats, 32, iters, true);
 }
 
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK(add_histogram_value_1t, iters) {
-    statsBM(kCounterHisto, 1, iters);
+    statsBM(kCounterHisto, 1, iters, false);
+}
+
+BENCHMARK_RELATIVE(add_histogram_value_1t_sharded, iters) {
+    statsBM(kCounterHisto, 1, iters, true);
 }
 
 BENCHMARK(add_histogram_value_4t, iters) {
-    statsBM(kCounterHisto, 4, iters);
+    statsBM(kCounterHisto, 4, iters, false);
+}
+
+BENCHMARK_RELATIVE(add_histogram_value_4t_sharded, iters) {
+    statsBM(kCounterHisto, 4, iters, true);
 }
 
 BENCHMARK(add_histogram_value_8t, iters) {
-    statsBM(kCounterHisto, 8, iters);
+    statsBM(kCounterHisto, 8, iters, false);
+}
+
+BENCHMARK_RELATIVE(add_histogram_value_8t_sharded, iters) {
+    statsBM(kCounterHisto, 8, iters, true);
+}
+
+BENCHMARK(add_histogram_value_32t, iters) {
+    statsBM(kCounterHisto, 32, iters, false);
+}
+
+BENCHMARK_RELATIVE(add_histogram_value_32t_sharded, iters) {
+    statsBM(kCounterHisto, 32, iters, true);
 }
 
 BENCHMARK_DRAW_LINE();
@@ -69,22 +110,3 @@ int main(int argc, char** argv) {
     folly::runBenchmarks();
     return 0;
 }
-
-/*
-Test on Intel i7-8650U CPU @ 1.90GHz, 8GB RAM
-
-============================================================================
-StatsManagerBenchmark.cpp                       relative  time/iter  iters/s
-============================================================================
-----------------------------------------------------------------------------
-add_stats_value_1t                                         701.59ns    1.43M
-add_stats_value_4t                                           1.14us  877.59K
-add_stats_value_8t                                           1.45us  689.51K
-----------------------------------------------------------------------------
-add_histogram_value_1t                                     813.82ns    1.23M
-add_histogram_value_4t                                       1.18us  846.58K
-add_histogram_value_8t                                       1.44us  695.65K
-----------------------------------------------------------------------------
-============================================================================
-*/
-
@@ -106,6 +106,55 @@ TEST(StatsManager, ReadAllTest) {
     EXPECT_EQ(stats[35]["value"], 1);
 }
 
+TEST(StatsManager, PendingValuesTest) {
+    FLAGS_stats_thread_local_shard = true;
+    auto statId = StatsManager::registerStats("stat05");
+    auto histoId = StatsManager::registerHisto("stat06", 1, 1, 100);
+
+    // The values recorded by the living threads are read
+    std::mutex lock;
+    std::condition_variable cond;
+    bool added = false;
+    bool read = false;
+    std::vector<std::thread> threads;
+    std::atomic<int32_t> numAdded{0};
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&] () {
+            for (int k = 1; k <= 10; k++) {
+                StatsManager::addValue(statId, k);
+                StatsManager::addValue(histoId, k);
+            }
+            std::unique_lock<std::mutex> l(lock);
+            if (++numAdded == 4) {
+                added = true;
+                cond.notify_all();
+            }
+            cond.wait(l, [&] { return read; });
+        });
+    }
+
+    {
+        std::unique_lock<std::mutex> l(lock);
+        cond.wait(l, [&] { return added; });
+    }
+    EXPECT_EQ(40, StatsManager::readValue("stat05.count.60").value());
+    EXPECT_EQ(220, StatsManager::readValue("stat05.sum.60").value());
+    EXPECT_EQ(40, StatsManager::readValue("stat06.count.60").value());
+    EXPECT_EQ(10, StatsManager::readValue("stat06.p99.60").value());
+    {
+        std::lock_guard<std::mutex> l(lock);
+        read = true;
+        cond.notify_all();
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // Nothing is merged twice
+    EXPECT_EQ(40, StatsManager::readValue("stat05.count.60").value());
+    EXPECT_EQ(40, StatsManager::readValue("stat06.count.60").value());
+}
+
 }   // namespace stats
 }   // namespace nebula
 
@@ -86,6 +86,17 @@ std::string NebulaKeyUtils::kvKey(PartitionID partId, const folly::StringPiece&
     return key;
 }
 
+// static
+std::string NebulaKeyUtils::degreeKey(PartitionID partId, VertexID vId, EdgeType type) {
+    int32_t item = (partId << kPartitionOffset) | static_cast<uint32_t>(NebulaKeyType::kDegree);
+    std::string key;
+    key.reserve(kDegreeLen);
+    key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID))
+       .append(reinterpret_cast<const char*>(&vId), sizeof(VertexID))
+       .append(reinterpret_cast<const char*>(&type), sizeof(EdgeType));
+    return key;
+}
+
 // static
 void NebulaKeyUtils::indexRaw(const IndexValues &values, std::string& raw) {
     std::vector<int32_t> colsLen;
@@ -139,6 +150,15 @@ std::string NebulaKeyUtils::indexPrefix(PartitionID partId, IndexID indexId) {
     return key;
 }
 
+// static
+std::string NebulaKeyUtils::indexPrefix(PartitionID partId) {
+    PartitionID item = (partId << kPartitionOffset) | static_cast<uint32_t>(NebulaKeyType::kIndex);
+    std::string key;
+    key.reserve(sizeof(PartitionID));
+    key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID));
+    return key;
+}
+
 // static
 std::string NebulaKeyUtils::vertexPrefix(PartitionID partId, VertexID vId, TagID tagId) {
     tagId &= kTagMaskSet;
@@ -195,12 +215,22 @@ std::string NebulaKeyUtils::prefix(PartitionID partId) {
 }
 
 // static
-std::string NebulaKeyUtils::snapshotPrefix(PartitionID partId) {
+std::string NebulaKeyUtils::degreePrefix(PartitionID partId) {
+    int32_t item = (partId << kPartitionOffset) | static_cast<uint32_t>(NebulaKeyType::kDegree);
+    std::string key;
+    key.reserve(sizeof(PartitionID));
+    key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID));
+    return key;
+}
+
+// static
+std::vector<std::string> NebulaKeyUtils::snapshotPrefix(PartitionID partId) {
     // snapshot of meta would be all key-value pairs
     if (partId == 0) {
-        return "";
+        return {""};
     }
-    return prefix(partId);
+    // The edge counters are out of the data keys, kDegree is after kData
+    return {prefix(partId), degreePrefix(partId)};
 }
 
 // static
@@ -22,6 +22,9 @@ namespace nebula {
  * EdgeKeyUtils:
  * type(1) + partId(3) + srcId(8) + edgeType(4) + edgeRank(8) + dstId(8) + version(8)
  *
+ * DegreeKeyUtils:
+ * type(1) + partId(3) + vertexId(8) + edgeType(4)
+ *
  * */
 
 enum class NebulaKeyType : uint32_t {
@@ -29,6 +32,7 @@ enum class NebulaKeyType : uint32_t {
     kIndex             = 0x00000002,
     kUUID              = 0x00000003,
     kSystem            = 0x00000004,
+    kDegree            = 0x00000005,
 };
 
 enum class NebulaSystemKeyType : uint32_t {
@@ -63,6 +67,12 @@ public:
 
     static std::string kvKey(PartitionID partId, const folly::StringPiece& name);
 
+    /**
+     * Generate the key of the edge counter of (vertex, edgeType),
+     * its value is a int64 maintained by merge operands.
+     * */
+    static std::string degreeKey(PartitionID partId, VertexID vId, EdgeType type);
+
     /**
      * Generate vertex|edge index key for kv store
      **/
@@ -77,6 +87,8 @@ public:
 
     static std::string indexPrefix(PartitionID partId, IndexID indexId);
 
+    static std::string indexPrefix(PartitionID partId);
+
     /**
      * Prefix for
      * */
@@ -104,7 +116,12 @@ public:
 
     static std::string prefix(PartitionID partId);
 
-    static std::string snapshotPrefix(PartitionID partId);
+    static std::string degreePrefix(PartitionID partId);
+
+    /**
+     * The prefixes of the keys sent in the snapshot of a part, in the order of the keys.
+     * */
+    static std::vector<std::string> snapshotPrefix(PartitionID partId);
 
     static PartitionID getPart(const folly::StringPiece& rawKey) {
         return readInt<PartitionID>(rawKey.data(), sizeof(PartitionID)) >> 8;
@@ -241,6 +258,36 @@ public:
         return static_cast<uint32_t>(NebulaKeyType::kIndex) == type;
     }
 
+    static bool isDegreeKey(const folly::StringPiece& key) {
+        if (key.size() != kDegreeLen) {
+            return false;
+        }
+        auto type = readInt<int32_t>(key.data(), sizeof(int32_t)) & kTypeMask;
+        return static_cast<uint32_t>(NebulaKeyType::kDegree) == type;
+    }
+
+    static VertexID getDegreeVertexId(const folly::StringPiece& rawKey) {
+        CHECK_EQ(rawKey.size(), kDegreeLen);
+        return readInt<VertexID>(rawKey.data() + sizeof(PartitionID), sizeof(VertexID));
+    }
+
+    static EdgeType getDegreeEdgeType(const folly::StringPiece& rawKey) {
+        CHECK_EQ(rawKey.size(), kDegreeLen);
+        auto offset = sizeof(PartitionID) + sizeof(VertexID);
+        return readInt<EdgeType>(rawKey.data() + offset, sizeof(EdgeType));
+    }
+
+    static std::string encodeDegree(int64_t degree) {
+        return std::string(reinterpret_cast<const char*>(&degree), sizeof(int64_t));
+    }
+
+    static int64_t decodeDegree(const folly::StringPiece& raw) {
+        if (raw.size() != sizeof(int64_t)) {
+            return 0;
+        }
+        return readInt<int64_t>(raw.data(), sizeof(int64_t));
+    }
+
     static bool isUUIDKey(const folly::StringPiece& key) {
         auto type = readInt<int32_t>(key.data(), sizeof(int32_t)) & kTypeMask;
         return static_cast<uint32_t>(NebulaKeyType::kUUID) == type;
@@ -408,6 +455,9 @@ private:
 
     static constexpr int32_t kSystemLen = sizeof(PartitionID) + sizeof(NebulaSystemKeyType);
 
+    static constexpr int32_t kDegreeLen = sizeof(PartitionID) + sizeof(VertexID)
+                                        + sizeof(EdgeType);
+
     // The partition id offset in 4 Bytes
     static constexpr uint8_t kPartitionOffset = 8;
 
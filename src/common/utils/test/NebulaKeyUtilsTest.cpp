@@ -39,6 +39,28 @@ TEST(NebulaKeyUtilsTest, SimpleTest) {
     ASSERT_EQ(rank, NebulaKeyUtils::getRank(edgeKey));
     auto uuidKey = NebulaKeyUtils::uuidKey(partId, "nebula");
     ASSERT_TRUE(NebulaKeyUtils::isUUIDKey(uuidKey));
+
+    auto degreeKey = NebulaKeyUtils::degreeKey(partId, srcId, -type);
+    ASSERT_TRUE(NebulaKeyUtils::isDegreeKey(degreeKey));
+    ASSERT_FALSE(NebulaKeyUtils::isDataKey(degreeKey));
+    ASSERT_FALSE(NebulaKeyUtils::isDegreeKey(edgeKey));
+    ASSERT_EQ(partId, NebulaKeyUtils::getPart(degreeKey));
+    ASSERT_EQ(srcId, NebulaKeyUtils::getDegreeVertexId(degreeKey));
+    ASSERT_EQ(-type, NebulaKeyUtils::getDegreeEdgeType(degreeKey));
+    ASSERT_EQ(-3, NebulaKeyUtils::decodeDegree(NebulaKeyUtils::encodeDegree(-3)));
+    ASSERT_TRUE(folly::StringPiece(degreeKey).startsWith(NebulaKeyUtils::degreePrefix(partId)));
+    auto snapshotPrefix = NebulaKeyUtils::snapshotPrefix(partId);
+    ASSERT_EQ(2, snapshotPrefix.size());
+    ASSERT_TRUE(folly::StringPiece(edgeKey).startsWith(snapshotPrefix[0]));
+    ASSERT_TRUE(folly::StringPiece(degreeKey).startsWith(snapshotPrefix[1]));
+    auto indexKey = NebulaKeyUtils::vertexIndexKey(partId, 1, srcId, {});
+    ASSERT_TRUE(folly::StringPiece(indexKey).startsWith(NebulaKeyUtils::indexPrefix(partId)));
+    ASSERT_LT(NebulaKeyUtils::prefix(partId), NebulaKeyUtils::indexPrefix(partId));
+    auto uuidPrefix = NebulaKeyUtils::uuidKey(partId, "");
+    ASSERT_TRUE(folly::StringPiece(NebulaKeyUtils::uuidKey(partId, "name"))
+                    .startsWith(uuidPrefix));
+    ASSERT_LT(NebulaKeyUtils::indexPrefix(partId), uuidPrefix);
+    ASSERT_LT(uuidPrefix, NebulaKeyUtils::degreePrefix(partId));
 }
 
 template<class T>
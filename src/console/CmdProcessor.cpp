@@ -385,6 +385,20 @@ void CmdProcessor::printData(const cpp2::ExecutionResponse& resp,
 }
 #undef PRINT_FIELD_VALUE
 
+void CmdProcessor::printProfile(const cpp2::ExecutionResponse& resp) const {
+    std::cout << "Execution profile:\n";
+    for (auto& node : *resp.get_profile()) {
+        std::cout << std::string(node.get_depth() * 2, ' ') << node.get_name()
+                  << " (" << node.get_duration_in_us() << " us)";
+        for (auto& stat : node.get_stats()) {
+            std::cout << " " << stat.first << "=" << stat.second;
+        }
+        std::cout << "\n";
+    }
+    std::cout << std::endl;
+}
+
+
 void CmdProcessor::printTime() const {
     auto now = std::chrono::system_clock::now();
     std::time_t nowTime = std::chrono::system_clock::to_time_t(now);
@@ -445,6 +459,10 @@ void CmdProcessor::processServerCmd(folly::StringPiece cmd) {
             std::cout << "[WARNING]: " << *resp.get_warning_msg() << std::endl;
             std::cout << std::endl;
         }
+
+        if (resp.__isset.profile) {
+            printProfile(resp);
+        }
    } else if (res == cpp2::ErrorCode::E_SYNTAX_ERROR) {
         std::cout << "[ERROR (" << static_cast<int32_t>(res) << ")]: "
                   << (resp.get_error_msg() == nullptr ? "" : *resp.get_error_msg()) << "\n";
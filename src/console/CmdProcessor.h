@@ -49,6 +49,8 @@ private:
                    const std::string& rowLine,
                    const std::vector<size_t>& widths,
                    const std::vector<std::string>& formats) const;
+    // Print the profile of a `PROFILE'd query as a tree
+    void printProfile(const cpp2::ExecutionResponse& resp) const;
     // Print the time of machine running console
     void printTime() const;
 
@@ -0,0 +1,332 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "graph/ColumnBatch.h"
+#include "dataman/RowWriter.h"
+
+namespace nebula {
+namespace graph {
+
+using nebula::cpp2::SupportedType;
+
+ColumnBatch::ColumnBatch(SchemaPtr schema) : schema_(std::move(schema)) {
+    auto columnCnt = schema_->getNumFields();
+    columns_.resize(columnCnt);
+    for (auto i = 0u; i < columnCnt; i++) {
+        auto type = schema_->getFieldType(i).type;
+        columns_[i].type_ = type;
+        switch (type) {
+            case SupportedType::VID:
+            case SupportedType::INT:
+            case SupportedType::TIMESTAMP:
+            case SupportedType::FLOAT:
+            case SupportedType::DOUBLE:
+            case SupportedType::BOOL:
+            case SupportedType::STRING:
+                break;
+            default:
+                if (unsupported_ < 0) {
+                    unsupported_ = i;
+                }
+        }
+    }
+}
+
+
+size_t ColumnBatch::byteSize() const {
+    size_t size = 0;
+    for (auto &column : columns_) {
+        size += column.ints_.size() * sizeof(int64_t);
+        size += column.doubles_.size() * sizeof(double);
+        size += column.bools_.size();
+        for (auto &str : column.strs_) {
+            size += str.size();
+        }
+    }
+    return size;
+}
+
+
+void ColumnBatch::appendNull(Column &column) {
+    auto word = numRows_ / 64;
+    if (column.nulls_.size() <= word) {
+        column.nulls_.resize(word + 1, 0);
+    }
+    column.nulls_[word] |= 1UL << (numRows_ % 64);
+    switch (column.type_) {
+        case SupportedType::FLOAT:
+        case SupportedType::DOUBLE:
+            column.doubles_.emplace_back(0.0);
+            break;
+        case SupportedType::BOOL:
+            column.bools_.emplace_back(false);
+            break;
+        case SupportedType::STRING:
+            column.strs_.emplace_back();
+            break;
+        default:
+            column.ints_.emplace_back(0);
+            break;
+    }
+}
+
+
+Status ColumnBatch::append(const std::vector<VariantType> &row) {
+    if (unsupported_ >= 0) {
+        return Status::Error("Unknown Type: %d",
+                             static_cast<int32_t>(columns_[unsupported_].type_));
+    }
+    for (auto i = 0u; i < columns_.size(); i++) {
+        auto &column = columns_[i];
+        if (i >= row.size()) {
+            appendNull(column);
+            continue;
+        }
+        auto &v = row[i];
+        switch (column.type_) {
+            case SupportedType::FLOAT:
+            case SupportedType::DOUBLE:
+                if (v.which() != VAR_DOUBLE) {
+                    appendNull(column);
+                    break;
+                }
+                column.doubles_.emplace_back(boost::get<double>(v));
+                break;
+            case SupportedType::BOOL:
+                if (v.which() != VAR_BOOL) {
+                    appendNull(column);
+                    break;
+                }
+                column.bools_.emplace_back(boost::get<bool>(v));
+                break;
+            case SupportedType::STRING:
+                if (v.which() != VAR_STR) {
+                    appendNull(column);
+                    break;
+                }
+                column.strs_.emplace_back(boost::get<std::string>(v));
+                break;
+            default:
+                if (v.which() != VAR_INT64) {
+                    appendNull(column);
+                    break;
+                }
+                column.ints_.emplace_back(boost::get<int64_t>(v));
+                break;
+        }
+    }
+    numRows_++;
+    return Status::OK();
+}
+
+
+Status ColumnBatch::append(const cpp2::RowValue &row) {
+    if (unsupported_ >= 0) {
+        return Status::Error("Unknown Type: %d",
+                             static_cast<int32_t>(columns_[unsupported_].type_));
+    }
+    using Type = cpp2::ColumnValue::Type;
+    auto &cols = row.get_columns();
+    for (auto i = 0u; i < columns_.size(); i++) {
+        auto &column = columns_[i];
+        if (i >= cols.size()) {
+            appendNull(column);
+            continue;
+        }
+        auto &v = cols[i];
+        switch (column.type_) {
+            case SupportedType::FLOAT:
+            case SupportedType::DOUBLE:
+                if (v.getType() == Type::double_precision) {
+                    column.doubles_.emplace_back(v.get_double_precision());
+                } else if (v.getType() == Type::single_precision) {
+                    column.doubles_.emplace_back(v.get_single_precision());
+                } else {
+                    appendNull(column);
+                }
+                break;
+            case SupportedType::BOOL:
+                if (v.getType() != Type::bool_val) {
+                    appendNull(column);
+                    break;
+                }
+                column.bools_.emplace_back(v.get_bool_val());
+                break;
+            case SupportedType::STRING:
+                if (v.getType() != Type::str) {
+                    appendNull(column);
+                    break;
+                }
+                column.strs_.emplace_back(v.get_str());
+                break;
+            default:
+                switch (v.getType()) {
+                    case Type::id:
+                        column.ints_.emplace_back(v.get_id());
+                        break;
+                    case Type::integer:
+                        column.ints_.emplace_back(v.get_integer());
+                        break;
+                    case Type::timestamp:
+                        column.ints_.emplace_back(v.get_timestamp());
+                        break;
+                    default:
+                        appendNull(column);
+                        break;
+                }
+                break;
+        }
+    }
+    numRows_++;
+    return Status::OK();
+}
+
+
+Status ColumnBatch::append(const RowReader *reader) {
+    if (unsupported_ >= 0) {
+        return Status::Error("Unknown Type: %d",
+                             static_cast<int32_t>(columns_[unsupported_].type_));
+    }
+    // Decode the whole row first, so a bad row leaves the batch untouched
+    std::vector<VariantType> row;
+    row.reserve(columns_.size());
+    for (auto i = 0u; i < columns_.size(); i++) {
+        ResultType rc;
+        switch (columns_[i].type_) {
+            case SupportedType::VID: {
+                int64_t v;
+                rc = reader->getVid(i, v);
+                row.emplace_back(v);
+                break;
+            }
+            case SupportedType::FLOAT: {
+                float v;
+                rc = reader->getFloat(i, v);
+                row.emplace_back(static_cast<double>(v));
+                break;
+            }
+            case SupportedType::DOUBLE: {
+                double v;
+                rc = reader->getDouble(i, v);
+                row.emplace_back(v);
+                break;
+            }
+            case SupportedType::BOOL: {
+                bool v;
+                rc = reader->getBool(i, v);
+                row.emplace_back(v);
+                break;
+            }
+            case SupportedType::STRING: {
+                folly::StringPiece v;
+                rc = reader->getString(i, v);
+                row.emplace_back(v.toString());
+                break;
+            }
+            default: {
+                int64_t v;
+                rc = reader->getInt(i, v);
+                row.emplace_back(v);
+                break;
+            }
+        }
+        if (rc != ResultType::SUCCEEDED) {
+            return Status::Error("Get `%s' from interim failed.", schema_->getFieldName(i));
+        }
+    }
+    return append(row);
+}
+
+
+VariantType ColumnBatch::value(size_t row, size_t col) const {
+    auto &column = columns_[col];
+    switch (column.type_) {
+        case SupportedType::FLOAT:
+        case SupportedType::DOUBLE:
+            return column.doubles_[row];
+        case SupportedType::BOOL:
+            return static_cast<bool>(column.bools_[row]);
+        case SupportedType::STRING:
+            return column.strs_[row];
+        default:
+            return column.ints_[row];
+    }
+}
+
+
+cpp2::ColumnValue ColumnBatch::columnValue(size_t row, size_t col) const {
+    auto &column = columns_[col];
+    cpp2::ColumnValue v;
+    switch (column.type_) {
+        case SupportedType::VID:
+            v.set_id(column.ints_[row]);
+            break;
+        case SupportedType::TIMESTAMP:
+            v.set_timestamp(column.ints_[row]);
+            break;
+        case SupportedType::FLOAT:
+            v.set_single_precision(column.doubles_[row]);
+            break;
+        case SupportedType::DOUBLE:
+            v.set_double_precision(column.doubles_[row]);
+            break;
+        case SupportedType::BOOL:
+            v.set_bool_val(column.bools_[row]);
+            break;
+        case SupportedType::STRING:
+            v.set_str(column.strs_[row]);
+            break;
+        default:
+            v.set_integer(column.ints_[row]);
+            break;
+    }
+    return v;
+}
+
+
+cpp2::RowValue ColumnBatch::rowValue(size_t row) const {
+    std::vector<cpp2::ColumnValue> cols;
+    cols.reserve(columns_.size());
+    for (auto i = 0u; i < columns_.size(); i++) {
+        cols.emplace_back(columnValue(row, i));
+    }
+    cpp2::RowValue rowValue;
+    rowValue.set_columns(std::move(cols));
+    return rowValue;
+}
+
+
+std::unique_ptr<RowSetWriter> ColumnBatch::encode() const {
+    auto rsWriter = std::make_unique<RowSetWriter>(schema_);
+    for (auto row = 0u; row < numRows_; row++) {
+        RowWriter writer(schema_);
+        for (auto &column : columns_) {
+            switch (column.type_) {
+                case SupportedType::FLOAT:
+                    writer << static_cast<float>(column.doubles_[row]);
+                    break;
+                case SupportedType::DOUBLE:
+                    writer << column.doubles_[row];
+                    break;
+                case SupportedType::BOOL:
+                    writer << static_cast<bool>(column.bools_[row]);
+                    break;
+                case SupportedType::STRING:
+                    writer << column.strs_[row];
+                    break;
+                default:
+                    writer << column.ints_[row];
+                    break;
+            }
+        }
+        rsWriter->addRow(writer);
+    }
+    return rsWriter;
+}
+
+}   // namespace graph
+}   // namespace nebula
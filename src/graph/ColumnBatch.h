@@ -0,0 +1,112 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef GRAPH_COLUMNBATCH_H_
+#define GRAPH_COLUMNBATCH_H_
+
+#include "base/Base.h"
+#include "base/Status.h"
+#include "gen-cpp2/graph_types.h"
+#include "meta/SchemaProviderIf.h"
+#include "dataman/RowReader.h"
+#include "dataman/RowSetWriter.h"
+
+namespace nebula {
+namespace graph {
+/**
+ * The rows of an intermediate result kept column by column in memory.
+ *
+ * Each column holds the values of its schema type in a plain vector:
+ * VID, INT and TIMESTAMP in int64_t, FLOAT and DOUBLE in double, BOOL and STRING
+ * in their own. A value missing or not of the column type is marked in
+ * the null bitmap of the column, and reads as the default of the type,
+ * which is the same as what RowWriter encodes for it.
+ */
+class ColumnBatch final {
+public:
+    using SchemaPtr = std::shared_ptr<const meta::SchemaProviderIf>;
+
+    explicit ColumnBatch(SchemaPtr schema);
+
+    const SchemaPtr& schema() const {
+        return schema_;
+    }
+
+    size_t numRows() const {
+        return numRows_;
+    }
+
+    size_t numColumns() const {
+        return columns_.size();
+    }
+
+    // The memory used by the values, as a hint of the size of the batch
+    size_t byteSize() const;
+
+    /**
+     * Append one row, the values are matched with the columns in order.
+     * Fail only when the schema has a type not supported.
+     */
+    Status append(const std::vector<VariantType> &row);
+    Status append(const cpp2::RowValue &row);
+    // Decode a row encoded with the same schema
+    Status append(const RowReader *reader);
+
+    bool isNull(size_t row, size_t col) const {
+        auto &nulls = columns_[col].nulls_;
+        auto word = row / 64;
+        return word < nulls.size() && (nulls[word] & (1UL << (row % 64))) != 0;
+    }
+
+    VariantType value(size_t row, size_t col) const;
+
+    cpp2::ColumnValue columnValue(size_t row, size_t col) const;
+
+    cpp2::RowValue rowValue(size_t row) const;
+
+    /**
+     * The values of a VID, INT or TIMESTAMP column,
+     * nullptr for the other columns.
+     */
+    const std::vector<int64_t>* ints(size_t col) const {
+        auto &column = columns_[col];
+        return isIntType(column.type_) ? &column.ints_ : nullptr;
+    }
+
+    // Encode the rows, for the consumers reading through RowReader
+    std::unique_ptr<RowSetWriter> encode() const;
+
+    static bool isIntType(nebula::cpp2::SupportedType type) {
+        return type == nebula::cpp2::SupportedType::VID
+            || type == nebula::cpp2::SupportedType::INT
+            || type == nebula::cpp2::SupportedType::TIMESTAMP;
+    }
+
+private:
+    struct Column {
+        nebula::cpp2::SupportedType     type_;
+        std::vector<int64_t>            ints_;
+        std::vector<double>             doubles_;
+        std::vector<bool>               bools_;
+        std::vector<std::string>        strs_;
+        std::vector<uint64_t>           nulls_;
+    };
+
+    // Append the default of the column type, marked as null
+    void appendNull(Column &column);
+
+private:
+    SchemaPtr                           schema_;
+    std::vector<Column>                 columns_;
+    size_t                              numRows_{0};
+    // The first column of a type not supported, -1 if none
+    int32_t                             unsupported_{-1};
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif  // GRAPH_COLUMNBATCH_H_
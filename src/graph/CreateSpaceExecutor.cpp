@@ -20,7 +20,7 @@ CreateSpaceExecutor::CreateSpaceExecutor(Sentence *sentence,
 
 Status CreateSpaceExecutor::prepare() {
     spaceDesc_ = meta::SpaceDesc();
-    spaceDesc_.spaceName_ = std::move(*(sentence_->spaceName()));
+    spaceDesc_.spaceName_ = *sentence_->spaceName();
     Status retStatus;
     StatusOr<std::string> retStatusOr;
     std::string result;
@@ -36,7 +36,9 @@ void CreateTagIndexExecutor::execute() {
                                      *name,
                                      *tagName,
                                      columns,
-                                     sentence_->isIfNotExist());
+                                     sentence_->isIfNotExist(),
+                                     sentence_->isGeo() ? nebula::cpp2::IndexType::GEO
+                                                        : nebula::cpp2::IndexType::NORMAL);
     auto *runner = ectx()->rctx()->runner();
     auto cb = [this] (auto &&resp) {
         if (!resp.ok()) {
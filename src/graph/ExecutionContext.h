@@ -75,6 +75,15 @@ public:
         return charsetInfo_;
     }
 
+    // Whether the query is `PROFILE'd, set before the executors are prepared
+    void setProfile(bool profile) {
+        profile_ = profile;
+    }
+
+    bool profile() const {
+        return profile_;
+    }
+
 private:
     RequestContextPtr                           rctx_;
     meta::SchemaManager                        *sm_{nullptr};
@@ -83,6 +92,7 @@ private:
     meta::MetaClient                           *metaClient_{nullptr};
     std::unique_ptr<VariableHolder>             variableHolder_;
     CharsetInfo                                *charsetInfo_{nullptr};
+    bool                                        profile_{false};
 };
 
 }   // namespace graph
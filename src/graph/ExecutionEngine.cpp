@@ -8,6 +8,7 @@
 #include "graph/ExecutionEngine.h"
 #include "graph/ExecutionContext.h"
 #include "graph/ExecutionPlan.h"
+#include "graph/GraphFlags.h"
 #include "storage/client/StorageClient.h"
 
 
@@ -34,6 +35,10 @@ Status ExecutionEngine::init(std::shared_ptr<folly::IOThreadPoolExecutor> ioExec
                                                         "graph");
     charsetInfo_ = CharsetInfo::instance();
 
+    if (FLAGS_parse_cache_capacity > 0) {
+        parseCache_ = std::make_unique<ParseCache>(FLAGS_parse_cache_capacity);
+    }
+
     return Status::OK();
 }
 
@@ -44,11 +49,57 @@ void ExecutionEngine::execute(RequestContextPtr rctx) {
                                                    storage_.get(),
                                                    metaClient_,
                                                    charsetInfo_);
-    // TODO(dutor) add support to plan cache
-    auto plan = new ExecutionPlan(std::move(ectx));
+    auto plan = new ExecutionPlan(std::move(ectx), parseCache_.get());
 
     plan->execute();
 }
 
+
+cpp2::PrepareResponse ExecutionEngine::prepare(session::Session *session,
+                                               const std::string &query) {
+    cpp2::PrepareResponse resp;
+    auto result = parseCache_ != nullptr ? parseCache_->take(query) : GQLParser().parse(query);
+    if (!result.ok()) {
+        auto status = std::move(result).status();
+        LOG(ERROR) << "Prepare `" << query << "' failed: " << status;
+        resp.set_error_code(status.isStatementEmpty() ? cpp2::ErrorCode::E_STATEMENT_EMTPY
+                                                      : cpp2::ErrorCode::E_SYNTAX_ERROR);
+        resp.set_error_msg(status.toString());
+        return resp;
+    }
+    auto sentences = std::move(result).value();
+    int32_t numParams = sentences->parameters().size();
+    if (parseCache_ != nullptr) {
+        // To be taken on execution
+        parseCache_->put(query, std::move(sentences));
+    }
+
+    // Kept in the session, and dropped with it on signout or expiry
+    auto id = nextStatementId_++;
+    if (!session->addPrepared(id, query, std::max(FLAGS_max_prepared_statements, 0))) {
+        resp.set_error_code(cpp2::ErrorCode::E_EXECUTION_ERROR);
+        resp.set_error_msg("Prepared statements are disabled");
+        return resp;
+    }
+    resp.set_error_code(cpp2::ErrorCode::SUCCEEDED);
+    resp.set_statement_id(id);
+    resp.set_num_params(numParams);
+    return resp;
+}
+
+
+void ExecutionEngine::executePrepared(RequestContextPtr rctx, int64_t statementId) {
+    std::string query;
+    if (!rctx->session()->getPrepared(statementId, &query)) {
+        rctx->resp().set_error_code(cpp2::ErrorCode::E_EXECUTION_ERROR);
+        rctx->resp().set_error_msg(
+            folly::stringPrintf("Prepared statement %ld not found", statementId));
+        rctx->finish();
+        return;
+    }
+    rctx->setQuery(std::move(query));
+    execute(std::move(rctx));
+}
+
 }   // namespace graph
 }   // namespace nebula
@@ -16,6 +16,7 @@
 #include "meta/client/MetaClient.h"
 #include "network/NetworkUtils.h"
 #include "charset/Charset.h"
+#include "graph/ParseCache.h"
 #include <folly/executors/IOThreadPoolExecutor.h>
 
 /**
@@ -41,7 +42,19 @@ public:
     using RequestContextPtr = std::unique_ptr<RequestContext<cpp2::ExecutionResponse>>;
     void execute(RequestContextPtr rctx);
 
+    /**
+     * Parse the query with parameters `?', and keep it for the session
+     * to execute it with the values bound by executePrepared().
+     */
+    cpp2::PrepareResponse prepare(session::Session *session, const std::string &query);
+
+    // The values of the parameters are in rctx->params()
+    void executePrepared(RequestContextPtr rctx, int64_t statementId);
+
 private:
+    std::unique_ptr<ParseCache>                       parseCache_;
+    std::atomic<int64_t>                              nextStatementId_{1};
+
     std::unique_ptr<meta::SchemaManager>              schemaManager_;
     std::unique_ptr<meta::ClientBasedGflagsManager>   gflagsManager_;
     std::unique_ptr<storage::StorageClient>           storage_;
@@ -17,7 +17,8 @@ void ExecutionPlan::execute() {
 
     Status status;
     do {
-        auto result = GQLParser().parse(rctx->query());
+        auto result = parseCache_ != nullptr ? parseCache_->take(rctx->query())
+                                             : GQLParser().parse(rctx->query());
         if (!result.ok()) {
             status = std::move(result).status();
             LOG(ERROR) << "Do cmd `" << rctx->query() << "' failed: " << status;
@@ -26,6 +27,11 @@ void ExecutionPlan::execute() {
         }
 
         sentences_ = std::move(result).value();
+        status = bindParameters();
+        if (!status.ok()) {
+            break;
+        }
+        ectx()->setProfile(sentences_->isProfile());
         executor_ = std::make_unique<SequentialExecutor>(sentences_.get(), ectx());
         status = executor_->prepare();
         if (!status.ok()) {
@@ -50,7 +56,44 @@ void ExecutionPlan::execute() {
     executor_->setOnFinish(std::move(onFinish));
     executor_->setOnError(std::move(onError));
 
-    executor_->execute();
+    executor_->start();
+}
+
+
+Status ExecutionPlan::bindParameters() {
+    auto &params = ectx()->rctx()->params();
+    auto &parameters = sentences_->parameters();
+    if (params.size() != parameters.size()) {
+        return Status::SyntaxError("%lu parameters in the query, but %lu are bound",
+                                   parameters.size(), params.size());
+    }
+    for (auto i = 0u; i < params.size(); i++) {
+        auto &param = params[i];
+        switch (param.getType()) {
+            case cpp2::ColumnValue::Type::id:
+                parameters[i]->setValue(param.get_id());
+                break;
+            case cpp2::ColumnValue::Type::integer:
+                parameters[i]->setValue(param.get_integer());
+                break;
+            case cpp2::ColumnValue::Type::timestamp:
+                parameters[i]->setValue(param.get_timestamp());
+                break;
+            case cpp2::ColumnValue::Type::bool_val:
+                parameters[i]->setValue(param.get_bool_val());
+                break;
+            case cpp2::ColumnValue::Type::double_precision:
+                parameters[i]->setValue(param.get_double_precision());
+                break;
+            case cpp2::ColumnValue::Type::str:
+                parameters[i]->setValue(param.get_str());
+                break;
+            default:
+                return Status::Error("Unsupported type of the parameter %u: %d",
+                                     i, static_cast<int32_t>(param.getType()));
+        }
+    }
+    return Status::OK();
 }
 
 
@@ -60,8 +103,14 @@ void ExecutionPlan::onFinish() {
     auto latency = rctx->duration().elapsedInUSec();
     stats::Stats::addStatsValue(allStats_.get(), true, latency);
     rctx->resp().set_latency_in_us(latency);
+    setupProfile();
     auto &spaceName = rctx->session()->spaceName();
     rctx->resp().set_space_name(spaceName);
+    if (parseCache_ != nullptr) {
+        // Only the sentences executed successfully are reused, no task is left on them
+        executor_.reset();
+        parseCache_->put(rctx->query(), std::move(sentences_));
+    }
     rctx->finish();
 
     // The `ExecutionPlan' is the root node holding all resources during the execution.
@@ -72,6 +121,20 @@ void ExecutionPlan::onFinish() {
 }
 
 
+void ExecutionPlan::setupProfile() {
+    if (!ectx()->profile() || executor_ == nullptr) {
+        return;
+    }
+    auto &resp = ectx()->rctx()->resp();
+    if (resp.__isset.rows) {
+        executor_->addRowsOut(resp.rows.size());
+    }
+    std::vector<cpp2::ProfileNode> nodes;
+    executor_->appendProfile(0, nodes);
+    resp.set_profile(std::move(nodes));
+}
+
+
 void ExecutionPlan::onError(Status status) {
     LOG(ERROR) << "Execute failed: " << status.toString();
     auto *rctx = ectx()->rctx();
@@ -88,6 +151,7 @@ void ExecutionPlan::onError(Status status) {
     auto latency = rctx->duration().elapsedInUSec();
     stats::Stats::addStatsValue(allStats_.get(), false, latency);
     rctx->resp().set_latency_in_us(latency);
+    setupProfile();
     rctx->finish();
     delete this;
 }
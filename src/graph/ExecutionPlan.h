@@ -13,6 +13,7 @@
 #include "parser/GQLParser.h"
 #include "graph/ExecutionContext.h"
 #include "graph/SequentialExecutor.h"
+#include "graph/ParseCache.h"
 
 /**
  * ExecutionPlan coordinates the execution process,
@@ -25,8 +26,10 @@ namespace graph {
 
 class ExecutionPlan final : public cpp::NonCopyable, public cpp::NonMovable {
 public:
-    explicit ExecutionPlan(std::unique_ptr<ExecutionContext> ectx) {
+    explicit ExecutionPlan(std::unique_ptr<ExecutionContext> ectx,
+                           ParseCache *parseCache = nullptr) {
         ectx_ = std::move(ectx);
+        parseCache_ = parseCache;
         allStats_ = std::make_unique<stats::Stats>("graph", "all");
         parseStats_ = std::make_unique<stats::Stats>("graph", "parse");
     }
@@ -53,6 +56,14 @@ public:
     }
 
 private:
+    // Bind the values of the request to the parameters in the sentences
+    Status bindParameters();
+
+    // Fill the profile of the executors into the response, if the query is `PROFILE'd
+    void setupProfile();
+
+private:
+    ParseCache                                 *parseCache_{nullptr};
     std::unique_ptr<SequentialSentences>        sentences_;
     std::unique_ptr<ExecutionContext>           ectx_;
     std::unique_ptr<SequentialExecutor>         executor_;
@@ -238,9 +238,83 @@ std::unique_ptr<Executor> Executor::makeExecutor(Sentence *sentence) {
             LOG(ERROR) << "Sentence kind illegal: " << kind;
             return nullptr;
     }
+    addChild(executor.get());
     return executor;
 }
 
+
+void Executor::start() {
+    if (ectx()->profile()) {
+        profile_.startInUs_ = ectx()->rctx()->duration().elapsedInUSec();
+    }
+    execute();
+}
+
+
+void Executor::setOnFinish(std::function<void(ProcessControl)> onFinish) {
+    if (!ectx()->profile()) {
+        onFinish_ = std::move(onFinish);
+        return;
+    }
+    onFinish_ = [this, cb = std::move(onFinish)] (ProcessControl ctr) {
+        profile_.finishInUs_ = ectx()->rctx()->duration().elapsedInUSec();
+        cb(ctr);
+    };
+}
+
+
+void Executor::setOnError(std::function<void(Status)> onError) {
+    if (!ectx()->profile()) {
+        onError_ = std::move(onError);
+        return;
+    }
+    onError_ = [this, cb = std::move(onError)] (Status status) {
+        profile_.finishInUs_ = ectx()->rctx()->duration().elapsedInUSec();
+        cb(std::move(status));
+    };
+}
+
+
+void Executor::appendProfile(int32_t depth, std::vector<cpp2::ProfileNode> &nodes) const {
+    cpp2::ProfileNode node;
+    node.set_name(name());
+    node.set_depth(depth);
+    if (profile_.startInUs_ >= 0 && profile_.finishInUs_ >= profile_.startInUs_) {
+        node.set_duration_in_us(profile_.finishInUs_ - profile_.startInUs_);
+    } else {
+        // Not executed, or not finished when the response is made
+        node.set_duration_in_us(-1);
+    }
+    std::map<std::string, int64_t> stats;
+    stats.emplace("rows_in", profile_.rowsIn_);
+    stats.emplace("rows_out", profile_.rowsOut_);
+    if (profile_.rpcs_ > 0) {
+        stats.emplace("rpcs", profile_.rpcs_);
+        stats.emplace("rpc_latency_us", profile_.rpcLatencyInUs_);
+    }
+    node.set_stats(std::move(stats));
+    nodes.emplace_back(std::move(node));
+
+    for (auto &entry : profile_.parts_) {
+        auto &part = entry.second;
+        cpp2::ProfileNode partNode;
+        partNode.set_name(folly::stringPrintf("part %d", entry.first));
+        partNode.set_depth(depth + 1);
+        partNode.set_duration_in_us(part.get_latency_in_us());
+        std::map<std::string, int64_t> partStats;
+        partStats.emplace("keys_scanned", part.get_keys_scanned());
+        partStats.emplace("rows_filtered", part.get_rows_filtered());
+        partStats.emplace("cache_hits", part.get_cache_hits());
+        partStats.emplace("bytes_decoded", part.get_bytes_decoded());
+        partNode.set_stats(std::move(partStats));
+        nodes.emplace_back(std::move(partNode));
+    }
+
+    for (auto *child : profile_.children_) {
+        child->appendProfile(depth + 1, nodes);
+    }
+}
+
 std::string Executor::valueTypeToString(nebula::cpp2::ValueType type) {
     switch (type.type) {
         case nebula::cpp2::SupportedType::BOOL:
@@ -285,7 +359,9 @@ bool Executor::checkValueType(const nebula::cpp2::ValueType &type, const Variant
             return nebula::cpp2::SupportedType::INT == type.type ||
                    nebula::cpp2::SupportedType::TIMESTAMP == type.type;
         case VAR_DOUBLE:
-            return nebula::cpp2::SupportedType::DOUBLE == type.type;
+            // RowWriter narrows a double for a FLOAT field
+            return nebula::cpp2::SupportedType::DOUBLE == type.type ||
+                   nebula::cpp2::SupportedType::FLOAT == type.type;
         case VAR_BOOL:
             return nebula::cpp2::SupportedType::BOOL == type.type;
         case VAR_STR:
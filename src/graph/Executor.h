@@ -12,6 +12,7 @@
 #include "cpp/helpers.h"
 #include "graph/ExecutionContext.h"
 #include "gen-cpp2/common_types.h"
+#include "gen-cpp2/graph_types.h"
 #include "gen-cpp2/storage_types.h"
 #include "dataman/RowWriter.h"
 #include "meta/SchemaManager.h"
@@ -55,12 +56,15 @@ public:
         kReturn,
     };
 
+    /**
+     * Start the execution, i.e. `execute' with its start time recorded for the profile.
+     */
+    void start();
+
     /**
      * Set callback to be invoked when this executor is finished(normally).
      */
-    void setOnFinish(std::function<void(ProcessControl)> onFinish) {
-        onFinish_ = onFinish;
-    }
+    void setOnFinish(std::function<void(ProcessControl)> onFinish);
     /**
      * When some error happens during an executor's execution, it should invoke its
      * `onError_' with a Status that indicates the reason.
@@ -68,9 +72,7 @@ public:
      * An executor terminates its execution via invoking either `onFinish_' or `onError_',
      * but should never call them both.
      */
-    void setOnError(std::function<void(Status)> onError) {
-        onError_ = onError;
-    }
+    void setOnError(std::function<void(Status)> onError);
     /**
      * Upon finished successfully, `setupResponse' would be invoked on the last executor.
      * Any Executor implementation, which wants to send its meaningful result to the client,
@@ -88,9 +90,61 @@ public:
         return duration_;
     }
 
+    void addRowsIn(int64_t rows) {
+        profile_.rowsIn_ += rows;
+    }
+
+    void addRowsOut(int64_t rows) {
+        profile_.rowsOut_ += rows;
+    }
+
+    /**
+     * Append the profile of this executor, the parts of storaged it visited
+     * and its sub-executors, in pre-order.
+     */
+    void appendProfile(int32_t depth, std::vector<cpp2::ProfileNode> &nodes) const;
+
 protected:
     std::unique_ptr<Executor> makeExecutor(Sentence *sentence);
 
+    // Register a sub-executor, whose profile is appended under this one
+    void addChild(const Executor *child) {
+        profile_.children_.emplace_back(child);
+    }
+
+    /**
+     * Count the RPCs sent to storaged and the counters of the parts returned,
+     * when the query is profiled.
+     */
+    template <typename RpcResponse>
+    void profileRpcs(const RpcResponse &result) {
+        if (!ectx()->profile()) {
+            return;
+        }
+        auto &hostLatency = result.hostLatency();
+        profile_.rpcs_ += hostLatency.size();
+        int64_t latency = 0;
+        for (auto &host : hostLatency) {
+            latency = std::max<int64_t>(latency, std::get<2>(host));
+        }
+        profile_.rpcLatencyInUs_ += latency;
+        for (auto &resp : result.responses()) {
+            auto &common = resp.get_result();
+            if (!common.__isset.profiles) {
+                continue;
+            }
+            for (auto &part : common.profiles) {
+                auto &sum = profile_.parts_[part.get_part_id()];
+                sum.part_id = part.get_part_id();
+                sum.keys_scanned += part.get_keys_scanned();
+                sum.rows_filtered += part.get_rows_filtered();
+                sum.cache_hits += part.get_cache_hits();
+                sum.bytes_decoded += part.get_bytes_decoded();
+                sum.latency_in_us += part.get_latency_in_us();
+            }
+        }
+    }
+
     std::string valueTypeToString(nebula::cpp2::ValueType type);
 
     Status writeVariantType(RowWriter &writer, const VariantType &value);
@@ -118,6 +172,23 @@ protected:
     std::function<void(Status)>                 onError_;
     time::Duration                              duration_;
     std::unique_ptr<stats::Stats>               stats_;
+
+private:
+    // Collected for the profile when the query is `PROFILE'd
+    struct Profile {
+        // Relative to the start of the request, -1 if not yet
+        int64_t                                         startInUs_{-1};
+        int64_t                                         finishInUs_{-1};
+        int64_t                                         rowsIn_{0};
+        int64_t                                         rowsOut_{0};
+        int64_t                                         rpcs_{0};
+        // The slowest RPC of each batch, summed over the batches
+        int64_t                                         rpcLatencyInUs_{0};
+        // The counters of each part, summed over the RPCs
+        std::map<PartitionID, storage::cpp2::PartProfile>  parts_;
+        std::vector<const Executor*>                    children_;
+    };
+    Profile                                     profile_;
 };
 
 }   // namespace graph
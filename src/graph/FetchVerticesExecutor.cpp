@@ -328,14 +328,16 @@ void FetchVerticesExecutor::execute() {
 
 void FetchVerticesExecutor::fetchVertices() {
     auto future = ectx()->getStorageClient()->getVertexProps(
-        spaceId_, vids_, std::move(props_));
+        spaceId_, vids_, std::move(props_), ectx()->profile());
     auto *runner = ectx()->rctx()->runner();
     auto cb = [this] (RpcResponse &&result) mutable {
         auto completeness = result.completeness();
         if (completeness == 0) {
             doError(Status::Error("Get tag props failed"));
             return;
-        } else if (completeness != 100) {
+        }
+        profileRpcs(result);
+        if (completeness != 100) {
             LOG(INFO) << "Get vertices partially failed: "  << completeness << "%";
             for (auto &error : result.failedParts()) {
                 LOG(ERROR) << "part: " << error.first
@@ -15,6 +15,13 @@
 
 DEFINE_bool(filter_pushdown, true, "If pushdown the filter to storage.");
 DEFINE_bool(trace_go, false, "Whether to dump the detail trace log from one go request");
+DEFINE_int32(get_neighbors_page_size, 0,
+             "Max edges fetched per vertex in one get neighbors request, 0 means no paging");
+DEFINE_int64(max_edges_buffered_in_paging, 10000000,
+             "Max edges of the pages of a recorded step held in memory, "
+             "the query fails once exceeded, 0 means no limit");
+DEFINE_bool(traverse_pushdown, false,
+            "If go the steps not recorded inside storaged, only the vertices reached are returned");
 
 namespace nebula {
 namespace graph {
@@ -518,6 +525,13 @@ void GoExecutor::setupResponse(cpp2::ExecutionResponse &resp) {
 
 
 void GoExecutor::stepOut() {
+    if (canTraverseInStorage()) {
+        reached_.clear();
+        std::unordered_map<int32_t, std::vector<VertexID>> pending;
+        pending.emplace(recordFrom_ - curStep_, std::move(starts_));
+        traverse(std::move(pending));
+        return;
+    }
     auto spaceId = ectx()->rctx()->session()->space();
     auto status = getStepOutProps();
     if (!status.ok()) {
@@ -533,18 +547,35 @@ void GoExecutor::stepOut() {
     }
     VLOG(1) << "edge type size: " << edgeTypes_.size()
             << " return cols: " << returns.size();
-    auto future  = ectx()->getStorageClient()->getNeighbors(spaceId,
-                                                            starts_,
-                                                            edgeTypes_,
-                                                            filterPushdown,
-                                                            std::move(returns));
+    if (FLAGS_get_neighbors_page_size > 0 && !paging_) {
+        cursors_.clear();
+        for (auto vid : starts_) {
+            cursors_.emplace(vid, "");
+        }
+    }
+    auto future  = FLAGS_get_neighbors_page_size > 0
+        ? ectx()->getStorageClient()->getNeighborsByPage(spaceId,
+                                                         cursors_,
+                                                         edgeTypes_,
+                                                         filterPushdown,
+                                                         std::move(returns),
+                                                         FLAGS_get_neighbors_page_size,
+                                                         ectx()->profile())
+        : ectx()->getStorageClient()->getNeighbors(spaceId,
+                                                   starts_,
+                                                   edgeTypes_,
+                                                   filterPushdown,
+                                                   std::move(returns),
+                                                   ectx()->profile());
     auto *runner = ectx()->rctx()->runner();
     auto cb = [this] (auto &&result) {
         auto completeness = result.completeness();
         if (completeness == 0) {
             doError(Status::Error("Get neighbors failed"));
             return;
-        } else if (completeness != 100) {
+        }
+        profileRpcs(result);
+        if (completeness != 100) {
             // TODO(dutor) We ought to let the user know that the execution was partially
             // performed, even in the case that this happened in the intermediate process.
             // Or, make this case configurable at runtime.
@@ -576,6 +607,98 @@ void GoExecutor::stepOut() {
     std::move(future).via(runner).thenValue(cb).thenError(error);
 }
 
+bool GoExecutor::canTraverseInStorage() const {
+    // The roots of the vertices are not traced back inside storaged,
+    // so it is not supported when the inputs are referred.
+    return FLAGS_traverse_pushdown
+        && !isRecord()
+        && !paging_
+        && !expCtx_->hasInputProp()
+        && !expCtx_->hasVariableProp();
+}
+
+void GoExecutor::traverse(std::unordered_map<int32_t, std::vector<VertexID>> pending) {
+    auto spaceId = ectx()->rctx()->session()->space();
+    std::vector<folly::SemiFuture<TraverseResponse>> futures;
+    for (auto &p : pending) {
+        VLOG(1) << "Go " << p.first << " steps from " << p.second.size() << " vertices";
+        futures.emplace_back(ectx()->getStorageClient()->traverse(spaceId,
+                                                                  p.second,
+                                                                  edgeTypes_,
+                                                                  p.first));
+    }
+    auto *runner = ectx()->rctx()->runner();
+    auto cb = [this] (auto &&results) {
+        onTraverseResponse(std::move(results));
+    };
+    auto error = [this] (auto &&e) {
+        LOG(ERROR) << "Exception when traverse: " << e.what();
+        doError(Status::Error("Exception when traverse: %s.", e.what().c_str()));
+    };
+    folly::collectAll(futures).via(runner).thenValue(cb).thenError(error);
+}
+
+void GoExecutor::onTraverseResponse(std::vector<folly::Try<TraverseResponse>> &&results) {
+    // steps left => vertices forwarded
+    std::unordered_map<int32_t, std::unordered_set<VertexID>> forwards;
+    for (auto &t : results) {
+        if (t.hasException()) {
+            LOG(ERROR) << "Exception when traverse: " << t.exception().what();
+            doError(Status::Error("Exception when traverse: %s.",
+                                  t.exception().what().c_str()));
+            return;
+        }
+        auto &result = t.value();
+        auto completeness = result.completeness();
+        if (completeness == 0) {
+            doError(Status::Error("Traverse failed"));
+            return;
+        } else if (completeness != 100) {
+            // Same as stepping out, keep going when partially failed.
+            LOG(INFO) << "Traverse partially failed: "  << completeness << "%";
+            for (auto &error : result.failedParts()) {
+                LOG(ERROR) << "part: " << error.first
+                           << "error code: " << static_cast<int>(error.second);
+            }
+        }
+        for (auto &resp : result.responses()) {
+            auto *vertices = resp.get_vertices();
+            if (vertices != nullptr) {
+                reached_.insert(vertices->begin(), vertices->end());
+            }
+            auto *forwarded = resp.get_forwards();
+            if (forwarded != nullptr) {
+                for (auto &f : *forwarded) {
+                    forwards[f.first].insert(f.second.begin(), f.second.end());
+                }
+            }
+        }
+    }
+
+    if (!forwards.empty()) {
+        std::unordered_map<int32_t, std::vector<VertexID>> pending;
+        for (auto &f : forwards) {
+            pending.emplace(f.first, std::vector<VertexID>(f.second.begin(), f.second.end()));
+        }
+        traverse(std::move(pending));
+        return;
+    }
+
+    // The steps gone inside storaged are not recorded,
+    // just keep a placeholder for each of them.
+    while (curStep_ < recordFrom_) {
+        records_.emplace_back(RpcResponse(0));
+        curStep_++;
+    }
+    starts_ = std::vector<VertexID>(reached_.begin(), reached_.end());
+    reached_.clear();
+    if (starts_.empty()) {
+        onEmptyInputs();
+        return;
+    }
+    stepOut();
+}
+
 #define GO_EXIT() do { \
         if (!isRecord()) { \
             onEmptyInputs(); \
@@ -587,11 +710,79 @@ void GoExecutor::stepOut() {
     } while (0);
 
 void GoExecutor::onStepOutResponse(RpcResponse &&rpcResp) {
-    joinResp(std::move(rpcResp));
+    std::unordered_map<VertexID, std::string> cursors;
+    for (auto &resp : rpcResp.responses()) {
+        auto *vertices = resp.get_vertices();
+        if (vertices == nullptr) {
+            continue;
+        }
+        for (auto &vdata : *vertices) {
+            if (vdata.__isset.next_cursor) {
+                cursors.emplace(vdata.vertex_id, *vdata.get_next_cursor());
+            }
+        }
+    }
+
+    auto pagingEnabled = FLAGS_get_neighbors_page_size > 0;
+    if (pagingEnabled && !paging_) {
+        pagedDsts_.clear();
+        pagedBackTrace_.clear();
+        bufferedEdges_ = 0;
+    }
+    if (pagingEnabled && !isRecord()) {
+        // Only the dst ids of the steps not recorded are needed,
+        // so collect them page by page, and keep a placeholder for the step.
+        collectDstIds(rpcResp, &pagedDsts_, &pagedBackTrace_);
+        if (!paging_) {
+            joinResp(RpcResponse(0));
+        }
+    } else {
+        if (pagingEnabled) {
+            for (auto &resp : rpcResp.responses()) {
+                if (resp.get_total_edges() != nullptr) {
+                    bufferedEdges_ += *resp.get_total_edges();
+                }
+            }
+            if (FLAGS_max_edges_buffered_in_paging > 0
+                    && bufferedEdges_ > FLAGS_max_edges_buffered_in_paging) {
+                doError(Status::Error("Too many edges in step %u, exceeds %ld",
+                                      curStep_, FLAGS_max_edges_buffered_in_paging));
+                return;
+            }
+        }
+        if (paging_) {
+            // Pages of the same step are folded into one record
+            CHECK_GT(records_.size(), 0);
+            auto &responses = records_.back().responses();
+            for (auto &resp : rpcResp.responses()) {
+                responses.emplace_back(std::move(resp));
+            }
+        } else {
+            joinResp(std::move(rpcResp));
+        }
+    }
+
+    if (!cursors.empty()) {
+        paging_ = true;
+        cursors_ = std::move(cursors);
+        stepOut();
+        return;
+    }
+    paging_ = false;
 
     // back trace each step
     CHECK_GT(records_.size(), 0);
-    auto dsts = getDstIdsFromRespWithBackTrack(records_.back());
+    std::vector<VertexID> dsts;
+    if (pagingEnabled && !isRecord()) {
+        if (!isFinalStep() && backTracker_ != nullptr) {
+            backTracker_->inject(pagedBackTrace_);
+        }
+        dsts.assign(pagedDsts_.begin(), pagedDsts_.end());
+        pagedDsts_.clear();
+        pagedBackTrace_.clear();
+    } else {
+        dsts = getDstIdsFromRespWithBackTrack(records_.back());
+    }
     if (isFinalStep()) {
         GO_EXIT();
     } else {
@@ -671,6 +862,16 @@ std::vector<VertexID> GoExecutor::getDstIdsFromRespWithBackTrack(const RpcRespon
     // So read all roots of current step first , then insert them
     std::multimap<VertexID, VertexID> backTrace;
     std::unordered_set<VertexID> set;
+    collectDstIds(rpcResp, &set, &backTrace);
+    if (!isFinalStep() && backTracker_ != nullptr) {
+        backTracker_->inject(backTrace);
+    }
+    return std::vector<VertexID>(set.begin(), set.end());
+}
+
+void GoExecutor::collectDstIds(const RpcResponse &rpcResp,
+                               std::unordered_set<VertexID> *dsts,
+                               std::multimap<VertexID, VertexID> *backTrace) const {
     for (const auto &resp : rpcResp.responses()) {
         auto *vertices = resp.get_vertices();
         if (vertices == nullptr) {
@@ -684,21 +885,17 @@ std::vector<VertexID> GoExecutor::getDstIdsFromRespWithBackTrack(const RpcRespon
                     if (!isFinalStep() && backTracker_ != nullptr) {
                         auto range = backTracker_->get(vdata.get_vertex_id());
                         if (range.first == range.second) {  // not found root
-                            backTrace.emplace(dst, vdata.get_vertex_id());
+                            backTrace->emplace(dst, vdata.get_vertex_id());
                         }
                         for (auto trace = range.first; trace != range.second; ++trace) {
-                            backTrace.emplace(dst, trace->second);
+                            backTrace->emplace(dst, trace->second);
                         }
                     }
-                    set.emplace(dst);
+                    dsts->emplace(dst);
                 }
             }
         }
     }
-    if (!isFinalStep() && backTracker_ != nullptr) {
-        backTracker_->inject(backTrace);
-    }
-    return std::vector<VertexID>(set.begin(), set.end());
 }
 
 void GoExecutor::finishExecution() {
@@ -924,14 +1121,19 @@ void GoExecutor::fetchVertexProps(std::vector<VertexID> ids) {
         return;
     }
     auto returns = status.value();
-    auto future = ectx()->getStorageClient()->getVertexProps(spaceId, ids, returns);
+    auto future = ectx()->getStorageClient()->getVertexProps(spaceId,
+                                                             ids,
+                                                             returns,
+                                                             ectx()->profile());
     auto *runner = ectx()->rctx()->runner();
     auto cb = [this, ectx = ectx()] (auto &&result) mutable {
         auto completeness = result.completeness();
         if (completeness == 0) {
             doError(Status::Error("Get dest props failed"));
             return;
-        } else if (completeness != 100) {
+        }
+        profileRpcs(result);
+        if (completeness != 100) {
             LOG(INFO) << "Get neighbors partially failed: "  << completeness << "%";
             for (auto &error : result.failedParts()) {
                 LOG(ERROR) << "part: " << error.first
@@ -974,7 +1176,7 @@ bool GoExecutor::setupInterimResult(std::unique_ptr<InterimResult> &result) cons
     // Generic results
     result = std::make_unique<InterimResult>(getResultColumnNames());
     std::shared_ptr<SchemaWriter> schema;
-    std::unique_ptr<RowSetWriter> rsWriter;
+    std::unique_ptr<ColumnBatch> columns;
     auto cb = [&] (std::vector<VariantType> record,
                    const std::vector<nebula::cpp2::SupportedType>& colTypes) -> Status {
         if (schema == nullptr) {
@@ -1012,40 +1214,18 @@ bool GoExecutor::setupInterimResult(std::unique_ptr<InterimResult> &result) cons
                 }
                 schema->appendCol(colnames[i], type);
             }  // for
-            rsWriter = std::make_unique<RowSetWriter>(schema);
+            columns = std::make_unique<ColumnBatch>(schema);
         }  // if
 
-        RowWriter writer(schema);
-        for (auto &column : record) {
-            switch (column.which()) {
-                case VAR_INT64:
-                    writer << boost::get<int64_t>(column);
-                    break;
-                case VAR_DOUBLE:
-                    writer << boost::get<double>(column);
-                    break;
-                case VAR_BOOL:
-                    writer << boost::get<bool>(column);
-                    break;
-                case VAR_STR:
-                    writer << boost::get<std::string>(column);
-                    break;
-                default:
-                    LOG(ERROR) << "Unknown VariantType: " << column.which();
-                    return Status::Error("Unknown VariantType: %d", column.which());
-            }
-        }
-
-        rsWriter->addRow(writer.encode());
-        return Status::OK();
+        return columns->append(record);
     };  // cb
 
     if (!processFinalResult(cb)) {
         return false;
     }
 
-    if (rsWriter != nullptr) {
-        result->setInterim(std::move(rsWriter));
+    if (columns != nullptr) {
+        result->setColumns(std::move(columns));
     }
     return true;
 }
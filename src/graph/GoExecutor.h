@@ -12,6 +12,7 @@
 #include "storage/client/StorageClient.h"
 
 DECLARE_bool(filter_pushdown);
+DECLARE_int32(get_neighbors_page_size);
 
 namespace nebula {
 
@@ -103,6 +104,25 @@ private:
      */
     void onStepOutResponse(RpcResponse &&rpcResp);
 
+    /**
+     * Whether the steps not recorded could be gone inside storaged,
+     * since only the vertices reached are needed in these steps.
+     */
+    bool canTraverseInStorage() const;
+
+    using TraverseResponse = storage::StorageRpcResponse<storage::cpp2::TraverseResponse>;
+    /**
+     * To go the steps not recorded inside storaged.
+     * `pending' is the vertices to go from, keyed by the steps left.
+     */
+    void traverse(std::unordered_map<int32_t, std::vector<VertexID>> pending);
+
+    /**
+     * Callback invoked upon the responses of traversing arrive, the vertices
+     * forwarded by storaged are sent to their hosts in the next round.
+     */
+    void onTraverseResponse(std::vector<folly::Try<TraverseResponse>> &&results);
+
     /**
      * Callback invoked when the stepping out action reaches the dead end.
      */
@@ -133,6 +153,14 @@ private:
 
     std::vector<VertexID> getDstIdsFromRespWithBackTrack(const RpcResponse &rpcResp) const;
 
+    /**
+     * Collect the dst ids and their roots from a stepping out response,
+     * the roots are injected into the back tracker once the step is done.
+     */
+    void collectDstIds(const RpcResponse &rpcResp,
+                       std::unordered_set<VertexID> *dsts,
+                       std::multimap<VertexID, VertexID> *backTrace) const;
+
     /**
      * get the edgeName when over all edges
      */
@@ -254,6 +282,17 @@ private:
     std::unique_ptr<cpp2::ExecutionResponse>    resp_;
     // Record the data of response in GO step
     std::vector<RpcResponse>                    records_;
+    // Cursors of the next page of edges, only used when paging is enabled
+    std::unordered_map<VertexID, std::string>   cursors_;
+    bool                                        paging_{false};
+    // The dst ids and their roots of the pages of a step not recorded,
+    // the pages are dropped once collected
+    std::unordered_set<VertexID>                pagedDsts_;
+    std::multimap<VertexID, VertexID>           pagedBackTrace_;
+    // The edges of the pages of a recorded step held in records_
+    int64_t                                     bufferedEdges_{0};
+    // Vertices reached by the steps gone inside storaged
+    std::unordered_set<VertexID>                reached_;
     // The name of Tag or Edge, index of prop in data
     using SchemaPropIndex = std::unordered_map<std::pair<std::string, std::string>, int64_t>;
 };
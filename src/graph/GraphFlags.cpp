@@ -39,3 +39,16 @@ DEFINE_string(auth_type, "password", "User login authentication type,"
                                      "cloud for cloud authentication");
 
 DEFINE_string(cloud_http_url, "", "cloud http url including ip, port, url path");
+
+DEFINE_int32(group_by_parallel_rows, 100000, "Group the rows on the worker threads in parallel "
+                                              "if there are not less than this number of rows, "
+                                              "0 to always group them in one thread");
+DEFINE_int32(group_by_partitions, 0, "Number of partitions to group the rows in parallel, "
+                                     "0 for the number of worker threads");
+
+DEFINE_int32(parse_cache_capacity, 1024, "Number of the queries whose parsed sentences are cached, "
+                                         "0 to disable the cache");
+DEFINE_int32(parse_cache_copies_per_query, 16,
+             "Max number of the parsed copies cached for one query");
+DEFINE_int32(max_prepared_statements, 10000, "Max number of the prepared statements kept "
+                                             "in a session, the oldest ones are dropped");
@@ -35,4 +35,11 @@ DECLARE_string(auth_type);
 
 DECLARE_string(cloud_http_url);
 
+DECLARE_int32(group_by_parallel_rows);
+DECLARE_int32(group_by_partitions);
+
+DECLARE_int32(parse_cache_capacity);
+DECLARE_int32(parse_cache_copies_per_query);
+DECLARE_int32(max_prepared_statements);
+
 #endif  // GRAPH_GRAPHFLAGS_H_
@@ -143,6 +143,48 @@ GraphService::future_execute(int64_t sessionId, const std::string& query) {
 }
 
 
+folly::Future<cpp2::PrepareResponse>
+GraphService::future_prepare(int64_t sessionId, const std::string& stmt) {
+    auto result = sessionManager_->findSession(sessionId);
+    if (!result.ok()) {
+        FLOG_ERROR("Session not found, id[%ld]", sessionId);
+        cpp2::PrepareResponse resp;
+        resp.set_error_code(cpp2::ErrorCode::E_SESSION_INVALID);
+        resp.set_error_msg(result.status().toString());
+        return resp;
+    }
+    auto session = std::move(result).value();
+    // keep the session active
+    session->charge();
+    return executionEngine_->prepare(session.get(), stmt);
+}
+
+
+folly::Future<cpp2::ExecutionResponse>
+GraphService::future_executePrepared(int64_t sessionId,
+                                     int64_t statementId,
+                                     const std::vector<cpp2::ColumnValue>& params) {
+    auto ctx = std::make_unique<RequestContext<cpp2::ExecutionResponse>>();
+    ctx->setParams(params);
+    ctx->setRunner(getThreadManager());
+    auto future = ctx->future();
+    {
+        auto result = sessionManager_->findSession(sessionId);
+        if (!result.ok()) {
+            FLOG_ERROR("Session not found, id[%ld]", sessionId);
+            ctx->resp().set_error_code(cpp2::ErrorCode::E_SESSION_INVALID);
+            ctx->resp().set_error_msg(result.status().toString());
+            ctx->finish();
+            return future;
+        }
+        ctx->setSession(std::move(result).value());
+    }
+    executionEngine_->executePrepared(std::move(ctx), statementId);
+
+    return future;
+}
+
+
 const char* GraphService::getErrorStr(cpp2::ErrorCode result) {
     switch (result) {
     case cpp2::ErrorCode::SUCCEEDED:
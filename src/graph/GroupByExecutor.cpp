@@ -7,6 +7,8 @@
 #include "base/Base.h"
 #include "graph/GroupByExecutor.h"
 #include "graph/AggregateFunction.h"
+#include "graph/GraphFlags.h"
+#include <folly/hash/Hash.h>
 
 namespace nebula {
 namespace graph {
@@ -208,12 +210,47 @@ void GroupByExecutor::execute() {
         return;
     }
 
-    status = groupingData();
+    size_t partitions = FLAGS_group_by_partitions;
+    if (partitions == 0) {
+        partitions = FLAGS_num_worker_threads > 0 ? FLAGS_num_worker_threads
+                                                  : std::thread::hardware_concurrency();
+    }
+    auto parallel = FLAGS_group_by_parallel_rows > 0
+                 && rows_.size() >= static_cast<size_t>(FLAGS_group_by_parallel_rows)
+                 && partitions > 1
+                 && ectx()->rctx()->runner() != nullptr;
+    intKeyIndex_ = intGroupKeyIndex();
+    auto intKey = intKeyIndex_ >= 0;
+    if (parallel) {
+        VLOG(1) << "Group " << rows_.size() << " rows in " << partitions << " partitions";
+        if (intKey) {
+            groupingDataInParallel<int64_t>(partitions);
+        } else {
+            groupingDataInParallel<ColVals>(partitions);
+        }
+        return;
+    }
+
+    if (intKey) {
+        status = groupingData<int64_t>();
+    } else {
+        status = groupingData<ColVals>();
+    }
+    finishGrouping(std::move(status));
+}
+
+
+void GroupByExecutor::finishGrouping(Status status) {
     if (!status.ok()) {
         doError(std::move(status));
         return;
     }
 
+    if (rows_.empty()) {
+        onEmptyInputs();
+        return;
+    }
+
     status = generateOutputSchema();
     if (!status.ok()) {
         doError(std::move(status));
@@ -233,104 +270,259 @@ void GroupByExecutor::execute() {
 }
 
 
-Status GroupByExecutor::groupingData() {
-    using FunCols = std::vector<std::shared_ptr<AggFun>>;
-    // key : the column values of group by, val: function table of aggregated columns
-    using GroupData = std::unordered_map<ColVals, FunCols, ColsHasher>;
+int64_t GroupByExecutor::intGroupKeyIndex() const {
+    if (groupCols_.size() != 1 || !groupCols_[0]->expr()->isInputExpression()) {
+        return -1;
+    }
+    auto *prop = static_cast<InputPropertyExpression*>(groupCols_[0]->expr())->prop();
+    auto it = schemaMap_.find(*prop);
+    if (it == schemaMap_.end()) {
+        return -1;
+    }
+    auto type = schema_->getFieldType(it->second).type;
+    if (!ColumnBatch::isIntType(type)) {
+        return -1;
+    }
+    return it->second;
+}
 
-    GroupData data;
-    Getters getters;
-    for (auto& it : rows_) {
-        ColVals groupVals;
-        FunCols calVals;
 
-        // Firstly: group the cols
-        for (auto &col : groupCols_) {
-            cpp2::ColumnValue::Type valType = cpp2::ColumnValue::Type::__EMPTY__;
-            getters.getInputProp = [&] (const std::string & prop) -> OptVariantType {
-                auto indexIt = schemaMap_.find(prop);
-                if (indexIt == schemaMap_.end()) {
-                    LOG(ERROR) << prop <<  " is nonexistent";
-                    return Status::Error("%s is nonexistent", prop.c_str());
-                }
-                auto val = it.columns[indexIt->second];
-                valType = val.getType();
-                return toVariantType(val);
-            };
-
-            auto eval = col->expr()->eval(getters);
-            if (!eval.ok()) {
-                return eval.status();
+Status GroupByExecutor::getGroupKey(const cpp2::RowValue &row, ColVals *key) const {
+    Getters getters;
+    for (auto &col : groupCols_) {
+        cpp2::ColumnValue::Type valType = cpp2::ColumnValue::Type::__EMPTY__;
+        getters.getInputProp = [&] (const std::string & prop) -> OptVariantType {
+            auto indexIt = schemaMap_.find(prop);
+            if (indexIt == schemaMap_.end()) {
+                LOG(ERROR) << prop <<  " is nonexistent";
+                return Status::Error("%s is nonexistent", prop.c_str());
             }
+            auto &val = row.columns[indexIt->second];
+            valType = val.getType();
+            return toVariantType(val);
+        };
+
+        auto eval = col->expr()->eval(getters);
+        if (!eval.ok()) {
+            return eval.status();
+        }
 
-            auto cVal = toColumnValue(eval.value(), valType);
-            if (!cVal.ok()) {
-                return cVal.status();
-            }
-            groupVals.vec.emplace_back(std::move(cVal).value());
+        auto cVal = toColumnValue(eval.value(), valType);
+        if (!cVal.ok()) {
+            return cVal.status();
         }
+        key->vec.emplace_back(std::move(cVal).value());
+    }
+    return Status::OK();
+}
 
-        auto findIt = data.find(groupVals);
 
-        // Secondly: get the value of the aggregated column
+Status GroupByExecutor::getGroupKey(const cpp2::RowValue &row, int64_t *key) const {
+    auto &val = row.columns[intKeyIndex_];
+    switch (val.getType()) {
+        case cpp2::ColumnValue::Type::id:
+            *key = val.get_id();
+            break;
+        case cpp2::ColumnValue::Type::integer:
+            *key = val.get_integer();
+            break;
+        case cpp2::ColumnValue::Type::timestamp:
+            *key = val.get_timestamp();
+            break;
+        default:
+            return Status::Error("Wrong type of the group key: %d", val.getType());
+    }
+    return Status::OK();
+}
 
-        // Get all aggregation function
-        if (findIt == data.end()) {
-            for (auto &col : yieldCols_) {
-                auto funPtr = funVec[col->getFunName()]();
-                calVals.emplace_back(std::move(funPtr));
-            }
-        } else {
-            calVals = findIt->second;
-        }
 
-        // Apply value
-        auto i = 0u;
-        for (auto &col : calVals) {
-            cpp2::ColumnValue::Type valType = cpp2::ColumnValue::Type::__EMPTY__;
-            getters.getInputProp = [&] (const std::string &prop) -> OptVariantType{
-                auto indexIt = schemaMap_.find(prop);
-                if (indexIt == schemaMap_.end()) {
-                    LOG(ERROR) << prop <<  " is nonexistent";
-                    return Status::Error("%s is nonexistent", prop.c_str());
-                }
-                auto val = it.columns[indexIt->second];
-                valType = val.getType();
-                return toVariantType(val);
-            };
-            auto eval = yieldCols_[i]->expr()->eval(getters);
-            if (!eval.ok()) {
-                return eval.status();
-            }
+template <typename Key>
+Status GroupByExecutor::aggregate(const cpp2::RowValue &row,
+                                  Key key,
+                                  GroupData<Key> *data) const {
+    auto &calVals = (*data)[std::move(key)];
+    // Get all aggregation function
+    if (calVals.empty()) {
+        for (auto &col : yieldCols_) {
+            auto funPtr = funVec.at(col->getFunName())();
+            calVals.emplace_back(std::move(funPtr));
+        }
+    }
 
-            auto cVal = toColumnValue(std::move(eval).value(), valType);
-            if (!cVal.ok()) {
-                return cVal.status();
+    // Apply value
+    Getters getters;
+    auto i = 0u;
+    for (auto &col : calVals) {
+        cpp2::ColumnValue::Type valType = cpp2::ColumnValue::Type::__EMPTY__;
+        getters.getInputProp = [&] (const std::string &prop) -> OptVariantType{
+            auto indexIt = schemaMap_.find(prop);
+            if (indexIt == schemaMap_.end()) {
+                LOG(ERROR) << prop <<  " is nonexistent";
+                return Status::Error("%s is nonexistent", prop.c_str());
             }
-            col->apply(cVal.value());
-            i++;
+            auto &val = row.columns[indexIt->second];
+            valType = val.getType();
+            return toVariantType(val);
+        };
+        auto eval = yieldCols_[i]->expr()->eval(getters);
+        if (!eval.ok()) {
+            return eval.status();
         }
 
-        if (findIt == data.end()) {
-            data.emplace(std::move(groupVals), std::move(calVals));
+        auto cVal = toColumnValue(std::move(eval).value(), valType);
+        if (!cVal.ok()) {
+            return cVal.status();
         }
+        col->apply(cVal.value());
+        i++;
     }
+    return Status::OK();
+}
 
-    // Generate result data
-    rows_.clear();
-    for (auto& item : data) {
+
+template <typename Key>
+void GroupByExecutor::collectRows(GroupData<Key> *data, std::vector<cpp2::RowValue> *rows) {
+    rows->reserve(rows->size() + data->size());
+    for (auto& item : *data) {
         std::vector<cpp2::ColumnValue> row;
         for (auto& col : item.second) {
             row.emplace_back(col->getResult());
         }
-        rows_.emplace_back();
-        rows_.back().set_columns(std::move(row));
+        rows->emplace_back();
+        rows->back().set_columns(std::move(row));
+    }
+    data->clear();
+}
+
+
+template <typename Key>
+Status GroupByExecutor::groupingData() {
+    GroupData<Key> data;
+    for (auto& it : rows_) {
+        Key key{};
+        // Firstly: group the cols
+        auto status = getGroupKey(it, &key);
+        if (!status.ok()) {
+            return status;
+        }
+        // Secondly: get the value of the aggregated column
+        status = aggregate(it, std::move(key), &data);
+        if (!status.ok()) {
+            return status;
+        }
     }
 
+    // Generate result data
+    rows_.clear();
+    collectRows(&data, &rows_);
     return Status::OK();
 }
 
 
+namespace {
+
+size_t partitionOf(const ColVals &key) {
+    return folly::hash::twang_mix64(ColsHasher()(key));
+}
+
+size_t partitionOf(int64_t key) {
+    return folly::hash::twang_mix64(key);
+}
+
+Status firstError(const std::vector<folly::Try<Status>> &results) {
+    for (auto &result : results) {
+        if (result.hasException()) {
+            return Status::Error("%s", result.exception().what().c_str());
+        }
+        if (!result.value().ok()) {
+            return result.value();
+        }
+    }
+    return Status::OK();
+}
+
+}   // namespace
+
+
+template <typename Key>
+void GroupByExecutor::groupingDataInParallel(size_t partitions) {
+    struct Context {
+        std::vector<Key>                                    keys;
+        // The rows in each partition, by the chunks they are in, to keep their order
+        std::vector<std::vector<std::vector<uint32_t>>>     rows;
+        std::vector<std::vector<cpp2::RowValue>>            results;
+    };
+    auto ctx = std::make_shared<Context>();
+    ctx->keys.resize(rows_.size());
+    ctx->rows.resize(partitions, std::vector<std::vector<uint32_t>>(partitions));
+    ctx->results.resize(partitions);
+
+    auto *runner = ectx()->rctx()->runner();
+    // Firstly: get the group keys chunk by chunk, and hash the rows into the partitions
+    auto chunkSize = (rows_.size() + partitions - 1) / partitions;
+    std::vector<folly::Future<Status>> futures;
+    for (auto chunk = 0u; chunk < partitions; chunk++) {
+        auto begin = std::min(rows_.size(), chunk * chunkSize);
+        auto end = std::min(rows_.size(), begin + chunkSize);
+        futures.emplace_back(folly::via(runner, [this, ctx, chunk, begin, end, partitions] () {
+            auto &parts = ctx->rows[chunk];
+            for (auto i = begin; i < end; i++) {
+                auto status = getGroupKey(rows_[i], &ctx->keys[i]);
+                if (!status.ok()) {
+                    return status;
+                }
+                parts[partitionOf(ctx->keys[i]) % partitions].emplace_back(i);
+            }
+            return Status::OK();
+        }));
+    }
+
+    // Secondly: aggregate each partition with its own table
+    auto group = [this, ctx, partitions, runner] (std::vector<folly::Try<Status>> results) {
+        auto status = firstError(results);
+        if (!status.ok()) {
+            return folly::makeFuture<Status>(std::move(status));
+        }
+        std::vector<folly::Future<Status>> futures;
+        for (auto part = 0u; part < partitions; part++) {
+            futures.emplace_back(folly::via(runner, [this, ctx, part] () {
+                GroupData<Key> data;
+                for (auto &chunk : ctx->rows) {
+                    for (auto i : chunk[part]) {
+                        auto status = aggregate(rows_[i], std::move(ctx->keys[i]), &data);
+                        if (!status.ok()) {
+                            return status;
+                        }
+                    }
+                }
+                collectRows(&data, &ctx->results[part]);
+                return Status::OK();
+            }));
+        }
+        return folly::collectAll(futures).via(runner).thenValue(firstError);
+    };
+
+    // Lastly: the groups in the partitions are disjoint, put them together
+    auto cb = [this, ctx] (Status status) {
+        if (status.ok()) {
+            rows_.clear();
+            for (auto &result : ctx->results) {
+                rows_.insert(rows_.end(),
+                             std::make_move_iterator(result.begin()),
+                             std::make_move_iterator(result.end()));
+            }
+        }
+        finishGrouping(std::move(status));
+    };
+
+    auto error = [this] (auto &&e) {
+        LOG(ERROR) << "Exception caught: " << e.what();
+        doError(Status::Error("Group by exception: %s", e.what().c_str()));
+    };
+    folly::collectAll(futures).via(runner).thenValue(group).thenValue(cb).thenError(error);
+}
+
+
 std::vector<std::string> GroupByExecutor::getResultColumnNames() const {
     std::vector<std::string> result;
     result.reserve(yieldCols_.size());
@@ -391,12 +583,15 @@ StatusOr<std::unique_ptr<InterimResult>> GroupByExecutor::setupInterimResult() {
         return result;
     }
     // Generate results
-    std::unique_ptr<RowSetWriter> rsWriter = std::make_unique<RowSetWriter>(resultSchema_);
-
-    InterimResult::getResultWriter(rows_, rsWriter.get());
-    if (rsWriter != nullptr) {
-        result->setInterim(std::move(rsWriter));
+    auto columns = std::make_unique<ColumnBatch>(resultSchema_);
+    for (auto &row : rows_) {
+        auto status = columns->append(row);
+        if (!status.ok()) {
+            LOG(ERROR) << status;
+            return status;
+        }
     }
+    result->setColumns(std::move(columns));
     return result;
 }
 
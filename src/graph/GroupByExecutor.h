@@ -9,6 +9,7 @@
 
 #include "base/Base.h"
 #include "graph/TraverseExecutor.h"
+#include "graph/AggregateFunction.h"
 
 namespace nebula {
 namespace graph {
@@ -32,7 +33,39 @@ private:
     Status prepareYield();
     Status checkAll();
 
+    using FunCols = std::vector<std::shared_ptr<AggFun>>;
+    // key : the column values of group by, val: function table of aggregated columns
+    template <typename Key>
+    using GroupData = std::unordered_map<Key, FunCols,
+          typename std::conditional<std::is_same<Key, ColVals>::value,
+                                    ColsHasher,
+                                    std::hash<Key>>::type>;
+
+    int64_t intGroupKeyIndex() const;
+
+    Status getGroupKey(const cpp2::RowValue &row, ColVals *key) const;
+    Status getGroupKey(const cpp2::RowValue &row, int64_t *key) const;
+
+    // Apply the row on the aggregation functions of its group
+    template <typename Key>
+    Status aggregate(const cpp2::RowValue &row, Key key, GroupData<Key> *data) const;
+
+    template <typename Key>
     Status groupingData();
+
+    /**
+     * Hash partition the rows by the group keys, and aggregate each partition
+     * on the worker threads, the groups of the partitions are disjoint,
+     * so they are simply put together.
+     */
+    template <typename Key>
+    void groupingDataInParallel(size_t partitions);
+
+    template <typename Key>
+    static void collectRows(GroupData<Key> *data, std::vector<cpp2::RowValue> *rows);
+
+    void finishGrouping(Status status);
+
     Status generateOutputSchema();
 
     std::vector<std::string> getResultColumnNames() const;
@@ -53,6 +86,8 @@ private:
     std::unordered_map<std::string, YieldColumn*>              aliases_;
     // input <fieldName, index>
     std::unordered_map<std::string, int64_t>                   schemaMap_;
+    // The index of the only group column of VID, INT or TIMESTAMP, -1 if none
+    int64_t                                                    intKeyIndex_{-1};
 };
 }  // namespace graph
 }  // namespace nebula
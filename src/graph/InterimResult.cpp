@@ -22,10 +22,33 @@ InterimResult::InterimResult(std::vector<std::string> &&colNames) {
 }
 
 void InterimResult::setInterim(std::unique_ptr<RowSetWriter> rsWriter) {
+    columns_.reset();
     rsWriter_ = std::move(rsWriter);
     rsReader_ = std::make_unique<RowSetReader>(rsWriter_->schema(), rsWriter_->data());
 }
 
+void InterimResult::setColumns(std::unique_ptr<ColumnBatch> columns) {
+    columns_ = std::move(columns);
+    rsReader_.reset();
+    rsWriter_.reset();
+}
+
+const RowSetReader* InterimResult::reader() const {
+    if (rsReader_ == nullptr && columns_ != nullptr) {
+        rsWriter_ = columns_->encode();
+        rsReader_ = std::make_unique<RowSetReader>(rsWriter_->schema(), rsWriter_->data());
+    }
+    return rsReader_.get();
+}
+
+StatusOr<int64_t> InterimResult::vidColumnIndex(const std::string &col) const {
+    auto index = columns_->schema()->getFieldIndex(col);
+    if (index < 0 || columns_->ints(index) == nullptr) {
+        return Status::Error("Column `%s' not found", col.c_str());
+    }
+    return index;
+}
+
 StatusOr<std::vector<VertexID>> InterimResult::getVIDs(const std::string &col) const {
     if (!vids_.empty()) {
         DCHECK(rsReader_ == nullptr);
@@ -34,6 +57,13 @@ StatusOr<std::vector<VertexID>> InterimResult::getVIDs(const std::string &col) c
     if (!hasData()) {
         return Status::Error("Interim has no data.");
     }
+    if (columns_ != nullptr) {
+        auto index = vidColumnIndex(col);
+        if (!index.ok()) {
+            return index.status();
+        }
+        return *columns_->ints(index.value());
+    }
     std::vector<VertexID> result;
     auto iter = rsReader_->begin();
     while (iter) {
@@ -48,6 +78,26 @@ StatusOr<std::vector<VertexID>> InterimResult::getVIDs(const std::string &col) c
     return result;
 }
 
+
+size_t InterimResult::numRows() const {
+    if (!vids_.empty()) {
+        return vids_.size();
+    }
+    if (!hasData()) {
+        return 0;
+    }
+    if (columns_ != nullptr) {
+        return columns_->numRows();
+    }
+    size_t count = 0;
+    auto iter = rsReader_->begin();
+    while (iter) {
+        count++;
+        ++iter;
+    }
+    return count;
+}
+
 StatusOr<std::vector<VertexID>> InterimResult::getDistinctVIDs(const std::string &col) const {
     if (!vids_.empty()) {
         DCHECK(rsReader_ == nullptr);
@@ -56,6 +106,15 @@ StatusOr<std::vector<VertexID>> InterimResult::getDistinctVIDs(const std::string
     if (!hasData()) {
         return Status::Error("Interim has no data.");
     }
+    if (columns_ != nullptr) {
+        auto index = vidColumnIndex(col);
+        if (!index.ok()) {
+            return index.status();
+        }
+        auto *vids = columns_->ints(index.value());
+        std::unordered_set<VertexID> uniq(vids->begin(), vids->end());
+        return std::vector<VertexID>(uniq.begin(), uniq.end());
+    }
     std::unordered_set<VertexID> uniq;
     auto iter = rsReader_->begin();
     while (iter) {
@@ -72,13 +131,33 @@ StatusOr<std::vector<VertexID>> InterimResult::getDistinctVIDs(const std::string
 }
 
 StatusOr<std::vector<cpp2::RowValue>> InterimResult::getRows() const {
+    std::vector<cpp2::RowValue> rows;
+    auto status = forEachRow([&rows] (cpp2::RowValue row) {
+        rows.emplace_back(std::move(row));
+        return Status::OK();
+    });
+    if (!status.ok()) {
+        return status;
+    }
+    return rows;
+}
+
+Status InterimResult::forEachRow(std::function<Status(cpp2::RowValue row)> visitor) const {
     if (!hasData()) {
         return Status::Error("Interim has no data.");
     }
+    if (columns_ != nullptr) {
+        for (auto i = 0u; i < columns_->numRows(); i++) {
+            auto status = visitor(columns_->rowValue(i));
+            if (!status.ok()) {
+                return status;
+            }
+        }
+        return Status::OK();
+    }
     auto schema = rsReader_->schema();
     auto columnCnt = schema->getNumFields();
     VLOG(1) << "columnCnt: " << columnCnt;
-    std::vector<cpp2::RowValue> rows;
     folly::StringPiece piece;
     using nebula::cpp2::SupportedType;
     auto rowIter = rsReader_->begin();
@@ -105,6 +184,17 @@ StatusOr<std::vector<cpp2::RowValue>> InterimResult::getRows() const {
                     row.back().set_id(v);
                     break;
                 }
+                case SupportedType::FLOAT: {
+                    float v;
+                    auto rc = rowIter->getFloat(field, v);
+                    if (rc != ResultType::SUCCEEDED) {
+                        return Status::Error(
+                                "Get float from interim failed, field: %s, index: %ld.",
+                                field, cnt);
+                    }
+                    row.back().set_single_precision(v);
+                    break;
+                }
                 case SupportedType::DOUBLE: {
                     double v;
                     auto rc = rowIter->getDouble(field, v);
@@ -167,11 +257,15 @@ StatusOr<std::vector<cpp2::RowValue>> InterimResult::getRows() const {
             }
             ++fieldIter;
         }
-        rows.emplace_back();
-        rows.back().set_columns(std::move(row));
+        cpp2::RowValue rowValue;
+        rowValue.set_columns(std::move(row));
+        auto status = visitor(std::move(rowValue));
+        if (!status.ok()) {
+            return status;
+        }
         ++rowIter;
     }
-    return rows;
+    return Status::OK();
 }
 
 StatusOr<std::unique_ptr<InterimResult::InterimResultIndex>>
@@ -182,7 +276,7 @@ InterimResult::buildIndex(const std::string &vidColumn) const {
     if (!hasData()) {
         return Status::Error("Interim has no data.");
     }
-    auto schema = rsReader_->schema();
+    auto schema = this->schema();
     auto columnCnt = schema->getNumFields();
     uint32_t vidIndex = 0u;
 
@@ -191,9 +285,7 @@ InterimResult::buildIndex(const std::string &vidColumn) const {
         auto name = schema->getFieldName(i);
         if (vidColumn == name) {
             VLOG(1) << "col name: " << vidColumn << ", col index: " << i;
-            if (schema->getFieldType(i).type != SupportedType::INT &&
-                schema->getFieldType(i).type != SupportedType::VID &&
-                schema->getFieldType(i).type != SupportedType::TIMESTAMP) {
+            if (!ColumnBatch::isIntType(schema->getFieldType(i).type)) {
                 return Status::Error(
                     "Build internal index for input data failed. "
                     "The specific vid column `%s' is not type of VID, INT or TIMESTAMP, "
@@ -205,83 +297,36 @@ InterimResult::buildIndex(const std::string &vidColumn) const {
         index->columnToIndex_[name] = i;
     }
 
-    auto rowIter = rsReader_->begin();
-    auto rowIndex = 0u;
-    while (rowIter) {
-        Row row;
-        row.reserve(columnCnt);
-        for (auto i = 0u; i < columnCnt; i++) {
-            auto type = schema->getFieldType(i).type;
-            switch (type) {
-                case SupportedType::VID: {
-                    int64_t v;
-                    auto rc = rowIter->getVid(i, v);
-                    if (rc != ResultType::SUCCEEDED) {
-                        return Status::Error("Get vid from interim failed.");
-                    }
-                    if (i == vidIndex) {
-                        index->vidToRowIndex_.emplace(v, rowIndex++);
-                    }
-                    row.emplace_back(v);
-                    break;
-                }
-                case SupportedType::DOUBLE: {
-                    double v;
-                    auto rc = rowIter->getDouble(i, v);
-                    if (rc != ResultType::SUCCEEDED) {
-                        return Status::Error("Get double from interim failed.");
-                    }
-                    row.emplace_back(v);
-                    break;
-                }
-                case SupportedType::BOOL: {
-                    bool v;
-                    auto rc = rowIter->getBool(i, v);
-                    if (rc != ResultType::SUCCEEDED) {
-                        return Status::Error("Get bool from interim failed.");
-                    }
-                    row.emplace_back(v);
-                    break;
-                }
-                case SupportedType::STRING: {
-                    folly::StringPiece piece;
-                    auto rc = rowIter->getString(i, piece);
-                    if (rc != ResultType::SUCCEEDED) {
-                        return Status::Error("Get string from interim failed.");
-                    }
-                    row.emplace_back(piece.toString());
-                    break;
-                }
-                case SupportedType::INT:
-                case SupportedType::TIMESTAMP: {
-                    int64_t v;
-                    auto rc = rowIter->getInt(i, v);
-                    if (rc != ResultType::SUCCEEDED) {
-                        return Status::Error("Get int from interim failed.");
-                    }
-                    if (i == vidIndex) {
-                        index->vidToRowIndex_.emplace(v, rowIndex++);
-                    }
-                    row.emplace_back(v);
-                    break;
-                }
-                default:
-                    std::string err =
-                        folly::sformat("Unknown Type: %d", static_cast<int32_t>(type));
-                    LOG(ERROR) << err;
-                    return Status::Error(err);
+    // The index shares the columns, the encoded rows are decoded only once
+    auto columns = columns_;
+    if (columns == nullptr) {
+        auto decoded = std::make_shared<ColumnBatch>(schema);
+        auto rowIter = rsReader_->begin();
+        while (rowIter) {
+            auto status = decoded->append(&*rowIter);
+            if (!status.ok()) {
+                LOG(ERROR) << status;
+                return status;
             }
+            ++rowIter;
+        }
+        columns = std::move(decoded);
+    }
+
+    auto *vids = columns->ints(vidIndex);
+    if (vids != nullptr) {
+        for (auto row = 0u; row < vids->size(); row++) {
+            index->vidToRowIndex_.emplace((*vids)[row], row);
         }
-        index->rows_.emplace_back(std::move(row));
-        ++rowIter;
     }
+    index->columns_ = std::move(columns);
     index->schema_ = schema;
     return index;
 }
 
 OptVariantType
 InterimResult::InterimResultIndex::getColumnWithRow(std::size_t row, const std::string &col) const {
-    if (row >= rows_.size()) {
+    if (row >= columns_->numRows()) {
         return Status::Error("Out of range");
     }
     uint32_t columnIndex = 0;
@@ -293,12 +338,12 @@ InterimResult::InterimResultIndex::getColumnWithRow(std::size_t row, const std::
         }
         columnIndex = iter->second;
     }
-    return rows_[row][columnIndex];
+    return columns_->value(row, columnIndex);
 }
 
 nebula::cpp2::SupportedType InterimResult::getColumnType(
     const std::string &col) const {
-    auto schema = rsReader_->schema();
+    auto schema = this->schema();
     if (schema == nullptr) {
         return nebula::cpp2::SupportedType::UNKNOWN;
     }
@@ -559,36 +604,13 @@ StatusOr<std::unique_ptr<InterimResult>>
 InterimResult::getInterim(
             std::shared_ptr<const meta::SchemaProviderIf> resultSchema,
             std::vector<cpp2::RowValue> &rows) {
-    auto rsWriter = std::make_unique<RowSetWriter>(resultSchema);
+    auto columns = std::make_unique<ColumnBatch>(resultSchema);
     for (auto &r : rows) {
-        RowWriter writer(resultSchema);
-        auto &cols = r.get_columns();
-        for (auto &col : cols) {
-            switch (col.getType()) {
-                case cpp2::ColumnValue::Type::id:
-                    writer << col.get_id();
-                    break;
-                case cpp2::ColumnValue::Type::integer:
-                    writer << col.get_integer();
-                    break;
-                case cpp2::ColumnValue::Type::double_precision:
-                    writer << col.get_double_precision();
-                    break;
-                case cpp2::ColumnValue::Type::bool_val:
-                    writer << col.get_bool_val();
-                    break;
-                case cpp2::ColumnValue::Type::str:
-                    writer << col.get_str();
-                    break;
-                case cpp2::ColumnValue::Type::timestamp:
-                    writer << col.get_timestamp();
-                    break;
-                default:
-                    LOG(ERROR) << NotSupported << static_cast<int32_t>(col.getType());
-                    return Status::Error(NotSupported);
-            }
+        auto status = columns->append(r);
+        if (!status.ok()) {
+            LOG(ERROR) << status;
+            return status;
         }
-        rsWriter->addRow(writer);
     }
 
     std::vector<std::string> colNames;
@@ -598,14 +620,18 @@ InterimResult::getInterim(
         ++iter;
     }
     auto result = std::make_unique<InterimResult>(std::move(colNames));
-    result->setInterim(std::move(rsWriter));
+    result->setColumns(std::move(columns));
     return result;
 }
 
 Status InterimResult::applyTo(std::function<Status(const RowReader *reader)> visitor,
                               int64_t limit) const {
     auto status = Status::OK();
-    auto iter = rsReader_->begin();
+    auto *rsReader = reader();
+    if (rsReader == nullptr) {
+        return status;
+    }
+    auto iter = rsReader->begin();
     while (iter && (limit > 0)) {
         status = visitor(&*iter);
         if (!status.ok()) {
@@ -13,11 +13,16 @@
 #include "dataman/RowSetReader.h"
 #include "dataman/RowSetWriter.h"
 #include "dataman/SchemaWriter.h"
+#include "graph/ColumnBatch.h"
 
 namespace nebula {
 namespace graph {
 /**
  * The intermediate form of execution result, used in pipeline and variable.
+ *
+ * The rows are held either encoded by a RowSetWriter, or column by column
+ * in a ColumnBatch, which is what the executors produce for the next ones,
+ * so the rows are not encoded and decoded again on each pipe.
  */
 class InterimResult final {
 public:
@@ -52,7 +57,12 @@ public:
 
     void setInterim(std::unique_ptr<RowSetWriter> rsWriter);
 
+    void setColumns(std::unique_ptr<ColumnBatch> columns);
+
     bool hasData() const {
+        if (columns_ != nullptr) {
+            return columns_->numRows() > 0;
+        }
         return (rsWriter_ != nullptr)
                 && (!rsWriter_->data().empty())
                 && (rsReader_ != nullptr);
@@ -62,6 +72,9 @@ public:
         if (!hasData()) {
             return nullptr;
         }
+        if (columns_ != nullptr) {
+            return columns_->schema();
+        }
         return rsReader_->schema();
     }
 
@@ -75,10 +88,32 @@ public:
 
     StatusOr<std::vector<cpp2::RowValue>> getRows() const;
 
+    /**
+     * Decode the rows one by one and hand them to the visitor,
+     * so they are not materialized all at once as in getRows().
+     * Stop on the first error returned by the visitor.
+     */
+    Status forEachRow(std::function<Status(cpp2::RowValue row)> visitor) const;
+
+    // The size of the rows, as a hint of the number of rows
+    size_t dataSize() const {
+        if (!hasData()) {
+            return 0;
+        }
+        return columns_ != nullptr ? columns_->byteSize() : rsWriter_->data().size();
+    }
+
+    // Counted by walking the encoded rows if not held in a ColumnBatch
+    size_t numRows() const;
+
     class InterimResultIndex;
     StatusOr<std::unique_ptr<InterimResultIndex>>
     buildIndex(const std::string &vidColumn) const;
 
+    /**
+     * Visit the rows through RowReader, the columns are encoded
+     * on the first call if the rows are held in a ColumnBatch.
+     */
     Status applyTo(std::function<Status(const RowReader *reader)> visitor,
                    int64_t limit = INT64_MAX) const;
 
@@ -105,8 +140,7 @@ public:
 
     private:
         friend class InterimResult;
-        using Row = std::vector<VariantType>;
-        std::vector<Row>                            rows_;
+        std::shared_ptr<const ColumnBatch>          columns_;
         using SchemaPtr = std::shared_ptr<const meta::SchemaProviderIf>;
         SchemaPtr                                   schema_{nullptr};
         std::unordered_map<std::string, uint32_t>   columnToIndex_;
@@ -114,10 +148,16 @@ public:
     };
 
 private:
-    using Row = std::vector<VariantType>;
+    const RowSetReader* reader() const;
+
+    StatusOr<int64_t> vidColumnIndex(const std::string &col) const;
+
+private:
     std::vector<std::string>                    colNames_;
-    std::unique_ptr<RowSetReader>               rsReader_;
-    std::unique_ptr<RowSetWriter>               rsWriter_;
+    // Encoded from columns_ on demand if it is set
+    mutable std::unique_ptr<RowSetReader>       rsReader_;
+    mutable std::unique_ptr<RowSetWriter>       rsWriter_;
+    std::shared_ptr<const ColumnBatch>          columns_;
     std::vector<VertexID>                       vids_;
 };
 
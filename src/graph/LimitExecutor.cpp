@@ -80,42 +80,16 @@ StatusOr<std::unique_ptr<InterimResult>> LimitExecutor::setupInterimResult() {
         return result;
     }
 
-    auto rsWriter = std::make_unique<RowSetWriter>(inputs_->schema());
-    using Type = cpp2::ColumnValue::Type;
+    auto columns = std::make_unique<ColumnBatch>(inputs_->schema());
     for (auto &row : rows_) {
-        RowWriter writer(inputs_->schema());
-        auto columns = row.get_columns();
-        for (auto &column : columns) {
-            switch (column.getType()) {
-                case cpp2::ColumnValue::Type::id:
-                    writer << column.get_id();
-                    break;
-                case Type::integer:
-                    writer << column.get_integer();
-                    break;
-                case Type::double_precision:
-                    writer << column.get_double_precision();
-                    break;
-                case Type::bool_val:
-                    writer << column.get_bool_val();
-                    break;
-                case Type::str:
-                    writer << column.get_str();
-                    break;
-                case cpp2::ColumnValue::Type::timestamp:
-                    writer << column.get_timestamp();
-                    break;
-                default:
-                    LOG(ERROR) << "Not Support type: " << column.getType();
-                    return Status::Error("Not Support type: %d", column.getType());
-            }
+        auto status = columns->append(row);
+        if (!status.ok()) {
+            LOG(ERROR) << status;
+            return status;
         }
-        rsWriter->addRow(writer);
     }
 
-    if (rsWriter != nullptr) {
-        result->setInterim(std::move(rsWriter));
-    }
+    result->setColumns(std::move(columns));
     return result;
 }
 
@@ -220,6 +220,22 @@ Status LookupExecutor::traversalExpr(const Expression *expr) {
             if (*name == "udf_is_in") {
                 return Status::SyntaxError("Unsupported function ： %s", name->c_str());
             }
+            /**
+             * near(tag.prop, center, distance) and within(tag.prop, polygon)
+             * could be looked up by the geo index on the prop.
+             */
+            auto args = fExpr->args();
+            bool isGeo = (*name == "near" && args.size() == 3) ||
+                         (*name == "within" && args.size() == 2);
+            if (isGeo && geoColumn_.empty() &&
+                args[0]->kind() == nebula::Expression::kAliasProp) {
+                auto* aExpr = dynamic_cast<const AliasPropertyExpression*>(args[0]);
+                auto st = checkAliasProperty(aExpr);
+                if (!st.ok()) {
+                    return st;
+                }
+                geoColumn_ = *aExpr->prop();
+            }
             break;
         }
         default : {
@@ -234,7 +250,7 @@ Status LookupExecutor::checkFilter() {
     if (!status.ok()) {
         return status;
     }
-    if (filters_.empty()) {
+    if (filters_.empty() && geoColumn_.empty()) {
         return Status::SyntaxError("Where clause error . have not index matching");
     }
     return Status::OK();
@@ -242,6 +258,23 @@ Status LookupExecutor::checkFilter() {
 
 Status
 LookupExecutor::findValidIndex() {
+    /**
+     * The geo index on the prop of near() or within() is preferred,
+     * the cells covering the region are much less than the whole index.
+     */
+    if (!geoColumn_.empty()) {
+        for (auto& index : indexes_) {
+            if (index->get_index_type() == nebula::cpp2::IndexType::GEO &&
+                index->get_fields().size() == 1 &&
+                index->get_fields()[0].get_name() == geoColumn_) {
+                index_ = index->get_index_id();
+                return Status::OK();
+            }
+        }
+        if (filters_.empty()) {
+            return Status::IndexNotFound();
+        }
+    }
     std::vector<std::shared_ptr<nebula::cpp2::IndexItem>> indexes;
     std::set<std::string> filterCols;
     for (auto& filter : filters_) {
@@ -261,6 +294,9 @@ LookupExecutor::findValidIndex() {
      * col3 > 1 --> index3 is valid.
      */
     for (auto& index : indexes_) {
+        if (index->get_index_type() == nebula::cpp2::IndexType::GEO) {
+            continue;
+        }
         bool matching = true;
         size_t filterNum = 1;
         for (const auto& field : index->get_fields()) {
@@ -85,6 +85,8 @@ private:
     std::unique_ptr<cpp2::ExecutionResponse>       resp_;
     std::vector<std::string>                       returnCols_;
     std::vector<FilterItem>                        filters_;
+    // The prop of near() or within() in the where clause, for the geo index
+    std::string                                    geoColumn_;
     std::vector<std::shared_ptr<nebula::cpp2::IndexItem>> indexes_;
 };
 }  // namespace graph
@@ -104,7 +104,13 @@ void OrderByExecutor::execute() {
         return false;
     };
 
-    if (!sortFactors_.empty()) {
+    if (limit_ >= 0 && rows_.size() > static_cast<uint64_t>(limit_)) {
+        // Sort out only the top rows by a heap, the others are dropped
+        if (!sortFactors_.empty()) {
+            std::partial_sort(rows_.begin(), rows_.begin() + limit_, rows_.end(), comparator);
+        }
+        rows_.resize(limit_);
+    } else if (!sortFactors_.empty()) {
         std::sort(rows_.begin(), rows_.end(), comparator);
     }
 
@@ -168,40 +174,16 @@ StatusOr<std::unique_ptr<InterimResult>> OrderByExecutor::setupInterimResult() {
     }
 
     auto schema = inputs_->schema();
-    auto rsWriter = std::make_unique<RowSetWriter>(schema);
-    using Type = cpp2::ColumnValue::Type;
+    auto columns = std::make_unique<ColumnBatch>(schema);
     for (auto &row : rows_) {
-        RowWriter writer(schema);
-        auto columns = row.get_columns();
-        for (auto &column : columns) {
-            switch (column.getType()) {
-                case Type::id:
-                    writer << column.get_id();
-                    break;
-                case Type::integer:
-                    writer << column.get_integer();
-                    break;
-                case Type::double_precision:
-                    writer << column.get_double_precision();
-                    break;
-                case Type::bool_val:
-                    writer << column.get_bool_val();
-                    break;
-                case Type::str:
-                    writer << column.get_str();
-                    break;
-                case Type::timestamp:
-                    writer << column.get_timestamp();
-                    break;
-                default:
-                    LOG(ERROR) << "Not Support type: " << column.getType();
-                    return Status::Error("Not Support type: %d", column.getType());
-            }
+        auto status = columns->append(row);
+        if (!status.ok()) {
+            LOG(ERROR) << status;
+            return status;
         }
-        rsWriter->addRow(writer);
     }
 
-    result->setInterim(std::move(rsWriter));
+    result->setColumns(std::move(columns));
     return result;
 }
 
@@ -25,6 +25,10 @@ public:
 
     void execute() override;
 
+    void setLimitHint(int64_t limit) override {
+        limit_ = limit;
+    }
+
     void setupResponse(cpp2::ExecutionResponse &resp) override;
 
 private:
@@ -37,6 +41,8 @@ private:
     std::vector<std::string>                                    colNames_;
     std::vector<cpp2::RowValue>                                 rows_;
     std::vector<std::pair<int64_t, OrderFactor::OrderType>>     sortFactors_;
+    // Only the top `limit_' rows are needed if not negative
+    int64_t                                                     limit_{-1};
 };
 }  // namespace graph
 }  // namespace nebula
@@ -0,0 +1,50 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "graph/ParseCache.h"
+#include "graph/GraphFlags.h"
+#include "parser/GQLParser.h"
+
+namespace nebula {
+namespace graph {
+
+// ConcurrentLRUCache needs more entries than buckets, so a small one is in one bucket
+ParseCache::ParseCache(size_t capacity)
+    : cache_(std::max<size_t>(capacity, 2), capacity >= 256 ? 4 : 0) {
+}
+
+
+StatusOr<std::unique_ptr<SequentialSentences>> ParseCache::take(const std::string &query) {
+    auto copies = cache_.get(query);
+    if (copies.ok()) {
+        auto &c = copies.value();
+        std::lock_guard<std::mutex> g(c->lock_);
+        if (!c->sentences_.empty()) {
+            auto sentences = std::move(c->sentences_.back());
+            c->sentences_.pop_back();
+            return sentences;
+        }
+    }
+    return GQLParser().parse(query);
+}
+
+
+void ParseCache::put(const std::string &query, std::unique_ptr<SequentialSentences> sentences) {
+    auto copies = std::make_shared<Copies>();
+    auto ret = cache_.putIfAbsent(query, copies);
+    if (ret.ok()) {
+        // Already cached
+        copies = std::move(ret).value();
+    }
+    std::lock_guard<std::mutex> g(copies->lock_);
+    if (copies->sentences_.size() < static_cast<size_t>(FLAGS_parse_cache_copies_per_query)) {
+        copies->sentences_.emplace_back(std::move(sentences));
+    }
+}
+
+}   // namespace graph
+}   // namespace nebula
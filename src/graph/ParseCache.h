@@ -0,0 +1,53 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef GRAPH_PARSECACHE_H_
+#define GRAPH_PARSECACHE_H_
+
+#include "base/Base.h"
+#include "base/StatusOr.h"
+#include "base/ConcurrentLRUCache.h"
+#include "parser/SequentialSentences.h"
+
+namespace nebula {
+namespace graph {
+
+/**
+ * The LRU cache of the parsed sentences, keyed by the query text.
+ *
+ * The sentences are changed in execution, e.g. the expression contexts set
+ * and the parameters bound, so they are taken out of the cache to be used
+ * by one execution exclusively, and put back when it is done. Several copies
+ * are kept for a query executed concurrently.
+ */
+class ParseCache final {
+public:
+    explicit ParseCache(size_t capacity);
+
+    /**
+     * Take out the sentences of the query, it is parsed if none is cached.
+     */
+    StatusOr<std::unique_ptr<SequentialSentences>> take(const std::string &query);
+
+    void put(const std::string &query, std::unique_ptr<SequentialSentences> sentences);
+
+    uint64_t hits() {
+        return cache_.hits();
+    }
+
+private:
+    struct Copies {
+        std::mutex                                          lock_;
+        std::vector<std::unique_ptr<SequentialSentences>>   sentences_;
+    };
+
+    ConcurrentLRUCache<std::string, std::shared_ptr<Copies>>  cache_;
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif  // GRAPH_PARSECACHE_H_
@@ -27,6 +27,18 @@ Status PipeExecutor::prepare() {
     DCHECK(left_ != nullptr);
     DCHECK(right_ != nullptr);
 
+    if (limitHint_ >= 0) {
+        right_->setLimitHint(limitHint_);
+    }
+    if (sentence_->right()->kind() == Sentence::Kind::kLimit) {
+        // Only the rows before `offset + count' from `left_' are needed,
+        // e.g. `ORDER BY ... | LIMIT n' needs to sort out only the top n rows.
+        auto *limit = static_cast<LimitSentence*>(sentence_->right());
+        if (limit->offset() >= 0 && limit->count() >= 0) {
+            left_->setLimitHint(limit->offset() + limit->count());
+        }
+    }
+
     auto onError = [this] (Status s) {
         /**
          * TODO(dutor)
@@ -42,7 +54,7 @@ Status PipeExecutor::prepare() {
         auto onFinish = [this] (Executor::ProcessControl ctr) {
             UNUSED(ctr);
             // Start executing `right_' when `left_' is finished.
-            right_->execute();
+            right_->start();
         };
         left_->setOnFinish(onFinish);
 
@@ -50,6 +62,9 @@ Status PipeExecutor::prepare() {
             // Feed results from `left_' to `right_'
             // result should never be null, it should give the column names at least.
             DCHECK(result != nullptr);
+            if (ectx()->profile()) {
+                right_->addRowsIn(result->numRows());
+            }
             right_->feedResult(std::move(result));
         };
         left_->setOnResult(onResult);
@@ -113,7 +128,7 @@ Status PipeExecutor::syntaxPreCheck() {
 }
 
 void PipeExecutor::execute() {
-    left_->execute();
+    left_->start();
 }
 
 
@@ -27,6 +27,11 @@ public:
 
     void feedResult(std::unique_ptr<InterimResult> result) override;
 
+    void setLimitHint(int64_t limit) override {
+        // The results come from `right_', which is created in `prepare()'
+        limitHint_ = limit;
+    }
+
     void setupResponse(cpp2::ExecutionResponse &resp) override;
 
 private:
@@ -36,6 +41,7 @@ private:
     PipedSentence                              *sentence_{nullptr};
     std::unique_ptr<TraverseExecutor>           left_;
     std::unique_ptr<TraverseExecutor>           right_;
+    int64_t                                     limitHint_{-1};
 };
 
 }   // namespace graph
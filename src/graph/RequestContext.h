@@ -44,6 +44,15 @@ public:
         return query_;
     }
 
+    // The values bound to the parameters `?' in the query
+    void setParams(std::vector<cpp2::ColumnValue> params) {
+        params_ = std::move(params);
+    }
+
+    const std::vector<cpp2::ColumnValue>& params() const {
+        return params_;
+    }
+
     Response& resp() {
         return resp_;
     }
@@ -83,6 +92,7 @@ public:
 private:
     time::Duration                              duration_;
     std::string                                 query_;
+    std::vector<cpp2::ColumnValue>              params_;
     Response                                    resp_;
     folly::Promise<Response>                    promise_;
     std::shared_ptr<session::Session>           session_;
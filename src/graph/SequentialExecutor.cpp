@@ -66,7 +66,7 @@ Status SequentialExecutor::prepare() {
                 }
                 case Executor::ProcessControl::kNext:
                 default: {
-                    executors_[next]->execute();
+                    executors_[next]->start();
                     break;
                 }
             }
@@ -88,7 +88,7 @@ Status SequentialExecutor::prepare() {
 
 
 void SequentialExecutor::execute() {
-    executors_.front()->execute();
+    executors_.front()->start();
 }
 
 
@@ -6,6 +6,7 @@
 
 #include "base/Base.h"
 #include "graph/SetExecutor.h"
+#include <folly/hash/Hash.h>
 
 namespace nebula {
 namespace graph {
@@ -16,6 +17,47 @@ bool RowValue::operator<(const RowValue& rhs) const {
 }
 }
 
+size_t SetExecutor::RowHash::operator()(const cpp2::RowValue &row) const {
+    using Type = cpp2::ColumnValue::Type;
+    size_t hash = 0;
+    for (auto &col : row.get_columns()) {
+        size_t h = 0;
+        switch (col.getType()) {
+            case Type::bool_val:
+                h = std::hash<bool>()(col.get_bool_val());
+                break;
+            case Type::integer:
+                h = std::hash<int64_t>()(col.get_integer());
+                break;
+            case Type::id:
+                h = std::hash<int64_t>()(col.get_id());
+                break;
+            case Type::single_precision:
+                h = std::hash<float>()(col.get_single_precision());
+                break;
+            case Type::double_precision:
+                h = std::hash<double>()(col.get_double_precision());
+                break;
+            case Type::str:
+                h = std::hash<std::string>()(col.get_str());
+                break;
+            case Type::timestamp:
+                h = std::hash<int64_t>()(col.get_timestamp());
+                break;
+            case Type::year:
+                h = std::hash<int16_t>()(col.get_year());
+                break;
+            default:
+                // The other types are hashed by their type only,
+                // the equality check tells them apart
+                break;
+        }
+        hash = folly::hash::hash_128_to_64(hash, folly::hash::hash_128_to_64(
+                    static_cast<size_t>(col.getType()), h));
+    }
+    return hash;
+}
+
 SetExecutor::SetExecutor(Sentence *sentence, ExecutionContext *ectx)
     : TraverseExecutor(ectx, "set") {
     sentence_ = static_cast<SetSentence*>(sentence);
@@ -114,8 +156,8 @@ void SetExecutor::execute() {
     }
 
     auto *runner = ectx()->rctx()->runner();
-    runner->add([this] () mutable { left_->execute(); });
-    runner->add([this] () mutable { right_->execute(); });
+    runner->add([this] () mutable { left_->start(); });
+    runner->add([this] () mutable { right_->start(); });
 
     auto cb = [this] (auto &&result) {
         UNUSED(result);
@@ -187,36 +229,34 @@ void SetExecutor::doUnion() {
         return;
     }
 
-    auto ret = leftResult_->getRows();
-    if (!ret.ok()) {
-        doError(std::move(ret).status());
-        return;
-    }
-    auto leftRows = std::move(ret).value();
-
-    ret = rightResult_->getRows();
-    if (!ret.ok()) {
-        doError(std::move(ret).status());
-        return;
-    }
-    auto rightRows = std::move(ret).value();
-
-    if (!castingMap_.empty()) {
-        auto stat = doCasting(rightRows);
-        if (!stat.ok()) {
-            doError(std::move(stat));
-            return;
+    std::vector<cpp2::RowValue> rows;
+    // Only the first one of the same rows is kept for UNION DISTINCT, the rows
+    // are indexed by their positions in `rows' to avoid the copies.
+    auto seen = makeRowIndexSet(rows);
+    auto distinct = sentence_->distinct();
+    auto visitor = [&rows, &seen, distinct] (cpp2::RowValue row) {
+        rows.emplace_back(std::move(row));
+        if (distinct && !seen.emplace(rows.size() - 1).second) {
+            rows.pop_back();
         }
+        return Status::OK();
+    };
+    status = leftResult_->forEachRow(visitor);
+    if (status.ok()) {
+        status = rightResult_->forEachRow([this, &visitor] (cpp2::RowValue row) {
+            auto stat = doCasting(row);
+            if (!stat.ok()) {
+                return stat;
+            }
+            return visitor(std::move(row));
+        });
     }
-
-    leftRows.insert(leftRows.end(),
-                    std::make_move_iterator(rightRows.begin()),
-                    std::make_move_iterator(rightRows.end()));
-    if (sentence_->distinct()) {
-        doDistinct(leftRows);
+    if (!status.ok()) {
+        doError(std::move(status));
+        return;
     }
 
-    finishExecution(std::move(leftRows));
+    finishExecution(std::move(rows));
     return;
 }
 
@@ -249,27 +289,26 @@ Status SetExecutor::checkSchema() {
     return Status::OK();
 }
 
-Status SetExecutor::doCasting(std::vector<cpp2::RowValue> &rows) const {
-    for (auto &row : rows) {
-        auto cols = row.get_columns();
-        for (auto &pair : castingMap_) {
-            auto stat =
-                InterimResult::castTo(&cols[pair.first], pair.second.get_type());
-            if (!stat.ok()) {
-                return stat;
-            }
+Status SetExecutor::doCasting(cpp2::RowValue &row) const {
+    for (auto &pair : castingMap_) {
+        auto stat = InterimResult::castTo(&row.columns[pair.first], pair.second.get_type());
+        if (!stat.ok()) {
+            return stat;
         }
-        row.set_columns(std::move(cols));
     }
 
     return Status::OK();
 }
 
 
-void SetExecutor::doDistinct(std::vector<cpp2::RowValue> &rows) const {
-    std::sort(rows.begin(), rows.end());
-    auto it = std::unique(rows.begin(), rows.end());
-    rows.erase(it, rows.end());
+SetExecutor::RowIndexSet SetExecutor::makeRowIndexSet(const std::vector<cpp2::RowValue> &rows) {
+    auto hash = [&rows] (size_t index) {
+        return RowHash()(rows[index]);
+    };
+    auto equal = [&rows] (size_t lhs, size_t rhs) {
+        return rows[lhs] == rows[rhs];
+    };
+    return RowIndexSet(rows.size(), hash, equal);
 }
 
 void SetExecutor::doIntersect() {
@@ -286,37 +325,67 @@ void SetExecutor::doIntersect() {
         return;
     }
 
-    auto ret = leftResult_->getRows();
-    if (!ret.ok()) {
-        doError(std::move(ret).status());
-        return;
-    }
-    auto leftRows = std::move(ret).value();
-
-    ret = rightResult_->getRows();
-    if (!ret.ok()) {
-        doError(std::move(ret).status());
-        return;
-    }
-    auto rightRows = std::move(ret).value();
-
-    if (!castingMap_.empty()) {
-        Status stat = doCasting(rightRows);
-        if (!stat.ok()) {
-            doError(std::move(stat));
+    // A row is kept as many times as it is on both sides, in the order of the left side.
+    // The hash table is built on the smaller side, and probed by the other one.
+    std::vector<cpp2::RowValue> rows;
+    if (rightResult_->dataSize() <= leftResult_->dataSize()) {
+        std::unordered_map<cpp2::RowValue, int64_t, RowHash> counts;
+        status = rightResult_->forEachRow([this, &counts] (cpp2::RowValue row) {
+            auto stat = doCasting(row);
+            if (!stat.ok()) {
+                return stat;
+            }
+            counts[std::move(row)]++;
+            return Status::OK();
+        });
+        if (status.ok()) {
+            status = leftResult_->forEachRow([&counts, &rows] (cpp2::RowValue row) {
+                auto it = counts.find(row);
+                if (it != counts.end() && it->second > 0) {
+                    it->second--;
+                    rows.emplace_back(std::move(row));
+                }
+                return Status::OK();
+            });
+        }
+    } else {
+        auto ret = leftResult_->getRows();
+        if (!ret.ok()) {
+            doError(std::move(ret).status());
             return;
         }
-    }
-
-    std::vector<cpp2::RowValue> rows;
-    for (auto &lr : leftRows) {
-        for (auto &rr : rightRows) {
-            if (rr == lr) {
-                rows.emplace_back(std::move(rr));
-                break;
+        auto leftRows = std::move(ret).value();
+        // The times each row on the left side is not matched yet and matched
+        std::unordered_map<cpp2::RowValue, std::pair<int64_t, int64_t>, RowHash> counts;
+        for (auto &row : leftRows) {
+            counts[row].first++;
+        }
+        status = rightResult_->forEachRow([this, &counts] (cpp2::RowValue row) {
+            auto stat = doCasting(row);
+            if (!stat.ok()) {
+                return stat;
+            }
+            auto it = counts.find(row);
+            if (it != counts.end() && it->second.first > 0) {
+                it->second.first--;
+                it->second.second++;
+            }
+            return Status::OK();
+        });
+        if (status.ok()) {
+            for (auto &row : leftRows) {
+                auto &matched = counts[row].second;
+                if (matched > 0) {
+                    matched--;
+                    rows.emplace_back(std::move(row));
+                }
             }
         }
     }
+    if (!status.ok()) {
+        doError(std::move(status));
+        return;
+    }
 
     finishExecution(std::move(rows));
     return;
@@ -342,39 +411,30 @@ void SetExecutor::doMinus() {
         return;
     }
 
-    auto ret = leftResult_->getRows();
-    if (!ret.ok()) {
-        doError(std::move(ret).status());
-        return;
-    }
-    auto leftRows = std::move(ret).value();
-
-    ret = rightResult_->getRows();
-    if (!ret.ok()) {
-        doError(std::move(ret).status());
-        return;
-    }
-    auto rightRows = std::move(ret).value();
-
-    if (!castingMap_.empty()) {
-        Status stat = doCasting(rightRows);
+    std::unordered_set<cpp2::RowValue, RowHash> rightRows;
+    status = rightResult_->forEachRow([this, &rightRows] (cpp2::RowValue row) {
+        auto stat = doCasting(row);
         if (!stat.ok()) {
-            doError(stat);
-            return;
+            return stat;
         }
-    }
-
-    for (auto &rr : rightRows) {
-        for (auto iter = leftRows.begin(); iter < leftRows.end();) {
-            if (rr == *iter) {
-                iter = leftRows.erase(iter);
-            } else {
-                ++iter;
+        rightRows.emplace(std::move(row));
+        return Status::OK();
+    });
+    std::vector<cpp2::RowValue> rows;
+    if (status.ok()) {
+        status = leftResult_->forEachRow([&rightRows, &rows] (cpp2::RowValue row) {
+            if (rightRows.count(row) == 0) {
+                rows.emplace_back(std::move(row));
             }
-        }
+            return Status::OK();
+        });
+    }
+    if (!status.ok()) {
+        doError(std::move(status));
+        return;
     }
 
-    finishExecution(std::move(leftRows));
+    finishExecution(std::move(rows));
     return;
 }
 
@@ -48,9 +48,19 @@ private:
 
     Status checkSchema();
 
-    Status doCasting(std::vector<cpp2::RowValue> &rows) const;
+    // Cast the columns of the row from the right side to the types of the left side
+    Status doCasting(cpp2::RowValue &row) const;
 
-    void doDistinct(std::vector<cpp2::RowValue> &rows) const;
+    struct RowHash {
+        size_t operator()(const cpp2::RowValue &row) const;
+    };
+
+    // The set of the rows indexed by their positions in a vector
+    using RowIndexSet = std::unordered_set<size_t,
+                                           std::function<size_t(size_t)>,
+                                           std::function<bool(size_t, size_t)>>;
+
+    static RowIndexSet makeRowIndexSet(const std::vector<cpp2::RowValue> &rows);
 
     void onEmptyInputs();
 
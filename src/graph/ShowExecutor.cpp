@@ -827,6 +827,9 @@ void ShowExecutor::showCreateTagIndex() {
         }
         buf = buf.substr(0, buf.size() - 2);
         buf += ")";
+        if (indexItems.get_index_type() == nebula::cpp2::IndexType::GEO) {
+            buf += " GEO";
+        }
 
         row[1].set_str(buf);
         rows.emplace_back();
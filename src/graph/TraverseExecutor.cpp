@@ -29,7 +29,23 @@ namespace nebula {
 namespace graph {
 
 std::unique_ptr<TraverseExecutor> TraverseExecutor::makeTraverseExecutor(Sentence *sentence) {
-    return makeTraverseExecutor(sentence, ectx());
+    auto executor = makeTraverseExecutor(sentence, ectx());
+    addChild(executor.get());
+    return executor;
+}
+
+
+void TraverseExecutor::setOnResult(OnResult onResult) {
+    if (!ectx()->profile()) {
+        onResult_ = std::move(onResult);
+        return;
+    }
+    onResult_ = [this, cb = std::move(onResult)] (std::unique_ptr<InterimResult> result) {
+        if (result != nullptr) {
+            addRowsOut(result->numRows());
+        }
+        cb(std::move(result));
+    };
 }
 
 
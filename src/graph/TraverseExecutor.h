@@ -148,8 +148,15 @@ public:
      * be cached during its execution and are to be used to fill `ExecutionResponse'
      * upon `setupResponse()'s invoke.
      */
-    void setOnResult(OnResult onResult) {
-        onResult_ = std::move(onResult);
+    void setOnResult(OnResult onResult);
+
+    /**
+     * Tell the executor that only the first `limit' rows of its results
+     * are to be used, e.g. when it is followed by a LIMIT.
+     * It's up to the executor to make use of it or not.
+     */
+    virtual void setLimitHint(int64_t limit) {
+        UNUSED(limit);
     }
 
     static std::unique_ptr<TraverseExecutor>
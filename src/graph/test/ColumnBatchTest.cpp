@@ -0,0 +1,163 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <gtest/gtest.h>
+#include "graph/ColumnBatch.h"
+#include "graph/InterimResult.h"
+#include "dataman/SchemaWriter.h"
+#include "dataman/RowSetReader.h"
+
+namespace nebula {
+namespace graph {
+
+using nebula::cpp2::SupportedType;
+
+static std::shared_ptr<SchemaWriter> makeSchema() {
+    auto schema = std::make_shared<SchemaWriter>();
+    schema->appendCol("id", SupportedType::VID);
+    schema->appendCol("age", SupportedType::INT);
+    schema->appendCol("score", SupportedType::DOUBLE);
+    schema->appendCol("male", SupportedType::BOOL);
+    schema->appendCol("name", SupportedType::STRING);
+    return schema;
+}
+
+TEST(ColumnBatchTest, AppendAndRead) {
+    ColumnBatch batch(makeSchema());
+    for (int64_t i = 0; i < 100; i++) {
+        std::vector<VariantType> row;
+        row.emplace_back(i);
+        row.emplace_back(i * 2);
+        if (i % 10 == 0) {
+            // Not of the column type
+            row.emplace_back(i);
+        } else {
+            row.emplace_back(i / 2.0);
+        }
+        row.emplace_back(i % 2 == 0);
+        row.emplace_back(folly::to<std::string>("name_", i));
+        ASSERT_TRUE(batch.append(row).ok());
+    }
+    ASSERT_EQ(100, batch.numRows());
+    ASSERT_EQ(5, batch.numColumns());
+    ASSERT_EQ(nullptr, batch.ints(2));
+    ASSERT_EQ(100, batch.ints(0)->size());
+
+    for (int64_t i = 0; i < 100; i++) {
+        ASSERT_EQ(i, boost::get<int64_t>(batch.value(i, 0)));
+        ASSERT_EQ(i * 2, boost::get<int64_t>(batch.value(i, 1)));
+        if (i % 10 == 0) {
+            ASSERT_TRUE(batch.isNull(i, 2));
+            ASSERT_EQ(0.0, boost::get<double>(batch.value(i, 2)));
+        } else {
+            ASSERT_FALSE(batch.isNull(i, 2));
+            ASSERT_EQ(i / 2.0, boost::get<double>(batch.value(i, 2)));
+        }
+        ASSERT_EQ(i % 2 == 0, boost::get<bool>(batch.value(i, 3)));
+
+        auto row = batch.rowValue(i);
+        auto &cols = row.get_columns();
+        ASSERT_EQ(5, cols.size());
+        ASSERT_EQ(i, cols[0].get_id());
+        ASSERT_EQ(i * 2, cols[1].get_integer());
+        ASSERT_EQ(folly::to<std::string>("name_", i), cols[4].get_str());
+    }
+}
+
+TEST(ColumnBatchTest, InterimResult) {
+    auto schema = makeSchema();
+    std::vector<cpp2::RowValue> rows;
+    for (int64_t i = 0; i < 10; i++) {
+        std::vector<cpp2::ColumnValue> cols(5);
+        cols[0].set_id(i % 5);
+        cols[1].set_integer(i);
+        cols[2].set_double_precision(i * 1.5);
+        cols[3].set_bool_val(true);
+        cols[4].set_str(folly::to<std::string>(i));
+        cpp2::RowValue row;
+        row.set_columns(std::move(cols));
+        rows.emplace_back(std::move(row));
+    }
+    auto ret = InterimResult::getInterim(schema, rows);
+    ASSERT_TRUE(ret.ok());
+    auto result = std::move(ret).value();
+    ASSERT_TRUE(result->hasData());
+    ASSERT_EQ(SupportedType::DOUBLE, result->getColumnType("score"));
+
+    auto vids = result->getVIDs("id");
+    ASSERT_TRUE(vids.ok());
+    ASSERT_EQ(10, vids.value().size());
+    auto distinct = result->getDistinctVIDs("id");
+    ASSERT_TRUE(distinct.ok());
+    ASSERT_EQ(5, distinct.value().size());
+    ASSERT_FALSE(result->getVIDs("name").ok());
+
+    auto got = result->getRows();
+    ASSERT_TRUE(got.ok());
+    ASSERT_EQ(rows, got.value());
+
+    // The rows read through RowReader are the same
+    int64_t count = 0;
+    auto status = result->applyTo([&] (const RowReader *reader) -> Status {
+        int64_t age;
+        EXPECT_EQ(ResultType::SUCCEEDED, reader->getInt("age", age));
+        EXPECT_EQ(count, age);
+        folly::StringPiece name;
+        EXPECT_EQ(ResultType::SUCCEEDED, reader->getString("name", name));
+        EXPECT_EQ(folly::to<std::string>(count), name.toString());
+        count++;
+        return Status::OK();
+    });
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(10, count);
+
+    auto index = result->buildIndex("id");
+    ASSERT_TRUE(index.ok());
+    auto rowsOfVid = index.value()->rowsOfVids({3});
+    ASSERT_EQ(2, rowsOfVid.size());
+    for (auto row : rowsOfVid) {
+        auto age = index.value()->getColumnWithRow(row, "age");
+        ASSERT_TRUE(age.ok());
+        ASSERT_EQ(3, boost::get<int64_t>(age.value()) % 5);
+    }
+}
+
+TEST(ColumnBatchTest, FloatColumn) {
+    auto schema = std::make_shared<SchemaWriter>();
+    schema->appendCol("id", SupportedType::VID);
+    schema->appendCol("score", SupportedType::FLOAT);
+    ColumnBatch batch(schema);
+    for (int64_t i = 0; i < 10; i++) {
+        std::vector<VariantType> row;
+        row.emplace_back(i);
+        row.emplace_back(i + 0.5);
+        ASSERT_TRUE(batch.append(row).ok());
+    }
+    for (int64_t i = 0; i < 10; i++) {
+        ASSERT_EQ(i + 0.5, boost::get<double>(batch.value(i, 1)));
+        auto col = batch.columnValue(i, 1);
+        ASSERT_EQ(cpp2::ColumnValue::Type::single_precision, col.getType());
+        ASSERT_EQ(static_cast<float>(i + 0.5), col.get_single_precision());
+    }
+
+    // Encoded as FLOAT fields, and decoded back
+    auto rsWriter = batch.encode();
+    RowSetReader rsReader(schema, rsWriter->data());
+    ColumnBatch decoded(schema);
+    auto iter = rsReader.begin();
+    while (iter) {
+        float v;
+        ASSERT_EQ(ResultType::SUCCEEDED, iter->getFloat(1, v));
+        ASSERT_TRUE(decoded.append(&*iter).ok());
+        ++iter;
+    }
+    ASSERT_EQ(10, decoded.numRows());
+    ASSERT_EQ(3.5, boost::get<double>(decoded.value(3, 1)));
+}
+
+}   // namespace graph
+}   // namespace nebula
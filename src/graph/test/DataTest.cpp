@@ -908,6 +908,67 @@ TEST_F(DataTest, InsertMultiVersionTest) {
     }
 }
 
+TEST_F(DataTest, FloatPropTest) {
+    // FLOAT is not in the DDL, the schemas are created through the meta client
+    auto spaceResult = gEnv->metaClient()->getSpaceIdByNameFromCache("mySpace");
+    ASSERT_TRUE(spaceResult.ok());
+    auto spaceId = spaceResult.value();
+    {
+        nebula::cpp2::Schema schema;
+        nebula::cpp2::ColumnDef column;
+        column.set_name("score");
+        nebula::cpp2::ValueType type;
+        type.set_type(nebula::cpp2::SupportedType::FLOAT);
+        column.set_type(std::move(type));
+        schema.columns.emplace_back(std::move(column));
+        auto ret = gEnv->metaClient()->createTagSchema(spaceId, "float_tag", schema).get();
+        ASSERT_TRUE(ret.ok());
+        ret = gEnv->metaClient()->createEdgeSchema(spaceId, "float_edge", schema).get();
+        ASSERT_TRUE(ret.ok());
+    }
+    sleep(FLAGS_heartbeat_interval_secs + 3);
+    {
+        cpp2::ExecutionResponse resp;
+        std::string cmd = "INSERT VERTEX float_tag(score) VALUES 1001:(1.5), 1002:(2.5)";
+        auto code = client_->execute(cmd, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+    }
+    {
+        cpp2::ExecutionResponse resp;
+        std::string cmd = "INSERT EDGE float_edge(score) VALUES "
+                          "1000->1001:(0.5), 1000->1002:(0.25)";
+        auto code = client_->execute(cmd, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+    }
+    {
+        cpp2::ExecutionResponse resp;
+        std::string cmd = "GO FROM 1000 OVER float_edge "
+                          "YIELD float_edge._dst AS id, float_edge.score AS score "
+                          "| ORDER BY $-.score";
+        auto code = client_->execute(cmd, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<int64_t, double>> expected = {
+            {1002, 0.25},
+            {1001, 0.5},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected, false));
+    }
+    {
+        cpp2::ExecutionResponse resp;
+        std::string cmd = "$var = GO FROM 1000 OVER float_edge "
+                          "YIELD float_edge._dst AS id, float_edge.score AS score; "
+                          "GO FROM $var.id OVER float_edge REVERSELY "
+                          "YIELD $var.score AS score, $^.float_tag.score AS src_score";
+        auto code = client_->execute(cmd, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<double, double>> expected = {
+            {0.5, 1.5},
+            {0.25, 2.5},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+}
+
 TEST_F(DataTest, InsertMultiVersionWithUUIDTest) {
     // Insert multi version vertex
     {
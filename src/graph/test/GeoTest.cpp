@@ -296,5 +296,70 @@ TEST_F(GeoTest, Near) {
         ASSERT_TRUE(verifyResult(resp, expected, false, {0}));
     }
 }
+
+TEST_F(GeoTest, GeoIndex) {
+    {
+        cpp2::ExecutionResponse resp;
+        std::string cmd = "USE myspace;"
+                          "CREATE TAG INDEX merchant_location ON merchant(coordinate) GEO";
+        auto code = client_->execute(cmd, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+    }
+    sleep(FLAGS_load_data_interval_secs + 3);
+    {
+        // Insert the merchants again to be indexed, and one far away
+        cpp2::ExecutionResponse resp;
+        std::string query = "INSERT VERTEX merchant(name, coordinate, rate) VALUES ";
+        for (decltype(merchants_.size()) index = 0; index < merchants_.size(); ++index) {
+            auto &merchant = merchants_[index];
+            query += folly::stringPrintf("%lu: (\"%s\", \"%s\", %f), ",
+                                         index,
+                                         merchant.name().c_str(),
+                                         merchant.coordinate().c_str(),
+                                         merchant.rate());
+        }
+        query += "100: (\"Far Away\", \"(30.38115 120.21438)\", 1.0)";
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+    }
+    {
+        cpp2::ExecutionResponse resp;
+        auto query = "LOOKUP ON merchant "
+                     "WHERE near(merchant.coordinate, \"(30.28243 120.01198)\", 5000) "
+                     "YIELD merchant.name";
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<VertexID, std::string>> expected = {
+            {0, merchants_[0].name()},
+            {1, merchants_[1].name()},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    {
+        cpp2::ExecutionResponse resp;
+        auto query = "LOOKUP ON merchant "
+                     "WHERE near(merchant.coordinate, \"(30.28243 120.01198)\", 300)";
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<VertexID>> expected = {
+            {1},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    {
+        cpp2::ExecutionResponse resp;
+        auto query = "LOOKUP ON merchant "
+                     "WHERE within(merchant.coordinate, "
+                     "\"POLYGON((30.2 120.0, 30.2 120.3, 30.4 120.3, 30.4 120.0, 30.2 120.0))\") "
+                     "&& merchant.rate < 4.0";
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<VertexID>> expected = {
+            {1},
+            {100},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+}
 }  // namespace graph
 }  // namespace nebula
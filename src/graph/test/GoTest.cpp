@@ -13,6 +13,7 @@
 #include "graph/TraverseExecutor.h"
 #include "graph/GoExecutor.h"
 
+DECLARE_int64(max_edges_buffered_in_paging);
 
 namespace nebula {
 namespace graph {
@@ -167,6 +168,65 @@ TEST_P(GoTest, OneStepOutBound) {
 }
 
 
+TEST_P(GoTest, PreparedStatement) {
+    cpp2::PrepareResponse prepared;
+    auto code = client_->prepare("GO FROM ? OVER serve YIELD $$.team.name AS name", prepared);
+    ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+    ASSERT_EQ(1, *prepared.get_num_params());
+    auto stmtId = *prepared.get_statement_id();
+    {
+        cpp2::ExecutionResponse resp;
+        std::vector<cpp2::ColumnValue> params(1);
+        params[0].set_id(players_["Tim Duncan"].vid());
+        code = client_->executePrepared(stmtId, std::move(params), resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<std::string>> expected = {
+            {"Spurs"},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    // Executed again with another vertex
+    {
+        cpp2::ExecutionResponse resp;
+        std::vector<cpp2::ColumnValue> params(1);
+        params[0].set_id(players_["Rajon Rondo"].vid());
+        code = client_->executePrepared(stmtId, std::move(params), resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<std::string>> expected = {
+            {"Celtics"}, {"Pelicans"}, {"Kings"}, {"Mavericks"}, {"Bulls"}, {"Lakers"},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    // Wrong number of the parameters
+    {
+        cpp2::ExecutionResponse resp;
+        code = client_->executePrepared(stmtId, {}, resp);
+        ASSERT_EQ(cpp2::ErrorCode::E_SYNTAX_ERROR, code);
+    }
+    {
+        cpp2::ExecutionResponse resp;
+        code = client_->executePrepared(stmtId + 1000, {}, resp);
+        ASSERT_EQ(cpp2::ErrorCode::E_EXECUTION_ERROR, code);
+    }
+    // Kept in the session which prepared it only
+    {
+        auto client = gEnv->getClient();
+        ASSERT_NE(nullptr, client);
+        cpp2::ExecutionResponse resp;
+        std::vector<cpp2::ColumnValue> params(1);
+        params[0].set_id(players_["Tim Duncan"].vid());
+        code = client->executePrepared(stmtId, std::move(params), resp);
+        ASSERT_EQ(cpp2::ErrorCode::E_EXECUTION_ERROR, code);
+    }
+    // Not bound in a plain query
+    {
+        cpp2::ExecutionResponse resp;
+        code = client_->execute("GO FROM ? OVER serve", resp);
+        ASSERT_EQ(cpp2::ErrorCode::E_SYNTAX_ERROR, code);
+    }
+}
+
+
 TEST_P(GoTest, AssignmentSimple) {
     {
         cpp2::ExecutionResponse resp;
@@ -3119,6 +3179,130 @@ TEST_P(GoTest, issueBackTrackOverlap) {
     }
 }
 
+TEST_P(GoTest, Paging) {
+    auto oldPageSize = FLAGS_get_neighbors_page_size;
+    auto oldMaxEdges = FLAGS_max_edges_buffered_in_paging;
+    // One edge per vertex in each page
+    FLAGS_get_neighbors_page_size = 1;
+    {
+        cpp2::ExecutionResponse resp;
+        auto &player = players_["Tony Parker"];
+        auto *fmt = "GO 2 STEPS FROM %ld OVER like YIELD DISTINCT like._dst";
+        auto query = folly::stringPrintf(fmt, player.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<VertexID>> expected = {
+            {players_["Tony Parker"].vid()},
+            {players_["Manu Ginobili"].vid()},
+            {players_["Tim Duncan"].vid()},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    // The roots are traced back across the pages of the step not recorded
+    {
+        cpp2::ExecutionResponse resp;
+        auto &player = players_["Tony Parker"];
+        auto *fmt = "GO FROM %ld OVER like YIELD like._dst as dst "
+            "| GO 2 STEPS FROM $-.dst OVER like YIELD DISTINCT $-.dst, like._dst";
+        auto query = folly::stringPrintf(fmt, player.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<VertexID, VertexID>> expected = {
+            {players_["Tim Duncan"].vid(), players_["Tim Duncan"].vid()},
+            {players_["Tim Duncan"].vid(), players_["Manu Ginobili"].vid()},
+            {players_["Tim Duncan"].vid(), players_["LaMarcus Aldridge"].vid()},
+            {players_["Manu Ginobili"].vid(), players_["Tony Parker"].vid()},
+            {players_["Manu Ginobili"].vid(), players_["Manu Ginobili"].vid()},
+            {players_["LaMarcus Aldridge"].vid(), players_["Tim Duncan"].vid()},
+            {players_["LaMarcus Aldridge"].vid(), players_["Manu Ginobili"].vid()},
+            {players_["LaMarcus Aldridge"].vid(), players_["LaMarcus Aldridge"].vid()},
+            {players_["LaMarcus Aldridge"].vid(), players_["Tony Parker"].vid()},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    // The pages of the recorded steps
+    {
+        cpp2::ExecutionResponse resp;
+        auto &player = players_["Tony Parker"];
+        auto *fmt = "GO 1 TO 2 STEPS FROM %ld OVER like "
+            "YIELD DISTINCT like._dst, like.likeness, $$.player.name";
+        auto query = folly::stringPrintf(fmt, player.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+
+        std::vector<std::tuple<VertexID, int64_t, std::string>> expected = {
+            {players_["Manu Ginobili"].vid(), 95, "Manu Ginobili"},
+            {players_["LaMarcus Aldridge"].vid(), 90, "LaMarcus Aldridge"},
+            {players_["Tim Duncan"].vid(), 95, "Tim Duncan"},
+            {players_["Tony Parker"].vid(), 95, "Tony Parker"},
+            {players_["Tony Parker"].vid(), 75, "Tony Parker"},
+            {players_["Tim Duncan"].vid(), 75, "Tim Duncan"},
+            {players_["Tim Duncan"].vid(), 90, "Tim Duncan"},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    // Too many edges held for the recorded steps
+    {
+        FLAGS_max_edges_buffered_in_paging = 1;
+        cpp2::ExecutionResponse resp;
+        auto &player = players_["Tony Parker"];
+        auto *fmt = "GO 1 TO 2 STEPS FROM %ld OVER like YIELD like._dst";
+        auto query = folly::stringPrintf(fmt, player.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::E_EXECUTION_ERROR, code);
+    }
+    FLAGS_max_edges_buffered_in_paging = oldMaxEdges;
+    FLAGS_get_neighbors_page_size = oldPageSize;
+}
+
+TEST_P(GoTest, Profile) {
+    {
+        cpp2::ExecutionResponse resp;
+        auto *fmt = "PROFILE GO FROM %ld OVER like YIELD like._dst as id "
+                    "| GO FROM $-.id OVER serve";
+        auto query = folly::stringPrintf(fmt, players_["Tim Duncan"].vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        ASSERT_NE(nullptr, resp.get_rows());
+        ASSERT_EQ(3, resp.get_rows()->size());
+        ASSERT_NE(nullptr, resp.get_profile());
+
+        auto &nodes = *resp.get_profile();
+        ASSERT_EQ("SequentialExecutor", nodes[0].get_name());
+        ASSERT_EQ(0, nodes[0].get_depth());
+        ASSERT_EQ(3, nodes[0].get_stats().at("rows_out"));
+        ASSERT_EQ("PipeExecutor", nodes[1].get_name());
+        ASSERT_EQ(1, nodes[1].get_depth());
+        std::vector<const cpp2::ProfileNode*> gos;
+        int64_t partsVisited = 0;
+        for (auto &node : nodes) {
+            ASSERT_LE(0, node.get_duration_in_us());
+            if (node.get_name() == "GoExecutor") {
+                ASSERT_EQ(2, node.get_depth());
+                ASSERT_LT(0, node.get_stats().at("rpcs"));
+                gos.emplace_back(&node);
+            } else if (node.get_name().find("part ") == 0) {
+                ASSERT_EQ(3, node.get_depth());
+                ASSERT_LT(0, node.get_stats().at("keys_scanned"));
+                partsVisited++;
+            }
+        }
+        ASSERT_EQ(2, gos.size());
+        // Tony Parker and Manu Ginobili are fed to the right GO
+        ASSERT_EQ(2, gos[0]->get_stats().at("rows_out"));
+        ASSERT_EQ(2, gos[1]->get_stats().at("rows_in"));
+        ASSERT_LE(2, partsVisited);
+    }
+    {
+        cpp2::ExecutionResponse resp;
+        auto *fmt = "GO FROM %ld OVER like";
+        auto query = folly::stringPrintf(fmt, players_["Tim Duncan"].vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        ASSERT_EQ(nullptr, resp.get_profile());
+    }
+}
+
 INSTANTIATE_TEST_CASE_P(IfPushdownFilter, GoTest, ::testing::Bool());
 
 }   // namespace graph
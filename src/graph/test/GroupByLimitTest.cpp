@@ -8,6 +8,7 @@
 #include "graph/test/TestEnv.h"
 #include "graph/test/TestBase.h"
 #include "graph/test/TraverseTestBase.h"
+#include "graph/GraphFlags.h"
 #include "meta/test/TestUtils.h"
 
 namespace nebula {
@@ -457,6 +458,69 @@ TEST_F(GroupByLimitTest, GroupByTest) {
 }
 
 
+TEST_F(GroupByLimitTest, GroupByInParallel) {
+    FLAGS_group_by_parallel_rows = 1;
+    FLAGS_group_by_partitions = 4;
+    // Group by one int col
+    {
+        cpp2::ExecutionResponse resp;
+        auto &player = players_["Marco Belinelli"];
+        auto *fmt = "GO FROM %ld OVER serve "
+                    "YIELD $$.team.name AS name, "
+                    "serve._dst AS id, "
+                    "serve.start_year AS start_year, "
+                    "serve.end_year AS end_year"
+                    "| GROUP BY $-.start_year "
+                    "YIELD COUNT($-.id), "
+                    "$-.start_year AS start_year, "
+                    "AVG($-.end_year) as avg";
+        auto query = folly::stringPrintf(fmt, player.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<uint64_t, uint64_t, double >> expected = {
+                {2, 2018, 2018.5, },
+                {1, 2017, 2018.0},
+                {1, 2016, 2017.0},
+                {1, 2009, 2010.0},
+                {1, 2007, 2009.0},
+                {1, 2012, 2013.0},
+                {1, 2015, 2016.0},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    // Group by several cols
+    {
+        cpp2::ExecutionResponse resp;
+        auto &player1 = players_["Aron Baynes"];
+        auto &player2 = players_["Tracy McGrady"];
+        auto *fmt = "GO FROM %ld,%ld OVER serve "
+                    "YIELD $$.team.name AS name, "
+                    "serve._dst AS id, "
+                    "serve.start_year AS start, "
+                    "serve.end_year AS end"
+                    "| GROUP BY $-.name, $-.start "
+                    "YIELD $-.name AS teamName, "
+                    "$-.start AS start_year, "
+                    "AVG($-.end) AS avg_end_year, "
+                    "COUNT($-.id)";
+        auto query = folly::stringPrintf(fmt, player1.vid(), player2.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<std::string, uint64_t, double, uint64_t>> expected = {
+                {"Celtics", 2017, 2019.0, 1},
+                {"Magic", 2000, 2004.0, 1},
+                {"Pistons", 2015, 2017.0, 1},
+                {"Raptors", 1997, 2000.0, 1},
+                {"Rockets", 2004, 2010.0, 1},
+                {"Spurs", 2013, 2014.0, 2},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    FLAGS_group_by_parallel_rows = 100000;
+    FLAGS_group_by_partitions = 0;
+}
+
+
 TEST_F(GroupByLimitTest, GroupByOrderByLimitTest) {
     // Test with OrderBy
     {
@@ -360,6 +360,72 @@ TEST_F(OrderByTest, InterimResult) {
     }
 }
 
+TEST_F(OrderByTest, TopN) {
+    std::string go = "GO FROM %ld OVER serve YIELD "
+                     "$^.player.name as name, serve.start_year as start, $$.team.name as team";
+    {
+        cpp2::ExecutionResponse resp;
+        auto &player = players_["Boris Diaw"];
+        auto fmt = go + "| ORDER BY $-.start DESC | LIMIT 2";
+        auto query = folly::stringPrintf(fmt.c_str(), player.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+
+        std::vector<std::tuple<std::string, int64_t, std::string>> expected = {
+            {player.name(), 2016, "Jazz"},
+            {player.name(), 2012, "Spurs"},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected, false));
+    }
+    {
+        cpp2::ExecutionResponse resp;
+        auto &player = players_["Boris Diaw"];
+        auto fmt = go + "| ORDER BY $-.start | LIMIT 1, 3";
+        auto query = folly::stringPrintf(fmt.c_str(), player.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+
+        std::vector<std::tuple<std::string, int64_t, std::string>> expected = {
+            {player.name(), 2005, "Suns"},
+            {player.name(), 2008, "Hornets"},
+            {player.name(), 2012, "Spurs"},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected, false));
+    }
+    {
+        // The limit is larger than the rows
+        cpp2::ExecutionResponse resp;
+        auto &player = players_["Boris Diaw"];
+        auto fmt = go + "| ORDER BY $-.team | LIMIT 10";
+        auto query = folly::stringPrintf(fmt.c_str(), player.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+
+        std::vector<std::tuple<std::string, int64_t, std::string>> expected = {
+            {player.name(), 2003, "Hawks"},
+            {player.name(), 2008, "Hornets"},
+            {player.name(), 2016, "Jazz"},
+            {player.name(), 2012, "Spurs"},
+            {player.name(), 2005, "Suns"},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected, false));
+    }
+    {
+        // The limit not right after the order by
+        cpp2::ExecutionResponse resp;
+        auto &player = players_["Boris Diaw"];
+        auto fmt = go + "| ORDER BY $-.team DESC | YIELD $-.team AS team | LIMIT 1";
+        auto query = folly::stringPrintf(fmt.c_str(), player.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+
+        std::vector<std::tuple<std::string>> expected = {
+            {"Suns"},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected, false));
+    }
+}
+
 TEST_F(OrderByTest, DuplicateColumn) {
     std::string go = "GO FROM %ld OVER serve YIELD "
                      "$^.player.name as team, serve.start_year as start, $$.team.name as team";
@@ -1339,5 +1339,36 @@ TEST_F(SchemaTest, issue2009) {
     }
 }
 
+TEST_F(SchemaTest, RepeatedDDL) {
+    auto client = gEnv->getClient();
+    ASSERT_NE(nullptr, client);
+    // The same texts are served from the parse cache the second time,
+    // the sentences must be the same as the parsed ones.
+    for (auto i = 0; i < 2; i++) {
+        {
+            cpp2::ExecutionResponse resp;
+            std::string query = "CREATE SPACE repeated_space(partition_num=1, replica_factor=1)";
+            auto code = client->execute(query, resp);
+            ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        }
+        {
+            cpp2::ExecutionResponse resp;
+            std::string query = "DESCRIBE SPACE repeated_space";
+            auto code = client->execute(query, resp);
+            ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+            std::vector<std::tuple<std::string, int, int, std::string, std::string>> expected{
+                {"repeated_space", 1, 1, "utf8", "utf8_bin"},
+            };
+            ASSERT_TRUE(verifyResult(resp, expected, true, {0}));
+        }
+        {
+            cpp2::ExecutionResponse resp;
+            std::string query = "DROP SPACE repeated_space";
+            auto code = client->execute(query, resp);
+            ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        }
+    }
+}
+
 }   // namespace graph
 }   // namespace nebula
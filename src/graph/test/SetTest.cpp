@@ -387,6 +387,26 @@ TEST_F(SetTest, UnionDistinct) {
         }
         ASSERT_TRUE(verifyResult(resp, expected));
     }
+    {
+        // The same rows on both sides
+        cpp2::ExecutionResponse resp;
+        auto *fmt =
+            "GO FROM %ld OVER serve YIELD $^.player.name, serve.start_year, $$.team.name"
+            " UNION DISTINCT "
+            "GO FROM %ld OVER serve YIELD $^.player.name, serve.start_year, $$.team.name";
+        auto &tony = players_["Tony Parker"];
+        auto query = folly::stringPrintf(fmt, tony.vid(), tony.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+
+        std::vector<std::tuple<std::string, int64_t, std::string>> expected;
+        for (auto &serve : tony.serves()) {
+            std::tuple<std::string, int64_t, std::string> record(
+                    tony.name(), std::get<1>(serve), std::get<0>(serve));
+            expected.emplace_back(std::move(record));
+        }
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
 }
 
 TEST_F(SetTest, Minus) {
@@ -443,6 +463,28 @@ TEST_F(SetTest, Intersect) {
         };
         ASSERT_TRUE(verifyColNames(resp, expectedColNames));
 
+        std::vector<std::tuple<std::string, int64_t, std::string>> expected;
+        for (auto &serve : tony.serves()) {
+            std::tuple<std::string, int64_t, std::string> record(
+                    tony.name(), std::get<1>(serve), std::get<0>(serve));
+            expected.emplace_back(std::move(record));
+        }
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    {
+        // The left side is smaller
+        cpp2::ExecutionResponse resp;
+        auto *fmt =
+            "GO FROM %ld OVER serve YIELD $^.player.name, serve.start_year, $$.team.name"
+            " INTERSECT "
+            "(GO FROM %ld OVER like YIELD like._dst as id | "
+            "GO FROM $-.id OVER serve YIELD $^.player.name, serve.start_year, $$.team.name)";
+        auto &tim = players_["Tim Duncan"];
+        auto &tony = players_["Tony Parker"];
+        auto query = folly::stringPrintf(fmt, tony.vid(), tim.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+
         std::vector<std::tuple<std::string, int64_t, std::string>> expected;
         for (auto &serve : tony.serves()) {
             std::tuple<std::string, int64_t, std::string> record(
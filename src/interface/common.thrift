@@ -93,12 +93,19 @@ union SchemaID {
     2: EdgeType      edge_type,
 }
 
+enum IndexType {
+    NORMAL = 0x00,
+    // Keyed by the S2 cell of the point in WKT, in the only string field
+    GEO    = 0x01,
+} (cpp.enum_strict)
+
 struct IndexItem {
     1: IndexID             index_id,
     2: string              index_name,
     3: SchemaID            schema_id
     4: string              schema_name,
     5: list<ColumnDef>     fields,
+    6: IndexType           index_type,
 }
 
 struct HostAddr {
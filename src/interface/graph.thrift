@@ -108,6 +108,18 @@ struct RowValue {
     1: list<ColumnValue> columns;
 }
 
+// One executor, or one partition in storaged, in the profile of a query
+struct ProfileNode {
+    1: binary name;
+    // The nodes are in pre-order, a node is the child of the nearest one
+    // before it with a smaller depth
+    2: i32 depth;
+    // Wall time of the execution
+    3: i64 duration_in_us;
+    // e.g. rows_in, rows_out, rpcs, keys_scanned
+    4: map<binary, i64> stats;
+}
+
 struct ExecutionResponse {
     1: required ErrorCode error_code;
     2: required i32 latency_in_us;          // Execution time on server
@@ -116,6 +128,8 @@ struct ExecutionResponse {
     5: optional list<RowValue> rows;
     6: optional string space_name;
     7: optional string warning_msg;
+    // Set when the query is `PROFILE'd
+    8: optional list<ProfileNode> profile;
 }
 
 
@@ -126,10 +140,25 @@ struct AuthResponse {
 }
 
 
+struct PrepareResponse {
+    1: required ErrorCode error_code;
+    2: optional i64 statement_id;
+    // Number of the parameters `?' in the statement
+    3: optional i32 num_params;
+    4: optional string error_msg;
+}
+
+
 service GraphService {
     AuthResponse authenticate(1: string username, 2: string password)
 
     oneway void signout(1: i64 sessionId)
 
     ExecutionResponse execute(1: i64 sessionId, 2: string stmt)
+
+    // Parse the statement once, and execute it with the parameters bound each time
+    PrepareResponse prepare(1: i64 sessionId, 2: string stmt)
+    ExecutionResponse executePrepared(1: i64 sessionId,
+                                      2: i64 statementId,
+                                      3: list<ColumnValue> params)
 }
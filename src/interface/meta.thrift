@@ -219,6 +219,9 @@ struct ListSpacesResp {
     // Valid if ret equals E_LEADER_CHANGED.
     2: common.HostAddr  leader,
     3: list<IdName> spaces,
+    // The last time each space, its parts, schemas or indexes changed,
+    // the spaces not changed since the versions were introduced are absent.
+    4: map<common.GraphSpaceID, i64> (cpp.template = "std::unordered_map") versions,
 }
 
 struct GetSpaceReq {
@@ -430,6 +433,7 @@ struct CreateTagIndexReq {
     3: string               tag_name,
     4: list<string>         fields,
     5: bool                 if_not_exists,
+    6: common.IndexType     index_type,
 }
 
 struct DropTagIndexReq {
@@ -34,6 +34,8 @@ enum ErrorCode {
     E_PERSIST_SNAPSHOT_FAILED = -16;
 
     E_BAD_ROLE = -17,
+    // Failed to write or ingest the sst file of the snapshot
+    E_SNAPSHOT_FILE_FAILED = -18;
 
     E_EXCEPTION = -20;          // An thrift internal exception was thrown
 }
@@ -116,6 +118,18 @@ struct AppendLogResponse {
     7: TermID              last_log_term;
 }
 
+// A chunk of the sst file built for the snapshot
+struct SnapshotFile {
+    1: string   name;
+    2: i64      offset;
+    3: binary   data;
+    // The last chunk of the file, the file could be ingested then
+    4: bool     eof;
+    // The rows in the file, set along with the last chunk
+    5: i64      count;
+    6: i64      size;
+}
+
 struct SendSnapshotRequest {
     1:  common.GraphSpaceID space;
     2:  common.PartitionID  part;
@@ -128,6 +142,8 @@ struct SendSnapshotRequest {
     9:  i64                 total_size;
     10: i64                 total_count;
     11: bool                done;
+    // Set if the rows are sent in an sst file, and the rows above are empty
+    12: optional SnapshotFile file;
 }
 
 struct SendSnapshotResponse {
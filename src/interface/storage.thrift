@@ -128,6 +128,8 @@ struct VertexData {
     1: common.VertexID       vertex_id,
     2: list<TagData>         tag_data,
     3: list<EdgeData>        edge_data,
+    // start key of the next page of edges, only set when paging and edges left
+    4: optional binary       next_cursor,
 }
 
 struct VertexIndexData {
@@ -135,11 +137,24 @@ struct VertexIndexData {
     2: binary                props,
 }
 
+// The counters of processing one partition, returned when the request is profiled
+struct PartProfile {
+    1: common.PartitionID part_id,
+    2: i64 keys_scanned,
+    // Rows dropped by the filter
+    3: i64 rows_filtered,
+    4: i64 cache_hits,
+    5: i64 bytes_decoded,
+    // Time spent on the vertices of the partition, summed over the handler threads
+    6: i64 latency_in_us,
+}
+
 struct ResponseCommon {
     // Only contains the partition that returns error
     1: required list<ResultCode> failed_codes,
     // Query latency from storage service
     2: required i32 latency_in_us,
+    3: optional list<PartProfile> profiles,
 }
 
 struct QueryResponse {
@@ -150,6 +165,14 @@ struct QueryResponse {
     5: optional i32 total_edges,
 }
 
+struct TraverseResponse {
+    1: required ResponseCommon result,
+    // Vertices reached after all the steps
+    2: optional list<common.VertexID> vertices,
+    // steps left => vertices reached, whose parts are not led by this host
+    3: optional map<i32, list<common.VertexID>>(cpp.template = "std::unordered_map") forwards,
+}
+
 struct ExecResponse {
     1: required ResponseCommon result,
 }
@@ -184,12 +207,32 @@ struct GetNeighborsRequest {
     3: list<common.EdgeType> edge_types,
     4: binary filter,
     5: list<PropDef> return_columns,
+    // start key of the edges for each vertex, see VertexData.next_cursor
+    6: map<common.VertexID, binary>(cpp.template = "std::unordered_map") cursors,
+    // max edges returned for each vertex in this response, 0 means no paging
+    7: i32 limit,
+    // Return the PartProfile of each part in ResponseCommon
+    8: bool profile,
+}
+
+// Go the given steps from the vertices along the edge types inside storaged,
+// the vertices of the parts not led by the host are returned to the caller.
+struct TraverseRequest {
+    1: common.GraphSpaceID space_id,
+    // partId => ids
+    2: map<common.PartitionID, list<common.VertexID>>(cpp.template = "std::unordered_map") parts,
+    3: list<common.EdgeType> edge_types,
+    4: i32 steps,
+    // Number of parts in the space, used to locate the part of the vertices reached
+    5: i32 parts_num,
 }
 
 struct VertexPropRequest {
     1: common.GraphSpaceID space_id,
     2: map<common.PartitionID, list<common.VertexID>>(cpp.template = "std::unordered_map") parts,
     3: list<PropDef> return_columns,
+    // Return the PartProfile of each part in ResponseCommon
+    4: bool profile,
 }
 
 struct EdgePropRequest {
@@ -445,6 +488,11 @@ struct RebuildIndexRequest {
     4: bool                         is_offline,
 }
 
+struct RebuildEdgeDegreeRequest {
+    1: common.GraphSpaceID          space_id,
+    2: list<common.PartitionID>     parts,
+}
+
 struct LookUpIndexRequest {
     1: common.GraphSpaceID       space_id,
     2: list<common.PartitionID>  parts,
@@ -466,6 +514,8 @@ service StorageService {
 
     QueryStatsResponse boundStats(1: GetNeighborsRequest req)
 
+    TraverseResponse traverse(1: TraverseRequest req)
+
     // When return_columns is empty, return all properties
     QueryResponse getProps(1: VertexPropRequest req);
     EdgePropResponse getEdgeProps(1: EdgePropRequest req)
@@ -501,6 +551,9 @@ service StorageService {
     AdminExecResp rebuildTagIndex(1: RebuildIndexRequest req);
     AdminExecResp rebuildEdgeIndex(1: RebuildIndexRequest req);
 
+    // Rebuild the edge counters from the edges, when the writes are blocked
+    AdminExecResp rebuildEdgeDegree(1: RebuildEdgeDegreeRequest req);
+
     // Interfaces for key-value storage
     ExecResponse      put(1: PutRequest req);
     GeneralResponse   get(1: GetRequest req);
@@ -47,6 +47,34 @@ public:
                         const folly::StringPiece& val) const = 0;
 };
 
+/**
+ * Notified of the data changed in a part once it is committed to the engine,
+ * on the leader as well as on the followers.
+ * */
+class CommitListener {
+public:
+    CommitListener() = default;
+    virtual ~CommitListener() = default;
+
+    /**
+     * Return true if the key should be passed to onCommitted when it is written or removed.
+     * */
+    virtual bool watch(const folly::StringPiece& key) const = 0;
+
+    /**
+     * The watched keys which are written or removed by the committed logs.
+     * */
+    virtual void onCommitted(GraphSpaceID spaceId,
+                             PartitionID partId,
+                             const std::vector<std::string>& keys) = 0;
+
+    /**
+     * The data of the part is changed in bulk, e.g. a range of keys removed,
+     * a snapshot received or sst files ingested.
+     * */
+    virtual void onReset(GraphSpaceID spaceId, PartitionID partId) = 0;
+};
+
 using KV = std::pair<std::string, std::string>;
 using KVCallback = folly::Function<void(ResultCode code)>;
 using NewLeaderCallback = folly::Function<void(HostAddr nLeader)>;
@@ -22,6 +22,16 @@ public:
                   << ", base level is " << info.base_input_level
                   << ", output level is " << info.output_level;
     }
+
+    void OnFlushCompleted(rocksdb::DB*, const rocksdb::FlushJobInfo& info) override {
+        // When the rocksdb wal is disabled, the raft logs committed are durable
+        // only after they are flushed
+        VLOG(1) << "Rocksdb flush column family: " << info.cf_name
+                << " into " << info.file_path
+                << ", seqno [" << info.smallest_seqno << ", " << info.largest_seqno << "]"
+                << ", triggered writes slowdown " << info.triggered_writes_slowdown
+                << ", triggered writes stop " << info.triggered_writes_stop;
+    }
 };
 
 }  // namespace kvstore
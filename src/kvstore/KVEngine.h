@@ -26,6 +26,9 @@ public:
     // Remove all keys in the range [start, end)
     virtual ResultCode removeRange(folly::StringPiece start,
                                    folly::StringPiece end) = 0;
+
+    // Merge the operand into the value of key by the engine's merge operator
+    virtual ResultCode merge(folly::StringPiece key, folly::StringPiece operand) = 0;
 };
 
 
@@ -45,6 +48,11 @@ public:
 
     virtual std::unique_ptr<WriteBatch> startBatchWrite() = 0;
 
+    // The batch write is used to commit the raft logs, so its wal could be
+    // disabled, the logs are recovered from the raft wal after a crash.
+    // The other writes below are not in any raft log, they always go through
+    // the wal of the engine.
+
     virtual ResultCode commitBatchWrite(std::unique_ptr<WriteBatch> batch,
                                         bool disableWAL = true,
                                         bool sync = false) = 0;
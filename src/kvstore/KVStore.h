@@ -43,6 +43,9 @@ struct KVOptions {
      * Custom CompactionFilter used in compaction.
      * */
     std::unique_ptr<CompactionFilterFactoryBuilder> cffBuilder_{nullptr};
+
+    // Notified of the data committed to the parts, could be nullptr.
+    std::shared_ptr<CommitListener> commitListener_{nullptr};
 };
 
 
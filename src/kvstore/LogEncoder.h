@@ -29,6 +29,7 @@ enum BatchLogType : char {
     OP_BATCH_PUT            = 0x1,
     OP_BATCH_REMOVE         = 0x2,
     OP_BATCH_REMOVE_RANGE   = 0x3,
+    OP_BATCH_MERGE          = 0x4,
 };
 
 std::string encodeKV(const folly::StringPiece& key,
@@ -84,6 +85,14 @@ public:
         batch_.emplace_back(std::move(op));
     }
 
+    // The operand is combined with the existing value by the merge operator
+    void merge(std::string&& key, std::string&& operand) {
+        auto op = std::make_tuple(BatchLogType::OP_BATCH_MERGE,
+                                  std::forward<std::string>(key),
+                                  std::forward<std::string>(operand));
+        batch_.emplace_back(std::move(op));
+    }
+
     void clear() {
         batch_.clear();
     }
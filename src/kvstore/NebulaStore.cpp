@@ -12,6 +12,7 @@
 #include "network/NetworkUtils.h"
 #include "fs/FileUtils.h"
 #include "kvstore/RocksEngine.h"
+#include "kvstore/RocksEngineConfig.h"
 #include "kvstore/SnapshotManagerImpl.h"
 #include <folly/ScopeGuard.h>
 
@@ -137,6 +138,7 @@ bool NebulaStore::init() {
                                                                bgWorkers_,
                                                                workers_,
                                                                snapshot_);
+                            part->setCommitListener(options_.commitListener_);
                             auto status = options_.partMan_->partMeta(spaceId, partId);
                             if (!status.ok()) {
                                 LOG(WARNING) << status.status().toString();
@@ -306,6 +308,7 @@ std::shared_ptr<Part> NebulaStore::newPart(GraphSpaceID spaceId,
                                        bgWorkers_,
                                        workers_,
                                        snapshot_);
+    part->setCommitListener(options_.commitListener_);
     std::vector<HostAddr> peers;
     if (defaultPeers.empty()) {
         // pull the information from meta
@@ -610,6 +613,9 @@ ResultCode NebulaStore::ingest(GraphSpaceID spaceId) {
                     return code;
                 }
             }
+            if (options_.commitListener_ != nullptr && !files.empty()) {
+                options_.commitListener_->onReset(spaceId, part);
+            }
         }
     }
     return ResultCode::SUCCEEDED;
@@ -854,11 +860,22 @@ void NebulaStore::cleanWAL() {
                                  this);
     };
     for (const auto& spaceEntry : spaces_) {
+        // The logs committed into the engines flushed could be dropped from the raft wal
+        std::unordered_set<KVEngine*> flushed;
         for (const auto& engine : spaceEntry.second->engines_) {
-            engine->flush();
+            if (engine->flush() == ResultCode::SUCCEEDED) {
+                flushed.emplace(engine.get());
+            }
         }
         for (const auto& partEntry : spaceEntry.second->parts_) {
             auto& part = partEntry.second;
+            if (FLAGS_rocksdb_disable_wal && flushed.count(part->engine()) == 0) {
+                // The logs committed might be only in the memtable, which are
+                // replayed from the raft wal after a crash
+                LOG(WARNING) << "Skip cleaning the wal of space " << spaceEntry.first
+                             << ", part " << partEntry.first << " since the engine is not flushed";
+                continue;
+            }
             if (part->needToCleanWal()) {
                 part->wal()->cleanWAL();
             }
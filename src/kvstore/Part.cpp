@@ -8,6 +8,10 @@
 #include "kvstore/LogEncoder.h"
 #include "utils/NebulaKeyUtils.h"
 #include "kvstore/RocksEngineConfig.h"
+#include <folly/ScopeGuard.h>
+#include <sys/stat.h>
+#include <rocksdb/sst_file_reader.h>
+#include "fs/FileUtils.h"
 
 DEFINE_int32(cluster_id, 0, "A unique id for each cluster");
 
@@ -189,6 +193,14 @@ bool Part::commitLogs(std::unique_ptr<LogIterator> iter) {
     auto batch = engine_->startBatchWrite();
     LogID lastId = -1;
     TermID lastTerm = -1;
+    // The keys changed by the logs, they are reported to the listener after committed
+    std::vector<std::string> changed;
+    bool reset = false;
+    auto watch = [this, &changed] (const folly::StringPiece& key) {
+        if (listener_ != nullptr && listener_->watch(key)) {
+            changed.emplace_back(key.str());
+        }
+    };
     while (iter->valid()) {
         lastId = iter->logId();
         lastTerm = iter->logTerm();
@@ -208,6 +220,7 @@ bool Part::commitLogs(std::unique_ptr<LogIterator> iter) {
                 LOG(ERROR) << idStr_ << "Failed to call WriteBatch::put()";
                 return false;
             }
+            watch(pieces[0]);
             break;
         }
         case OP_MULTI_PUT: {
@@ -219,6 +232,7 @@ bool Part::commitLogs(std::unique_ptr<LogIterator> iter) {
                     LOG(ERROR) << idStr_ << "Failed to call WriteBatch::put()";
                     return false;
                 }
+                watch(kvs[i]);
             }
             break;
         }
@@ -228,6 +242,7 @@ bool Part::commitLogs(std::unique_ptr<LogIterator> iter) {
                 LOG(ERROR) << idStr_ << "Failed to call WriteBatch::remove()";
                 return false;
             }
+            watch(key);
             break;
         }
         case OP_MULTI_REMOVE: {
@@ -237,6 +252,7 @@ bool Part::commitLogs(std::unique_ptr<LogIterator> iter) {
                     LOG(ERROR) << idStr_ << "Failed to call WriteBatch::remove()";
                     return false;
                 }
+                watch(k);
             }
             break;
         }
@@ -247,6 +263,7 @@ bool Part::commitLogs(std::unique_ptr<LogIterator> iter) {
                 LOG(ERROR) << idStr_ << "Failed to call WriteBatch::removeRange()";
                 return false;
             }
+            reset = true;
             break;
         }
         case OP_BATCH_WRITE: {
@@ -255,10 +272,16 @@ bool Part::commitLogs(std::unique_ptr<LogIterator> iter) {
                 ResultCode code = ResultCode::SUCCEEDED;
                 if (op.first == BatchLogType::OP_BATCH_PUT) {
                     code = batch->put(op.second.first, op.second.second);
+                    watch(op.second.first);
                 } else if (op.first == BatchLogType::OP_BATCH_REMOVE) {
                     code = batch->remove(op.second.first);
+                    watch(op.second.first);
                 } else if (op.first == BatchLogType::OP_BATCH_REMOVE_RANGE) {
                     code = batch->removeRange(op.second.first, op.second.second);
+                    reset = true;
+                } else if (op.first == BatchLogType::OP_BATCH_MERGE) {
+                    code = batch->merge(op.second.first, op.second.second);
+                    watch(op.second.first);
                 }
                 if (code != ResultCode::SUCCEEDED) {
                     LOG(ERROR) << idStr_ << "Failed to call WriteBatch";
@@ -309,9 +332,19 @@ bool Part::commitLogs(std::unique_ptr<LogIterator> iter) {
             return false;
         }
     }
-    return engine_->commitBatchWrite(std::move(batch),
-                                     FLAGS_rocksdb_disable_wal,
-                                     FLAGS_rocksdb_wal_sync) == ResultCode::SUCCEEDED;
+    if (engine_->commitBatchWrite(std::move(batch),
+                                  FLAGS_rocksdb_disable_wal,
+                                  FLAGS_rocksdb_wal_sync) != ResultCode::SUCCEEDED) {
+        return false;
+    }
+    if (listener_ != nullptr) {
+        if (reset) {
+            listener_->onReset(spaceId_, partId_);
+        } else if (!changed.empty()) {
+            listener_->onCommitted(spaceId_, partId_, changed);
+        }
+    }
+    return true;
 }
 
 std::pair<int64_t, int64_t> Part::commitSnapshot(const std::vector<std::string>& rows,
@@ -341,9 +374,104 @@ std::pair<int64_t, int64_t> Part::commitSnapshot(const std::vector<std::string>&
         LOG(ERROR) << idStr_ << "Put failed in commit";
         return std::make_pair(0, 0);
     }
+    if (listener_ != nullptr) {
+        listener_->onReset(spaceId_, partId_);
+    }
     return std::make_pair(count, size);
 }
 
+raftex::cpp2::ErrorCode Part::commitSnapshotFile(const raftex::cpp2::SnapshotFile& file,
+                                                 std::pair<int64_t, int64_t>* rows) {
+    *rows = std::make_pair(0, 0);
+    // The sender only sends the flat file names, never write out of the recv dir
+    const auto& name = file.get_name();
+    if (name.empty() || name.find('/') != std::string::npos) {
+        LOG(ERROR) << idStr_ << "Invalid snapshot file name " << name;
+        return raftex::cpp2::ErrorCode::E_SNAPSHOT_FILE_FAILED;
+    }
+    auto dir = folly::stringPrintf("%s/snapshot/recv_%d", engine_->getDataRoot(), partId_);
+    auto path = folly::stringPrintf("%s/%s", dir.c_str(), name.c_str());
+    // The files received are removed once failed, the sender aborts the snapshot then
+    bool succeeded = false;
+    SCOPE_EXIT {
+        if (!succeeded) {
+            fs::FileUtils::remove(dir.c_str(), true);
+        }
+    };
+    int flags = O_WRONLY | O_CREAT;
+    if (file.get_offset() == 0) {
+        if (!fs::FileUtils::makeDir(dir)) {
+            LOG(ERROR) << idStr_ << "Failed to make dir " << dir;
+            return raftex::cpp2::ErrorCode::E_SNAPSHOT_FILE_FAILED;
+        }
+        flags |= O_TRUNC;
+    }
+    int fd = ::open(path.c_str(), flags, 0644);
+    if (fd < 0) {
+        LOG(ERROR) << idStr_ << "Failed to open " << path << ", error: " << strerror(errno);
+        return raftex::cpp2::ErrorCode::E_SNAPSHOT_FILE_FAILED;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        LOG(ERROR) << idStr_ << "Failed to stat " << path << ", error: " << strerror(errno);
+        ::close(fd);
+        return raftex::cpp2::ErrorCode::E_SNAPSHOT_FILE_FAILED;
+    }
+    if (st.st_size != file.get_offset()) {
+        // Some chunk before is missing
+        LOG(ERROR) << idStr_ << "Bad offset " << file.get_offset() << " of " << path
+                   << ", the size received is " << st.st_size;
+        ::close(fd);
+        return raftex::cpp2::ErrorCode::E_SNAPSHOT_FILE_FAILED;
+    }
+    const auto& data = file.get_data();
+    auto written = ::pwrite(fd, data.data(), data.size(), file.get_offset());
+    ::close(fd);
+    if (written != static_cast<ssize_t>(data.size())) {
+        LOG(ERROR) << idStr_ << "Failed to write " << path << ", error: " << strerror(errno);
+        return raftex::cpp2::ErrorCode::E_SNAPSHOT_FILE_FAILED;
+    }
+    if (!file.get_eof()) {
+        succeeded = true;
+        return raftex::cpp2::ErrorCode::SUCCEEDED;
+    }
+
+    SCOPE_EXIT {
+        fs::FileUtils::remove(path.c_str());
+    };
+    rocksdb::Options options;
+    auto status = initRocksdbOptions(options);
+    if (!status.ok()) {
+        LOG(ERROR) << idStr_ << "Failed to init the options: " << status.ToString();
+        return raftex::cpp2::ErrorCode::E_SNAPSHOT_FILE_FAILED;
+    }
+    // Count the rows in the file, in case the file is truncated or mixed up
+    rocksdb::SstFileReader reader(options);
+    status = reader.Open(path);
+    if (!status.ok()) {
+        LOG(ERROR) << idStr_ << "Failed to open the snapshot file " << path
+                   << ": " << status.ToString();
+        return raftex::cpp2::ErrorCode::E_SNAPSHOT_FILE_FAILED;
+    }
+    auto count = static_cast<int64_t>(reader.GetTableProperties()->num_entries);
+    if (count != file.get_count()) {
+        LOG(ERROR) << idStr_ << "Bad snapshot file " << path << ", " << count
+                   << " rows received, but " << file.get_count() << " rows sent";
+        return raftex::cpp2::ErrorCode::E_SNAPSHOT_FILE_FAILED;
+    }
+    if (engine_->ingest({path}) != ResultCode::SUCCEEDED) {
+        LOG(ERROR) << idStr_ << "Failed to ingest the snapshot file " << path;
+        return raftex::cpp2::ErrorCode::E_SNAPSHOT_FILE_FAILED;
+    }
+    LOG(INFO) << idStr_ << "Ingest the snapshot file " << path << " of " << count << " rows";
+    if (listener_ != nullptr) {
+        listener_->onReset(spaceId_, partId_);
+    }
+    succeeded = true;
+    *rows = std::make_pair(file.get_count(), file.get_size());
+    return raftex::cpp2::ErrorCode::SUCCEEDED;
+}
+
 ResultCode Part::putCommitMsg(WriteBatch* batch, LogID committedLogId, TermID committedLogTerm) {
     std::string commitMsg;
     commitMsg.reserve(sizeof(LogID) + sizeof(TermID));
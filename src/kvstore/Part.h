@@ -8,6 +8,7 @@
 #define KVSTORE_PART_H_
 
 #include "base/Base.h"
+#include <gtest/gtest_prod.h>
 #include "utils/NebulaKeyUtils.h"
 #include "raftex/RaftPart.h"
 #include "kvstore/Common.h"
@@ -21,6 +22,8 @@ namespace kvstore {
 
 class Part : public raftex::RaftPart {
     friend class SnapshotManager;
+    FRIEND_TEST(NebulaStoreTest, SnapshotFileRecvTest);
+
 public:
     Part(GraphSpaceID spaceId,
          PartitionID partId,
@@ -72,6 +75,10 @@ public:
         newLeaderCb_ = nullptr;
     }
 
+    void setCommitListener(std::shared_ptr<CommitListener> listener) {
+        listener_ = std::move(listener);
+    }
+
     // clean up all data about this part.
     void reset() {
         LOG(INFO) << idStr_ << "Clean up all wals";
@@ -107,6 +114,9 @@ private:
                                                TermID committedLogTerm,
                                                bool finished) override;
 
+    raftex::cpp2::ErrorCode commitSnapshotFile(const raftex::cpp2::SnapshotFile& file,
+                                               std::pair<int64_t, int64_t>* rows) override;
+
     ResultCode putCommitMsg(WriteBatch* batch, LogID committedLogId, TermID committedLogTerm);
 
     void cleanup() override {
@@ -116,7 +126,8 @@ private:
             LOG(ERROR) << idStr_ << "Put failed in commit";
             return;
         }
-        if (ResultCode::SUCCEEDED != engine_->commitBatchWrite(std::move(batch))) {
+        // The reset is in no raft log to replay, so keep it in the rocksdb's wal.
+        if (ResultCode::SUCCEEDED != engine_->commitBatchWrite(std::move(batch), false)) {
             LOG(ERROR) << idStr_ << "Put failed in commit";
             return;
         }
@@ -132,6 +143,7 @@ protected:
     std::string walPath_;
     KVEngine* engine_ = nullptr;
     NewLeaderCallback newLeaderCb_ = nullptr;
+    std::shared_ptr<CommitListener> listener_{nullptr};
 };
 
 }  // namespace kvstore
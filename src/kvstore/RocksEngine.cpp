@@ -59,6 +59,14 @@ public:
         }
     }
 
+    ResultCode merge(folly::StringPiece key, folly::StringPiece operand) override {
+        if (batch_.Merge(toSlice(key), toSlice(operand)).ok()) {
+            return ResultCode::SUCCEEDED;
+        } else {
+            return ResultCode::ERR_UNKNOWN;
+        }
+    }
+
     rocksdb::WriteBatch* data() {
         return &batch_;
     }
@@ -214,7 +222,6 @@ ResultCode RocksEngine::rangeWithPrefix(const std::string& start,
 
 ResultCode RocksEngine::put(std::string key, std::string value) {
     rocksdb::WriteOptions options;
-    options.disableWAL = FLAGS_rocksdb_disable_wal;
     rocksdb::Status status = db_->Put(options, key, value);
     if (status.ok()) {
         return ResultCode::SUCCEEDED;
@@ -231,7 +238,6 @@ ResultCode RocksEngine::multiPut(std::vector<KV> keyValues) {
         updates.Put(keyValues[i].first, keyValues[i].second);
     }
     rocksdb::WriteOptions options;
-    options.disableWAL = FLAGS_rocksdb_disable_wal;
     rocksdb::Status status = db_->Write(options, &updates);
     if (status.ok()) {
         return ResultCode::SUCCEEDED;
@@ -244,7 +250,6 @@ ResultCode RocksEngine::multiPut(std::vector<KV> keyValues) {
 
 ResultCode RocksEngine::remove(const std::string& key) {
     rocksdb::WriteOptions options;
-    options.disableWAL = FLAGS_rocksdb_disable_wal;
     auto status = db_->Delete(options, key);
     if (status.ok()) {
         return ResultCode::SUCCEEDED;
@@ -261,7 +266,6 @@ ResultCode RocksEngine::multiRemove(std::vector<std::string> keys) {
         deletes.Delete(keys[i]);
     }
     rocksdb::WriteOptions options;
-    options.disableWAL = FLAGS_rocksdb_disable_wal;
     rocksdb::Status status = db_->Write(options, &deletes);
     if (status.ok()) {
         return ResultCode::SUCCEEDED;
@@ -275,7 +279,6 @@ ResultCode RocksEngine::multiRemove(std::vector<std::string> keys) {
 ResultCode RocksEngine::removeRange(const std::string& start,
                                     const std::string& end) {
     rocksdb::WriteOptions options;
-    options.disableWAL = FLAGS_rocksdb_disable_wal;
     auto status = db_->DeleteRange(options, db_->DefaultColumnFamily(), start, end);
     if (status.ok()) {
         return ResultCode::SUCCEEDED;
@@ -300,7 +303,6 @@ void RocksEngine::addPart(PartitionID partId) {
 
 void RocksEngine::removePart(PartitionID partId) {
      rocksdb::WriteOptions options;
-     options.disableWAL = FLAGS_rocksdb_disable_wal;
      auto status = db_->Delete(options, partKey(partId));
      if (status.ok()) {
          partsNum_--;
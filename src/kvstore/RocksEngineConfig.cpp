@@ -20,7 +20,8 @@
 // [WAL]
 DEFINE_bool(rocksdb_disable_wal,
             false,
-            "Whether to disable the WAL in rocksdb");
+            "Whether to disable the WAL in rocksdb when committing the raft logs, "
+            "the logs not flushed are replayed from the raft wal after a crash");
 
 DEFINE_bool(rocksdb_wal_sync,
             false,
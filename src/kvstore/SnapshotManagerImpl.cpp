@@ -4,10 +4,21 @@
  * attached with Common Clause Condition 1.0, found in the LICENSES directory.
  */
 #include "kvstore/SnapshotManagerImpl.h"
+#include <fstream>
+#include <folly/ScopeGuard.h>
+#include <rocksdb/sst_file_writer.h>
 #include "utils/NebulaKeyUtils.h"
 #include "kvstore/LogEncoder.h"
+#include "kvstore/Part.h"
+#include "kvstore/RocksEngineConfig.h"
+#include "fs/FileUtils.h"
+#include "time/WallClock.h"
 
 DEFINE_int32(snapshot_batch_size, 1024 * 1024 * 10, "batch size for snapshot");
+DEFINE_bool(snapshot_send_sst, false, "Whether to send the snapshot in sst files, "
+                                      "the parts fit in one batch are always sent in rows");
+DEFINE_int64(snapshot_sst_file_size, 256 * 1024 * 1024,
+             "The max size of the rows in one sst file of the snapshot");
 
 namespace nebula {
 namespace kvstore {
@@ -16,42 +27,207 @@ void SnapshotManagerImpl::accessAllRowsInSnapshot(GraphSpaceID spaceId,
                                                   PartitionID partId,
                                                   raftex::SnapshotCallback cb) {
     CHECK_NOTNULL(store_);
-    std::unique_ptr<KVIterator> iter;
-    auto prefix = NebulaKeyUtils::snapshotPrefix(partId);
+    std::vector<std::unique_ptr<KVIterator>> iters;
     std::vector<std::string> data;
     int64_t totalSize = 0;
     int64_t totalCount = 0;
-    auto ret = store_->prefix(spaceId, partId, prefix, &iter);
-    if (ret != ResultCode::SUCCEEDED) {
-        LOG(INFO) << "[spaceId:" << spaceId << ", partId:" << partId << "] access prefix failed"
-                  << ", error code:" << static_cast<int32_t>(ret);
-        cb(data, totalCount, totalSize, raftex::SnapshotStatus::FAILED);
-        return;
+    for (auto& prefix : NebulaKeyUtils::snapshotPrefix(partId)) {
+        std::unique_ptr<KVIterator> iter;
+        auto ret = store_->prefix(spaceId, partId, prefix, &iter);
+        if (ret != ResultCode::SUCCEEDED) {
+            LOG(INFO) << "[spaceId:" << spaceId << ", partId:" << partId << "] access prefix failed"
+                      << ", error code:" << static_cast<int32_t>(ret);
+            cb(data, nullptr, totalCount, totalSize, raftex::SnapshotStatus::FAILED);
+            return;
+        }
+        iters.emplace_back(std::move(iter));
     }
     data.reserve(kReserveNum);
     int32_t batchSize = 0;
-    while (iter && iter->valid()) {
-        if (batchSize >= FLAGS_snapshot_batch_size) {
-            if (cb(data, totalCount, totalSize, raftex::SnapshotStatus::IN_PROGRESS)) {
-                data.clear();
-                batchSize = 0;
-            } else {
-                LOG(INFO) << "[spaceId:" << spaceId << ", partId:" << partId
-                          << "] callback invoked failed";
-                return;
+    for (size_t i = 0; i < iters.size(); i++) {
+        auto* iter = iters[i].get();
+        while (iter && iter->valid()) {
+            if (batchSize >= FLAGS_snapshot_batch_size) {
+                if (FLAGS_snapshot_send_sst) {
+                    // Nothing is sent yet, the part is too large to be sent row by row
+                    std::vector<KVIterator*> rest;
+                    for (auto j = i; j < iters.size(); j++) {
+                        rest.emplace_back(iters[j].get());
+                    }
+                    sendInSstFiles(spaceId, partId, std::move(data), rest, cb);
+                    return;
+                }
+                if (cb(data, nullptr, totalCount, totalSize,
+                       raftex::SnapshotStatus::IN_PROGRESS)) {
+                    data.clear();
+                    batchSize = 0;
+                } else {
+                    LOG(INFO) << "[spaceId:" << spaceId << ", partId:" << partId
+                              << "] callback invoked failed";
+                    return;
+                }
             }
+            auto key = iter->key();
+            auto val = iter->val();
+            data.emplace_back(encodeKV(key, val));
+            batchSize += data.back().size();
+            totalSize += data.back().size();
+            totalCount++;
+            iter->next();
         }
-        auto key = iter->key();
-        auto val = iter->val();
-        data.emplace_back(encodeKV(key, val));
-        batchSize += data.back().size();
-        totalSize += data.back().size();
-        totalCount++;
-        iter->next();
     }
-    cb(data, totalCount, totalSize, raftex::SnapshotStatus::DONE);
+    cb(data, nullptr, totalCount, totalSize, raftex::SnapshotStatus::DONE);
 }
-}  // namespace kvstore
-}  // namespace nebula
 
+bool SnapshotManagerImpl::sendInSstFiles(GraphSpaceID spaceId,
+                                         PartitionID partId,
+                                         std::vector<std::string> rows,
+                                         const std::vector<KVIterator*>& iters,
+                                         raftex::SnapshotCallback& cb) {
+    std::vector<std::string> empty;
+    int64_t totalCount = 0;
+    int64_t totalSize = 0;
+    auto partRet = store_->part(spaceId, partId);
+    if (!ok(partRet)) {
+        LOG(INFO) << "[spaceId:" << spaceId << ", partId:" << partId << "] part not found";
+        cb(empty, nullptr, totalCount, totalSize, raftex::SnapshotStatus::FAILED);
+        return false;
+    }
+    auto dir = folly::stringPrintf("%s/snapshot/send_%d_%ld",
+                                   nebula::value(partRet)->engine()->getDataRoot(),
+                                   partId,
+                                   time::WallClock::fastNowInMicroSec());
+    if (!fs::FileUtils::makeDir(dir)) {
+        LOG(ERROR) << "Failed to make dir " << dir;
+        cb(empty, nullptr, totalCount, totalSize, raftex::SnapshotStatus::FAILED);
+        return false;
+    }
+    SCOPE_EXIT {
+        fs::FileUtils::remove(dir.c_str(), true);
+    };
+
+    // The keys are iterated in order, so they could be written into the sst files directly,
+    // in the same format as the engine
+    rocksdb::Options options;
+    auto optStatus = initRocksdbOptions(options);
+    if (!optStatus.ok()) {
+        LOG(ERROR) << "Failed to init the options: " << optStatus.ToString();
+        cb(empty, nullptr, totalCount, totalSize, raftex::SnapshotStatus::FAILED);
+        return false;
+    }
+    std::unique_ptr<rocksdb::SstFileWriter> writer;
+    std::string path;
+    int32_t fileIndex = 0;
+    int64_t fileCount = 0;
+    int64_t fileSize = 0;
+    auto finishFile = [&] () -> bool {
+        auto status = writer->Finish();
+        writer.reset();
+        if (!status.ok()) {
+            LOG(ERROR) << "Failed to finish the sst file " << path << ": " << status.ToString();
+            cb(empty, nullptr, totalCount, totalSize, raftex::SnapshotStatus::FAILED);
+            return false;
+        }
+        auto sent = sendSstFile(path, fileCount, fileSize, totalCount, totalSize, cb);
+        fs::FileUtils::remove(path.c_str());
+        return sent;
+    };
+    auto put = [&] (folly::StringPiece key, folly::StringPiece val) -> bool {
+        if (writer == nullptr) {
+            writer = std::make_unique<rocksdb::SstFileWriter>(rocksdb::EnvOptions(), options);
+            path = folly::stringPrintf("%s/%d.sst", dir.c_str(), fileIndex++);
+            fileCount = 0;
+            fileSize = 0;
+            auto status = writer->Open(path);
+            if (!status.ok()) {
+                LOG(ERROR) << "Failed to open the sst file " << path << ": " << status.ToString();
+                cb(empty, nullptr, totalCount, totalSize, raftex::SnapshotStatus::FAILED);
+                return false;
+            }
+        }
+        auto status = writer->Put(rocksdb::Slice(key.data(), key.size()),
+                                  rocksdb::Slice(val.data(), val.size()));
+        if (!status.ok()) {
+            LOG(ERROR) << "Failed to write the sst file " << path << ": " << status.ToString();
+            cb(empty, nullptr, totalCount, totalSize, raftex::SnapshotStatus::FAILED);
+            return false;
+        }
+        fileCount++;
+        // Same as the size of the row encoded
+        fileSize += sizeof(uint32_t) * 2 + key.size() + val.size();
+        if (fileSize >= FLAGS_snapshot_sst_file_size) {
+            return finishFile();
+        }
+        return true;
+    };
+
+    LOG(INFO) << "[spaceId:" << spaceId << ", partId:" << partId
+              << "] Send the snapshot in sst files under " << dir;
+    for (auto& row : rows) {
+        auto kv = decodeKV(row);
+        if (!put(kv.first, kv.second)) {
+            return false;
+        }
+    }
+    rows.clear();
+    for (auto* iter : iters) {
+        for (; iter != nullptr && iter->valid(); iter->next()) {
+            if (!put(iter->key(), iter->val())) {
+                return false;
+            }
+        }
+    }
+    if (writer != nullptr && !finishFile()) {
+        return false;
+    }
+    return cb(empty, nullptr, totalCount, totalSize, raftex::SnapshotStatus::DONE);
+}
 
+bool SnapshotManagerImpl::sendSstFile(const std::string& path,
+                                      int64_t count,
+                                      int64_t size,
+                                      int64_t& totalCount,
+                                      int64_t& totalSize,
+                                      raftex::SnapshotCallback& cb) {
+    std::vector<std::string> empty;
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) {
+        LOG(ERROR) << "Failed to open the sst file " << path;
+        cb(empty, nullptr, totalCount, totalSize, raftex::SnapshotStatus::FAILED);
+        return false;
+    }
+    int64_t fileLen = in.tellg();
+    in.seekg(0);
+    auto name = path.substr(path.rfind('/') + 1);
+    int64_t offset = 0;
+    do {
+        auto len = std::min<int64_t>(fileLen - offset, FLAGS_snapshot_batch_size);
+        std::string buf(len, '\0');
+        if (!in.read(&buf[0], len)) {
+            LOG(ERROR) << "Failed to read the sst file " << path;
+            cb(empty, nullptr, totalCount, totalSize, raftex::SnapshotStatus::FAILED);
+            return false;
+        }
+        raftex::cpp2::SnapshotFile file;
+        file.set_name(name);
+        file.set_offset(offset);
+        file.set_data(std::move(buf));
+        offset += len;
+        file.set_eof(offset >= fileLen);
+        if (file.get_eof()) {
+            file.set_count(count);
+            file.set_size(size);
+            totalCount += count;
+            totalSize += size;
+        }
+        if (!cb(empty, &file, totalCount, totalSize, raftex::SnapshotStatus::IN_PROGRESS)) {
+            LOG(INFO) << "Failed to send the sst file " << path;
+            return false;
+        }
+    } while (offset < fileLen);
+    VLOG(1) << "Sent the sst file " << path << " of " << count << " rows";
+    return true;
+}
+
+}  // namespace kvstore
+}  // namespace nebula
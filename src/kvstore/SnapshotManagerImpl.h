@@ -22,6 +22,27 @@ public:
                                  PartitionID partId,
                                  raftex::SnapshotCallback cb) override;
 
+private:
+    /**
+     * Send the rows left in sst files, which are built in the data path of the
+     * engine and ingested by the receiver. The rows are the ones iterated but
+     * not sent yet, followed by the ones left in iters, in the order of the keys.
+     * Return false if failed, and the callback has been told.
+     * */
+    bool sendInSstFiles(GraphSpaceID spaceId,
+                        PartitionID partId,
+                        std::vector<std::string> rows,
+                        const std::vector<KVIterator*>& iters,
+                        raftex::SnapshotCallback& cb);
+
+    // Send the sst file in chunks
+    bool sendSstFile(const std::string& path,
+                     int64_t count,
+                     int64_t size,
+                     int64_t& totalCount,
+                     int64_t& totalSize,
+                     raftex::SnapshotCallback& cb);
+
 private:
     KVStore* store_;
 };
@@ -20,6 +20,7 @@ DEFINE_int32(raft_rpc_timeout_ms, 500, "rpc timeout for raft client");
 
 DECLARE_bool(trace_raft);
 DECLARE_uint32(raft_heartbeat_interval_secs);
+DECLARE_uint32(max_inflight_appendlog_batches);
 
 namespace nebula {
 namespace raftex {
@@ -34,8 +35,7 @@ Host::Host(const HostAddr& addr, std::shared_ptr<RaftPart> part, bool isLearner)
             "%s[Host: %s:%d] ",
             part_->idStr_.c_str(),
             NetworkUtils::intToIPv4(addr_.first).c_str(),
-            addr_.second))
-        , cachingPromise_(folly::SharedPromise<cpp2::AppendLogResponse>()) {
+            addr_.second)) {
 }
 
 
@@ -44,7 +44,7 @@ void Host::waitForStop() {
 
     CHECK(stopped_);
     noMoreRequestCV_.wait(g, [this] {
-        return !requestOnGoing_;
+        return requestsOnGoing_ == 0;
     });
     LOG(INFO) << idStr_ << "The host has been stopped!";
 }
@@ -105,32 +105,25 @@ folly::Future<cpp2::AppendLogResponse> Host::appendLogs(
                   << "]";
     }
     auto ret = folly::Future<cpp2::AppendLogResponse>::makeEmpty();
-    std::shared_ptr<cpp2::AppendLogRequest> req;
+    std::vector<std::shared_ptr<cpp2::AppendLogRequest>> reqs;
+    uint64_t round = 0;
     {
         std::lock_guard<std::mutex> g(lock_);
 
         auto res = checkStatus();
-        if (logId <= lastLogIdSent_) {
-            LOG(INFO) << idStr_ << "The log " << logId << " has been sended"
-                      << ", lastLogIdSent " << lastLogIdSent_;
+        if (term < logTermToSend_) {
+            VLOG(2) << idStr_ << "The term " << term << " is out of date, current term "
+                    << logTermToSend_;
             cpp2::AppendLogResponse r;
-            r.set_error_code(cpp2::ErrorCode::SUCCEEDED);
+            r.set_error_code(cpp2::ErrorCode::E_TERM_OUT_OF_DATE);
             return r;
         }
-
-        if (requestOnGoing_ && res == cpp2::ErrorCode::SUCCEEDED) {
-            if (cachingPromise_.size() <= FLAGS_max_outstanding_requests) {
-                pendingReq_ = std::make_tuple(term,
-                                              logId,
-                                              committedLogId);
-                return cachingPromise_.getFuture();
-            } else {
-                PLOG_EVERY_N(INFO, 200) << idStr_
-                          << "Too many requests are waiting, return error";
-                cpp2::AppendLogResponse r;
-                r.set_error_code(cpp2::ErrorCode::E_TOO_MANY_REQUESTS);
-                return r;
-            }
+        if (term == logTermToSend_ && logId <= lastLogIdAccepted_) {
+            LOG(INFO) << idStr_ << "The log " << logId << " has been accepted"
+                      << ", lastLogIdAccepted " << lastLogIdAccepted_;
+            cpp2::AppendLogResponse r;
+            r.set_error_code(cpp2::ErrorCode::SUCCEEDED);
+            return r;
         }
 
         if (res != cpp2::ErrorCode::SUCCEEDED) {
@@ -141,266 +134,305 @@ folly::Future<cpp2::AppendLogResponse> Host::appendLogs(
             return r;
         }
 
-        VLOG(2) << idStr_ << "About to send the AppendLog request";
+        if (promises_.size() >= FLAGS_max_outstanding_requests
+                && promises_.find(logId) == promises_.end()) {
+            PLOG_EVERY_N(INFO, 200) << idStr_
+                      << "Too many requests are waiting, return error";
+            cpp2::AppendLogResponse r;
+            r.set_error_code(cpp2::ErrorCode::E_TOO_MANY_REQUESTS);
+            return r;
+        }
+
+        if (term > logTermToSend_) {
+            // The logs accepted in the previous terms might have been rolled back,
+            // and the logs waited for are never sent again.
+            cpp2::AppendLogResponse r;
+            r.set_error_code(cpp2::ErrorCode::E_TERM_OUT_OF_DATE);
+            setResponse(r);
+            lastLogIdAccepted_ = 0;
+            newRound();
+        }
 
-        // No request is ongoing, let's send a new request
         if (UNLIKELY(lastLogIdSent_ == 0 && lastLogTermSent_ == 0)) {
             LOG(INFO) << idStr_ << "This is the first time to send the logs to this host";
             lastLogIdSent_ = prevLogId;
             lastLogTermSent_ = prevLogTerm;
         }
-        if (prevLogTerm < lastLogTermSent_ || prevLogId < lastLogIdSent_) {
+        if (inflight_ == 0 && (prevLogTerm < lastLogTermSent_ || prevLogId < lastLogIdSent_)) {
             LOG(INFO) << idStr_ << "We have sended this log, so go on from id " << lastLogIdSent_
                       << ", term " << lastLogTermSent_ << "; current prev log id " << prevLogId
                       << ", current prev log term " << prevLogTerm;
         }
-        logTermToSend_ = term;
-        logIdToSend_ = logId;
-        committedLogId_ = committedLogId;
-        pendingReq_ = std::make_tuple(0, 0, 0);
-        promise_ = std::move(cachingPromise_);
-        cachingPromise_ = folly::SharedPromise<cpp2::AppendLogResponse>();
-        ret = promise_.getFuture();
-
-        requestOnGoing_ = true;
+        if (term > logTermToSend_ || logId > logIdToSend_) {
+            logTermToSend_ = term;
+            logIdToSend_ = logId;
+        }
+        committedLogId_ = std::max(committedLogId_, committedLogId);
+        ret = promises_[logId].getFuture();
 
-        req = prepareAppendLogRequest();
+        // Send the logs right away if the window allows, otherwise they are
+        // sent along with the following logs when a request is responded.
+        reqs = prepareAppendLogRequests();
+        round = round_;
     }
 
-    // Get a new promise
-    appendLogsInternal(eb, std::move(req));
+    for (auto& req : reqs) {
+        VLOG(2) << idStr_ << "About to send the AppendLog request";
+        appendLogsInternal(eb, std::move(req), round);
+    }
 
     return ret;
 }
 
 void Host::setResponse(const cpp2::AppendLogResponse& r) {
     CHECK(!lock_.try_lock());
-    promise_.setValue(r);
-    cachingPromise_.setValue(r);
-    cachingPromise_ = folly::SharedPromise<cpp2::AppendLogResponse>();
-    pendingReq_ = std::make_tuple(0, 0, 0);
-    requestOnGoing_ = false;
+    for (auto& p : promises_) {
+        p.second.setValue(r);
+    }
+    promises_.clear();
+}
+
+void Host::onAccepted(LogID logId, const cpp2::AppendLogResponse& r) {
+    CHECK(!lock_.try_lock());
+    lastLogIdAccepted_ = std::max(lastLogIdAccepted_, logId);
+    auto end = promises_.upper_bound(lastLogIdAccepted_);
+    for (auto it = promises_.begin(); it != end; ++it) {
+        it->second.setValue(r);
+    }
+    promises_.erase(promises_.begin(), end);
+}
+
+void Host::newRound() {
+    CHECK(!lock_.try_lock());
+    ++round_;
+    inflight_ = 0;
+    probing_ = true;
 }
 
 void Host::appendLogsInternal(folly::EventBase* eb,
-                              std::shared_ptr<cpp2::AppendLogRequest> req) {
-    sendAppendLogRequest(eb, std::move(req)).via(eb).then(
-            [eb, self = shared_from_this()] (folly::Try<cpp2::AppendLogResponse>&& t) {
+                              std::shared_ptr<cpp2::AppendLogRequest> req,
+                              uint64_t round) {
+    sendAppendLogRequest(eb, req).via(eb).then(
+            [eb, req, round, self = shared_from_this()]
+            (folly::Try<cpp2::AppendLogResponse>&& t) {
         VLOG(3) << self->idStr_ << "appendLogs() call got response";
-        if (t.hasException()) {
-            VLOG(2) << self->idStr_ << t.exception().what();
-            cpp2::AppendLogResponse r;
-            r.set_error_code(cpp2::ErrorCode::E_EXCEPTION);
-            {
-                std::lock_guard<std::mutex> g(self->lock_);
-                self->setResponse(r);
-                self->lastLogIdSent_ = self->logIdToSend_ - 1;
-            }
+        std::vector<std::shared_ptr<cpp2::AppendLogRequest>> newReqs;
+        uint64_t newRound = 0;
+        {
+            std::lock_guard<std::mutex> g(self->lock_);
+            newReqs = self->processAppendLogResponse(*req, round, std::move(t));
+            newRound = self->round_;
+        }
+        if (newReqs.empty()) {
             self->noMoreRequestCV_.notify_all();
-            return;
         }
+        for (auto& newReq : newReqs) {
+            self->appendLogsInternal(eb, std::move(newReq), newRound);
+        }
+    });
+}
+
 
-        cpp2::AppendLogResponse resp = std::move(t).value();
-        if (FLAGS_trace_raft) {
-            LOG(INFO)
-                << self->idStr_ << "AppendLogResponse "
-                << "code " << static_cast<int32_t>(resp.get_error_code())
-                << ", currTerm " << resp.get_current_term()
-                << ", lastLogId " << resp.get_last_log_id()
-                << ", lastLogTerm " << resp.get_last_log_term()
-                << ", commitLogId " << resp.get_committed_log_id()
-                << ", lastLogIdSent_ " << self->lastLogIdSent_
-                << ", lastLogTermSent_ " << self->lastLogTermSent_;
+std::vector<std::shared_ptr<cpp2::AppendLogRequest>>
+Host::processAppendLogResponse(const cpp2::AppendLogRequest& req,
+                               uint64_t round,
+                               folly::Try<cpp2::AppendLogResponse>&& t) {
+    CHECK(!lock_.try_lock());
+    --requestsOnGoing_;
+    if (round != round_) {
+        // The logs have been sent again in a new round,
+        // so only take the logs accepted by the follower.
+        if (t.hasValue()
+                && t.value().get_error_code() == cpp2::ErrorCode::SUCCEEDED
+                && req.get_current_term() == logTermToSend_) {
+            onAccepted(t.value().get_last_log_id(), t.value());
         }
-        switch (resp.get_error_code()) {
-            case cpp2::ErrorCode::SUCCEEDED: {
-                VLOG(2) << self->idStr_
-                        << "AppendLog request sent successfully";
-
-                std::shared_ptr<cpp2::AppendLogRequest> newReq;
-                {
-                    std::lock_guard<std::mutex> g(self->lock_);
-                    auto res = self->checkStatus();
-                    if (res != cpp2::ErrorCode::SUCCEEDED) {
-                        VLOG(2) << self->idStr_
-                                << "The host is not in a proper status,"
-                                   " just return";
-                        cpp2::AppendLogResponse r;
-                        r.set_error_code(res);
-                        self->setResponse(r);
-                    } else if (self->lastLogIdSent_ >= resp.get_last_log_id()) {
-                        VLOG(1) << self->idStr_
-                                << "We send nothing in the last request"
-                                << ", so we don't send the same logs again";
-                        self->followerCommittedLogId_ = resp.get_committed_log_id();
-                        cpp2::AppendLogResponse r;
-                        r.set_error_code(res);
-                        self->setResponse(r);
-                    } else {
-                        self->lastLogIdSent_ = resp.get_last_log_id();
-                        self->lastLogTermSent_ = resp.get_last_log_term();
-                        self->followerCommittedLogId_ = resp.get_committed_log_id();
-                        if (self->lastLogIdSent_ < self->logIdToSend_) {
-                            // More to send
-                            VLOG(2) << self->idStr_
-                                    << "There are more logs to send";
-                            newReq = self->prepareAppendLogRequest();
-                        } else {
-                            VLOG(2) << self->idStr_
-                                    << "Fulfill the promise, size = " << self->promise_.size();
-                            // Fulfill the promise
-                            self->promise_.setValue(resp);
-
-                            if (self->noRequest()) {
-                                VLOG(2) << self->idStr_ << "No request any more!";
-                                self->requestOnGoing_ = false;
-                            } else {
-                                auto& tup = self->pendingReq_;
-                                self->logTermToSend_ = std::get<0>(tup);
-                                self->logIdToSend_ = std::get<1>(tup);
-                                self->committedLogId_ = std::get<2>(tup);
-                                VLOG(2) << self->idStr_
-                                        << "Sending the pending request in the queue"
-                                        << ", from " << self->lastLogIdSent_ + 1
-                                        << " to " << self->logIdToSend_;
-                                newReq = self->prepareAppendLogRequest();
-                                self->promise_ = std::move(self->cachingPromise_);
-                                self->cachingPromise_
-                                    = folly::SharedPromise<cpp2::AppendLogResponse>();
-                                self->pendingReq_ = std::make_tuple(0, 0, 0);
-                            }  // self->noRequest()
-                        }  // self->lastLogIdSent_ < self->logIdToSend_
-                    }  // else
-                }
-                if (newReq) {
-                    self->appendLogsInternal(eb, newReq);
-                } else {
-                    self->noMoreRequestCV_.notify_all();
-                }
-                return;
+        return {};
+    }
+    --inflight_;
+
+    if (t.hasException()) {
+        VLOG(2) << idStr_ << t.exception().what();
+        cpp2::AppendLogResponse r;
+        r.set_error_code(cpp2::ErrorCode::E_EXCEPTION);
+        setResponse(r);
+        lastLogIdSent_ = logIdToSend_ - 1;
+        newRound();
+        return {};
+    }
+
+    cpp2::AppendLogResponse resp = std::move(t).value();
+    if (FLAGS_trace_raft) {
+        LOG(INFO)
+            << idStr_ << "AppendLogResponse "
+            << "code " << static_cast<int32_t>(resp.get_error_code())
+            << ", currTerm " << resp.get_current_term()
+            << ", lastLogId " << resp.get_last_log_id()
+            << ", lastLogTerm " << resp.get_last_log_term()
+            << ", commitLogId " << resp.get_committed_log_id()
+            << ", lastLogIdSent " << req.get_last_log_id_sent()
+            << ", lastLogTermSent " << req.get_last_log_term_sent();
+    }
+    switch (resp.get_error_code()) {
+        case cpp2::ErrorCode::SUCCEEDED: {
+            VLOG(2) << idStr_
+                    << "AppendLog request sent successfully";
+            auto res = checkStatus();
+            if (res != cpp2::ErrorCode::SUCCEEDED) {
+                VLOG(2) << idStr_
+                        << "The host is not in a proper status,"
+                           " just return";
+                cpp2::AppendLogResponse r;
+                r.set_error_code(res);
+                setResponse(r);
+                newRound();
+                return {};
             }
-            case cpp2::ErrorCode::E_LOG_GAP: {
-                VLOG(2) << self->idStr_
-                        << "The host's log is behind, need to catch up";
-                std::shared_ptr<cpp2::AppendLogRequest> newReq;
-                {
-                    std::lock_guard<std::mutex> g(self->lock_);
-                    auto res = self->checkStatus();
-                    if (res != cpp2::ErrorCode::SUCCEEDED) {
-                        VLOG(2) << self->idStr_
-                                << "The host is not in a proper status,"
-                                   " skip catching up the gap";
-                        cpp2::AppendLogResponse r;
-                        r.set_error_code(res);
-                        self->setResponse(r);
-                    } else if (self->lastLogIdSent_ == resp.get_last_log_id()) {
-                        VLOG(1) << self->idStr_
-                                << "We send nothing in the last request"
-                                << ", so we don't send the same logs again";
-                        self->lastLogIdSent_ = resp.get_last_log_id();
-                        self->lastLogTermSent_ = resp.get_last_log_term();
-                        self->followerCommittedLogId_ = resp.get_committed_log_id();
-                        cpp2::AppendLogResponse r;
-                        r.set_error_code(cpp2::ErrorCode::SUCCEEDED);
-                        self->setResponse(r);
-                    } else {
-                        self->lastLogIdSent_ = std::min(resp.get_last_log_id(),
-                                                        self->logIdToSend_ - 1);
-                        self->lastLogTermSent_ = resp.get_last_log_term();
-                        self->followerCommittedLogId_ = resp.get_committed_log_id();
-                        newReq = self->prepareAppendLogRequest();
-                    }
-                }
-                if (newReq) {
-                    self->appendLogsInternal(eb, newReq);
-                } else {
-                    self->noMoreRequestCV_.notify_all();
-                }
-                return;
+            if (req.get_last_log_id_sent() >= resp.get_last_log_id()) {
+                VLOG(1) << idStr_
+                        << "We send nothing in the last request"
+                        << ", so we don't send the same logs again";
+                followerCommittedLogId_ = resp.get_committed_log_id();
+                cpp2::AppendLogResponse r;
+                r.set_error_code(res);
+                setResponse(r);
+                return {};
             }
-            case cpp2::ErrorCode::E_WAITING_SNAPSHOT: {
-                VLOG(2) << self->idStr_
-                        << "The host is waiting for the snapshot, so we need to send log from "
-                        << " current committedLogId " << self->committedLogId_;
-                std::shared_ptr<cpp2::AppendLogRequest> newReq;
-                {
-                    std::lock_guard<std::mutex> g(self->lock_);
-                    auto res = self->checkStatus();
-                    if (res != cpp2::ErrorCode::SUCCEEDED) {
-                        VLOG(2) << self->idStr_
-                                << "The host is not in a proper status,"
-                                   " skip waiting the snapshot";
-                        cpp2::AppendLogResponse r;
-                        r.set_error_code(res);
-                        self->setResponse(r);
-                    } else {
-                        self->lastLogIdSent_ = self->committedLogId_;
-                        self->lastLogTermSent_ = self->logTermToSend_;
-                        self->followerCommittedLogId_ = resp.get_committed_log_id();
-                        newReq = self->prepareAppendLogRequest();
-                    }
-                }
-                if (newReq) {
-                    self->appendLogsInternal(eb, newReq);
-                } else {
-                    self->noMoreRequestCV_.notify_all();
-                }
-                return;
+            followerCommittedLogId_ = resp.get_committed_log_id();
+            if (probing_) {
+                // The follower has caught up, go on from its last log,
+                // and the following requests could be pipelined.
+                lastLogIdSent_ = resp.get_last_log_id();
+                lastLogTermSent_ = resp.get_last_log_term();
+                probing_ = false;
             }
-            case cpp2::ErrorCode::E_LOG_STALE: {
-                VLOG(2) << self->idStr_ << "Log stale, reset lastLogIdSent " << self->lastLogIdSent_
-                        << " to the followers lastLodId " << resp.get_last_log_id();
-                std::shared_ptr<cpp2::AppendLogRequest> newReq;
-                {
-                    std::lock_guard<std::mutex> g(self->lock_);
-                    auto res = self->checkStatus();
-                    if (res != cpp2::ErrorCode::SUCCEEDED) {
-                        VLOG(2) << self->idStr_
-                                << "The host is not in a proper status,"
-                                   " skip waiting the snapshot";
-                        cpp2::AppendLogResponse r;
-                        r.set_error_code(res);
-                        self->setResponse(r);
-                    } else if (self->logIdToSend_ <= resp.get_last_log_id()) {
-                        VLOG(1) << self->idStr_
-                                << "It means the request has been received by follower";
-                        self->lastLogIdSent_ = self->logIdToSend_ - 1;
-                        self->lastLogTermSent_ = resp.get_last_log_term();
-                        self->followerCommittedLogId_ = resp.get_committed_log_id();
-                        cpp2::AppendLogResponse r;
-                        r.set_error_code(cpp2::ErrorCode::SUCCEEDED);
-                        self->setResponse(r);
-                    } else {
-                        self->lastLogIdSent_ = std::min(resp.get_last_log_id(),
-                                                        self->logIdToSend_ - 1);
-                        self->lastLogTermSent_ = resp.get_last_log_term();
-                        self->followerCommittedLogId_ = resp.get_committed_log_id();
-                        newReq = self->prepareAppendLogRequest();
-                    }
-                }
-                if (newReq) {
-                    self->appendLogsInternal(eb, newReq);
-                } else {
-                    self->noMoreRequestCV_.notify_all();
-                }
-                return;
+            VLOG(2) << idStr_ << "Fulfill the promises up to " << resp.get_last_log_id();
+            onAccepted(resp.get_last_log_id(), resp);
+            if (lastLogIdSent_ < logIdToSend_) {
+                VLOG(2) << idStr_ << "There are more logs to send";
             }
-            default: {
-                PLOG_EVERY_N(ERROR, 100)
-                           << self->idStr_
-                           << "Failed to append logs to the host (Err: "
-                           << static_cast<int32_t>(resp.get_error_code())
-                           << ")";
-                {
-                    std::lock_guard<std::mutex> g(self->lock_);
-                    self->setResponse(resp);
-                    self->lastLogIdSent_ = self->logIdToSend_ - 1;
-                }
-                self->noMoreRequestCV_.notify_all();
-                return;
+            return prepareAppendLogRequests();
+        }
+        case cpp2::ErrorCode::E_LOG_GAP: {
+            VLOG(2) << idStr_
+                    << "The host's log is behind, need to catch up";
+            auto res = checkStatus();
+            if (res != cpp2::ErrorCode::SUCCEEDED) {
+                VLOG(2) << idStr_
+                        << "The host is not in a proper status,"
+                           " skip catching up the gap";
+                cpp2::AppendLogResponse r;
+                r.set_error_code(res);
+                setResponse(r);
+                newRound();
+                return {};
             }
+            if (req.get_last_log_id_sent() == resp.get_last_log_id()) {
+                VLOG(1) << idStr_
+                        << "We send nothing in the last request"
+                        << ", so we don't send the same logs again";
+                lastLogIdSent_ = resp.get_last_log_id();
+                lastLogTermSent_ = resp.get_last_log_term();
+                followerCommittedLogId_ = resp.get_committed_log_id();
+                cpp2::AppendLogResponse r;
+                r.set_error_code(cpp2::ErrorCode::SUCCEEDED);
+                setResponse(r);
+                return {};
+            }
+            // The requests might arrive out of order as well, anyway,
+            // send the logs again from where the follower asks for.
+            lastLogIdSent_ = std::min(resp.get_last_log_id(), logIdToSend_ - 1);
+            lastLogTermSent_ = resp.get_last_log_term();
+            followerCommittedLogId_ = resp.get_committed_log_id();
+            newRound();
+            return prepareAppendLogRequests();
         }
-    });
+        case cpp2::ErrorCode::E_WAITING_SNAPSHOT: {
+            VLOG(2) << idStr_
+                    << "The host is waiting for the snapshot, so we need to send log from "
+                    << " current committedLogId " << committedLogId_;
+            auto res = checkStatus();
+            if (res != cpp2::ErrorCode::SUCCEEDED) {
+                VLOG(2) << idStr_
+                        << "The host is not in a proper status,"
+                           " skip waiting the snapshot";
+                cpp2::AppendLogResponse r;
+                r.set_error_code(res);
+                setResponse(r);
+                newRound();
+                return {};
+            }
+            lastLogIdSent_ = committedLogId_;
+            lastLogTermSent_ = logTermToSend_;
+            followerCommittedLogId_ = resp.get_committed_log_id();
+            newRound();
+            return prepareAppendLogRequests();
+        }
+        case cpp2::ErrorCode::E_LOG_STALE: {
+            VLOG(2) << idStr_ << "Log stale, reset lastLogIdSent " << lastLogIdSent_
+                    << " to the followers lastLodId " << resp.get_last_log_id();
+            auto res = checkStatus();
+            if (res != cpp2::ErrorCode::SUCCEEDED) {
+                VLOG(2) << idStr_
+                        << "The host is not in a proper status,"
+                           " skip waiting the snapshot";
+                cpp2::AppendLogResponse r;
+                r.set_error_code(res);
+                setResponse(r);
+                newRound();
+                return {};
+            }
+            if (logIdToSend_ <= resp.get_last_log_id()) {
+                VLOG(1) << idStr_
+                        << "It means the request has been received by follower";
+                lastLogIdSent_ = logIdToSend_ - 1;
+                lastLogTermSent_ = resp.get_last_log_term();
+                followerCommittedLogId_ = resp.get_committed_log_id();
+                cpp2::AppendLogResponse r;
+                r.set_error_code(cpp2::ErrorCode::SUCCEEDED);
+                setResponse(r);
+                newRound();
+                return {};
+            }
+            lastLogIdSent_ = std::min(resp.get_last_log_id(), logIdToSend_ - 1);
+            lastLogTermSent_ = resp.get_last_log_term();
+            followerCommittedLogId_ = resp.get_committed_log_id();
+            newRound();
+            return prepareAppendLogRequests();
+        }
+        default: {
+            PLOG_EVERY_N(ERROR, 100)
+                       << idStr_
+                       << "Failed to append logs to the host (Err: "
+                       << static_cast<int32_t>(resp.get_error_code())
+                       << ")";
+            setResponse(resp);
+            lastLogIdSent_ = logIdToSend_ - 1;
+            newRound();
+            return {};
+        }
+    }
+}
+
+
+std::vector<std::shared_ptr<cpp2::AppendLogRequest>> Host::prepareAppendLogRequests() {
+    CHECK(!lock_.try_lock());
+    std::vector<std::shared_ptr<cpp2::AppendLogRequest>> reqs;
+    size_t window = probing_ ? 1 : std::max(FLAGS_max_inflight_appendlog_batches, 1U);
+    while (inflight_ < window && lastLogIdSent_ < logIdToSend_) {
+        auto req = prepareAppendLogRequest();
+        ++inflight_;
+        ++requestsOnGoing_;
+        reqs.emplace_back(req);
+        auto numLogs = req->get_log_str_list().size();
+        if (numLogs == 0) {
+            // Nothing could be sent for now, wait for the response
+            break;
+        }
+        lastLogIdSent_ += numLogs;
+        lastLogTermSent_ = req->get_log_term();
+    }
+    return reqs;
 }
 
 
@@ -501,12 +533,6 @@ folly::Future<cpp2::AppendLogResponse> Host::sendAppendLogRequest(
     return client->future_appendLog(*req);
 }
 
-bool Host::noRequest() const {
-    CHECK(!lock_.try_lock());
-    static auto emptyTup = std::make_tuple(0, 0, 0);
-    return pendingReq_ == emptyTup;
-}
-
 }  // namespace raftex
 }  // namespace nebula
 
@@ -89,12 +89,37 @@ private:
 
     void appendLogsInternal(
         folly::EventBase* eb,
-        std::shared_ptr<cpp2::AppendLogRequest> req);
+        std::shared_ptr<cpp2::AppendLogRequest> req,
+        uint64_t round);
+
+    /**
+     * Handle the response of one request, and return the requests to send next.
+     * */
+    std::vector<std::shared_ptr<cpp2::AppendLogRequest>> processAppendLogResponse(
+        const cpp2::AppendLogRequest& req,
+        uint64_t round,
+        folly::Try<cpp2::AppendLogResponse>&& t);
 
     std::shared_ptr<cpp2::AppendLogRequest> prepareAppendLogRequest();
 
-    bool noRequest() const;
+    /**
+     * Prepare the requests for the logs not sent yet, as many as the window allows.
+     * The logs are assumed to be accepted by the follower once they are sent, so the
+     * next request goes on from the last log in the previous one.
+     * */
+    std::vector<std::shared_ptr<cpp2::AppendLogRequest>> prepareAppendLogRequests();
+
+    /**
+     * Start a new round, the logs not accepted have to be sent again one request
+     * at a time, from where the follower asks for. The responses of the requests
+     * sent in the previous rounds only tell which logs are accepted.
+     * */
+    void newRound();
+
+    // The follower has accepted the logs up to logId
+    void onAccepted(LogID logId, const cpp2::AppendLogResponse& r);
 
+    // Fulfill all the promises
     void setResponse(const cpp2::AppendLogResponse& r);
 
     thrift::ThriftClientManager<cpp2::RaftexServiceAsyncClient>& tcManager() {
@@ -103,9 +128,6 @@ private:
     }
 
 private:
-    // <term, logId, committedLogId>
-    using Request = std::tuple<TermID, LogID, LogID>;
-
     std::shared_ptr<RaftPart> part_;
     const HostAddr addr_;
     bool isLearner_ = false;
@@ -116,21 +138,31 @@ private:
     bool paused_{false};
     bool stopped_{false};
 
-    bool requestOnGoing_{false};
+    // The requests not responded yet, including the ones of the previous rounds
+    size_t requestsOnGoing_{0};
     std::condition_variable noMoreRequestCV_;
-    folly::SharedPromise<cpp2::AppendLogResponse> promise_;
-    folly::SharedPromise<cpp2::AppendLogResponse> cachingPromise_;
 
-    Request pendingReq_{0, 0, 0};
+    // The requests sent in the current round and not responded yet
+    size_t inflight_{0};
+    uint64_t round_{0};
+    // Only one request is in flight until the follower accepts the logs,
+    // then up to FLAGS_max_inflight_appendlog_batches requests
+    bool probing_{true};
+
+    // The last log id => the promise fulfilled when the follower accepts it
+    std::map<LogID, folly::SharedPromise<cpp2::AppendLogResponse>> promises_;
 
     // These logId and term pointing to the latest log we need to send
     LogID logIdToSend_{0};
     TermID logTermToSend_{0};
 
-    // The previous log before this batch
+    // The last log sent, the next request goes on from it
     LogID lastLogIdSent_{0};
     TermID lastLogTermSent_{0};
 
+    // The last log accepted by the follower in the current term
+    LogID lastLogIdAccepted_{0};
+
     LogID committedLogId_{0};
     std::atomic_bool sendingSnapshot_{false};
 
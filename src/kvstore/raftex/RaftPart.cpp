@@ -9,6 +9,7 @@
 #include <folly/io/async/EventBaseManager.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include <folly/gen/Base.h>
+#include <folly/ScopeGuard.h>
 #include "gen-cpp2/RaftexServiceAsyncClient.h"
 #include "base/CollectNSucceeded.h"
 #include "thrift/ThriftClientManager.h"
@@ -27,12 +28,18 @@ DEFINE_uint32(raft_heartbeat_interval_secs, 5,
 DEFINE_uint64(raft_snapshot_timeout, 60 * 5, "Max seconds between two snapshot requests");
 
 DEFINE_uint32(max_batch_size, 256, "The max number of logs in a batch");
+DEFINE_uint32(max_inflight_appendlog_batches, 1,
+              "The max number of log batches being replicated at the same time in one part, "
+              "which is also the max number of appendLog requests in flight to one peer, "
+              "1 means the batches are replicated one by one");
 
 DEFINE_int32(wal_ttl, 14400, "Default wal ttl");
 DEFINE_int64(wal_file_size, 16 * 1024 * 1024, "Default wal file size");
 DEFINE_int32(wal_buffer_size, 8 * 1024 * 1024, "Default wal buffer size");
 DEFINE_int32(wal_buffer_num, 2, "Default wal buffer number");
 DEFINE_bool(wal_sync, false, "Whether fsync needs to be called every write");
+DEFINE_bool(wal_group_sync, false, "Whether the wals on the same disk are synced together "
+                                   "in a shared thread, only works when wal_sync is on");
 DEFINE_bool(trace_raft, false, "Enable trace one raft request");
 
 namespace nebula {
@@ -82,6 +89,12 @@ public:
         return firstLogId_;
     }
 
+    // The ids are decided when the logs are written into the wal,
+    // since the batches ahead might be still being replicated
+    void setFirstLogId(LogID firstLogId) {
+        firstLogId_ = logId_ = firstLogId;
+    }
+
     // Return true if the current log is a AtomicOp, otherwise return false
     bool processAtomicOp() {
         while (idx_ < logs_.size()) {
@@ -227,6 +240,7 @@ RaftPart::RaftPart(ClusterID clusterId,
     policy.bufferSize = FLAGS_wal_buffer_size;
     policy.numBuffers = FLAGS_wal_buffer_num;
     policy.sync = FLAGS_wal_sync;
+    policy.groupSync = FLAGS_wal_group_sync;
     wal_ = FileBasedWal::getWal(walRoot,
                                 idStr_,
                                 policy,
@@ -289,6 +303,11 @@ void RaftPart::start(std::vector<HostAddr>&& peers, bool asLearner) {
         lastLogId_ = committedLogId_;
         lastLogTerm_ = term_;
         wal_->reset();
+    } else if (lastLogId_ > committedLogId_) {
+        // The logs might have been committed but not persisted in the engine,
+        // they are committed again when the commit log id is known from the leader
+        LOG(INFO) << idStr_ << "The logs in (" << committedLogId_ << ", " << lastLogId_
+                  << "] would be committed again";
     }
     LOG(INFO) << idStr_ << "There are "
                         << peers.size()
@@ -565,9 +584,11 @@ folly::Future<AppendLogResult> RaftPart::appendLogAsync(ClusterID source,
         PLOG_EVERY_N(WARNING, 30) << idStr_
                      << "The appendLog buffer is full."
                         " Please slow down the log appending rate."
-                     << "replicatingLogs_ :" << replicatingLogs_;
+                     << "replicatingBatches_ :" << replicatingBatches_;
         return AppendLogResult::E_BUFFER_OVERFLOW;
     }
+    std::shared_ptr<PromiseSet<AppendLogResult>> promise;
+    uint64_t seq = 0;
     {
         std::lock_guard<std::mutex> lck(logsLock_);
 
@@ -578,7 +599,7 @@ folly::Future<AppendLogResult> RaftPart::appendLogAsync(ClusterID source,
             LOG(WARNING) << idStr_
                          << "The appendLog buffer is full."
                             " Please slow down the log appending rate."
-                         << "replicatingLogs_ :" << replicatingLogs_;
+                         << "replicatingBatches_ :" << replicatingBatches_;
             bufferOverFlow_ = true;
             return AppendLogResult::E_BUFFER_OVERFLOW;
         }
@@ -591,23 +612,28 @@ folly::Future<AppendLogResult> RaftPart::appendLogAsync(ClusterID source,
         switch (logType) {
             case LogType::ATOMIC_OP:
                 retFuture = cachingPromise_.getSingleFuture();
+                exclusiveLogsCached_ = true;
                 break;
             case LogType::COMMAND:
                 retFuture = cachingPromise_.getAndRollSharedFuture();
+                exclusiveLogsCached_ = true;
                 break;
             case LogType::NORMAL:
                 retFuture = cachingPromise_.getSharedFuture();
                 break;
         }
 
-        bool expected = false;
-        if (replicatingLogs_.compare_exchange_strong(expected, true)) {
+        if (canReplicateMore()) {
             // We need to send logs to all followers
             VLOG(2) << idStr_ << "Preparing to send AppendLog request";
-            sendingPromise_ = std::move(cachingPromise_);
+            ++replicatingBatches_;
+            replicatingExclusive_ = replicatingExclusive_ || exclusiveLogsCached_;
+            exclusiveLogsCached_ = false;
+            promise = std::make_shared<PromiseSet<AppendLogResult>>(std::move(cachingPromise_));
             cachingPromise_.reset();
             std::swap(swappedOutLogs, logs_);
             bufferOverFlow_ = false;
+            seq = nextBatchSeq_++;
         } else {
             VLOG(2) << idStr_
                     << "Another AppendLogs request is ongoing,"
@@ -620,15 +646,17 @@ folly::Future<AppendLogResult> RaftPart::appendLogAsync(ClusterID source,
     TermID termId = 0;
     AppendLogResult res;
     {
-        std::lock_guard<std::mutex> g(raftLock_);
+        std::unique_lock<std::mutex> g(raftLock_);
         res = canAppendLogs();
         if (res == AppendLogResult::SUCCEEDED) {
             firstId = lastLogId_ + 1;
             termId = term_;
+        } else {
+            skipWalTurn(seq);
         }
     }
 
-    if (!checkAppendLogResult(res)) {
+    if (!checkAppendLogResult(res, *promise)) {
         // Mosy likely failed because the parttion is not leader
         PLOG_EVERY_N(ERROR, 100) << idStr_ << "Cannot append logs, clean the buffer";
         return res;
@@ -642,21 +670,64 @@ folly::Future<AppendLogResult> RaftPart::appendLogAsync(ClusterID source,
         firstId,
         termId,
         std::move(swappedOutLogs),
-        [this] (AtomicOp opCB) -> folly::Optional<std::string> {
+        [promise] (AtomicOp opCB) -> folly::Optional<std::string> {
             CHECK(opCB != nullptr);
             auto opRet = opCB();
             if (!opRet.hasValue()) {
                 // Failed
-                sendingPromise_.setOneSingleValue(AppendLogResult::E_ATOMIC_OP_FAILURE);
+                promise->setOneSingleValue(AppendLogResult::E_ATOMIC_OP_FAILURE);
             }
             return opRet;
         });
-    appendLogsInternal(std::move(it), termId);
+    appendLogsInternal(std::move(it), termId, std::move(promise), seq);
 
     return retFuture;
 }
 
-void RaftPart::appendLogsInternal(AppendLogsIterator iter, TermID termId) {
+void RaftPart::finishWalTurn() {
+    ++walBatchSeq_;
+    auto it = pendingWalTurns_.find(walBatchSeq_);
+    while (it != pendingWalTurns_.end() && !it->second) {
+        // The batch has been given up, hand the turn over to the next one
+        pendingWalTurns_.erase(it);
+        it = pendingWalTurns_.find(++walBatchSeq_);
+    }
+    if (it != pendingWalTurns_.end()) {
+        executor_->add(std::move(it->second));
+        pendingWalTurns_.erase(it);
+    }
+}
+
+void RaftPart::skipWalTurn(uint64_t seq) {
+    if (walBatchSeq_ == seq) {
+        finishWalTurn();
+    } else {
+        pendingWalTurns_.emplace(seq, nullptr);
+    }
+}
+
+bool RaftPart::canReplicateMore() const {
+    if (replicatingBatches_ == 0) {
+        return true;
+    }
+    // The atomic ops and commands have to see all the logs before them committed
+    return !replicatingExclusive_
+        && !exclusiveLogsCached_
+        && replicatingBatches_ < FLAGS_max_inflight_appendlog_batches;
+}
+
+void RaftPart::finishReplicating() {
+    std::lock_guard<std::mutex> lck(logsLock_);
+    CHECK_GT(replicatingBatches_.load(), 0);
+    if (--replicatingBatches_ == 0) {
+        replicatingExclusive_ = false;
+    }
+}
+
+void RaftPart::appendLogsInternal(AppendLogsIterator iter,
+                                  TermID termId,
+                                  std::shared_ptr<PromiseSet<AppendLogResult>> promise,
+                                  uint64_t seq) {
     TermID currTerm = 0;
     LogID prevLogId = 0;
     TermID prevLogTerm = 0;
@@ -668,12 +739,36 @@ void RaftPart::appendLogsInternal(AppendLogsIterator iter, TermID termId) {
                 << currTerm << ")";
     } else {
         LOG(ERROR) << idStr_ << "Only happend when Atomic op failed";
-        replicatingLogs_ = false;
+        {
+            std::lock_guard<std::mutex> g(raftLock_);
+            skipWalTurn(seq);
+        }
+        finishReplicating();
         return;
     }
     AppendLogResult res = AppendLogResult::SUCCEEDED;
     do {
         std::lock_guard<std::mutex> g(raftLock_);
+        // Write the batches in the order they are taken from the buffer
+        if (walBatchSeq_ != seq) {
+            // Park the batch until the ones ahead are written, we could be
+            // on an IO thread processing the responses, so don't wait here
+            VLOG(2) << idStr_ << "The batch " << seq << " waits for the batch "
+                    << walBatchSeq_ << " to be written";
+            pendingWalTurns_.emplace(
+                seq,
+                [self = shared_from_this(),
+                 it = std::move(iter),
+                 termId,
+                 promise = std::move(promise),
+                 seq] () mutable {
+                    self->appendLogsInternal(std::move(it), termId, std::move(promise), seq);
+                });
+            return;
+        }
+        SCOPE_EXIT {
+            finishWalTurn();
+        };
         if (status_ != Status::RUNNING) {
             // The partition is not running
             VLOG(2) << idStr_ << "The partition is stopped";
@@ -696,6 +791,12 @@ void RaftPart::appendLogsInternal(AppendLogsIterator iter, TermID termId) {
         currTerm = term_;
         prevLogId = lastLogId_;
         prevLogTerm = lastLogTerm_;
+        if (replicatingBatches_ > 1 && wal_->lastLogId() > lastLogId_) {
+            // The batches ahead have not been committed yet, go on from them
+            prevLogId = wal_->lastLogId();
+            prevLogTerm = wal_->lastLogTerm();
+        }
+        iter.setFirstLogId(prevLogId + 1);
         committed = committedLogId_;
         // Step 1: Write WAL
         SlowOpTracker tracker;
@@ -713,7 +814,7 @@ void RaftPart::appendLogsInternal(AppendLogsIterator iter, TermID termId) {
                 << iter.firstLogId() << ", " << lastId << "] to WAL";
     } while (false);
 
-    if (!checkAppendLogResult(res)) {
+    if (!checkAppendLogResult(res, *promise)) {
         LOG(ERROR) << idStr_ << "Failed append logs";
         return;
     }
@@ -725,7 +826,8 @@ void RaftPart::appendLogsInternal(AppendLogsIterator iter, TermID termId) {
                   lastId,
                   committed,
                   prevLogTerm,
-                  prevLogId);
+                  prevLogId,
+                  std::move(promise));
     return;
 }
 
@@ -736,7 +838,8 @@ void RaftPart::replicateLogs(folly::EventBase* eb,
                              LogID lastLogId,
                              LogID committedId,
                              TermID prevLogTerm,
-                             LogID prevLogId) {
+                             LogID prevLogId,
+                             std::shared_ptr<PromiseSet<AppendLogResult>> promise) {
     using namespace folly;  // NOLINT since the fancy overload of | operator
 
     decltype(hosts_) hosts;
@@ -761,7 +864,7 @@ void RaftPart::replicateLogs(folly::EventBase* eb,
         hosts = hosts_;
     } while (false);
 
-    if (!checkAppendLogResult(res)) {
+    if (!checkAppendLogResult(res, *promise)) {
         LOG(ERROR) << idStr_ << "Replicate logs failed";
         return;
     }
@@ -809,6 +912,7 @@ void RaftPart::replicateLogs(folly::EventBase* eb,
                    prevLogId,
                    prevLogTerm,
                    pHosts = std::move(hosts),
+                   promise = std::move(promise),
                    tracker] (folly::Try<AppendLogResponses>&& result) mutable {
             VLOG(2) << self->idStr_ << "Received enough response";
             CHECK(!result.hasException());
@@ -824,7 +928,8 @@ void RaftPart::replicateLogs(folly::EventBase* eb,
                                             committedId,
                                             prevLogTerm,
                                             prevLogId,
-                                            std::move(pHosts));
+                                            std::move(pHosts),
+                                            std::move(promise));
 
             return *result;
         });
@@ -840,7 +945,8 @@ void RaftPart::processAppendLogResponses(
         LogID committedId,
         TermID prevLogTerm,
         LogID prevLogId,
-        std::vector<std::shared_ptr<Host>> hosts) {
+        std::vector<std::shared_ptr<Host>> hosts,
+        std::shared_ptr<PromiseSet<AppendLogResult>> promise) {
     // Make sure majority have succeeded
     size_t numSucceeded = 0;
     for (auto& res : resps) {
@@ -874,63 +980,78 @@ void RaftPart::processAppendLogResponses(
                 res = AppendLogResult::E_TERM_OUT_OF_DATE;
                 break;
             }
-            lastLogId_ = lastLogId;
-            lastLogTerm_ = currTerm;
-
-            auto walIt = wal_->iterator(committedId + 1, lastLogId);
-            SlowOpTracker tracker;
-            // Step 3: Commit the batch
-            if (commitLogs(std::move(walIt))) {
-                committedLogId_ = lastLogId;
-                firstLogId = lastLogId_ + 1;
+            if (lastLogId <= committedLogId_) {
+                // The batches behind this one have been accepted by the majority
+                // first, and this batch has been committed along with them
+                VLOG(2) << idStr_ << "The logs to " << lastLogId << " have been committed";
             } else {
-                LOG(FATAL) << idStr_ << "Failed to commit logs";
-            }
-            if (tracker.slow()) {
-                tracker.output(idStr_, folly::stringPrintf("Total commit: %ld",
-                                                           committedLogId_ - committedId));
+                lastLogId_ = lastLogId;
+                lastLogTerm_ = currTerm;
+
+                auto firstCommitId = committedLogId_ + 1;
+                auto walIt = wal_->iterator(firstCommitId, lastLogId);
+                SlowOpTracker tracker;
+                // Step 3: Commit the batch
+                if (commitLogs(std::move(walIt))) {
+                    committedLogId_ = lastLogId;
+                } else {
+                    LOG(FATAL) << idStr_ << "Failed to commit logs";
+                }
+                if (tracker.slow()) {
+                    tracker.output(idStr_,
+                                   folly::stringPrintf("Total commit: %ld",
+                                                       committedLogId_ - firstCommitId + 1));
+                }
+                VLOG(2) << idStr_ << "Leader succeeded in committing the logs "
+                                  << firstCommitId << " to " << lastLogId;
             }
-            VLOG(2) << idStr_ << "Leader succeeded in committing the logs "
-                              << committedId + 1 << " to " << lastLogId;
+            firstLogId = lastLogId_ + 1;
 
             lastMsgAcceptedCostMs_ = lastMsgSentDur_.elapsedInMSec();
             lastMsgAcceptedTime_ = time::WallClock::fastNowInMilliSec();
         } while (false);
 
-        if (!checkAppendLogResult(res)) {
+        if (!checkAppendLogResult(res, *promise)) {
             LOG(ERROR) << idStr_ << "processAppendLogResponses failed!";
             return;
         }
         // Step 4: Fulfill the promise
         if (iter.hasNonAtomicOpLogs()) {
-            sendingPromise_.setOneSharedValue(AppendLogResult::SUCCEEDED);
+            promise->setOneSharedValue(AppendLogResult::SUCCEEDED);
         }
         if (iter.leadByAtomicOp()) {
-            sendingPromise_.setOneSingleValue(AppendLogResult::SUCCEEDED);
+            promise->setOneSingleValue(AppendLogResult::SUCCEEDED);
         }
         // Step 5: Check whether need to continue
         // the log replication
+        uint64_t seq = 0;
         {
             std::lock_guard<std::mutex> lck(logsLock_);
-            CHECK(replicatingLogs_);
+            CHECK_GT(replicatingBatches_.load(), 0);
             // Continue to process the original AppendLogsIterator if necessary
             iter.resume();
             // If no more valid logs to be replicated in iter, create a new one if we have new log
             if (iter.empty()) {
                 VLOG(2) << idStr_ << "logs size " << logs_.size();
-                if (logs_.size() > 0) {
+                // The atomic ops and commands have to wait for the other batches
+                if (logs_.size() > 0 && (!exclusiveLogsCached_ || replicatingBatches_ == 1)) {
                     // continue to replicate the logs
-                    sendingPromise_ = std::move(cachingPromise_);
+                    if (replicatingBatches_ == 1) {
+                        replicatingExclusive_ = exclusiveLogsCached_;
+                    }
+                    exclusiveLogsCached_ = false;
+                    promise = std::make_shared<PromiseSet<AppendLogResult>>(
+                        std::move(cachingPromise_));
                     cachingPromise_.reset();
                     iter = AppendLogsIterator(
                         firstLogId,
                         currTerm,
                         std::move(logs_),
-                        [this] (AtomicOp op) -> folly::Optional<std::string> {
+                        [promise] (AtomicOp op) -> folly::Optional<std::string> {
                             auto opRet = op();
                             if (!opRet.hasValue()) {
                                 // Failed
-                                sendingPromise_.setOneSingleValue(
+                                promise->setOneSingleValue(
                                     AppendLogResult::E_ATOMIC_OP_FAILURE);
                             }
                             return opRet;
@@ -938,18 +1059,22 @@ void RaftPart::processAppendLogResponses(
                     logs_.clear();
                     bufferOverFlow_ = false;
                 }
-                // Reset replicatingLogs_ one of the following is true:
+                // Finish the batch if one of the following is true:
                 // 1. old iter is empty && logs_.size() == 0
                 // 2. old iter is empty && logs_.size() > 0, but all logs in new iter is atomic op,
                 //    and all of them failed, which would make iter is empty again
+                // 3. old iter is empty && logs_ has to wait for the other batches
                 if (iter.empty()) {
-                    replicatingLogs_ = false;
+                    if (--replicatingBatches_ == 0) {
+                        replicatingExclusive_ = false;
+                    }
                     VLOG(2) << idStr_ << "No more log to be replicated";
                     return;
                 }
             }
+            seq = nextBatchSeq_++;
         }
-        this->appendLogsInternal(std::move(iter), currTerm);
+        this->appendLogsInternal(std::move(iter), currTerm, std::move(promise), seq);
     } else {
         // Not enough hosts accepted the log, re-try
         LOG(WARNING) << idStr_ << "Only " << numSucceeded
@@ -960,7 +1085,8 @@ void RaftPart::processAppendLogResponses(
                       lastLogId,
                       committedId,
                       prevLogTerm,
-                      prevLogId);
+                      prevLogId,
+                      std::move(promise));
     }
 }
 
@@ -1747,11 +1873,21 @@ void RaftPart::processSendSnapshotRequest(const cpp2::SendSnapshotRequest& req,
         status_ = Status::WAITING_SNAPSHOT;
     }
     lastSnapshotRecvDur_.reset();
-    // TODO(heng): Maybe we should save them into one sst firstly?
-    auto ret = commitSnapshot(req.get_rows(),
-                              req.get_committed_log_id(),
-                              req.get_committed_log_term(),
-                              req.get_done());
+    // The last request of the snapshot is always sent in rows, which carries
+    // the committed log id
+    std::pair<int64_t, int64_t> ret;
+    if (req.get_file() != nullptr) {
+        auto code = commitSnapshotFile(*req.get_file(), &ret);
+        if (code != cpp2::ErrorCode::SUCCEEDED) {
+            resp.set_error_code(code);
+            return;
+        }
+    } else {
+        ret = commitSnapshot(req.get_rows(),
+                             req.get_committed_log_id(),
+                             req.get_committed_log_term(),
+                             req.get_done());
+    }
     lastTotalCount_ += ret.first;
     lastTotalSize_ += ret.second;
     if (lastTotalCount_ != req.get_total_count()
@@ -1798,7 +1934,7 @@ std::vector<std::shared_ptr<Host>> RaftPart::followers() const {
     return hosts;
 }
 
-bool RaftPart::checkAppendLogResult(AppendLogResult res) {
+bool RaftPart::checkAppendLogResult(AppendLogResult res, PromiseSet<AppendLogResult>& promise) {
     if (res != AppendLogResult::SUCCEEDED) {
         {
             std::lock_guard<std::mutex> lck(logsLock_);
@@ -1806,9 +1942,10 @@ bool RaftPart::checkAppendLogResult(AppendLogResult res) {
             cachingPromise_.setValue(res);
             cachingPromise_.reset();
             bufferOverFlow_ = false;
+            exclusiveLogsCached_ = false;
         }
-        sendingPromise_.setValue(res);
-        replicatingLogs_ = false;
+        finishReplicating();
+        promise.setValue(res);
         return false;;
     }
     return true;
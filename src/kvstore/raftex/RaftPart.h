@@ -261,6 +261,17 @@ protected:
                                                        TermID committedLogTerm,
                                                        bool finished) = 0;
 
+    // Save a chunk of the sst file in the snapshot, the file is ingested once
+    // its last chunk is received. The <count, size> of the rows ingested is returned
+    // in rows, E_SNAPSHOT_FILE_FAILED is returned if the chunk could not be saved.
+    virtual cpp2::ErrorCode commitSnapshotFile(const cpp2::SnapshotFile& file,
+                                               std::pair<int64_t, int64_t>* rows) {
+        UNUSED(rows);
+        LOG(ERROR) << idStr_ << "The snapshot in sst files is not supported, file "
+                   << file.get_name();
+        return cpp2::ErrorCode::E_SNAPSHOT_FILE_FAILED;
+    }
+
     // Clean up all data about current part in storage.
     virtual void cleanup() = 0;
 
@@ -304,6 +315,83 @@ private:
                    AtomicOp>>;
 
 
+    template<class ValueType>
+    class PromiseSet final {
+    public:
+        PromiseSet() = default;
+        PromiseSet(const PromiseSet&) = delete;
+        PromiseSet(PromiseSet&&) = default;
+
+        ~PromiseSet()  = default;
+
+        PromiseSet& operator=(const PromiseSet&) = delete;
+        PromiseSet& operator=(PromiseSet&& right) = default;
+
+        void reset() {
+            sharedPromises_.clear();
+            singlePromises_.clear();
+            rollSharedPromise_ = true;
+        }
+
+        folly::Future<ValueType> getSharedFuture() {
+            if (rollSharedPromise_) {
+                sharedPromises_.emplace_back();
+                rollSharedPromise_ = false;
+            }
+
+            return sharedPromises_.back().getFuture();
+        }
+
+        folly::Future<ValueType> getSingleFuture() {
+            singlePromises_.emplace_back();
+            rollSharedPromise_ = true;
+
+            return singlePromises_.back().getFuture();
+        }
+
+        folly::Future<ValueType> getAndRollSharedFuture() {
+            if (rollSharedPromise_) {
+                sharedPromises_.emplace_back();
+            }
+            rollSharedPromise_ = true;
+            return sharedPromises_.back().getFuture();
+        }
+
+        template<class VT>
+        void setOneSharedValue(VT&& val) {
+            CHECK(!sharedPromises_.empty());
+            sharedPromises_.front().setValue(std::forward<VT>(val));
+            sharedPromises_.pop_front();
+        }
+
+        template<class VT>
+        void setOneSingleValue(VT&& val) {
+            CHECK(!singlePromises_.empty());
+            singlePromises_.front().setValue(std::forward<VT>(val));
+            singlePromises_.pop_front();
+        }
+
+        void setValue(ValueType val) {
+            for (auto& p : sharedPromises_) {
+                p.setValue(val);
+            }
+            for (auto& p : singlePromises_) {
+                p.setValue(val);
+            }
+        }
+
+
+    private:
+        // Whether the last future was returned from a shared promise
+        bool rollSharedPromise_{true};
+
+        // Promises shared by continuous non atomic op logs
+        std::list<folly::SharedPromise<ValueType>> sharedPromises_;
+        // A list of promises for atomic op logs
+        std::list<folly::Promise<ValueType>> singlePromises_;
+    };
+
+
     /****************************************************
      *
      * Private methods
@@ -359,7 +447,26 @@ private:
                                                   std::string log,
                                                   AtomicOp cb = nullptr);
 
-    void appendLogsInternal(AppendLogsIterator iter, TermID termId);
+    // Whether the logs in logs_ could be replicated as a new batch right now
+    // Pre-condition: The caller needs to hold the logsLock_
+    bool canReplicateMore() const;
+
+    // seq is the sequence of the batch taken from logs_
+    void appendLogsInternal(AppendLogsIterator iter,
+                            TermID termId,
+                            std::shared_ptr<PromiseSet<AppendLogResult>> promise,
+                            uint64_t seq);
+
+    // The batches are written into the wal in the same order as they are
+    // taken from logs_. The batch whose turn has not come is parked in
+    // pendingWalTurns_ rather than waiting, since the caller could be an IO
+    // thread, and it is run on the executor_ when the turn is handed over.
+    // Pre-condition: The caller needs to hold the raftLock_
+    void finishWalTurn();
+
+    // The batch seq is given up before being written
+    // Pre-condition: The caller needs to hold the raftLock_
+    void skipWalTurn(uint64_t seq);
 
     void replicateLogs(
         folly::EventBase* eb,
@@ -368,7 +475,8 @@ private:
         LogID lastLogId,
         LogID committedId,
         TermID prevLogTerm,
-        LogID prevLogId);
+        LogID prevLogId,
+        std::shared_ptr<PromiseSet<AppendLogResult>> promise);
 
     void processAppendLogResponses(
         const AppendLogResponses& resps,
@@ -379,92 +487,20 @@ private:
         LogID committedId,
         TermID prevLogTerm,
         LogID prevLogId,
-        std::vector<std::shared_ptr<Host>> hosts);
+        std::vector<std::shared_ptr<Host>> hosts,
+        std::shared_ptr<PromiseSet<AppendLogResult>> promise);
 
     std::vector<std::shared_ptr<Host>> followers() const;
 
-    bool checkAppendLogResult(AppendLogResult res);
+    // Fail the batch with the promise, and the logs not replicated yet
+    bool checkAppendLogResult(AppendLogResult res, PromiseSet<AppendLogResult>& promise);
+
+    // The batch has been replicated, or it has nothing to replicate
+    void finishReplicating();
 
     void updateQuorum();
 
 protected:
-    template<class ValueType>
-    class PromiseSet final {
-    public:
-        PromiseSet() = default;
-        PromiseSet(const PromiseSet&) = delete;
-        PromiseSet(PromiseSet&&) = default;
-
-        ~PromiseSet()  = default;
-
-        PromiseSet& operator=(const PromiseSet&) = delete;
-        PromiseSet& operator=(PromiseSet&& right) = default;
-
-        void reset() {
-            sharedPromises_.clear();
-            singlePromises_.clear();
-            rollSharedPromise_ = true;
-        }
-
-        folly::Future<ValueType> getSharedFuture() {
-            if (rollSharedPromise_) {
-                sharedPromises_.emplace_back();
-                rollSharedPromise_ = false;
-            }
-
-            return sharedPromises_.back().getFuture();
-        }
-
-        folly::Future<ValueType> getSingleFuture() {
-            singlePromises_.emplace_back();
-            rollSharedPromise_ = true;
-
-            return singlePromises_.back().getFuture();
-        }
-
-        folly::Future<ValueType> getAndRollSharedFuture() {
-            if (rollSharedPromise_) {
-                sharedPromises_.emplace_back();
-            }
-            rollSharedPromise_ = true;
-            return sharedPromises_.back().getFuture();
-        }
-
-        template<class VT>
-        void setOneSharedValue(VT&& val) {
-            CHECK(!sharedPromises_.empty());
-            sharedPromises_.front().setValue(std::forward<VT>(val));
-            sharedPromises_.pop_front();
-        }
-
-        template<class VT>
-        void setOneSingleValue(VT&& val) {
-            CHECK(!singlePromises_.empty());
-            singlePromises_.front().setValue(std::forward<VT>(val));
-            singlePromises_.pop_front();
-        }
-
-        void setValue(ValueType val) {
-            for (auto& p : sharedPromises_) {
-                p.setValue(val);
-            }
-            for (auto& p : singlePromises_) {
-                p.setValue(val);
-            }
-        }
-
-
-    private:
-        // Whether the last future was returned from a shared promise
-        bool rollSharedPromise_{true};
-
-        // Promises shared by continuous non atomic op logs
-        std::list<folly::SharedPromise<ValueType>> sharedPromises_;
-        // A list of promises for atomic op logs
-        std::list<folly::Promise<ValueType>> singlePromises_;
-    };
-
-
     const std::string idStr_;
 
     const ClusterID clusterId_;
@@ -476,15 +512,26 @@ protected:
 
     // The lock is used to protect logs_ and cachingPromise_
     mutable std::mutex logsLock_;
-    std::atomic_bool replicatingLogs_{false};
+    // The number of the batches being replicated, each batch holds its own
+    // promises, and at most FLAGS_max_inflight_appendlog_batches are in flight
+    std::atomic<size_t> replicatingBatches_{0};
+    // Whether the batch being replicated has atomic ops or commands, which
+    // depend on all the logs before them, so such a batch is replicated alone
+    bool replicatingExclusive_{false};
+    // Whether there are atomic ops or commands in logs_
+    bool exclusiveLogsCached_{false};
+    // The sequence of the next batch taken from logs_
+    uint64_t nextBatchSeq_{0};
     std::atomic_bool bufferOverFlow_{false};
     PromiseSet<AppendLogResult> cachingPromise_;
     LogCache logs_;
 
     // Partition level lock to synchronize the access of the partition
     mutable std::mutex raftLock_;
-
-    PromiseSet<AppendLogResult> sendingPromise_;
+    // The sequence of the next batch to write into the wal
+    uint64_t walBatchSeq_{0};
+    // The batches waiting for their turns, a null turn means the batch is given up
+    std::unordered_map<uint64_t, folly::Function<void()>> pendingWalTurns_;
 
     Status status_;
     Role role_;
@@ -40,6 +40,7 @@ folly::Future<Status> SnapshotManager::sendSnapshot(std::shared_ptr<RaftPart> pa
                                 partId,
                                 [&, this, p = std::move(p)] (
                                            const std::vector<std::string>& data,
+                                           const cpp2::SnapshotFile* file,
                                            int64_t totalCount,
                                            int64_t totalSize,
                                            SnapshotStatus status) mutable -> bool {
@@ -57,6 +58,7 @@ folly::Future<Status> SnapshotManager::sendSnapshot(std::shared_ptr<RaftPart> pa
                               commitLogIdAndTerm.second,
                               localhost,
                               data,
+                              file,
                               totalSize,
                               totalCount,
                               dst,
@@ -102,6 +104,7 @@ folly::Future<raftex::cpp2::SendSnapshotResponse> SnapshotManager::send(
                                                             TermID committedLogTerm,
                                                             const HostAddr& localhost,
                                                             const std::vector<std::string>& data,
+                                                            const cpp2::SnapshotFile* file,
                                                             int64_t totalSize,
                                                             int64_t totalCount,
                                                             const HostAddr& addr,
@@ -119,6 +122,9 @@ folly::Future<raftex::cpp2::SendSnapshotResponse> SnapshotManager::send(
     req.set_total_size(totalSize);
     req.set_total_count(totalCount);
     req.set_done(finished);
+    if (file != nullptr) {
+        req.set_file(*file);
+    }
     auto* evb = ioThreadPool_->getEventBase();
     return folly::via(evb, [this, addr, evb, req = std::move(req)] () mutable {
         auto client = connManager_.client(addr, evb, false, FLAGS_snapshot_send_timeout_ms);
@@ -26,7 +26,10 @@ enum SnapshotStatus {
     FAILED,
 };
 
+// The rows are sent either in the rows encoded, or in a chunk of an sst file
+// when the file is not null.
 using SnapshotCallback = folly::Function<bool(const std::vector<std::string>& rows,
+                                              const cpp2::SnapshotFile* file,
                                               int64_t totalCount,
                                               int64_t totalSize,
                                               SnapshotStatus status)>;
@@ -50,6 +53,7 @@ private:
                                                    TermID committedLogTerm,
                                                    const HostAddr& localhost,
                                                    const std::vector<std::string>& data,
+                                                   const cpp2::SnapshotFile* file,
                                                    int64_t totalSize,
                                                    int64_t totalCount,
                                                    const HostAddr& addr,
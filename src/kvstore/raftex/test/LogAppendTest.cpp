@@ -17,6 +17,7 @@
 
 DECLARE_uint32(raft_heartbeat_interval_secs);
 DECLARE_uint32(max_batch_size);
+DECLARE_uint32(max_inflight_appendlog_batches);
 
 namespace nebula {
 namespace raftex {
@@ -135,6 +136,274 @@ TEST(LogAppend, MultiThreadAppend) {
     finishRaft(services, copies, workers, leader);
 }
 
+TEST(LogAppend, PipelinedAppend) {
+    fs::TempDir walRoot("/tmp/pipelined_append.XXXXXX");
+    gflags::FlagSaver flagSaver;
+    FLAGS_max_inflight_appendlog_batches = 4;
+    std::shared_ptr<thread::GenericThreadPool> workers;
+    std::vector<std::string> wals;
+    std::vector<HostAddr> allHosts;
+    std::vector<std::shared_ptr<RaftexService>> services;
+    std::vector<std::shared_ptr<test::TestShard>> copies;
+
+    std::shared_ptr<test::TestShard> leader;
+    setupRaft(3, walRoot, workers, wals, allHosts, services, copies, leader);
+
+    // Check all hosts agree on the same leader
+    checkLeadership(copies, leader);
+
+    // Create 4 threads, each appends 100 logs without waiting,
+    // so several batches are replicated at the same time
+    const int numThreads = 4;
+    const int numLogs = 100;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numThreads; ++i) {
+        threads.emplace_back(std::thread([i, leader] {
+            std::vector<folly::Future<AppendLogResult>> futs;
+            for (int j = 1; j <= numLogs; ++j) {
+                futs.emplace_back(leader->appendAsync(
+                    0, folly::stringPrintf("Log %03d for t%d", j, i)));
+            }
+            for (auto& fut : futs) {
+                ASSERT_EQ(AppendLogResult::SUCCEEDED, std::move(fut).get());
+            }
+        }));
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // Sleep a while to make sure the last log has been committed on
+    // followers
+    sleep(FLAGS_raft_heartbeat_interval_secs);
+
+    for (auto& c : copies) {
+        ASSERT_EQ(numThreads * numLogs, c->getNumLogs());
+    }
+    // The logs of each thread should be in the order they are appended
+    std::vector<int> lastSeen(numThreads, 0);
+    for (int i = 0; i < numThreads * numLogs; ++i) {
+        folly::StringPiece msg;
+        ASSERT_TRUE(leader->getLogMsg(i, msg));
+        int seq = 0, t = 0;
+        ASSERT_EQ(2, sscanf(msg.str().c_str(), "Log %d for t%d", &seq, &t));
+        ASSERT_EQ(lastSeen[t] + 1, seq);
+        lastSeen[t] = seq;
+        for (auto& c : copies) {
+            if (c != leader) {
+                folly::StringPiece log;
+                ASSERT_TRUE(c->getLogMsg(i, log));
+                ASSERT_EQ(msg, log);
+            }
+        }
+    }
+
+    finishRaft(services, copies, workers, leader);
+}
+
+// Append logs in numThreads threads without waiting, the log j of the thread i
+// is an atomic op if atomicOp(j) returns 'T' (succeeded) or 'F' (failed)
+std::vector<std::thread> appendPipelinedLogs(
+        std::shared_ptr<test::TestShard> leader,
+        int numThreads,
+        int numLogs,
+        std::function<char(int)> atomicOp,
+        std::function<void(AppendLogResult, char)> check) {
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numThreads; ++i) {
+        threads.emplace_back(std::thread([=] {
+            std::vector<std::pair<folly::Future<AppendLogResult>, char>> futs;
+            for (int j = 1; j <= numLogs; ++j) {
+                auto msg = folly::stringPrintf("Log %03d for t%d", j, i);
+                auto op = atomicOp(j);
+                if (op == 0) {
+                    futs.emplace_back(leader->appendAsync(0, std::move(msg)), op);
+                } else {
+                    msg = op + msg;
+                    futs.emplace_back(leader->atomicOpAsync([msg] () {
+                        return test::compareAndSet(msg);
+                    }), op);
+                }
+            }
+            for (auto& fut : futs) {
+                check(std::move(fut.first).get(), fut.second);
+            }
+        }));
+    }
+    return threads;
+}
+
+// Check all the running copies hold the same logs as the leader, and the logs of
+// each thread are in the order they are appended. Returns the number of the logs.
+size_t checkPipelinedLogs(std::vector<std::shared_ptr<test::TestShard>>& copies,
+                          std::shared_ptr<test::TestShard> leader,
+                          int numThreads) {
+    // Sleep a while to make sure the last log has been committed on followers
+    sleep(FLAGS_raft_heartbeat_interval_secs);
+
+    size_t numLogs = leader->getNumLogs();
+    for (auto& c : copies) {
+        if (c != nullptr && c->isRunning()) {
+            EXPECT_EQ(numLogs, c->getNumLogs());
+        }
+    }
+    std::vector<int> lastSeen(numThreads, 0);
+    for (size_t i = 0; i < numLogs; ++i) {
+        folly::StringPiece msg;
+        EXPECT_TRUE(leader->getLogMsg(i, msg));
+        int seq = 0, t = 0;
+        EXPECT_EQ(2, sscanf(msg.str().c_str(), "Log %d for t%d", &seq, &t));
+        EXPECT_TRUE(t >= 0 && t < numThreads);
+        if (t < 0 || t >= numThreads) {
+            continue;
+        }
+        EXPECT_LT(lastSeen[t], seq);
+        lastSeen[t] = seq;
+        for (auto& c : copies) {
+            if (c != nullptr && c != leader && c->isRunning()) {
+                folly::StringPiece log;
+                EXPECT_TRUE(c->getLogMsg(i, log));
+                EXPECT_EQ(msg, log);
+            }
+        }
+    }
+    return numLogs;
+}
+
+TEST(LogAppend, PipelinedAppendWithAtomicOps) {
+    fs::TempDir walRoot("/tmp/pipelined_append_with_atomic_ops.XXXXXX");
+    gflags::FlagSaver flagSaver;
+    FLAGS_max_inflight_appendlog_batches = 4;
+    std::shared_ptr<thread::GenericThreadPool> workers;
+    std::vector<std::string> wals;
+    std::vector<HostAddr> allHosts;
+    std::vector<std::shared_ptr<RaftexService>> services;
+    std::vector<std::shared_ptr<test::TestShard>> copies;
+
+    std::shared_ptr<test::TestShard> leader;
+    setupRaft(3, walRoot, workers, wals, allHosts, services, copies, leader);
+    checkLeadership(copies, leader);
+
+    // Every 10th log is a valid CAS, and the 15th, 45th and 75th are invalid ones,
+    // so the exclusive batches are mixed with the batches in flight
+    const int numThreads = 4;
+    const int numLogs = 100;
+    auto threads = appendPipelinedLogs(
+        leader, numThreads, numLogs,
+        [] (int j) -> char {
+            if (j % 10 == 0) {
+                return 'T';
+            }
+            return j % 15 == 0 ? 'F' : 0;
+        },
+        [] (AppendLogResult res, char op) {
+            if (op == 'F') {
+                EXPECT_EQ(AppendLogResult::E_ATOMIC_OP_FAILURE, res);
+            } else {
+                EXPECT_EQ(AppendLogResult::SUCCEEDED, res);
+            }
+        });
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    ASSERT_EQ(numThreads * (numLogs - 3), checkPipelinedLogs(copies, leader, numThreads));
+    finishRaft(services, copies, workers, leader);
+}
+
+TEST(LogAppend, PipelinedAppendWithFollowerRestart) {
+    fs::TempDir walRoot("/tmp/pipelined_append_with_follower_restart.XXXXXX");
+    gflags::FlagSaver flagSaver;
+    FLAGS_max_inflight_appendlog_batches = 4;
+    std::shared_ptr<thread::GenericThreadPool> workers;
+    std::vector<std::string> wals;
+    std::vector<HostAddr> allHosts;
+    std::vector<std::shared_ptr<RaftexService>> services;
+    std::vector<std::shared_ptr<test::TestShard>> copies;
+
+    std::shared_ptr<test::TestShard> leader;
+    setupRaft(3, walRoot, workers, wals, allHosts, services, copies, leader);
+    checkLeadership(copies, leader);
+
+    // The quorum is kept, so all the logs should be appended
+    const int numThreads = 4;
+    const int numLogs = 500;
+    auto threads = appendPipelinedLogs(
+        leader, numThreads, numLogs,
+        [] (int) -> char { return 0; },
+        [] (AppendLogResult res, char) {
+            EXPECT_EQ(AppendLogResult::SUCCEEDED, res);
+        });
+
+    LOG(INFO) << "=====> Restart one follower with batches in flight";
+    size_t idx = (leader->index() + 1) % copies.size();
+    killOneCopy(services, copies, leader, idx);
+    usleep(100 * 1000);
+    rebootOneCopy(services, copies, allHosts, idx);
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // Append one more log to bring the restarted follower up to date
+    waitUntilAllHasLeader(copies);
+    checkLeadership(copies, leader);
+    ASSERT_EQ(AppendLogResult::SUCCEEDED,
+              leader->appendAsync(0, folly::stringPrintf("Log %03d for t0", numLogs + 1)).get());
+
+    ASSERT_EQ(numThreads * numLogs + 1, checkPipelinedLogs(copies, leader, numThreads));
+    finishRaft(services, copies, workers, leader);
+}
+
+TEST(LogAppend, PipelinedAppendWithLeaderChange) {
+    fs::TempDir walRoot("/tmp/pipelined_append_with_leader_change.XXXXXX");
+    gflags::FlagSaver flagSaver;
+    FLAGS_max_inflight_appendlog_batches = 4;
+    std::shared_ptr<thread::GenericThreadPool> workers;
+    std::vector<std::string> wals;
+    std::vector<HostAddr> allHosts;
+    std::vector<std::shared_ptr<RaftexService>> services;
+    std::vector<std::shared_ptr<test::TestShard>> copies;
+
+    std::shared_ptr<test::TestShard> leader;
+    setupRaft(3, walRoot, workers, wals, allHosts, services, copies, leader);
+    checkLeadership(copies, leader);
+
+    // The batches in flight of the old leader either succeed or fail,
+    // but none of them should hang
+    const int numThreads = 4;
+    const int numLogs = 500;
+    std::atomic<int> succeeded{0};
+    auto threads = appendPipelinedLogs(
+        leader, numThreads, numLogs,
+        [] (int) -> char { return 0; },
+        [&succeeded] (AppendLogResult res, char) {
+            if (res == AppendLogResult::SUCCEEDED) {
+                ++succeeded;
+            }
+        });
+
+    LOG(INFO) << "=====> Kill the leader with batches in flight";
+    auto oldLeader = leader;
+    killOneCopy(services, copies, leader, oldLeader->index());
+    for (auto& t : threads) {
+        t.join();
+    }
+    waitUntilLeaderElected(copies, leader);
+    ASSERT_NE(oldLeader, leader);
+
+    LOG(INFO) << "=====> The old leader comes back";
+    rebootOneCopy(services, copies, allHosts, oldLeader->index());
+    waitUntilAllHasLeader(copies);
+    checkLeadership(copies, leader);
+    ASSERT_EQ(AppendLogResult::SUCCEEDED,
+              leader->appendAsync(0, folly::stringPrintf("Log %03d for t0", numLogs + 1)).get());
+
+    // All the logs succeeded have been kept by the new leader
+    auto numAppended = checkPipelinedLogs(copies, leader, numThreads);
+    ASSERT_LE(static_cast<size_t>(succeeded + 1), numAppended);
+    finishRaft(services, copies, workers, leader);
+}
+
 }  // namespace raftex
 }  // namespace nebula
 
@@ -133,6 +133,7 @@ TEST(LogEncoderTest, BatchTest) {
     helper->put("put_key", "put_value");
     helper->rangeRemove("begin", "end");
     helper->put("put_key_again", "put_value_again");
+    helper->merge("merge_key", "merge_operand");
 
     auto encoded = encodeBatchValue(helper->getBatch());
     auto decoded = decodeBatchValue(encoded.c_str());
@@ -147,6 +148,8 @@ TEST(LogEncoderTest, BatchTest) {
             std::pair<folly::StringPiece, folly::StringPiece>("begin", "end"));
     expectd.emplace_back(OP_BATCH_PUT,
             std::pair<folly::StringPiece, folly::StringPiece>("put_key_again", "put_value_again"));
+    expectd.emplace_back(OP_BATCH_MERGE,
+            std::pair<folly::StringPiece, folly::StringPiece>("merge_key", "merge_operand"));
     ASSERT_EQ(expectd, decoded);
 }
 
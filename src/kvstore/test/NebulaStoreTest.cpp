@@ -7,17 +7,24 @@
 #include "base/Base.h"
 #include <gtest/gtest.h>
 #include <rocksdb/db.h>
+#include <rocksdb/sst_file_writer.h>
 #include <iostream>
+#include <fstream>
 #include "fs/TempDir.h"
 #include "fs/FileUtils.h"
 #include "kvstore/NebulaStore.h"
 #include "kvstore/PartManager.h"
 #include "kvstore/RocksEngine.h"
+#include "kvstore/RocksEngineConfig.h"
 #include "kvstore/LogEncoder.h"
+#include "kvstore/SnapshotManagerImpl.h"
 #include "network/NetworkUtils.h"
 #include <thrift/lib/cpp/concurrency/ThreadManager.h>
 
 DECLARE_uint32(raft_heartbeat_interval_secs);
+DECLARE_int32(snapshot_batch_size);
+DECLARE_bool(snapshot_send_sst);
+DECLARE_int64(snapshot_sst_file_size);
 
 namespace nebula {
 namespace kvstore {
@@ -926,6 +933,240 @@ TEST(NebulaStoreTest, AtomicOpBatchTest) {
         EXPECT_EQ(expected, result);
     }
 }
+
+TEST(NebulaStoreTest, RecoverFromRaftWalTest) {
+    auto disableWal = FLAGS_rocksdb_disable_wal;
+    auto dbOptions = FLAGS_rocksdb_db_options;
+    FLAGS_rocksdb_disable_wal = true;
+    // Drop the memtable when closing the engine, just like crashing
+    FLAGS_rocksdb_db_options = R"({"avoid_flush_during_shutdown":"true"})";
+
+    fs::TempDir rootPath("/tmp/nebula_store_test.XXXXXX");
+    auto ioThreadPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
+    auto initStore = [&] {
+        auto partMan = std::make_unique<MemPartManager>();
+        partMan->partsMap_[1][0] = PartMeta();
+        KVOptions options;
+        options.dataPaths_ = {folly::stringPrintf("%s/disk1", rootPath.path())};
+        options.partMan_ = std::move(partMan);
+        HostAddr local = {0, 0};
+        auto store = std::make_unique<NebulaStore>(std::move(options),
+                                                   ioThreadPool,
+                                                   local,
+                                                   getHandlers());
+        store->init();
+        sleep(FLAGS_raft_heartbeat_interval_secs);
+        return store;
+    };
+
+    {
+        auto store = initStore();
+        for (auto i = 0; i < 10; i++) {
+            folly::Baton<true, std::atomic> baton;
+            std::vector<KV> data{{folly::stringPrintf("key_%d", i),
+                                  folly::stringPrintf("val_%d", i)}};
+            store->asyncMultiPut(1, 0, std::move(data), [&] (ResultCode code) {
+                EXPECT_EQ(ResultCode::SUCCEEDED, code);
+                baton.post();
+            });
+            baton.wait();
+        }
+    }
+
+    LOG(INFO) << "Restart the store, the logs lost in the engine are committed again";
+    auto store = initStore();
+    for (auto i = 0; i < 10; i++) {
+        std::string val;
+        ASSERT_EQ(ResultCode::SUCCEEDED, store->get(1, 0, folly::stringPrintf("key_%d", i), &val));
+        EXPECT_EQ(folly::stringPrintf("val_%d", i), val);
+    }
+
+    FLAGS_rocksdb_disable_wal = disableWal;
+    FLAGS_rocksdb_db_options = dbOptions;
+}
+
+
+TEST(NebulaStoreTest, SnapshotInSstFilesTest) {
+    auto batchSize = FLAGS_snapshot_batch_size;
+    auto sendSst = FLAGS_snapshot_send_sst;
+    auto sstFileSize = FLAGS_snapshot_sst_file_size;
+    FLAGS_snapshot_batch_size = 1024;
+    FLAGS_snapshot_sst_file_size = 16 * 1024;
+
+    auto partMan = std::make_unique<MemPartManager>();
+    partMan->partsMap_[1][1] = PartMeta();
+    partMan->partsMap_[1][2] = PartMeta();
+    fs::TempDir rootPath("/tmp/nebula_store_test.XXXXXX");
+    KVOptions options;
+    options.dataPaths_ = {folly::stringPrintf("%s/disk1", rootPath.path())};
+    options.partMan_ = std::move(partMan);
+    HostAddr local = {0, 0};
+    auto store = std::make_unique<NebulaStore>(std::move(options),
+                                               std::make_shared<folly::IOThreadPoolExecutor>(4),
+                                               local,
+                                               getHandlers());
+    store->init();
+    sleep(FLAGS_raft_heartbeat_interval_secs);
+
+    // Part 1 is larger than one batch, and part 2 fits in one batch
+    for (PartitionID partId = 1; partId <= 2; partId++) {
+        std::vector<KV> data;
+        auto rows = partId == 1 ? 1000 : 10;
+        for (auto i = 0; i < rows; i++) {
+            data.emplace_back(NebulaKeyUtils::vertexKey(partId, i, 0, 0),
+                              folly::stringPrintf("val_%d", i));
+        }
+        folly::Baton<true, std::atomic> baton;
+        store->asyncMultiPut(1, partId, std::move(data), [&] (ResultCode code) {
+            EXPECT_EQ(ResultCode::SUCCEEDED, code);
+            baton.post();
+        });
+        baton.wait();
+    }
+
+    FLAGS_snapshot_send_sst = true;
+    SnapshotManagerImpl snapshot(store.get());
+    for (PartitionID partId = 1; partId <= 2; partId++) {
+        fs::TempDir recvPath("/tmp/nebula_store_test_recv.XXXXXX");
+        auto engine = std::make_unique<RocksEngine>(1, recvPath.path());
+        std::string file;
+        int64_t rowsRecv = 0;
+        int32_t filesRecv = 0;
+        bool done = false;
+        snapshot.accessAllRowsInSnapshot(1, partId, [&] (const std::vector<std::string>& rows,
+                                                          const raftex::cpp2::SnapshotFile* f,
+                                                          int64_t totalCount,
+                                                          int64_t,
+                                                          raftex::SnapshotStatus status) {
+            EXPECT_NE(raftex::SnapshotStatus::FAILED, status);
+            done = status == raftex::SnapshotStatus::DONE;
+            if (f == nullptr) {
+                std::vector<KV> data;
+                for (auto& row : rows) {
+                    auto kv = decodeKV(row);
+                    data.emplace_back(kv.first.str(), kv.second.str());
+                }
+                rowsRecv += data.size();
+                EXPECT_EQ(ResultCode::SUCCEEDED, engine->multiPut(std::move(data)));
+            } else {
+                EXPECT_TRUE(rows.empty());
+                EXPECT_EQ(file.size(), f->get_offset());
+                file.append(f->get_data());
+                if (f->get_eof()) {
+                    auto path = folly::stringPrintf("%s/%s", recvPath.path(),
+                                                    f->get_name().c_str());
+                    std::ofstream out(path, std::ios::binary);
+                    out.write(file.data(), file.size());
+                    out.close();
+                    EXPECT_EQ(ResultCode::SUCCEEDED, engine->ingest({path}));
+                    rowsRecv += f->get_count();
+                    filesRecv++;
+                    file.clear();
+                }
+            }
+            EXPECT_EQ(rowsRecv, totalCount);
+            return true;
+        });
+        EXPECT_TRUE(done);
+        if (partId == 1) {
+            EXPECT_EQ(1000, rowsRecv);
+            EXPECT_LT(1, filesRecv);
+        } else {
+            EXPECT_EQ(10, rowsRecv);
+            EXPECT_EQ(0, filesRecv);
+        }
+        for (auto i = 0; i < rowsRecv; i++) {
+            std::string val;
+            EXPECT_EQ(ResultCode::SUCCEEDED,
+                      engine->get(NebulaKeyUtils::vertexKey(partId, i, 0, 0), &val));
+            EXPECT_EQ(folly::stringPrintf("val_%d", i), val);
+        }
+    }
+
+    FLAGS_snapshot_batch_size = batchSize;
+    FLAGS_snapshot_send_sst = sendSst;
+    FLAGS_snapshot_sst_file_size = sstFileSize;
+}
+
+TEST(NebulaStoreTest, SnapshotFileRecvTest) {
+    auto partMan = std::make_unique<MemPartManager>();
+    partMan->partsMap_[1][1] = PartMeta();
+    fs::TempDir rootPath("/tmp/nebula_store_test.XXXXXX");
+    KVOptions options;
+    options.dataPaths_ = {folly::stringPrintf("%s/disk1", rootPath.path())};
+    options.partMan_ = std::move(partMan);
+    HostAddr local = {0, 0};
+    auto store = std::make_unique<NebulaStore>(std::move(options),
+                                               std::make_shared<folly::IOThreadPoolExecutor>(4),
+                                               local,
+                                               getHandlers());
+    store->init();
+    auto part = nebula::value(store->part(1, 1));
+    auto recvDir = folly::stringPrintf("%s/snapshot/recv_1", part->engine()->getDataRoot());
+
+    // Build an sst file of 10 rows, and split it into 2 chunks
+    auto sstPath = folly::stringPrintf("%s/data.sst", rootPath.path());
+    rocksdb::Options rocksOptions;
+    rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), rocksOptions);
+    ASSERT_TRUE(writer.Open(sstPath).ok());
+    for (auto i = 0; i < 10; i++) {
+        auto key = NebulaKeyUtils::vertexKey(1, i, 0, 0);
+        ASSERT_TRUE(writer.Put(key, folly::stringPrintf("val_%d", i)).ok());
+    }
+    ASSERT_TRUE(writer.Finish().ok());
+    std::ifstream in(sstPath, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    auto half = content.size() / 2;
+    auto chunk = [&] (bool first, int64_t count) {
+        raftex::cpp2::SnapshotFile file;
+        file.set_name("0.sst");
+        file.set_offset(first ? 0 : half);
+        file.set_data(first ? content.substr(0, half) : content.substr(half));
+        file.set_eof(!first);
+        file.set_count(count);
+        file.set_size(100);
+        return file;
+    };
+
+    std::pair<int64_t, int64_t> rows;
+    // The file name must be flat
+    for (auto name : {"", "../0.sst", "sub/0.sst"}) {
+        auto file = chunk(true, 10);
+        file.set_name(name);
+        EXPECT_EQ(raftex::cpp2::ErrorCode::E_SNAPSHOT_FILE_FAILED,
+                  part->commitSnapshotFile(file, &rows));
+    }
+    EXPECT_FALSE(fs::FileUtils::exist(recvDir));
+    EXPECT_FALSE(fs::FileUtils::exist(folly::stringPrintf("%s/snapshot/0.sst",
+                                                          part->engine()->getDataRoot())));
+
+    // The first chunk is missing
+    EXPECT_EQ(raftex::cpp2::ErrorCode::E_SNAPSHOT_FILE_FAILED,
+              part->commitSnapshotFile(chunk(false, 10), &rows));
+    EXPECT_FALSE(fs::FileUtils::exist(recvDir));
+
+    // The count sent doesn't match the rows in the file
+    EXPECT_EQ(raftex::cpp2::ErrorCode::SUCCEEDED,
+              part->commitSnapshotFile(chunk(true, 0), &rows));
+    EXPECT_EQ(0, rows.first);
+    EXPECT_EQ(raftex::cpp2::ErrorCode::E_SNAPSHOT_FILE_FAILED,
+              part->commitSnapshotFile(chunk(false, 11), &rows));
+    EXPECT_FALSE(fs::FileUtils::exist(recvDir));
+
+    EXPECT_EQ(raftex::cpp2::ErrorCode::SUCCEEDED,
+              part->commitSnapshotFile(chunk(true, 0), &rows));
+    EXPECT_EQ(raftex::cpp2::ErrorCode::SUCCEEDED,
+              part->commitSnapshotFile(chunk(false, 10), &rows));
+    EXPECT_EQ(10, rows.first);
+    EXPECT_EQ(100, rows.second);
+    for (auto i = 0; i < 10; i++) {
+        std::string val;
+        EXPECT_EQ(ResultCode::SUCCEEDED,
+                  part->engine()->get(NebulaKeyUtils::vertexKey(1, i, 0, 0), &val));
+        EXPECT_EQ(folly::stringPrintf("val_%d", i), val);
+    }
+}
+
 }  // namespace kvstore
 }  // namespace nebula
 
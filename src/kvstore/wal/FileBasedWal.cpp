@@ -49,6 +49,10 @@ FileBasedWal::FileBasedWal(const folly::StringPiece dir,
         }
     }
 
+    if (policy_.sync && policy_.groupSync) {
+        syncer_ = WalSyncer::get(dir_);
+    }
+
     scanAllWalFiles();
     if (!walFiles_.empty()) {
         firstLogId_ = walFiles_.begin()->second->firstId();
@@ -286,7 +290,7 @@ void FileBasedWal::closeCurrFile() {
         return;
     }
 
-    if (!policy_.sync) {
+    if (!policy_.sync || unsynced_) {
         if (::fsync(currFd_) == -1) {
             LOG(WARNING) << "sync wal \"" << currInfo_->path()
                          << "\" failed, error: " << strerror(errno);
@@ -299,6 +303,7 @@ void FileBasedWal::closeCurrFile() {
                      << "\" failed, error: " << strerror(errno);
     }
     currFd_ = -1;
+    unsynced_ = false;
 
     auto now = time::WallClock::fastNowInSec();
     currInfo_->setMTime(now);
@@ -554,13 +559,7 @@ bool FileBasedWal::appendLogInternal(LogID id,
         LOG(FATAL) << idStr_ << "bytesWritten:" << bytesWritten << ", expected:" << strBuf.size()
                    << ", error:" << strerror(errno);
     }
-
-    if (policy_.sync) {
-        if (::fsync(currFd_) == -1) {
-            LOG(WARNING) << "sync wal \"" << currInfo_->path()
-                         << "\" failed, error: " << strerror(errno);
-        }
-    }
+    unsynced_ = true;
     currInfo_->setSize(currInfo_->size() + strBuf.size());
     currInfo_->setLastId(id);
     currInfo_->setLastTerm(term);
@@ -584,7 +583,9 @@ bool FileBasedWal::appendLog(LogID id,
                              TermID term,
                              ClusterID cluster,
                              std::string msg) {
-    if (!appendLogInternal(id, term, cluster, std::move(msg))) {
+    auto ret = appendLogInternal(id, term, cluster, std::move(msg));
+    syncCurrFile();
+    if (!ret) {
         LOG(ERROR) << "Failed to append log for logId " << id;
         return false;
     }
@@ -600,14 +601,37 @@ bool FileBasedWal::appendLogs(LogIterator& iter) {
                                iter.logMsg().toString())) {
             LOG(ERROR) << idStr_ << "Failed to append log for logId "
                        << iter.logId();
+            syncCurrFile();
             return false;
         }
     }
 
+    // The whole batch is synced at once
+    syncCurrFile();
     return true;
 }
 
 
+void FileBasedWal::syncCurrFile() {
+    if (!policy_.sync || !unsynced_ || currFd_ < 0) {
+        return;
+    }
+    bool ok = false;
+    if (syncer_ != nullptr) {
+        ok = syncer_->sync(currFd_).get();
+    } else {
+        ok = ::fsync(currFd_) == 0;
+        if (!ok) {
+            LOG(WARNING) << "sync wal \"" << currInfo_->path()
+                         << "\" failed, error: " << strerror(errno);
+        }
+    }
+    if (ok) {
+        unsynced_ = false;
+    }
+}
+
+
 std::unique_ptr<LogIterator> FileBasedWal::iterator(LogID firstLogId,
                                                     LogID lastLogId) {
     return std::make_unique<FileBasedWalIterator>(shared_from_this(), firstLogId, lastLogId);
@@ -14,6 +14,7 @@
 #include "kvstore/wal/Wal.h"
 #include "kvstore/wal/InMemoryLogBuffer.h"
 #include "kvstore/wal/WalFileInfo.h"
+#include "kvstore/wal/WalSyncer.h"
 
 namespace nebula {
 namespace wal {
@@ -35,6 +36,10 @@ struct FileBasedWalPolicy {
     size_t numBuffers = 2;
     // Whether fsync needs to be called every write
     bool sync = false;
+    // Whether the fsync is issued by the WalSyncer shared by the wals on the
+    // same disk, so the wals syncing at the same time are synced together.
+    // Only works when sync is true
+    bool groupSync = false;
 };
 
 
@@ -46,6 +51,7 @@ class FileBasedWal final : public Wal
     FRIEND_TEST(FileBasedWal, TTLTest);
     FRIEND_TEST(FileBasedWal, CheckLastWalTest);
     FRIEND_TEST(FileBasedWal, LinkTest);
+    FRIEND_TEST(FileBasedWal, GroupSyncTest);
     friend class FileBasedWalIterator;
 public:
     // A factory method to create a new WAL
@@ -161,12 +167,16 @@ private:
     // If the last buffer is big enough, create a new one
     BufferPtr getLastBuffer(LogID id, size_t expectedToWrite);
 
-    // Implementation of appendLog()
+    // Implementation of appendLog(), the log is not synced
     bool appendLogInternal(LogID id,
                            TermID term,
                            ClusterID cluster,
                            std::string msg);
 
+    // Sync the logs written into the current wal file if needed,
+    // called once per appendLog() or appendLogs()
+    void syncCurrFile();
+
 
 private:
     using WalFiles = std::map<LogID, WalFileInfoPtr>;
@@ -199,6 +209,10 @@ private:
     int32_t currFd_{-1};
     // The WalFileInfo corresponding to the currFd_
     WalFileInfoPtr currInfo_;
+    // Whether there are logs written into currFd_ but not synced yet
+    bool unsynced_{false};
+    // Not null if policy_.groupSync is on
+    std::shared_ptr<WalSyncer> syncer_;
 
     // The purpose of the memory buffer is to provide a read cache
     BufferList buffers_;
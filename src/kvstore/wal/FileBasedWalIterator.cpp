@@ -5,9 +5,11 @@
  */
 
 #include "base/Base.h"
+#include <sys/mman.h>
 #include "kvstore/wal/FileBasedWalIterator.h"
 #include "kvstore/wal/FileBasedWal.h"
 #include "kvstore/wal/WalFileInfo.h"
+#include <folly/ScopeGuard.h>
 
 namespace nebula {
 namespace wal {
@@ -66,16 +68,10 @@ FileBasedWalIterator::FileBasedWalIterator(
                 // Skip this file
                 return true;
             }
-            int fd = open(info->path(), O_RDONLY);
-            if (fd < 0) {
-                LOG(ERROR) << "Failed to open wal file \""
-                           << info->path()
-                           << "\" (" << errno << "): "
-                           << strerror(errno);
+            if (!mapFile(info->path())) {
                 currId_ = lastId_ + 1;
                 return false;
             }
-            fds_.push_front(fd);
             idRanges_.push_front(std::make_pair(info->firstId(), info->lastId()));
 
             if (info->firstId() <= currId_) {
@@ -108,26 +104,7 @@ FileBasedWalIterator::FileBasedWalIterator(
         // Find the correct position in the first WAL file
         currPos_ = 0;
         while (true) {
-            LogID logId;
-            // Read the logID
-            int fd = fds_.front();
-            CHECK_EQ(pread(fd,
-                           reinterpret_cast<char*>(&logId),
-                           sizeof(LogID),
-                           currPos_),
-                     static_cast<ssize_t>(sizeof(LogID)));
-            // Read the termID
-            CHECK_EQ(pread(fd,
-                           reinterpret_cast<char*>(&currTerm_),
-                           sizeof(TermID),
-                           currPos_ + sizeof(LogID)),
-                     static_cast<ssize_t>(sizeof(TermID)));
-            // Read the log length
-            CHECK_EQ(pread(fd,
-                           reinterpret_cast<char*>(&currMsgLen_),
-                           sizeof(int32_t),
-                           currPos_ + sizeof(LogID) + sizeof(TermID)),
-                     static_cast<ssize_t>(sizeof(int32_t)));
+            LogID logId = readHead();
             if (logId == currId_) {
                 break;
             }
@@ -142,12 +119,67 @@ FileBasedWalIterator::FileBasedWalIterator(
 
 
 FileBasedWalIterator::~FileBasedWalIterator() {
-    for (auto& fd : fds_) {
+    for (auto& file : files_) {
+        unmapFile(file);
+    }
+}
+
+
+bool FileBasedWalIterator::mapFile(const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        LOG(ERROR) << "Failed to open wal file \""
+                   << path
+                   << "\" (" << errno << "): "
+                   << strerror(errno);
+        return false;
+    }
+    SCOPE_EXIT {
+        // The mapping is still valid after the fd is closed
         close(fd);
+    };
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        LOG(ERROR) << "Failed to stat wal file \"" << path << "\": " << strerror(errno);
+        return false;
+    }
+    MappedFile file;
+    file.size_ = st.st_size;
+    if (file.size_ > 0) {
+        void* addr = mmap(nullptr, file.size_, PROT_READ, MAP_SHARED, fd, 0);
+        if (addr == MAP_FAILED) {
+            LOG(ERROR) << "Failed to mmap wal file \"" << path << "\": " << strerror(errno);
+            return false;
+        }
+        // The logs are read one by one, so read ahead aggressively
+        madvise(addr, file.size_, MADV_SEQUENTIAL);
+        file.data_ = static_cast<const char*>(addr);
+    }
+    files_.push_front(file);
+    return true;
+}
+
+
+void FileBasedWalIterator::unmapFile(const MappedFile& file) {
+    if (file.data_ != nullptr) {
+        CHECK_EQ(munmap(const_cast<char*>(file.data_), file.size_), 0);
     }
 }
 
 
+LogID FileBasedWalIterator::readHead() {
+    const auto& file = files_.front();
+    CHECK_LE(currPos_ + sizeof(LogID) + sizeof(TermID) + sizeof(int32_t), file.size_)
+        << wal_->idStr_ << "Failed to read. Curr position is " << currPos_;
+    LogID logId;
+    const char* pos = file.data_ + currPos_;
+    memcpy(&logId, pos, sizeof(LogID));
+    memcpy(&currTerm_, pos + sizeof(LogID), sizeof(TermID));
+    memcpy(&currMsgLen_, pos + sizeof(LogID) + sizeof(TermID), sizeof(int32_t));
+    return logId;
+}
+
+
 LogIterator& FileBasedWalIterator::operator++() {
     ++currId_;
     if (currId_ < firstIdInBuffer_) {
@@ -159,8 +191,8 @@ LogIterator& FileBasedWalIterator::operator++() {
                     << nextFirstId_
                     << ", so need to move to the next file";
             // Close the current file
-            CHECK_EQ(close(fds_.front()), 0);
-            fds_.pop_front();
+            unmapFile(files_.front());
+            files_.pop_front();
             idRanges_.pop_front();
 
             if (idRanges_.empty()) {
@@ -189,27 +221,8 @@ LogIterator& FileBasedWalIterator::operator++() {
             currId_ = lastId_ + 1;
             return *this;
         } else {
-            LogID logId;
-            int fd = fds_.front();
-            // Read the logID
-            CHECK_EQ(pread(fd,
-                           reinterpret_cast<char*>(&logId),
-                           sizeof(LogID),
-                           currPos_),
-                     static_cast<ssize_t>(sizeof(LogID))) << "currPos = " << currPos_;
-            CHECK_EQ(currId_, logId);
-            // Read the termID
-            CHECK_EQ(pread(fd,
-                           reinterpret_cast<char*>(&currTerm_),
-                           sizeof(TermID),
-                           currPos_ + sizeof(LogID)),
-                     static_cast<ssize_t>(sizeof(TermID)));
-            // Read the log length
-            CHECK_EQ(pread(fd,
-                           reinterpret_cast<char*>(&currMsgLen_),
-                           sizeof(int32_t),
-                           currPos_ + sizeof(TermID) + sizeof(LogID)),
-                     static_cast<ssize_t>(sizeof(int32_t)));
+            LogID logId = readHead();
+            CHECK_EQ(currId_, logId) << "currPos = " << currPos_;
         }
     } else if (currId_ <= lastId_) {
         // Need to adjust nextFirstId_, in case we just start
@@ -271,21 +284,14 @@ ClusterID FileBasedWalIterator::logSource() const {
         return buffers_.front()->getCluster(currIdx_);
     } else {
         // Retrieve from the file
-        DCHECK(!fds_.empty());
-
-        ClusterID cluster = 0;
-        CHECK_EQ(pread(fds_.front(),
-                       &(cluster),
-                       sizeof(ClusterID),
-                       currPos_
-                        + sizeof(LogID)
-                        + sizeof(TermID)
-                        + sizeof(int32_t)),
-                 static_cast<ssize_t>(sizeof(ClusterID)))
+        DCHECK(!files_.empty());
+        auto offset = currPos_ + sizeof(LogID) + sizeof(TermID) + sizeof(int32_t);
+        CHECK_LE(offset + sizeof(ClusterID), files_.front().size_)
             << "Failed to read. Curr position is " << currPos_
-            << ", expected read length is " << sizeof(ClusterID)
-            << " (errno: " << errno << "): " << strerror(errno);
+            << ", expected read length is " << sizeof(ClusterID);
 
+        ClusterID cluster = 0;
+        memcpy(&cluster, files_.front().data_ + offset, sizeof(ClusterID));
         return cluster;
     }
 }
@@ -297,24 +303,18 @@ folly::StringPiece FileBasedWalIterator::logMsg() const {
         DCHECK(!buffers_.empty());
         return buffers_.front()->getLog(currIdx_);
     } else {
-        // Retrieve from the file
-        DCHECK(!fds_.empty());
-
-        currLog_.resize(currMsgLen_);
-        CHECK_EQ(pread(fds_.front(),
-                       &(currLog_[0]),
-                       currMsgLen_,
-                       currPos_
-                        + sizeof(LogID)
-                        + sizeof(TermID)
-                        + sizeof(int32_t)
-                        + sizeof(ClusterID)),
-                 static_cast<ssize_t>(currMsgLen_))
+        // Retrieve from the file, without copying
+        DCHECK(!files_.empty());
+        auto offset = currPos_
+                      + sizeof(LogID)
+                      + sizeof(TermID)
+                      + sizeof(int32_t)
+                      + sizeof(ClusterID);
+        CHECK_LE(offset + currMsgLen_, files_.front().size_)
             << "Failed to read. Curr position is " << currPos_
-            << ", expected read length is " << currMsgLen_
-            << " (errno: " << errno << "): " << strerror(errno);
+            << ", expected read length is " << currMsgLen_;
 
-        return currLog_;
+        return folly::StringPiece(files_.front().data_ + offset, currMsgLen_);
     }
 }
 
@@ -24,6 +24,10 @@ class FileBasedWal;
  * or from the in-memory buffers. If the given log id is out of range,
  * an invalid (valid() method will return false) iterator will be
  * constructed
+ *
+ * The wal files are mapped read-only, and the log messages in them are
+ * returned without copying. So the message returned by logMsg() is only
+ * valid until the iterator moves to the next file or buffer.
  */
 class FileBasedWalIterator final : public LogIterator {
 public:
@@ -47,9 +51,22 @@ public:
     folly::StringPiece logMsg() const override;
 
 private:
+    struct MappedFile {
+        const char* data_{nullptr};
+        size_t size_{0};
+    };
+
     LogID getFirstIdInNextBuffer() const;
     LogID getFirstIdInNextFile() const;
 
+    // Map the whole wal file, return false if failed
+    bool mapFile(const char* path);
+    void unmapFile(const MappedFile& file);
+
+    // Read the head of the log at currPos_ in the current file,
+    // the term and the message length are kept
+    LogID readHead();
+
 private:
     // Holds the Wal object, so that it will not be destroyed before the iterator
     std::shared_ptr<FileBasedWal> wal_;
@@ -67,10 +84,9 @@ private:
 
     // [firstId, lastId]
     std::list<std::pair<LogID, LogID>> idRanges_;
-    std::list<int> fds_;
+    std::list<MappedFile> files_;
     int64_t currPos_{0};
     int32_t currMsgLen_{0};
-    mutable std::string currLog_;
     // we hold the read lock to avoid wal being rolled back during iterator
     std::unique_ptr<folly::RWSpinLock::ReadHolder> holder_;
 };
@@ -0,0 +1,110 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include "kvstore/wal/WalSyncer.h"
+
+namespace nebula {
+namespace wal {
+
+WalSyncer::WalSyncer(std::string name)
+        : name_(std::move(name)) {
+    thread_ = thread::NamedThread("wal-sync", &WalSyncer::loop, this);
+}
+
+
+WalSyncer::~WalSyncer() {
+    {
+        std::lock_guard<std::mutex> g(lock_);
+        stopped_ = true;
+    }
+    cv_.notify_one();
+    thread_.join();
+    LOG(INFO) << "WalSyncer " << name_ << " stopped, " << numRequests_.load()
+              << " requests served by " << numSyncs_.load() << " syncs";
+}
+
+
+// static
+std::shared_ptr<WalSyncer> WalSyncer::get(const std::string& path) {
+    static std::mutex lock;
+    static std::unordered_map<dev_t, std::weak_ptr<WalSyncer>> syncers;
+
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0) {
+        LOG(ERROR) << "Failed to stat \"" << path << "\", error: " << strerror(errno);
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> g(lock);
+    auto syncer = syncers[st.st_dev].lock();
+    if (syncer == nullptr) {
+        syncer = std::make_shared<WalSyncer>(
+            folly::stringPrintf("dev %u:%u", major(st.st_dev), minor(st.st_dev)));
+        syncers[st.st_dev] = syncer;
+        LOG(INFO) << "Start WalSyncer for the wals on " << path;
+    }
+    return syncer;
+}
+
+
+folly::Future<bool> WalSyncer::sync(int32_t fd) {
+    Request req;
+    req.fd_ = fd;
+    auto future = req.promise_.getFuture();
+    {
+        std::lock_guard<std::mutex> g(lock_);
+        if (stopped_) {
+            return false;
+        }
+        pending_.emplace_back(std::move(req));
+    }
+    numRequests_++;
+    cv_.notify_one();
+    return future;
+}
+
+
+void WalSyncer::loop() {
+    while (true) {
+        std::vector<Request> reqs;
+        {
+            std::unique_lock<std::mutex> g(lock_);
+            cv_.wait(g, [this] {
+                return stopped_ || !pending_.empty();
+            });
+            if (pending_.empty()) {
+                // Stopped
+                return;
+            }
+            reqs.swap(pending_);
+        }
+
+        // All the requests on one file are served by one fsync
+        std::unordered_map<int32_t, bool> results;
+        for (auto& req : reqs) {
+            if (results.find(req.fd_) != results.end()) {
+                continue;
+            }
+            bool ok = ::fsync(req.fd_) == 0;
+            if (!ok) {
+                LOG(WARNING) << "sync wal fd " << req.fd_ << " failed, error: "
+                             << strerror(errno);
+            }
+            numSyncs_++;
+            results.emplace(req.fd_, ok);
+        }
+        VLOG(3) << "WalSyncer " << name_ << " served " << reqs.size()
+                << " requests by " << results.size() << " syncs";
+        for (auto& req : reqs) {
+            req.promise_.setValue(results[req.fd_]);
+        }
+    }
+}
+
+}  // namespace wal
+}  // namespace nebula
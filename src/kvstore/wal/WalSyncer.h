@@ -0,0 +1,76 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef WAL_WALSYNCER_H_
+#define WAL_WALSYNCER_H_
+
+#include "base/Base.h"
+#include <folly/futures/Future.h>
+
+namespace nebula {
+namespace wal {
+
+/**
+ * Sync the wal files on one disk in a dedicated thread (group commit).
+ *
+ * The wals ask for syncing their files and wait on the futures returned.
+ * While the thread is syncing, the requests coming in are gathered, and
+ * they are served together in the next turn, each file being synced only
+ * once no matter how many requests are waiting on it.
+ *
+ * The syncer is shared by all wals on the same device, see get().
+ * */
+class WalSyncer final {
+public:
+    explicit WalSyncer(std::string name);
+
+    ~WalSyncer();
+
+    /**
+     * Return the syncer of the device where the path is, it is created when
+     * no wal on the device holds one.
+     * */
+    static std::shared_ptr<WalSyncer> get(const std::string& path);
+
+    /**
+     * Sync the file, the future is fulfilled with false if it fails.
+     * The fd should not be closed until the future is fulfilled.
+     * This method IS thread-safe.
+     * */
+    folly::Future<bool> sync(int32_t fd);
+
+    // Number of the sync requests received
+    uint64_t numRequests() const {
+        return numRequests_.load();
+    }
+
+    // Number of the fsync calls issued
+    uint64_t numSyncs() const {
+        return numSyncs_.load();
+    }
+
+private:
+    void loop();
+
+private:
+    struct Request {
+        int32_t fd_;
+        folly::Promise<bool> promise_;
+    };
+
+    const std::string name_;
+    std::vector<Request> pending_;
+    bool stopped_{false};
+    std::mutex lock_;
+    std::condition_variable cv_;
+    std::atomic<uint64_t> numRequests_{0};
+    std::atomic<uint64_t> numSyncs_{0};
+    std::thread thread_;
+};
+
+}  // namespace wal
+}  // namespace nebula
+#endif  // WAL_WALSYNCER_H_
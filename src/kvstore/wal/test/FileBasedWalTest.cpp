@@ -578,6 +578,66 @@ TEST(FileBasedWal, LinkTest) {
     EXPECT_EQ(num + 1, wal->walFiles_.size());
 }
 
+TEST(FileBasedWal, GroupSyncTest) {
+    FileBasedWalPolicy policy;
+    policy.fileSize = 1024L * 1024L;
+    policy.bufferSize = 1024L * 1024L;
+    policy.sync = true;
+    policy.groupSync = true;
+
+    TempDir walDir("/tmp/testWal.XXXXXX");
+    const int32_t numWals = 8;
+    const int32_t numLogs = 500;
+    std::vector<std::shared_ptr<FileBasedWal>> wals;
+    for (int32_t i = 0; i < numWals; i++) {
+        auto path = folly::stringPrintf("%s/%d", walDir.path(), i);
+        wals.emplace_back(FileBasedWal::getWal(path,
+                                               folly::stringPrintf("[wal %d] ", i),
+                                               policy,
+                                               [](LogID, TermID, ClusterID, const std::string&) {
+                                                   return true;
+                                               }));
+    }
+    // All the wals are in the same dir, so they share one syncer
+    auto syncer = wals.front()->syncer_;
+    ASSERT_NE(nullptr, syncer);
+    for (auto& wal : wals) {
+        EXPECT_EQ(syncer, wal->syncer_);
+    }
+
+    std::vector<std::thread> threads;
+    for (auto& wal : wals) {
+        threads.emplace_back([wal] {
+            for (int32_t i = 1; i <= numLogs; i++) {
+                ASSERT_TRUE(wal->appendLog(i /*id*/, 1 /*term*/, 0 /*cluster*/,
+                                           folly::stringPrintf(kLongMsg, i)));
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    // Each appendLog asks for one sync, and the requests at the same time are
+    // served together
+    EXPECT_EQ(numWals * numLogs, syncer->numRequests());
+    EXPECT_LE(syncer->numSyncs(), syncer->numRequests());
+    LOG(INFO) << syncer->numRequests() << " requests served by "
+              << syncer->numSyncs() << " syncs";
+
+    for (auto& wal : wals) {
+        ASSERT_EQ(numLogs, wal->lastLogId());
+        auto it = wal->iterator(1, numLogs);
+        LogID id = 1;
+        while (it->valid()) {
+            ASSERT_EQ(id, it->logId());
+            ASSERT_EQ(folly::stringPrintf(kLongMsg, id), it->logMsg());
+            ++(*it);
+            ++id;
+        }
+        EXPECT_EQ(numLogs + 1, id);
+    }
+}
+
 }  // namespace wal
 }  // namespace nebula
 
@@ -63,11 +63,17 @@ bool ActiveHostsMan::isLived(kvstore::KVStore* kv, const HostAddr& host) {
     return std::find(activeHosts.begin(), activeHosts.end(), host) != activeHosts.end();
 }
 
-kvstore::ResultCode LastUpdateTimeMan::update(kvstore::KVStore* kv, const int64_t timeInMilliSec) {
+kvstore::ResultCode LastUpdateTimeMan::update(kvstore::KVStore* kv,
+                                              const int64_t timeInMilliSec,
+                                              const std::unordered_set<GraphSpaceID>& spaces) {
     CHECK_NOTNULL(kv);
     std::vector<kvstore::KV> data;
     data.emplace_back(MetaServiceUtils::lastUpdateTimeKey(),
                       MetaServiceUtils::lastUpdateTimeVal(timeInMilliSec));
+    for (auto spaceId : spaces) {
+        data.emplace_back(MetaServiceUtils::spaceUpdateTimeKey(spaceId),
+                          MetaServiceUtils::lastUpdateTimeVal(timeInMilliSec));
+    }
 
     folly::SharedMutex::WriteHolder wHolder(LockUtils::lastUpdateTimeLock());
     folly::Baton<true, std::atomic> baton;
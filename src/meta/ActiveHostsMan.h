@@ -65,7 +65,13 @@ class LastUpdateTimeMan final {
 public:
     ~LastUpdateTimeMan() = default;
 
-    static kvstore::ResultCode update(kvstore::KVStore* kv, const int64_t timeInMilliSec);
+    /**
+     * Update the last update time of the meta, along with the ones of the
+     * spaces changed, so the clients could reload only these spaces.
+     * */
+    static kvstore::ResultCode update(kvstore::KVStore* kv,
+                                      const int64_t timeInMilliSec,
+                                      const std::unordered_set<GraphSpaceID>& spaces = {});
 
     static int64_t get(kvstore::KVStore* kv);
 
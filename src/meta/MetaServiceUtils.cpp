@@ -26,6 +26,7 @@ const std::string kDefaultTable        = "__default__";        // NOLINT
 const std::string kSnapshotsTable      = "__snapshots__";      // NOLINT
 const std::string kLastUpdateTimeTable = "__last_update_time__"; // NOLINT
 const std::string kLeadersTable        = "__leaders__";          // NOLINT
+const std::string kSpaceUpdateTimeTable = "__space_update_time__"; // NOLINT
 
 const std::string kHostOnline  = "Online";       // NOLINT
 const std::string kHostOffline = "Offline";      // NOLINT
@@ -44,6 +45,32 @@ std::string MetaServiceUtils::lastUpdateTimeVal(const int64_t timeInMilliSec) {
     return val;
 }
 
+std::string MetaServiceUtils::spaceUpdateTimeKey(GraphSpaceID spaceId) {
+    std::string key;
+    key.reserve(kSpaceUpdateTimeTable.size() + sizeof(GraphSpaceID));
+    key.append(kSpaceUpdateTimeTable.data(), kSpaceUpdateTimeTable.size())
+       .append(reinterpret_cast<const char*>(&spaceId), sizeof(GraphSpaceID));
+    return key;
+}
+
+const std::string& MetaServiceUtils::spaceUpdateTimePrefix() {
+    return kSpaceUpdateTimeTable;
+}
+
+GraphSpaceID MetaServiceUtils::parseSpaceUpdateTimeKey(folly::StringPiece key) {
+    return *reinterpret_cast<const GraphSpaceID*>(key.data() + kSpaceUpdateTimeTable.size());
+}
+
+GraphSpaceID MetaServiceUtils::spaceIdOfKey(folly::StringPiece key) {
+    // The space id is right after the table name in all these tables
+    for (auto* table : {&kSpacesTable, &kPartsTable, &kTagsTable, &kEdgesTable, &kIndexesTable}) {
+        if (key.startsWith(*table) && key.size() >= table->size() + sizeof(GraphSpaceID)) {
+            return *reinterpret_cast<const GraphSpaceID*>(key.data() + table->size());
+        }
+    }
+    return -1;
+}
+
 std::string MetaServiceUtils::spaceKey(GraphSpaceID spaceId) {
     std::string key;
     key.reserve(kSpacesTable.size() + sizeof(GraphSpaceID));
@@ -35,6 +35,18 @@ public:
 
     static std::string lastUpdateTimeVal(const int64_t timeInMilliSec);
 
+    static std::string spaceUpdateTimeKey(GraphSpaceID spaceId);
+
+    static const std::string& spaceUpdateTimePrefix();
+
+    static GraphSpaceID parseSpaceUpdateTimeKey(folly::StringPiece key);
+
+    /**
+     * Return the space which the key of the space, parts, schemas or indexes
+     * belongs to, and -1 for the other keys.
+     * */
+    static GraphSpaceID spaceIdOfKey(folly::StringPiece key);
+
     static std::string spaceKey(GraphSpaceID spaceId);
 
     static std::string spaceVal(const cpp2::SpaceProperties &properties);
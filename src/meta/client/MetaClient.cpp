@@ -156,25 +156,44 @@ bool MetaClient::loadData() {
         return false;
     }
 
-    auto ret = listSpaces().get();
+    // The changes after listing the spaces would be loaded next time
+    auto metadLastUpdateTime = metadLastUpdateTime_.load();
+    auto ret = listSpacesWithVersions().get();
     if (!ret.ok()) {
         LOG(ERROR) << "List space failed, status:" << ret.status();
         return false;
     }
+    auto& spaces = ret.value().get_spaces();
+    auto& versions = ret.value().get_versions();
 
-    decltype(localCache_)            cache;
-    decltype(spaceIndexByName_)      spaceIndexByName;
-    decltype(spaceTagIndexByName_)   spaceTagIndexByName;
-    decltype(spaceEdgeIndexByName_)  spaceEdgeIndexByName;
-    decltype(spaceNewestTagVerMap_)  spaceNewestTagVerMap;
-    decltype(spaceNewestEdgeVerMap_) spaceNewestEdgeVerMap;
-    decltype(spaceEdgeIndexByType_)  spaceEdgeIndexByType;
-    decltype(spaceTagIndexById_)     spaceTagIndexById;
-    decltype(spaceAllEdgeMap_)       spaceAllEdgeMap;
-    decltype(spaceAllTagMap_)        spaceAllTagMap;
+    std::shared_ptr<const MetaData> oldData;
+    {
+        folly::RWSpinLock::ReadHolder holder(localCacheLock_);
+        oldData = metaData_;
+    }
+    auto data = std::make_shared<MetaData>();
+    // The spaces not changed since last load are not loaded again
+    std::unordered_set<GraphSpaceID> unchanged;
+    for (auto& space : spaces) {
+        auto spaceId = space.get_id().get_space_id();
+        auto verIt = versions.find(spaceId);
+        auto oldIt = oldData->localCache_.find(spaceId);
+        if (verIt != versions.end()
+                && oldIt != oldData->localCache_.end()
+                && oldIt->second->version_ == verIt->second
+                && oldIt->second->spaceName == space.get_name()) {
+            data->localCache_.emplace(spaceId, oldIt->second);
+            data->spaceIndexByName_.emplace(space.get_name(), spaceId);
+            unchanged.emplace(spaceId);
+        }
+    }
+    copySpaceMaps(unchanged, *oldData, *data);
 
-    for (auto space : ret.value()) {
-        auto spaceId = space.first;
+    for (auto& space : spaces) {
+        auto spaceId = space.get_id().get_space_id();
+        if (unchanged.count(spaceId) != 0) {
+            continue;
+        }
         auto r = getPartsAlloc(spaceId).get();
         if (!r.ok()) {
             LOG(ERROR) << "Get parts allocation failed for spaceId " << spaceId
@@ -184,22 +203,27 @@ bool MetaClient::loadData() {
 
         auto spaceCache = std::make_shared<SpaceInfoCache>();
         auto partsAlloc = r.value();
-        spaceCache->spaceName = space.second;
+        spaceCache->spaceName = space.get_name();
         spaceCache->partsOnHost_ = reverse(partsAlloc);
         spaceCache->partsAlloc_ = std::move(partsAlloc);
+        auto verIt = versions.find(spaceId);
+        if (verIt != versions.end()) {
+            spaceCache->version_ = verIt->second;
+        }
         VLOG(2) << "Load space " << spaceId
-                << ", parts num:" << spaceCache->partsAlloc_.size();
+                << ", parts num:" << spaceCache->partsAlloc_.size()
+                << ", version:" << spaceCache->version_;
 
         if (!loadSchemas(spaceId,
                          spaceCache,
-                         spaceTagIndexByName,
-                         spaceTagIndexById,
-                         spaceEdgeIndexByName,
-                         spaceEdgeIndexByType,
-                         spaceNewestTagVerMap,
-                         spaceNewestEdgeVerMap,
-                         spaceAllEdgeMap,
-                         spaceAllTagMap)) {
+                         data->spaceTagIndexByName_,
+                         data->spaceTagIndexById_,
+                         data->spaceEdgeIndexByName_,
+                         data->spaceEdgeIndexByType_,
+                         data->spaceNewestTagVerMap_,
+                         data->spaceNewestEdgeVerMap_,
+                         data->spaceAllEdgeMap_,
+                         data->spaceAllTagMap_)) {
             LOG(ERROR) << "Load Schemas Failed";
             return false;
         }
@@ -210,30 +234,42 @@ bool MetaClient::loadData() {
             return false;
         }
 
-        cache.emplace(spaceId, spaceCache);
-        spaceIndexByName.emplace(space.second, spaceId);
+        data->localCache_.emplace(spaceId, spaceCache);
+        data->spaceIndexByName_.emplace(space.get_name(), spaceId);
     }
-    decltype(localCache_) oldCache;
+    VLOG(1) << "Load " << spaces.size() << " spaces, " << unchanged.size() << " not changed";
     {
         folly::RWSpinLock::WriteHolder holder(localCacheLock_);
-        oldCache               = std::move(localCache_);
-        localCache_            = std::move(cache);
-        spaceIndexByName_      = std::move(spaceIndexByName);
-        spaceTagIndexByName_   = std::move(spaceTagIndexByName);
-        spaceEdgeIndexByName_  = std::move(spaceEdgeIndexByName);
-        spaceNewestTagVerMap_  = std::move(spaceNewestTagVerMap);
-        spaceNewestEdgeVerMap_ = std::move(spaceNewestEdgeVerMap);
-        spaceEdgeIndexByType_  = std::move(spaceEdgeIndexByType);
-        spaceTagIndexById_     = std::move(spaceTagIndexById);
-        spaceAllEdgeMap_       = std::move(spaceAllEdgeMap);
-        spaceAllTagMap_        = std::move(spaceAllTagMap);
-    }
-    localDataLastUpdateTime_.store(metadLastUpdateTime_.load());
-    diff(oldCache, localCache_);
+        std::atomic_store(&metaData_, std::shared_ptr<const MetaData>(std::move(data)));
+    }
+    localDataLastUpdateTime_.store(metadLastUpdateTime);
+    diff(oldData->localCache_, metaData_->localCache_);
     ready_ = true;
     return true;
 }
 
+void MetaClient::copySpaceMaps(const std::unordered_set<GraphSpaceID>& spaces,
+                               const MetaData& from,
+                               MetaData& to) {
+    auto copy = [&spaces] (const auto& fromMap, auto& toMap, auto getSpace) {
+        for (auto& entry : fromMap) {
+            if (spaces.count(getSpace(entry.first)) != 0) {
+                toMap.emplace(entry);
+            }
+        }
+    };
+    auto first = [] (const auto& key) { return key.first; };
+    auto self = [] (GraphSpaceID spaceId) { return spaceId; };
+    copy(from.spaceTagIndexByName_, to.spaceTagIndexByName_, first);
+    copy(from.spaceEdgeIndexByName_, to.spaceEdgeIndexByName_, first);
+    copy(from.spaceEdgeIndexByType_, to.spaceEdgeIndexByType_, first);
+    copy(from.spaceTagIndexById_, to.spaceTagIndexById_, first);
+    copy(from.spaceNewestTagVerMap_, to.spaceNewestTagVerMap_, first);
+    copy(from.spaceNewestEdgeVerMap_, to.spaceNewestEdgeVerMap_, first);
+    copy(from.spaceAllEdgeMap_, to.spaceAllEdgeMap_, self);
+    copy(from.spaceAllTagMap_, to.spaceAllTagMap_, self);
+}
+
 static TagSchemas __buildTagSchemas(std::vector<cpp2::TagItem> tagItemVec) {
     TagSchemas tagSchemas;
     for (auto& tagIt : tagItemVec) {
@@ -400,42 +436,25 @@ bool MetaClient::loadIndexes(GraphSpaceID spaceId,
     return true;
 }
 
-const MetaClient::ThreadLocalInfo& MetaClient::getThreadLocalInfo() {
+const MetaClient::MetaData& MetaClient::getMetaData() {
     ThreadLocalInfo& threadLocalInfo = folly::SingletonThreadLocal<ThreadLocalInfo>::get();
 
-    if (threadLocalInfo.localLastUpdateTime_ < localDataLastUpdateTime_) {
+    if (threadLocalInfo.client_ != this
+            || threadLocalInfo.localLastUpdateTime_ < localDataLastUpdateTime_) {
+        // Read the time first, the meta data published along with it is newer
         threadLocalInfo.localLastUpdateTime_ = localDataLastUpdateTime_;
-
-        folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-        for (auto& spaceInfo : localCache_) {
-            GraphSpaceID spaceId = spaceInfo.first;
-            std::shared_ptr<SpaceInfoCache> info = spaceInfo.second;
-            std::shared_ptr<SpaceInfoCache> infoDeepCopy = std::make_shared<SpaceInfoCache>(*info);
-            infoDeepCopy->tagSchemas_ = __buildTagSchemas(infoDeepCopy->tagItemVec_);
-            infoDeepCopy->edgeSchemas_ = __buildEdgeSchemas(infoDeepCopy->edgeItemVec_);
-            infoDeepCopy->tagIndexes_ = __buildIndexes(infoDeepCopy->tagIndexItemVec_);
-            infoDeepCopy->edgeIndexes_ = __buildIndexes(infoDeepCopy->edgeIndexItemVec_);
-            threadLocalInfo.localCache_[spaceId] = infoDeepCopy;
-        }
-        threadLocalInfo.spaceIndexByName_ = spaceIndexByName_;
-        threadLocalInfo.spaceTagIndexByName_ = spaceTagIndexByName_;
-        threadLocalInfo.spaceEdgeIndexByName_ = spaceEdgeIndexByName_;
-        threadLocalInfo.spaceNewestTagVerMap_ = spaceNewestTagVerMap_;
-        threadLocalInfo.spaceNewestEdgeVerMap_ = spaceNewestEdgeVerMap_;
-        threadLocalInfo.spaceEdgeIndexByType_ = spaceEdgeIndexByType_;
-        threadLocalInfo.spaceTagIndexById_ = spaceTagIndexById_;
-        threadLocalInfo.spaceAllEdgeMap_ = spaceAllEdgeMap_;
-        threadLocalInfo.spaceAllTagMap_ = spaceAllTagMap_;
+        threadLocalInfo.metaData_ = std::atomic_load(&metaData_);
+        threadLocalInfo.client_ = this;
     }
 
-    return threadLocalInfo;
+    return *threadLocalInfo.metaData_;
 }
 
 Status MetaClient::checkTagIndexed(GraphSpaceID space, TagID tagID) {
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto it = threadLocalInfo.localCache_.find(space);
-    if (it != threadLocalInfo.localCache_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto it = metaData.localCache_.find(space);
+    if (it != metaData.localCache_.end()) {
         auto tagIt = it->second->tagIndexes_.find(tagID);
         if (tagIt != it->second->tagIndexes_.end()) {
             return Status::OK();
@@ -448,9 +467,9 @@ Status MetaClient::checkTagIndexed(GraphSpaceID space, TagID tagID) {
 
 Status MetaClient::checkEdgeIndexed(GraphSpaceID space, EdgeType edgeType) {
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto it = threadLocalInfo.localCache_.find(space);
-    if (it != threadLocalInfo.localCache_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto it = metaData.localCache_.find(space);
+    if (it != metaData.localCache_.end()) {
         auto edgeIt = it->second->edgeIndexes_.find(edgeType);
         if (edgeIt != it->second->edgeIndexes_.end()) {
             return Status::OK();
@@ -753,6 +772,18 @@ folly::Future<StatusOr<std::vector<SpaceIdName>>> MetaClient::listSpaces() {
     return future;
 }
 
+folly::Future<StatusOr<cpp2::ListSpacesResp>> MetaClient::listSpacesWithVersions() {
+    cpp2::ListSpacesReq req;
+    folly::Promise<StatusOr<cpp2::ListSpacesResp>> promise;
+    auto future = promise.getFuture();
+    getResponse(std::move(req), [] (auto client, auto request) {
+                    return client->future_listSpaces(request);
+                }, [] (cpp2::ListSpacesResp&& resp) -> cpp2::ListSpacesResp {
+                    return std::move(resp);
+                }, std::move(promise));
+    return future;
+}
+
 folly::Future<StatusOr<cpp2::AdminJobResult>>
 MetaClient::submitJob(cpp2::AdminJobOp op, std::vector<std::string> paras) {
     cpp2::AdminJobReq req;
@@ -848,9 +879,9 @@ MetaClient::getSpaceIdByNameFromCache(const std::string& name) {
         return Status::Error("Not ready!");
     }
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto it = threadLocalInfo.spaceIndexByName_.find(name);
-    if (it != threadLocalInfo.spaceIndexByName_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto it = metaData.spaceIndexByName_.find(name);
+    if (it != metaData.spaceIndexByName_.end()) {
         return it->second;
     }
     return Status::SpaceNotFound();
@@ -863,9 +894,9 @@ StatusOr<TagID> MetaClient::getTagIDByNameFromCache(const GraphSpaceID& space,
         return Status::Error("Not ready!");
     }
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto it = threadLocalInfo.spaceTagIndexByName_.find(std::make_pair(space, name));
-    if (it == threadLocalInfo.spaceTagIndexByName_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto it = metaData.spaceTagIndexByName_.find(std::make_pair(space, name));
+    if (it == metaData.spaceTagIndexByName_.end()) {
         std::string error = folly::stringPrintf("TagName `%s'  is nonexistent", name.c_str());
         return Status::Error(std::move(error));
     }
@@ -878,9 +909,9 @@ StatusOr<std::string> MetaClient::getTagNameByIdFromCache(const GraphSpaceID& sp
         return Status::Error("Not ready!");
     }
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto it = threadLocalInfo.spaceTagIndexById_.find(std::make_pair(space, tagId));
-    if (it == threadLocalInfo.spaceTagIndexById_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto it = metaData.spaceTagIndexById_.find(std::make_pair(space, tagId));
+    if (it == metaData.spaceTagIndexById_.end()) {
         std::string error = folly::stringPrintf("TagID `%d'  is nonexistent", tagId);
         return Status::Error(std::move(error));
     }
@@ -894,9 +925,9 @@ StatusOr<EdgeType> MetaClient::getEdgeTypeByNameFromCache(const GraphSpaceID& sp
         return Status::Error("Not ready!");
     }
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto it = threadLocalInfo.spaceEdgeIndexByName_.find(std::make_pair(space, name));
-    if (it == threadLocalInfo.spaceEdgeIndexByName_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto it = metaData.spaceEdgeIndexByName_.find(std::make_pair(space, name));
+    if (it == metaData.spaceEdgeIndexByName_.end()) {
         std::string error = folly::stringPrintf("EdgeName `%s'  is nonexistent", name.c_str());
         return Status::Error(std::move(error));
     }
@@ -909,9 +940,9 @@ StatusOr<std::string> MetaClient::getEdgeNameByTypeFromCache(const GraphSpaceID&
         return Status::Error("Not ready!");
     }
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto it = threadLocalInfo.spaceEdgeIndexByType_.find(std::make_pair(space, edgeType));
-    if (it == threadLocalInfo.spaceEdgeIndexByType_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto it = metaData.spaceEdgeIndexByType_.find(std::make_pair(space, edgeType));
+    if (it == metaData.spaceEdgeIndexByType_.end()) {
         std::string error = folly::stringPrintf("EdgeType `%d'  is nonexistent", edgeType);
         return Status::Error(std::move(error));
     }
@@ -923,9 +954,9 @@ StatusOr<std::vector<std::string>> MetaClient::getAllEdgeFromCache(const GraphSp
         return Status::Error("Not ready!");
     }
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto it = threadLocalInfo.spaceAllEdgeMap_.find(space);
-    if (it == threadLocalInfo.spaceAllEdgeMap_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto it = metaData.spaceAllEdgeMap_.find(space);
+    if (it == metaData.spaceAllEdgeMap_.end()) {
         std::string error = folly::stringPrintf("SpaceId `%d'  is nonexistent", space);
         return Status::Error(std::move(error));
     }
@@ -937,9 +968,9 @@ StatusOr<std::vector<std::string>> MetaClient::getAllTagFromCache(const GraphSpa
         return Status::Error("Not ready!");
     }
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto it = threadLocalInfo.spaceAllTagMap_.find(space);
-    if (it == threadLocalInfo.spaceAllTagMap_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto it = metaData.spaceAllTagMap_.find(space);
+    if (it == metaData.spaceAllTagMap_.end()) {
         std::string error = folly::stringPrintf("SpaceId `%d'  is nonexistent", space);
         return Status::Error(std::move(error));
     }
@@ -1078,16 +1109,16 @@ MetaClient::removeRange(std::string segment, std::string start, std::string end)
 
 PartsMap MetaClient::getPartsMapFromCache(const HostAddr& host) {
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    return doGetPartsMap(host, threadLocalInfo.localCache_);
+    const MetaData& metaData = getMetaData();
+    return doGetPartsMap(host, metaData.localCache_);
 }
 
 
 StatusOr<PartMeta> MetaClient::getPartMetaFromCache(GraphSpaceID spaceId, PartitionID partId) {
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto it = threadLocalInfo.localCache_.find(spaceId);
-    if (it == threadLocalInfo.localCache_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto it = metaData.localCache_.find(spaceId);
+    if (it == metaData.localCache_.end()) {
         return Status::Error("Space not found, spaceid: %d", spaceId);
     }
     auto& cache = it->second;
@@ -1107,9 +1138,9 @@ Status  MetaClient::checkPartExistInCache(const HostAddr& host,
                                           GraphSpaceID spaceId,
                                           PartitionID partId) {
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto it = threadLocalInfo.localCache_.find(spaceId);
-    if (it != threadLocalInfo.localCache_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto it = metaData.localCache_.find(spaceId);
+    if (it != metaData.localCache_.end()) {
         auto partsIt = it->second->partsOnHost_.find(host);
         if (partsIt != it->second->partsOnHost_.end()) {
             for (auto& pId : partsIt->second) {
@@ -1128,9 +1159,9 @@ Status  MetaClient::checkPartExistInCache(const HostAddr& host,
 Status MetaClient::checkSpaceExistInCache(const HostAddr& host,
                                           GraphSpaceID spaceId) {
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto it = threadLocalInfo.localCache_.find(spaceId);
-    if (it != threadLocalInfo.localCache_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto it = metaData.localCache_.find(spaceId);
+    if (it != metaData.localCache_.end()) {
         auto partsIt = it->second->partsOnHost_.find(host);
         if (partsIt != it->second->partsOnHost_.end() && !partsIt->second.empty()) {
             return Status::OK();
@@ -1143,9 +1174,9 @@ Status MetaClient::checkSpaceExistInCache(const HostAddr& host,
 
 StatusOr<int32_t> MetaClient::partsNum(GraphSpaceID spaceId) {
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto it = threadLocalInfo.localCache_.find(spaceId);
-    if (it == threadLocalInfo.localCache_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto it = metaData.localCache_.find(spaceId);
+    if (it == metaData.localCache_.end()) {
         return Status::Error("Space not found, spaceid: %d", spaceId);
     }
     return it->second->partsAlloc_.size();
@@ -1333,13 +1364,15 @@ MetaClient::createTagIndex(GraphSpaceID spaceID,
                            std::string  indexName,
                            std::string  tagName,
                            std::vector<std::string> fields,
-                           bool ifNotExists) {
+                           bool ifNotExists,
+                           nebula::cpp2::IndexType indexType) {
     cpp2::CreateTagIndexReq req;
     req.set_space_id(spaceID);
     req.set_index_name(std::move(indexName));
     req.set_tag_name(std::move(tagName));
     req.set_fields(std::move(fields));
     req.set_if_not_exists(ifNotExists);
+    req.set_index_type(indexType);
 
     folly::Promise<StatusOr<IndexID>> promise;
     auto future = promise.getFuture();
@@ -1549,9 +1582,9 @@ MetaClient::getTagSchemaFromCache(GraphSpaceID spaceId, TagID tagID, SchemaVer v
         return Status::Error("Not ready!");
     }
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto spaceIt = threadLocalInfo.localCache_.find(spaceId);
-    if (spaceIt == threadLocalInfo.localCache_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto spaceIt = metaData.localCache_.find(spaceId);
+    if (spaceIt == metaData.localCache_.end()) {
         LOG(ERROR) << "Space " << spaceId << " not found!";
         return std::shared_ptr<const SchemaProviderIf>();
     } else {
@@ -1571,9 +1604,9 @@ MetaClient::getEdgeSchemaFromCache(GraphSpaceID spaceId, EdgeType edgeType, Sche
         return Status::Error("Not ready!");
     }
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto spaceIt = threadLocalInfo.localCache_.find(spaceId);
-    if (spaceIt == threadLocalInfo.localCache_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto spaceIt = metaData.localCache_.find(spaceId);
+    if (spaceIt == metaData.localCache_.end()) {
         LOG(ERROR) << "Space " << spaceId << " not found!";
         return std::shared_ptr<const SchemaProviderIf>();
     } else {
@@ -1631,9 +1664,9 @@ MetaClient::getTagIndexFromCache(GraphSpaceID spaceId, IndexID indexID) {
     }
 
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto spaceIt = threadLocalInfo.localCache_.find(spaceId);
-    if (spaceIt == threadLocalInfo.localCache_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto spaceIt = metaData.localCache_.find(spaceId);
+    if (spaceIt == metaData.localCache_.end()) {
         LOG(ERROR) << "Space " << spaceId << " not found!";
         return Status::SpaceNotFound();
     } else {
@@ -1670,9 +1703,9 @@ MetaClient::getEdgeIndexFromCache(GraphSpaceID spaceId, IndexID indexID) {
     }
 
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto spaceIt = threadLocalInfo.localCache_.find(spaceId);
-    if (spaceIt == threadLocalInfo.localCache_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto spaceIt = metaData.localCache_.find(spaceId);
+    if (spaceIt == metaData.localCache_.end()) {
         VLOG(3) << "Space " << spaceId << " not found!";
         return Status::SpaceNotFound();
     } else {
@@ -1709,9 +1742,9 @@ MetaClient::getTagIndexesFromCache(GraphSpaceID spaceId) {
     }
 
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto spaceIt = threadLocalInfo.localCache_.find(spaceId);
-    if (spaceIt == threadLocalInfo.localCache_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto spaceIt = metaData.localCache_.find(spaceId);
+    if (spaceIt == metaData.localCache_.end()) {
         VLOG(3) << "Space " << spaceId << " not found!";
         return Status::SpaceNotFound();
     } else {
@@ -1733,9 +1766,9 @@ MetaClient::getEdgeIndexesFromCache(GraphSpaceID spaceId) {
     }
 
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto spaceIt = threadLocalInfo.localCache_.find(spaceId);
-    if (spaceIt == threadLocalInfo.localCache_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto spaceIt = metaData.localCache_.find(spaceId);
+    if (spaceIt == metaData.localCache_.end()) {
         VLOG(3) << "Space " << spaceId << " not found!";
         return Status::SpaceNotFound();
     } else {
@@ -1785,9 +1818,9 @@ StatusOr<SchemaVer> MetaClient::getLatestTagVersionFromCache(const GraphSpaceID&
         return Status::Error("Not ready!");
     }
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto it = threadLocalInfo.spaceNewestTagVerMap_.find(std::make_pair(space, tagId));
-    if (it == threadLocalInfo.spaceNewestTagVerMap_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto it = metaData.spaceNewestTagVerMap_.find(std::make_pair(space, tagId));
+    if (it == metaData.spaceNewestTagVerMap_.end()) {
         return Status::TagNotFound();
     }
     return it->second;
@@ -1799,9 +1832,9 @@ StatusOr<SchemaVer> MetaClient::getLatestEdgeVersionFromCache(const GraphSpaceID
         return Status::Error("Not ready!");
     }
 //    folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    const ThreadLocalInfo& threadLocalInfo = getThreadLocalInfo();
-    auto it = threadLocalInfo.spaceNewestEdgeVerMap_.find(std::make_pair(space, edgeType));
-    if (it == threadLocalInfo.spaceNewestEdgeVerMap_.end()) {
+    const MetaData& metaData = getMetaData();
+    auto it = metaData.spaceNewestEdgeVerMap_.find(std::make_pair(space, edgeType));
+    if (it == metaData.spaceNewestEdgeVerMap_.end()) {
         return Status::EdgeNotFound();
     }
     return it->second;
@@ -2296,7 +2329,7 @@ void MetaClient::updateNestedGflags(const std::string& name) {
         optionMap.emplace(key, val.asString());
     });
     folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-    for (const auto& spaceEntry : localCache_) {
+    for (const auto& spaceEntry : metaData_->localCache_) {
         listener_->onSpaceOptionUpdated(spaceEntry.first, optionMap);
     }
 }
@@ -56,6 +56,8 @@ struct SpaceInfoCache {
     Indexes tagIndexes_;
     std::vector<nebula::cpp2::IndexItem> edgeIndexItemVec_;
     Indexes edgeIndexes_;
+    // The last time the space changed on metad, 0 if unknown
+    int64_t version_{0};
 };
 
 using LocalCache = std::unordered_map<GraphSpaceID, std::shared_ptr<SpaceInfoCache>>;
@@ -185,6 +187,7 @@ class MetaClient {
     FRIEND_TEST(MetaClientTest, RetryOnceTest);
     FRIEND_TEST(MetaClientTest, RetryUntilLimitTest);
     FRIEND_TEST(MetaClientTest, RocksdbOptionsTest);
+    FRIEND_TEST(MetaClientTest, IncrementalLoadTest);
 
 public:
     MetaClient(std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool,
@@ -284,7 +287,8 @@ public:
                    std::string indexName,
                    std::string tagName,
                    std::vector<std::string> fields,
-                   bool ifNotExists = false);
+                   bool ifNotExists = false,
+                   nebula::cpp2::IndexType indexType = nebula::cpp2::IndexType::NORMAL);
 
     // Remove the define of tag index
     folly::Future<StatusOr<bool>>
@@ -524,6 +528,9 @@ protected:
     bool loadIndexes(GraphSpaceID spaceId,
                      std::shared_ptr<SpaceInfoCache> cache);
 
+    // List the spaces along with the versions of them
+    folly::Future<StatusOr<cpp2::ListSpacesResp>> listSpacesWithVersions();
+
     folly::Future<StatusOr<bool>> heartbeat();
 
     std::unordered_map<HostAddr, std::vector<PartitionID>> reverse(const PartsAlloc& parts);
@@ -585,8 +592,13 @@ private:
     std::atomic<int64_t>  localCfgLastUpdateTime_{-1};
     std::atomic<int64_t>  metadLastUpdateTime_{0};
 
-    struct ThreadLocalInfo {
-        int64_t               localLastUpdateTime_{-1};
+    /**
+     * The meta data loaded, which is never modified once published, so all
+     * threads could read it without copying. Each load publishes a new one,
+     * in which the spaces not changed share the SpaceInfoCache with the
+     * old one.
+     * */
+    struct MetaData {
         LocalCache            localCache_;
         SpaceNameIdMap        spaceIndexByName_;
         SpaceTagNameIdMap     spaceTagIndexByName_;
@@ -599,9 +611,28 @@ private:
         SpaceAllTagMap        spaceAllTagMap_;
     };
 
-    const ThreadLocalInfo& getThreadLocalInfo();
+    // Each thread holds the meta data it read, which is refreshed only when
+    // a newer one is published, so the readers share nothing in common.
+    struct ThreadLocalInfo {
+        const MetaClient*               client_{nullptr};
+        int64_t                         localLastUpdateTime_{-1};
+        std::shared_ptr<const MetaData> metaData_;
+    };
+
+    /**
+     * Return the latest meta data, it is valid until the next call
+     * in the same thread.
+     * */
+    const MetaData& getMetaData();
+
+    // Copy the entries of the spaces in the maps of the meta data
+    static void copySpaceMaps(const std::unordered_set<GraphSpaceID>& spaces,
+                              const MetaData& from,
+                              MetaData& to);
 
-    LocalCache localCache_;
+    // Published with std::atomic_store under localCacheLock_, read with
+    // std::atomic_load by the threads without the lock
+    std::shared_ptr<const MetaData> metaData_{std::make_shared<const MetaData>()};
     std::vector<HostAddr> addrs_;
     // The lock used to protect active_ and leader_.
     folly::RWSpinLock hostLock_;
@@ -610,15 +641,6 @@ private:
     HostAddr localHost_;
 
     std::unique_ptr<thread::GenericWorker> bgThread_;
-    SpaceNameIdMap        spaceIndexByName_;
-    SpaceTagNameIdMap     spaceTagIndexByName_;
-    SpaceEdgeNameTypeMap  spaceEdgeIndexByName_;
-    SpaceEdgeTypeNameMap  spaceEdgeIndexByType_;
-    SpaceTagIdNameMap     spaceTagIndexById_;
-    SpaceNewestTagVerMap  spaceNewestTagVerMap_;
-    SpaceNewestEdgeVerMap spaceNewestEdgeVerMap_;
-    SpaceAllEdgeMap       spaceAllEdgeMap_;
-    SpaceAllTagMap        spaceAllTagMap_;
 
     UserRolesMap          userRolesMap_;
     UserPasswordMap       userPasswordMap_;
@@ -369,6 +369,13 @@ kvstore::ResultCode BaseProcessor<RESP>::doSyncPut(std::vector<kvstore::KV> data
 
 template<typename RESP>
 void BaseProcessor<RESP>::doSyncPutAndUpdate(std::vector<kvstore::KV> data) {
+    std::unordered_set<GraphSpaceID> spaces;
+    for (auto& kv : data) {
+        auto spaceId = MetaServiceUtils::spaceIdOfKey(kv.first);
+        if (spaceId >= 0) {
+            spaces.emplace(spaceId);
+        }
+    }
     folly::Baton<true, std::atomic> baton;
     auto ret = kvstore::ResultCode::SUCCEEDED;
     kvstore_->asyncMultiPut(kDefaultSpaceId,
@@ -387,13 +394,31 @@ void BaseProcessor<RESP>::doSyncPutAndUpdate(std::vector<kvstore::KV> data) {
         this->onFinished();
         return;
     }
-    ret = LastUpdateTimeMan::update(kvstore_, time::WallClock::fastNowInMilliSec());
+    ret = LastUpdateTimeMan::update(kvstore_, time::WallClock::fastNowInMilliSec(), spaces);
     this->handleErrorCode(MetaCommon::to(ret));
     this->onFinished();
 }
 
 template<typename RESP>
 void BaseProcessor<RESP>::doSyncMultiRemoveAndUpdate(std::vector<std::string> keys) {
+    std::unordered_set<GraphSpaceID> spaces;
+    std::vector<GraphSpaceID> droppedSpaces;
+    for (auto& key : keys) {
+        auto spaceId = MetaServiceUtils::spaceIdOfKey(key);
+        if (spaceId < 0) {
+            continue;
+        }
+        if (key == MetaServiceUtils::spaceKey(spaceId)) {
+            droppedSpaces.emplace_back(spaceId);
+        } else {
+            spaces.emplace(spaceId);
+        }
+    }
+    // The update time of the space dropped is removed along with it
+    for (auto spaceId : droppedSpaces) {
+        spaces.erase(spaceId);
+        keys.emplace_back(MetaServiceUtils::spaceUpdateTimeKey(spaceId));
+    }
     folly::Baton<true, std::atomic> baton;
     auto ret = kvstore::ResultCode::SUCCEEDED;
     kvstore_->asyncMultiRemove(kDefaultSpaceId,
@@ -412,7 +437,7 @@ void BaseProcessor<RESP>::doSyncMultiRemoveAndUpdate(std::vector<std::string> ke
         this->onFinished();
         return;
     }
-    ret = LastUpdateTimeMan::update(kvstore_, time::WallClock::fastNowInMilliSec());
+    ret = LastUpdateTimeMan::update(kvstore_, time::WallClock::fastNowInMilliSec(), spaces);
     this->handleErrorCode(MetaCommon::to(ret));
     this->onFinished();
 }
@@ -73,6 +73,10 @@ public:
         return taskIdStr_;
     }
 
+    GraphSpaceID spaceId() const {
+        return spaceId_;
+    }
+
     void invoke();
 
     void rollback();
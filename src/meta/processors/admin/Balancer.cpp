@@ -20,6 +20,15 @@ DEFINE_double(leader_balance_deviation, 0.05, "after leader balance, leader coun
 namespace nebula {
 namespace meta {
 
+// The spaces whose parts are moved by the plan
+static std::unordered_set<GraphSpaceID> spacesOf(const BalancePlan& plan) {
+    std::unordered_set<GraphSpaceID> spaces;
+    for (auto& task : plan.tasks()) {
+        spaces.emplace(task.spaceId());
+    }
+    return spaces;
+}
+
 ErrorOr<cpp2::ErrorCode, BalanceID> Balancer::balance(std::unordered_set<HostAddr> hostDel) {
     std::lock_guard<std::mutex> lg(lock_);
     if (!running_) {
@@ -113,7 +122,9 @@ cpp2::ErrorCode Balancer::recovery() {
             auto self = plan_;
             {
                 std::lock_guard<std::mutex> lg(lock_);
-                if (LastUpdateTimeMan::update(kv_, time::WallClock::fastNowInMilliSec()) !=
+                if (LastUpdateTimeMan::update(kv_,
+                                              time::WallClock::fastNowInMilliSec(),
+                                              spacesOf(*plan_)) !=
                         kvstore::ResultCode::SUCCEEDED) {
                     LOG(INFO) << "Balance plan " << plan_->id() << " update meta failed";
                 }
@@ -171,7 +182,9 @@ cpp2::ErrorCode Balancer::buildBalancePlan(std::unordered_set<HostAddr> hostDel)
         auto self = plan_;
         {
             std::lock_guard<std::mutex> lg(lock_);
-            if (LastUpdateTimeMan::update(kv_, time::WallClock::fastNowInMilliSec()) !=
+            if (LastUpdateTimeMan::update(kv_,
+                                          time::WallClock::fastNowInMilliSec(),
+                                          spacesOf(*plan_)) !=
                     kvstore::ResultCode::SUCCEEDED) {
                 LOG(INFO) << "Balance plan " << plan_->id() << " update meta failed";
             }
@@ -15,12 +15,19 @@ void CreateTagIndexProcessor::process(const cpp2::CreateTagIndexReq& req) {
     const auto &indexName = req.get_index_name();
     auto &tagName = req.get_tag_name();
     auto &fieldNames = req.get_fields();
+    auto indexType = req.get_index_type();
     if (fieldNames.empty()) {
         LOG(ERROR) << "The index field of an tag should not be empty.";
         handleErrorCode(cpp2::ErrorCode::E_INVALID_PARM);
         onFinished();
         return;
     }
+    if (indexType == nebula::cpp2::IndexType::GEO && fieldNames.size() != 1) {
+        LOG(ERROR) << "The geo index should be on exactly one field.";
+        handleErrorCode(cpp2::ErrorCode::E_INVALID_PARM);
+        onFinished();
+        return;
+    }
     std::set<std::string> columnSet(fieldNames.begin(), fieldNames.end());
     if (fieldNames.size() != columnSet.size()) {
         LOG(ERROR) << "Conflict field in the tag index.";
@@ -65,7 +72,8 @@ void CreateTagIndexProcessor::process(const cpp2::CreateTagIndexReq& req) {
         auto item = MetaServiceUtils::parseIndex(val);
         if (item.get_schema_id().getType() != nebula::cpp2::SchemaID::Type::tag_id ||
             fieldNames.size() > item.get_fields().size() ||
-            tagID != item.get_schema_id().get_tag_id()) {
+            tagID != item.get_schema_id().get_tag_id() ||
+            indexType != item.get_index_type()) {
             checkIter->next();
             continue;
         }
@@ -105,6 +113,13 @@ void CreateTagIndexProcessor::process(const cpp2::CreateTagIndexReq& req) {
             return;
         } else {
             auto type = fields[field];
+            if (indexType == nebula::cpp2::IndexType::GEO &&
+                type.get_type() != nebula::cpp2::SupportedType::STRING) {
+                LOG(ERROR) << "The geo index field " << field << " should be a string";
+                handleErrorCode(cpp2::ErrorCode::E_INVALID_PARM);
+                onFinished();
+                return;
+            }
             nebula::cpp2::ColumnDef column;
             column.set_name(std::move(field));
             column.set_type(std::move(type));
@@ -130,6 +145,7 @@ void CreateTagIndexProcessor::process(const cpp2::CreateTagIndexReq& req) {
     item.set_schema_id(schemaID);
     item.set_schema_name(tagName);
     item.set_fields(std::move(columns));
+    item.set_index_type(indexType);
 
     data.emplace_back(MetaServiceUtils::indexIndexKey(space, indexName),
                       std::string(reinterpret_cast<const char*>(&tagIndex), sizeof(IndexID)));
@@ -31,6 +31,23 @@ void ListSpacesProcessor::process(const cpp2::ListSpacesReq&) {
         iter->next();
     }
     resp_.set_spaces(std::move(spaces));
+
+    ret = kvstore_->prefix(kDefaultSpaceId,
+                           kDefaultPartId,
+                           MetaServiceUtils::spaceUpdateTimePrefix(),
+                           &iter);
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        handleErrorCode(MetaCommon::to(ret));
+        onFinished();
+        return;
+    }
+    std::unordered_map<GraphSpaceID, int64_t> versions;
+    while (iter->valid()) {
+        auto spaceId = MetaServiceUtils::parseSpaceUpdateTimeKey(iter->key());
+        versions.emplace(spaceId, *reinterpret_cast<const int64_t*>(iter->val().data()));
+        iter->next();
+    }
+    resp_.set_versions(std::move(versions));
     onFinished();
 }
 
@@ -1145,6 +1145,91 @@ TEST(MetaClientTest, DiffTest) {
     ASSERT_EQ(9, listener->partNum);
 }
 
+TEST(MetaClientTest, IncrementalLoadTest) {
+    FLAGS_heartbeat_interval_secs = 1;
+    fs::TempDir rootPath("/tmp/IncrementalLoadTest.XXXXXX");
+    int32_t localMetaPort = 0;
+    auto sc = TestUtils::mockMetaServer(localMetaPort, rootPath.path());
+
+    auto threadPool = std::make_shared<folly::IOThreadPoolExecutor>(1);
+    IPv4 localIp;
+    network::NetworkUtils::ipv4ToInt("127.0.0.1", localIp);
+    auto client = std::make_shared<MetaClient>(threadPool,
+                                               std::vector<HostAddr>{
+                                                    HostAddr(localIp, sc->port_)});
+    client->waitForMetadReady();
+    std::vector<HostAddr> hosts = {{0, 0}};
+    TestUtils::registerHB(sc->kvStore_.get(), hosts);
+
+    auto createTag = [&client] (GraphSpaceID spaceId, const std::string& name) {
+        std::vector<nebula::cpp2::ColumnDef> columns;
+        columns.emplace_back();
+        columns.back().set_name("col");
+        ValueType vt;
+        vt.set_type(SupportedType::INT);
+        columns.back().set_type(vt);
+        nebula::cpp2::Schema schema;
+        schema.set_columns(std::move(columns));
+        auto ret = client->createTagSchema(spaceId, name, std::move(schema)).get();
+        ASSERT_TRUE(ret.ok()) << ret.status();
+    };
+
+    auto ret1 = client->createSpace(SpaceDesc("space_1", 3, 1)).get();
+    ASSERT_TRUE(ret1.ok()) << ret1.status();
+    auto spaceId1 = ret1.value();
+    auto ret2 = client->createSpace(SpaceDesc("space_2", 3, 1)).get();
+    ASSERT_TRUE(ret2.ok()) << ret2.status();
+    auto spaceId2 = ret2.value();
+    createTag(spaceId1, "tag_1");
+    createTag(spaceId2, "tag_2");
+    sleep(FLAGS_heartbeat_interval_secs + 1);
+
+    std::shared_ptr<SpaceInfoCache> space1, space2;
+    {
+        const auto& metaData = client->getMetaData();
+        ASSERT_EQ(2, metaData.localCache_.size());
+        space1 = metaData.localCache_.at(spaceId1);
+        space2 = metaData.localCache_.at(spaceId2);
+        ASSERT_LT(0, space1->version_);
+        ASSERT_LT(0, space2->version_);
+    }
+
+    // Only the space changed is loaded again
+    createTag(spaceId2, "tag_3");
+    sleep(FLAGS_heartbeat_interval_secs + 1);
+    {
+        const auto& metaData = client->getMetaData();
+        ASSERT_EQ(2, metaData.localCache_.size());
+        ASSERT_EQ(space1, metaData.localCache_.at(spaceId1));
+        ASSERT_NE(space2, metaData.localCache_.at(spaceId2));
+        ASSERT_LT(space2->version_, metaData.localCache_.at(spaceId2)->version_);
+    }
+    ASSERT_TRUE(client->getTagIDByNameFromCache(spaceId1, "tag_1").ok());
+    ASSERT_TRUE(client->getTagIDByNameFromCache(spaceId2, "tag_2").ok());
+    ASSERT_TRUE(client->getTagIDByNameFromCache(spaceId2, "tag_3").ok());
+    ASSERT_EQ(1, client->getAllTagFromCache(spaceId1).value().size());
+    ASSERT_EQ(2, client->getAllTagFromCache(spaceId2).value().size());
+
+    // The space dropped is gone along with its version
+    {
+        auto ret = client->dropSpace("space_2").get();
+        ASSERT_TRUE(ret.ok()) << ret.status();
+    }
+    sleep(FLAGS_heartbeat_interval_secs + 1);
+    {
+        const auto& metaData = client->getMetaData();
+        ASSERT_EQ(1, metaData.localCache_.size());
+        ASSERT_EQ(space1, metaData.localCache_.at(spaceId1));
+    }
+    ASSERT_FALSE(client->getTagIDByNameFromCache(spaceId2, "tag_2").ok());
+    {
+        auto ret = client->listSpacesWithVersions().get();
+        ASSERT_TRUE(ret.ok()) << ret.status();
+        ASSERT_EQ(1, ret.value().get_versions().size());
+        ASSERT_EQ(1, ret.value().get_versions().count(spaceId1));
+    }
+}
+
 TEST(MetaClientTest, HeartbeatTest) {
     FLAGS_heartbeat_interval_secs = 1;
     const nebula::ClusterID kClusterId = 10;
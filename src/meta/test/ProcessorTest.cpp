@@ -2268,6 +2268,61 @@ TEST(ProcessorTest, TagIndexTest) {
     }
 }
 
+TEST(ProcessorTest, GeoTagIndexTest) {
+    fs::TempDir rootPath("/tmp/GeoTagIndexTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    TestUtils::createSomeHosts(kv.get());
+    ASSERT_TRUE(TestUtils::assembleSpace(kv.get(), 1, 1));
+    TestUtils::mockTag(kv.get(), 1);
+    auto createIndex = [&kv] (const std::string& name, std::vector<std::string> fields) {
+        cpp2::CreateTagIndexReq req;
+        req.set_space_id(1);
+        req.set_tag_name("tag_0");
+        req.set_fields(std::move(fields));
+        req.set_index_name(name);
+        req.set_index_type(nebula::cpp2::IndexType::GEO);
+        auto* processor = CreateTagIndexProcessor::instance(kv.get());
+        auto f = processor->getFuture();
+        processor->process(req);
+        return std::move(f).get().get_code();
+    };
+    // Not a string field
+    ASSERT_EQ(cpp2::ErrorCode::E_INVALID_PARM, createIndex("geo_index", {"tag_0_col_0"}));
+    // More than one field
+    ASSERT_EQ(cpp2::ErrorCode::E_INVALID_PARM,
+              createIndex("geo_index", {"tag_0_col_1", "tag_0_col_0"}));
+    ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, createIndex("geo_index", {"tag_0_col_1"}));
+    ASSERT_EQ(cpp2::ErrorCode::E_EXISTED, createIndex("another_geo_index", {"tag_0_col_1"}));
+    {
+        // The normal index on the same field is not the same one
+        cpp2::CreateTagIndexReq req;
+        req.set_space_id(1);
+        req.set_tag_name("tag_0");
+        std::vector<std::string> fields{"tag_0_col_1"};
+        req.set_fields(std::move(fields));
+        req.set_index_name("normal_index");
+        auto* processor = CreateTagIndexProcessor::instance(kv.get());
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, resp.get_code());
+    }
+    {
+        cpp2::GetTagIndexReq req;
+        req.set_space_id(1);
+        req.set_index_name("geo_index");
+        auto* processor = GetTagIndexProcessor::instance(kv.get());
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, resp.get_code());
+        auto item = resp.get_item();
+        ASSERT_EQ(nebula::cpp2::IndexType::GEO, item.get_index_type());
+        ASSERT_EQ(1, item.get_fields().size());
+        ASSERT_EQ("tag_0_col_1", item.get_fields()[0].get_name());
+    }
+}
+
 TEST(ProcessorTest, EdgeIndexTest) {
     fs::TempDir rootPath("/tmp/EdgeIndexTest.XXXXXX");
     std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
@@ -55,6 +55,8 @@ public:
                 sentences_ = nullptr;
             }
             scanner_.setQuery(nullptr);
+            // They are released along with the sentences
+            scanner_.takeParameters();
             return Status::SyntaxError(error_);
         }
 
@@ -64,6 +66,7 @@ public:
         auto *sentences = sentences_;
         sentences_ = nullptr;
         scanner_.setQuery(nullptr);
+        sentences->setParameters(scanner_.takeParameters());
         return std::unique_ptr<SequentialSentences>(sentences);
     }
 
@@ -51,6 +51,17 @@ public:
         return query_;
     }
 
+    // Called by the parser on each parameter `?', in the order they are in the query
+    void addParameter(PrimaryExpression *expr) {
+        parameters_.emplace_back(expr);
+    }
+
+    std::vector<PrimaryExpression*> takeParameters() {
+        std::vector<PrimaryExpression*> parameters;
+        parameters.swap(parameters_);
+        return parameters;
+    }
+
 protected:
     // Called when YY_INPUT is invoked
     int LexerInput(char *buf, int maxSize) override {
@@ -92,6 +103,7 @@ private:
     size_t                              sbufPos_{0};
     std::function<int(char*, int)>      readBuffer_;
     std::string*                        query_{nullptr};
+    std::vector<PrimaryExpression*>     parameters_;
 };
 
 }   // namespace nebula
@@ -215,6 +215,9 @@ std::string CreateTagIndexSentence::toString() const {
     folly::join(", ", this->names(), columns);
     buf += columns;
     buf += ")";
+    if (isGeo_) {
+        buf += " GEO";
+    }
     return buf;
 }
 
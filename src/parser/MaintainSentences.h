@@ -490,11 +490,13 @@ public:
     CreateTagIndexSentence(std::string *indexName,
                            std::string *tagName,
                            ColumnNameList *columns,
-                           bool ifNotExists)
+                           bool ifNotExists,
+                           bool isGeo = false)
         : CreateSentence(ifNotExists) {
         indexName_.reset(indexName);
         tagName_.reset(tagName);
         columns_.reset(columns);
+        isGeo_ = isGeo;
         kind_ = Kind::kCreateTagIndex;
     }
 
@@ -517,10 +519,16 @@ public:
         return result;
     }
 
+    // The index keyed by the S2 cell of the point in its field
+    bool isGeo() const {
+        return isGeo_;
+    }
+
 private:
     std::unique_ptr<std::string>                indexName_;
     std::unique_ptr<std::string>                tagName_;
     std::unique_ptr<ColumnNameList>             columns_;
+    bool                                        isGeo_{false};
 };
 
 
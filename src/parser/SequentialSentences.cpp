@@ -12,6 +12,9 @@ namespace nebula {
 std::string SequentialSentences::toString() const {
     std::string buf;
     buf.reserve(1024);
+    if (profile_) {
+        buf += "PROFILE ";
+    }
     auto i = 0UL;
     buf += sentences_[i++]->toString();
     for ( ; i < sentences_.size(); i++) {
@@ -40,9 +40,33 @@ public:
 
     std::string toString() const;
 
+    void setParameters(std::vector<PrimaryExpression*> parameters) {
+        parameters_ = std::move(parameters);
+    }
+
+    /**
+     * The parameters `?' in the sentences, in the order they are in the query.
+     * Their values are bound before execution, see PrimaryExpression::setValue().
+     */
+    const std::vector<PrimaryExpression*>& parameters() const {
+        return parameters_;
+    }
+
+    // `PROFILE' the sentences, i.e. the execution profile is returned along with the result
+    void setProfile(bool profile) {
+        profile_ = profile;
+    }
+
+    bool isProfile() const {
+        return profile_;
+    }
+
 private:
     friend class nebula::graph::SequentialExecutor;
     std::vector<std::unique_ptr<Sentence>>      sentences_;
+    // Owned by the sentences
+    std::vector<PrimaryExpression*>             parameters_;
+    bool                                        profile_{false};
 };
 
 
@@ -33,6 +33,9 @@ static constexpr size_t MAX_ABS_INTEGER = 9223372036854775808ULL;
 
     void ifOutOfRange(const int64_t input,
                       const nebula::GraphParser::location_type& loc);
+
+    // Create the expression of a parameter, whose value is bound on execution
+    nebula::Expression* newParameter(nebula::GraphScanner& scanner);
 }
 
 %union {
@@ -125,12 +128,12 @@ static constexpr size_t MAX_ABS_INTEGER = 9223372036854775808ULL;
 %token KW_USER KW_USERS KW_ACCOUNT
 %token KW_PASSWORD KW_CHANGE KW_ROLE KW_ROLES
 %token KW_GOD KW_ADMIN KW_DBA KW_GUEST KW_GRANT KW_REVOKE KW_ON
-%token KW_CONTAINS
+%token KW_CONTAINS KW_PROFILE KW_GEO
 
 /* symbols */
 %token L_PAREN R_PAREN L_BRACKET R_BRACKET L_BRACE R_BRACE COMMA
 %token PIPE OR AND XOR LT LE GT GE EQ NE PLUS MINUS MUL DIV MOD NOT NEG ASSIGN
-%token DOT COLON SEMICOLON L_ARROW R_ARROW AT
+%token DOT COLON SEMICOLON L_ARROW R_ARROW AT QM
 %token ID_PROP TYPE_PROP SRC_ID_PROP DST_ID_PROP RANK_PROP INPUT_REF DST_REF SRC_REF
 
 /* token type specification */
@@ -241,13 +244,13 @@ static constexpr size_t MAX_ABS_INTEGER = 9223372036854775808ULL;
 %type <sentence> set_config_sentence get_config_sentence balance_sentence
 %type <sentence> process_control_sentence return_sentence
 %type <sentence> sentence
-%type <sentences> sentences
+%type <sentences> sentences query
 
 %type <boolval> opt_if_not_exists
 %type <boolval> opt_if_exists
 
 
-%start sentences
+%start query
 
 %%
 
@@ -312,6 +315,8 @@ unreserved_keyword
      | KW_SHORTEST           { $$ = new std::string("shortest"); }
      | KW_COUNT_DISTINCT     { $$ = new std::string("count_distinct"); }
      | KW_CONTAINS           { $$ = new std::string("contains"); }
+     | KW_PROFILE            { $$ = new std::string("profile"); }
+     | KW_GEO                { $$ = new std::string("geo"); }
      ;
 
 agg_function
@@ -346,6 +351,9 @@ base_expression
     : DOUBLE {
         $$ = new PrimaryExpression($1);
     }
+    | QM {
+        $$ = newParameter(scanner);
+    }
     | STRING {
         $$ = new PrimaryExpression(*$1);
         delete $1;
@@ -646,6 +654,9 @@ vid
     : unary_integer {
         $$ = new PrimaryExpression($1);
     }
+    | QM {
+        $$ = newParameter(scanner);
+    }
     | function_call_expression {
         $$ = $1;
     }
@@ -1228,6 +1239,9 @@ create_tag_index_sentence
     : KW_CREATE KW_TAG KW_INDEX opt_if_not_exists name_label KW_ON name_label L_PAREN column_name_list R_PAREN {
         $$ = new CreateTagIndexSentence($5, $7, $9, $4);
     }
+    | KW_CREATE KW_TAG KW_INDEX opt_if_not_exists name_label KW_ON name_label L_PAREN column_name_list R_PAREN KW_GEO {
+        $$ = new CreateTagIndexSentence($5, $7, $9, $4, true);
+    }
     ;
 
 create_edge_index_sentence
@@ -2037,6 +2051,19 @@ sentences
     }
     ;
 
+query
+    : sentences {
+        $$ = $1;
+    }
+    | KW_PROFILE sentences {
+        if ($2 == nullptr) {
+            throw nebula::GraphParser::syntax_error(@1, "Nothing to profile");
+        }
+        $$ = $2;
+        $2->setProfile(true);
+    }
+    ;
+
 
 %%
 
@@ -2077,6 +2104,12 @@ void nebula::GraphParser::error(const nebula::GraphParser::location_type& loc,
     errmsg = os.str();
 }
 
+nebula::Expression* newParameter(nebula::GraphScanner& scanner) {
+    auto *expr = new nebula::PrimaryExpression();
+    scanner.addParameter(expr);
+    return expr;
+}
+
 // check the positive integer boundary
 // parameter input accept the INTEGER value
 // which filled as uint64_t
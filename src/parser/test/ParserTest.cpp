@@ -484,6 +484,17 @@ TEST(Parser, IndexOperation) {
         auto result = parser.parse(query);
         ASSERT_TRUE(result.ok()) << result.status();
     }
+    {
+        GQLParser parser;
+        std::string query = "CREATE TAG INDEX location_index ON merchant(location) GEO";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+        auto sentences = result.value()->sentences();
+        auto *sentence = static_cast<CreateTagIndexSentence*>(sentences[0]);
+        ASSERT_TRUE(sentence->isGeo());
+        ASSERT_EQ("CREATE TAG INDEX location_index ON merchant (location) GEO",
+                  sentence->toString());
+    }
     {
         GQLParser parser;
         std::string query = "CREATE EDGE INDEX IF NOT EXISTS like_index ON service(like)";
@@ -2055,4 +2066,85 @@ TEST(Parser, UseReservedKeyword) {
         ASSERT_TRUE(result.ok());
     }
 }
+
+TEST(Parser, Parameters) {
+    {
+        GQLParser parser;
+        std::string query = "GO FROM ?, ? OVER like WHERE like.likeness > ? "
+                            "YIELD like._dst, ?";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+        auto sentences = std::move(result).value();
+        auto &parameters = sentences->parameters();
+        ASSERT_EQ(4, parameters.size());
+        parameters[0]->setValue(int64_t(1));
+        parameters[1]->setValue(int64_t(2));
+        parameters[2]->setValue(90.0);
+        parameters[3]->setValue(std::string("name"));
+        ASSERT_EQ(int64_t(2), boost::get<int64_t>(parameters[1]->value()));
+        ASSERT_EQ("name", boost::get<std::string>(parameters[3]->value()));
+    }
+    {
+        GQLParser parser;
+        std::string query = "INSERT VERTEX person(name, age) VALUES ?:(?, ?)";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+        ASSERT_EQ(3, result.value()->parameters().size());
+    }
+    {
+        GQLParser parser;
+        std::string query = "GO FROM 1 OVER like";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+        ASSERT_TRUE(result.value()->parameters().empty());
+    }
+    {
+        GQLParser parser;
+        std::string query = "GO FROM ? OVER ?";
+        auto result = parser.parse(query);
+        ASSERT_FALSE(result.ok());
+        // The parameters of the failed one are not left
+        query = "GO FROM ? OVER like";
+        result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+        ASSERT_EQ(1, result.value()->parameters().size());
+    }
+}
+
+TEST(Parser, Profile) {
+    {
+        GQLParser parser;
+        std::string query = "PROFILE GO FROM 1 OVER like | FETCH PROP ON person $-.id";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+        ASSERT_TRUE(result.value()->isProfile());
+    }
+    {
+        GQLParser parser;
+        std::string query = "profile GO FROM 1 OVER like; GO FROM 2 OVER like";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+        ASSERT_TRUE(result.value()->isProfile());
+        ASSERT_EQ(2, result.value()->sentences().size());
+    }
+    {
+        GQLParser parser;
+        std::string query = "GO FROM 1 OVER like YIELD like.profile";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+        ASSERT_FALSE(result.value()->isProfile());
+    }
+    {
+        GQLParser parser;
+        std::string query = "PROFILE";
+        auto result = parser.parse(query);
+        ASSERT_FALSE(result.ok());
+    }
+    {
+        GQLParser parser;
+        std::string query = "GO FROM 1 OVER like; PROFILE GO FROM 2 OVER like";
+        auto result = parser.parse(query);
+        ASSERT_FALSE(result.ok());
+    }
+}
 }   // namespace nebula
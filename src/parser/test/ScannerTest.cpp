@@ -447,6 +447,12 @@ TEST(Scanner, Basic) {
         CHECK_SEMANTIC_TYPE("CONTAINS", TokenType::KW_CONTAINS),
         CHECK_SEMANTIC_TYPE("Contains", TokenType::KW_CONTAINS),
         CHECK_SEMANTIC_TYPE("contains", TokenType::KW_CONTAINS),
+        CHECK_SEMANTIC_TYPE("PROFILE", TokenType::KW_PROFILE),
+        CHECK_SEMANTIC_TYPE("Profile", TokenType::KW_PROFILE),
+        CHECK_SEMANTIC_TYPE("profile", TokenType::KW_PROFILE),
+        CHECK_SEMANTIC_TYPE("GEO", TokenType::KW_GEO),
+        CHECK_SEMANTIC_TYPE("Geo", TokenType::KW_GEO),
+        CHECK_SEMANTIC_TYPE("geo", TokenType::KW_GEO),
 
         CHECK_SEMANTIC_TYPE("_type", TokenType::TYPE_PROP),
         CHECK_SEMANTIC_TYPE("_id", TokenType::ID_PROP),
@@ -63,6 +63,10 @@ protected:
                                   PartitionID partId,
                                   std::vector<kvstore::KV> data);
 
+    kvstore::ResultCode doSyncRemove(GraphSpaceID spaceId,
+                                     PartitionID partId,
+                                     std::vector<std::string> keys);
+
     void doRemove(GraphSpaceID spaceId, PartitionID partId, std::vector<std::string> keys);
 
     kvstore::ResultCode doRange(GraphSpaceID spaceId, PartitionID partId, std::string start,
@@ -153,6 +157,13 @@ protected:
     StatusOr<IndexValues> collectIndexValues(RowReader* reader,
                                              const std::vector<nebula::cpp2::ColumnDef>& cols);
 
+    /**
+     * The values in the key of the index. The geo index has only one value,
+     * the leaf cell of the point in its field.
+     * */
+    StatusOr<IndexValues> collectIndexValues(RowReader* reader,
+                                             const nebula::cpp2::IndexItem& index);
+
     void collectProps(RowReader* reader, const std::vector<PropContext>& props,
                       Collector* collector);
 
@@ -6,6 +6,7 @@
 
 #include "base/Base.h"
 #include "storage/BaseProcessor.h"
+#include "storage/CommonUtils.h"
 
 namespace nebula {
 namespace storage {
@@ -83,6 +84,25 @@ kvstore::ResultCode BaseProcessor<RESP>::doSyncPut(GraphSpaceID spaceId,
     return ret;
 }
 
+template <typename RESP>
+kvstore::ResultCode BaseProcessor<RESP>::doSyncRemove(GraphSpaceID spaceId,
+                                                      PartitionID partId,
+                                                      std::vector<std::string> keys) {
+    folly::Baton<true, std::atomic> baton;
+    auto ret = kvstore::ResultCode::SUCCEEDED;
+    kvstore_->asyncMultiRemove(spaceId,
+                               partId,
+                               std::move(keys),
+                               [&ret, &baton] (kvstore::ResultCode code) {
+        if (kvstore::ResultCode::SUCCEEDED != code) {
+            ret = code;
+        }
+        baton.post();
+    });
+    baton.wait();
+    return ret;
+}
+
 template <typename RESP>
 void BaseProcessor<RESP>::doRemove(GraphSpaceID spaceId,
                                    PartitionID partId,
@@ -138,6 +158,28 @@ BaseProcessor<RESP>::collectIndexValues(RowReader* reader,
     return values;
 }
 
+template <typename RESP>
+StatusOr<IndexValues>
+BaseProcessor<RESP>::collectIndexValues(RowReader* reader,
+                                        const nebula::cpp2::IndexItem& index) {
+    if (index.get_index_type() != nebula::cpp2::IndexType::GEO) {
+        return collectIndexValues(reader, index.get_fields());
+    }
+    auto& fields = index.get_fields();
+    if (fields.size() != 1) {
+        return Status::Error("Bad geo index %s", index.get_index_name().c_str());
+    }
+    auto cell = geoIndexValue(reader, fields[0].get_name());
+    if (!cell.ok()) {
+        VLOG(1) << "Skip the geo index " << index.get_index_name() << ": " << cell.status();
+        return cell.status();
+    }
+    IndexValues values;
+    // The cell is of fixed length as an INT, no length is appended in the key
+    values.emplace_back(nebula::cpp2::SupportedType::INT, std::move(cell).value());
+    return values;
+}
+
 template <typename RESP>
 void BaseProcessor<RESP>::collectProps(RowReader* reader,
                                        const std::vector<PropContext>& props,
@@ -6,6 +6,8 @@
 
 #include "base/Base.h"
 #include "storage/CommonUtils.h"
+#include "filter/geo/GeoFilter.h"
+#include "filter/geo/GeoIndex.h"
 
 namespace nebula {
 namespace storage {
@@ -49,5 +51,28 @@ bool checkDataExpiredForTTL(const meta::SchemaProviderIf* schema,
 }
 
 
+std::string encodeGeoCell(uint64_t cellId) {
+    auto big = folly::Endian::big(cellId);
+    return std::string(reinterpret_cast<const char*>(&big), sizeof(big));
+}
+
+
+StatusOr<std::string> geoIndexValue(RowReader* reader, const std::string& field) {
+    if (reader == nullptr) {
+        return Status::Error("Invalid row reader");
+    }
+    folly::StringPiece wkt;
+    auto ret = reader->getString(field, wkt);
+    if (ret != ResultType::SUCCEEDED) {
+        return Status::Error("Bad geo field %s", field.c_str());
+    }
+    auto point = geo::GeoFilter::parsePoint(wkt.str());
+    if (!point.ok()) {
+        return point.status();
+    }
+    return encodeGeoCell(geo::GeoIndex::pointCell(point.value()).id());
+}
+
+
 }  // namespace storage
 }  // namespace nebula
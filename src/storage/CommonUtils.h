@@ -8,7 +8,8 @@
 #define STORAGE_COMMON_H_
 
 #include "base/Base.h"
-#include "base/ConcurrentLRUCache.h"
+#include "base/StatusOr.h"
+#include "base/ConcurrentClockCache.h"
 #include "filter/Expressions.h"
 #include "dataman/RowReader.h"
 
@@ -17,7 +18,7 @@ namespace storage {
 
 using TagProp = std::pair<std::string, std::string>;
 
-using VertexCache = ConcurrentLRUCache<std::pair<VertexID, TagID>, std::string>;
+using VertexCache = ConcurrentClockCache<std::pair<VertexID, TagID>, std::string>;
 
 struct FilterContext {
     // key: <tagName, propName> -> propValue
@@ -32,6 +33,8 @@ public:
         DST  = 0x02,
         TYPE = 0x03,
         RANK = 0x04,
+        // Not in the key, it's the number of edges of the vertex in the edge type
+        DEGREE = 0x05,
     };
 
     PropContext() = default;
@@ -127,6 +130,17 @@ bool checkDataExpiredForTTL(const meta::SchemaProviderIf* schema,
                             const std::string& ttlCol,
                             int64_t ttlDuration);
 
+/**
+ * Encode the S2 cell id in the geo index key, in big endian, so the leaf
+ * cells of a cell are in the key range [range_min, range_max] of the cell.
+ */
+std::string encodeGeoCell(uint64_t cellId);
+
+/**
+ * The value of the geo index on the field, i.e. the encoded leaf cell
+ * of the point in WKT in the field.
+ */
+StatusOr<std::string> geoIndexValue(RowReader* reader, const std::string& field);
 
 
 }  // namespace storage
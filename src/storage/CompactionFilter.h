@@ -56,6 +56,13 @@ public:
                 VLOG(3) << "Index invalid for the key " << key;
                 return true;
             }
+        } else if (NebulaKeyUtils::isDegreeKey(key)) {
+            auto edgeType = std::abs(NebulaKeyUtils::getDegreeEdgeType(key));
+            auto ret = schemaMan_->getLatestEdgeSchemaVersion(spaceId, edgeType);
+            if (ret.ok() && ret.value() == -1) {
+                VLOG(3) << "Space " << spaceId << ", EdgeType " << edgeType << " invalid";
+                return true;
+            }
         } else {
             VLOG(3) << "Skip the system key inside, key " << key;
         }
@@ -0,0 +1,141 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "storage/EdgeCache.h"
+#include "kvstore/Part.h"
+#include "utils/NebulaKeyUtils.h"
+
+DEFINE_bool(enable_edge_cache, false, "Cache the edges of the hot vertices");
+DEFINE_int64(edge_cache_capacity_in_mb, 256, "Total bytes of the edges inside the cache");
+DEFINE_int32(edge_cache_bucket_exp, 4, "Total buckets number is 1 << edge_cache_bucket_exp");
+DEFINE_int32(edge_cache_max_edges_per_vertex, 10000,
+             "The edges of one vertex in one edge type are not cached if more than it");
+
+DECLARE_bool(check_leader);
+
+namespace nebula {
+namespace storage {
+
+EdgeCache::EdgeCache(size_t capacity, uint32_t bucketsExp)
+    : cache_(capacity, bucketsExp)
+    , versions_(kVersionSlots) {}
+
+kvstore::ResultCode EdgeCache::prefix(kvstore::KVStore* kvstore,
+                                      GraphSpaceID spaceId,
+                                      PartitionID partId,
+                                      VertexID vId,
+                                      EdgeType edgeType,
+                                      std::unique_ptr<kvstore::KVIterator>* iter,
+                                      bool* hit) {
+    auto key = std::make_pair(spaceId, NebulaKeyUtils::edgePrefix(partId, vId, edgeType));
+    auto cached = cache_.get(key);
+    if (cached.ok() && cached.value()->tooMany_) {
+        // Known to have too many edges, don't copy them again
+        return kvstore->prefix(spaceId, partId, key.second, iter);
+    }
+    if (cached.ok()) {
+        // Same as reading from the kvstore, only the leader could serve the read
+        auto partRet = kvstore->part(spaceId, partId);
+        if (!ok(partRet)) {
+            return error(partRet);
+        }
+        auto part = nebula::value(partRet);
+        if (FLAGS_check_leader && !(part->isLeader() && part->leaseValid())) {
+            return kvstore::ResultCode::ERR_LEADER_CHANGED;
+        }
+        iter->reset(new EdgeListIterator(std::move(cached).value()));
+        if (hit != nullptr) {
+            *hit = true;
+        }
+        return kvstore::ResultCode::SUCCEEDED;
+    }
+
+    auto ver = version(key);
+    std::unique_ptr<kvstore::KVIterator> it;
+    auto ret = kvstore->prefix(spaceId, partId, key.second, &it);
+    if (ret != kvstore::ResultCode::SUCCEEDED || !it) {
+        return ret;
+    }
+    auto list = std::make_shared<EdgeList>();
+    size_t edgeLen = 0;
+    for (; it->valid(); it->next()) {
+        auto k = it->key();
+        auto v = it->val();
+        if (!list->edges_.empty()
+                && k.size() == list->edges_.back().first.size()
+                && k.subpiece(0, edgeLen) ==
+                        folly::StringPiece(list->edges_.back().first).subpiece(0, edgeLen)) {
+            // Older version of the last edge
+            continue;
+        }
+        if (list->edges_.size() >= static_cast<size_t>(FLAGS_edge_cache_max_edges_per_vertex)) {
+            VLOG(3) << "Too many edges to cache for vId " << vId << ", edgeType " << edgeType;
+            auto tooMany = std::make_shared<EdgeList>();
+            tooMany->tooMany_ = true;
+            insert(key, ver, std::move(tooMany));
+            return kvstore->prefix(spaceId, partId, key.second, iter);
+        }
+        edgeLen = k.size() - sizeof(EdgeVersion);
+        list->edges_.emplace_back(k.str(), v.str());
+        list->bytes_ += sizeof(kvstore::KV) + k.size() + v.size();
+    }
+
+    std::shared_ptr<const EdgeList> edges = std::move(list);
+    insert(key, ver, edges);
+    iter->reset(new EdgeListIterator(std::move(edges)));
+    return kvstore::ResultCode::SUCCEEDED;
+}
+
+void EdgeCache::insert(const Key& key, uint64_t ver, std::shared_ptr<const EdgeList> list) {
+    cache_.insert(key, std::move(list));
+    if (version(key) != ver) {
+        // Some edges might be changed after they were read
+        cache_.evict(key);
+    }
+}
+
+void EdgeCache::invalidate(GraphSpaceID spaceId, std::string prefix) {
+    auto key = std::make_pair(spaceId, std::move(prefix));
+    // Bump the version before evicting, so the lists being read could not be cached
+    versions_[std::hash<Key>()(key) & (kVersionSlots - 1)].fetch_add(1);
+    cache_.evict(key);
+}
+
+bool EdgeCache::watch(const folly::StringPiece& key) const {
+    return NebulaKeyUtils::isEdge(key);
+}
+
+void EdgeCache::onCommitted(GraphSpaceID spaceId,
+                            PartitionID partId,
+                            const std::vector<std::string>& keys) {
+    std::string last;
+    for (auto& key : keys) {
+        auto prefix = NebulaKeyUtils::edgePrefix(partId,
+                                                 NebulaKeyUtils::getSrcId(key),
+                                                 NebulaKeyUtils::getEdgeType(key));
+        if (prefix == last) {
+            continue;
+        }
+        last = prefix;
+        invalidate(spaceId, std::move(prefix));
+    }
+}
+
+void EdgeCache::onReset(GraphSpaceID spaceId, PartitionID partId) {
+    // The keys of one part could not be found without walking the whole cache,
+    // and a part is reset rarely, so just drop everything.
+    LOG(INFO) << "Drop the edge cache since space " << spaceId << ", part " << partId
+              << " is reset";
+    resets_.fetch_add(1);
+    cache_.clear();
+}
+
+uint64_t EdgeCache::version(const Key& key) const {
+    return resets_.load() + versions_[std::hash<Key>()(key) & (kVersionSlots - 1)].load();
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,142 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef STORAGE_EDGECACHE_H_
+#define STORAGE_EDGECACHE_H_
+
+#include "base/Base.h"
+#include "base/ConcurrentClockCache.h"
+#include "kvstore/KVStore.h"
+#include "kvstore/KVIterator.h"
+
+DECLARE_bool(enable_edge_cache);
+DECLARE_int64(edge_cache_capacity_in_mb);
+DECLARE_int32(edge_cache_bucket_exp);
+DECLARE_int32(edge_cache_max_edges_per_vertex);
+
+namespace nebula {
+namespace storage {
+
+/**
+ * The latest version of the edges of one vertex in one edge type,
+ * in the same order as they are stored in the engine.
+ * */
+struct EdgeList {
+    std::vector<kvstore::KV> edges_;
+    // Bytes taken by the keys and values
+    size_t bytes_{0};
+    // The vertex has too many edges to cache, the edges_ is empty then,
+    // and the edges are read from the kvstore until they are changed
+    bool tooMany_{false};
+};
+
+inline size_t weigh(const std::shared_ptr<const EdgeList>& list) {
+    return sizeof(EdgeList) + list->bytes_;
+}
+
+/**
+ * Iterate the cached edges the same way as iterating them in the engine.
+ * */
+class EdgeListIterator final : public kvstore::KVIterator {
+public:
+    explicit EdgeListIterator(std::shared_ptr<const EdgeList> list)
+        : list_(std::move(list)) {}
+
+    bool valid() const override {
+        return idx_ >= 0 && idx_ < static_cast<int64_t>(list_->edges_.size());
+    }
+
+    void next() override {
+        ++idx_;
+    }
+
+    void prev() override {
+        --idx_;
+    }
+
+    folly::StringPiece key() const override {
+        return list_->edges_[idx_].first;
+    }
+
+    folly::StringPiece val() const override {
+        return list_->edges_[idx_].second;
+    }
+
+private:
+    std::shared_ptr<const EdgeList> list_;
+    int64_t idx_{0};
+};
+
+/**
+ * Cache the edges of the hot vertices, keyed by the space and the prefix of
+ * the edges of one vertex in one edge type.
+ *
+ * The cache listens to the logs committed in the kvstore, so the lists are
+ * invalidated when the edges are changed, on the leader and the followers alike.
+ * A version is taken before a list is read from the engine, and the list is
+ * dropped if any change on it is committed before it is cached.
+ * */
+class EdgeCache final : public kvstore::CommitListener {
+public:
+    using Key = std::pair<GraphSpaceID, std::string>;
+    using Cache = ConcurrentClockCache<Key, std::shared_ptr<const EdgeList>>;
+
+    EdgeCache(size_t capacity, uint32_t bucketsExp);
+
+    void registerStats(folly::StringPiece prefix) {
+        cache_.registerStats(prefix);
+    }
+
+    /**
+     * Same as KVStore::prefix on the edges of vId in edgeType, the edges are
+     * served from the cache when possible. Only the latest version of each edge
+     * is kept in the cache. `hit' is set if the edges are served from the cache.
+     * */
+    kvstore::ResultCode prefix(kvstore::KVStore* kvstore,
+                               GraphSpaceID spaceId,
+                               PartitionID partId,
+                               VertexID vId,
+                               EdgeType edgeType,
+                               std::unique_ptr<kvstore::KVIterator>* iter,
+                               bool* hit = nullptr);
+
+    /**
+     * Invalidate the edges of one vertex in one edge type, prefix is the
+     * one returned by NebulaKeyUtils::edgePrefix(partId, vId, edgeType)
+     * */
+    void invalidate(GraphSpaceID spaceId, std::string prefix);
+
+    bool watch(const folly::StringPiece& key) const override;
+
+    void onCommitted(GraphSpaceID spaceId,
+                     PartitionID partId,
+                     const std::vector<std::string>& keys) override;
+
+    void onReset(GraphSpaceID spaceId, PartitionID partId) override;
+
+    Cache& cache() {
+        return cache_;
+    }
+
+private:
+    uint64_t version(const Key& key) const;
+
+    // Cache the list unless the edges have been changed since the version ver
+    void insert(const Key& key, uint64_t ver, std::shared_ptr<const EdgeList> list);
+
+private:
+    // The versions are shared by the keys hashed into the same slot
+    static constexpr size_t kVersionSlots = 4096;
+
+    Cache cache_;
+    std::vector<std::atomic<uint64_t>> versions_;
+    // Bumped when the whole cache is dropped
+    std::atomic<uint64_t> resets_{0};
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // STORAGE_EDGECACHE_H_
@@ -9,10 +9,15 @@
 
 #include "base/Base.h"
 #include <rocksdb/merge_operator.h>
+#include "utils/NebulaKeyUtils.h"
 
 namespace nebula {
 namespace storage {
 
+/**
+ * The merge operator of storage. Now it only serves the degree keys, whose
+ * operands are int64 deltas added to the counter of (vertex, edgeType).
+ * */
 class NebulaOperator : public rocksdb::MergeOperator {
 public:
     const char* Name() const override {
@@ -22,22 +27,35 @@ public:
 private:
     bool FullMergeV2(const MergeOperationInput& merge_in,
                      MergeOperationOutput* merge_out) const override {
-        UNUSED(merge_in);
-        UNUSED(merge_out);
-        LOG(ERROR) << "NebulaMergeOperator not supported yet";
-        return false;
+        auto key = folly::StringPiece(merge_in.key.data(), merge_in.key.size());
+        if (!NebulaKeyUtils::isDegreeKey(key)) {
+            LOG(ERROR) << "NebulaMergeOperator not supported for the key";
+            return false;
+        }
+        int64_t degree = 0;
+        if (merge_in.existing_value != nullptr) {
+            degree = decode(*merge_in.existing_value);
+        }
+        for (auto& operand : merge_in.operand_list) {
+            degree += decode(operand);
+        }
+        merge_out->new_value = NebulaKeyUtils::encodeDegree(degree);
+        return true;
     }
 
     bool PartialMerge(const rocksdb::Slice& key, const rocksdb::Slice& left_operand,
                       const rocksdb::Slice& right_operand, std::string* new_value,
                       rocksdb::Logger* logger) const override {
-        UNUSED(key);
-        UNUSED(left_operand);
-        UNUSED(right_operand);
-        UNUSED(new_value);
         UNUSED(logger);
-        LOG(ERROR) << "NebulaMergeOperator not supported yet";
-        return false;
+        if (!NebulaKeyUtils::isDegreeKey(folly::StringPiece(key.data(), key.size()))) {
+            return false;
+        }
+        *new_value = NebulaKeyUtils::encodeDegree(decode(left_operand) + decode(right_operand));
+        return true;
+    }
+
+    static int64_t decode(const rocksdb::Slice& val) {
+        return NebulaKeyUtils::decodeDegree(folly::StringPiece(val.data(), val.size()));
     }
 };
 
@@ -20,3 +20,7 @@ DEFINE_int32(rebuild_index_batch_num, 1024,
              "The batch size when rebuild index");
 DEFINE_bool(enable_multi_versions, false, "If true, the insert timestamp will be the wall clock. "
                                           "If false, always has the same timestamp of max");
+DEFINE_bool(enable_edge_degree, false, "If true, maintain the edge counter of each vertex and "
+                                       "edge type on write, _degree will be read from it. "
+                                       "The edges written before it's enabled are counted "
+                                       "by rebuildEdgeDegree");
@@ -23,4 +23,6 @@ DECLARE_int32(rebuild_index_batch_num);
 
 DECLARE_bool(enable_multi_versions);
 
+DECLARE_bool(enable_edge_degree);
+
 #endif  // STORAGE_STORAGEFLAGS_H_
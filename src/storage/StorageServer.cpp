@@ -16,6 +16,7 @@
 #include "webservice/Router.h"
 #include "webservice/WebService.h"
 #include "storage/CompactionFilter.h"
+#include "storage/MergeOperator.h"
 #include "hdfs/HdfsCommandHelper.h"
 #include "thread/GenericThreadPool.h"
 #include <thrift/lib/cpp/concurrency/ThreadManager.h>
@@ -48,6 +49,14 @@ std::unique_ptr<kvstore::KVStore> StorageServer::getStoreInstance() {
                                                 metaClient_.get());
     options.cffBuilder_ = std::make_unique<StorageCompactionFilterFactoryBuilder>(schemaMan_.get(),
                                                                                   indexMan_.get());
+    options.mergeOp_ = std::make_shared<NebulaOperator>();
+    if (FLAGS_enable_edge_cache) {
+        edgeCache_ = std::make_shared<EdgeCache>(FLAGS_edge_cache_capacity_in_mb * 1024 * 1024,
+                                                 FLAGS_edge_cache_bucket_exp);
+        edgeCache_->registerStats("storage_edge_cache");
+        // The cached edges are invalidated when the changes are committed
+        options.commitListener_ = edgeCache_;
+    }
     if (FLAGS_store_type == "nebula") {
         auto nbStore = std::make_unique<kvstore::NebulaStore>(std::move(options),
                                                               ioThreadPool_,
@@ -143,7 +152,8 @@ bool StorageServer::start() {
     auto handler = std::make_shared<StorageServiceHandler>(kvstore_.get(),
                                                            schemaMan_.get(),
                                                            indexMan_.get(),
-                                                           metaClient_.get());
+                                                           metaClient_.get(),
+                                                           edgeCache_.get());
     try {
         LOG(INFO) << "The storage deamon start on " << localHost_;
         tfServer_ = std::make_unique<apache::thrift::ThriftServer>();
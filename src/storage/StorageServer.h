@@ -15,6 +15,7 @@
 #include "meta/client/MetaClient.h"
 #include "meta/ClientBasedGflagsManager.h"
 #include "hdfs/HdfsHelper.h"
+#include "storage/EdgeCache.h"
 
 namespace nebula {
 
@@ -72,6 +73,7 @@ private:
     std::unique_ptr<meta::ClientBasedGflagsManager> gFlagsMan_;
     std::unique_ptr<meta::SchemaManager> schemaMan_;
     std::unique_ptr<meta::IndexManager> indexMan_;
+    std::shared_ptr<EdgeCache> edgeCache_;
 
     HostAddr localHost_;
     std::vector<HostAddr> metaAddrs_;
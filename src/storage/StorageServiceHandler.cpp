@@ -10,6 +10,7 @@
 #include "storage/query/QueryVertexPropsProcessor.h"
 #include "storage/query/QueryEdgePropsProcessor.h"
 #include "storage/query/QueryStatsProcessor.h"
+#include "storage/query/TraverseProcessor.h"
 #include "storage/query/GetUUIDProcessor.h"
 #include "storage/query/ScanEdgeProcessor.h"
 #include "storage/query/ScanVertexProcessor.h"
@@ -27,6 +28,7 @@
 #include "storage/admin/SendBlockSignProcessor.h"
 #include "storage/admin/RebuildTagIndexProcessor.h"
 #include "storage/admin/RebuildEdgeIndexProcessor.h"
+#include "storage/admin/RebuildEdgeDegreeProcessor.h"
 #include "storage/index/LookUpIndexProcessor.h"
 
 #define RETURN_FUTURE(processor) \
@@ -34,7 +36,7 @@
     processor->process(req); \
     return f;
 
-DEFINE_int32(vertex_cache_num, 16 * 1000 * 1000, "Total keys inside the cache");
+DEFINE_int64(vertex_cache_capacity_in_mb, 1024, "Total bytes of the vertices inside the cache");
 DEFINE_int32(vertex_cache_bucket_exp, 4, "Total buckets number is 1 << cache_bucket_exp");
 DEFINE_int32(reader_handlers, 32, "Total reader handlers");
 DEFINE_string(reader_handlers_type, "cpu", "Type of reader handlers, options: cpu,io");
@@ -48,7 +50,8 @@ StorageServiceHandler::future_getBound(const cpp2::GetNeighborsRequest& req) {
                                                     schemaMan_,
                                                     &getBoundQpsStat_,
                                                     readerPool_.get(),
-                                                    &vertexCache_);
+                                                    &vertexCache_,
+                                                    edgeCache_);
     RETURN_FUTURE(processor);
 }
 
@@ -58,7 +61,18 @@ StorageServiceHandler::future_boundStats(const cpp2::GetNeighborsRequest& req) {
                                                     schemaMan_,
                                                     &boundStatsQpsStat_,
                                                     readerPool_.get(),
-                                                    &vertexCache_);
+                                                    &vertexCache_,
+                                                    edgeCache_);
+    RETURN_FUTURE(processor);
+}
+
+folly::Future<cpp2::TraverseResponse>
+StorageServiceHandler::future_traverse(const cpp2::TraverseRequest& req) {
+    auto* processor = TraverseProcessor::instance(kvstore_,
+                                                  schemaMan_,
+                                                  &traverseQpsStat_,
+                                                  readerPool_.get(),
+                                                  edgeCache_);
     RETURN_FUTURE(processor);
 }
 
@@ -247,13 +261,20 @@ StorageServiceHandler::future_rebuildEdgeIndex(const cpp2::RebuildIndexRequest&
     RETURN_FUTURE(processor);
 }
 
+folly::Future<cpp2::AdminExecResp>
+StorageServiceHandler::future_rebuildEdgeDegree(const cpp2::RebuildEdgeDegreeRequest& req) {
+    auto* processor = RebuildEdgeDegreeProcessor::instance(kvstore_, schemaMan_);
+    RETURN_FUTURE(processor);
+}
+
 folly::Future<cpp2::LookUpIndexResp>
 StorageServiceHandler::future_lookUpIndex(const cpp2::LookUpIndexRequest& req) {
     auto* processor = LookUpIndexProcessor::instance(kvstore_,
                                                      schemaMan_,
                                                      indexMan_,
                                                      &lookupVerticesQpsStat_,
-                                                     &vertexCache_);
+                                                     &vertexCache_,
+                                                     readerPool_.get());
     RETURN_FUTURE(processor);
 }
 
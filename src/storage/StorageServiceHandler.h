@@ -15,9 +15,10 @@
 #include "meta/IndexManager.h"
 #include "stats/StatsManager.h"
 #include "storage/CommonUtils.h"
+#include "storage/EdgeCache.h"
 #include "stats/Stats.h"
 
-DECLARE_int32(vertex_cache_num);
+DECLARE_int64(vertex_cache_capacity_in_mb);
 DECLARE_int32(vertex_cache_bucket_exp);
 DECLARE_int32(reader_handlers);
 DECLARE_string(reader_handlers_type);
@@ -32,12 +33,15 @@ public:
     StorageServiceHandler(kvstore::KVStore* kvstore,
                           meta::SchemaManager* schemaMan,
                           meta::IndexManager* indexMan,
-                          meta::MetaClient* client)
+                          meta::MetaClient* client,
+                          EdgeCache* edgeCache = nullptr)
         : kvstore_(kvstore)
         , schemaMan_(schemaMan)
         , indexMan_(indexMan)
         , metaClient_(client)
-        , vertexCache_(FLAGS_vertex_cache_num, FLAGS_vertex_cache_bucket_exp) {
+        , edgeCache_(edgeCache)
+        , vertexCache_(FLAGS_vertex_cache_capacity_in_mb * 1024 * 1024,
+                       FLAGS_vertex_cache_bucket_exp) {
         if (FLAGS_reader_handlers_type == "io") {
             auto tf = std::make_shared<folly::NamedThreadFactory>("reader-pool");
             readerPool_ = std::make_shared<folly::IOThreadPoolExecutor>(FLAGS_reader_handlers,
@@ -54,6 +58,7 @@ public:
         }
         getBoundQpsStat_ = stats::Stats("storage", "get_bound");
         boundStatsQpsStat_ = stats::Stats("storage", "bound_stats");
+        traverseQpsStat_ = stats::Stats("storage", "traverse");
         vertexPropsQpsStat_ = stats::Stats("storage", "vertex_props");
         edgePropsQpsStat_ = stats::Stats("storage", "edge_props");
         addVertexQpsStat_ = stats::Stats("storage", "add_vertex");
@@ -67,6 +72,7 @@ public:
         putKvQpsStat_ = stats::Stats("storage", "put_kv");
         lookupVerticesQpsStat_ = stats::Stats("storage", "lookup_vertices");
         lookupEdgesQpsStat_ = stats::Stats("storage", "lookup_edges");
+        vertexCache_.registerStats("storage_vertex_cache");
     }
 
     folly::Future<cpp2::QueryResponse>
@@ -75,6 +81,9 @@ public:
     folly::Future<cpp2::QueryStatsResponse>
     future_boundStats(const cpp2::GetNeighborsRequest& req) override;
 
+    folly::Future<cpp2::TraverseResponse>
+    future_traverse(const cpp2::TraverseRequest& req) override;
+
     folly::Future<cpp2::QueryResponse>
     future_getProps(const cpp2::VertexPropRequest& req) override;
 
@@ -154,6 +163,9 @@ public:
     folly::Future<cpp2::AdminExecResp>
     future_rebuildEdgeIndex(const cpp2::RebuildIndexRequest& req) override;
 
+    folly::Future<cpp2::AdminExecResp>
+    future_rebuildEdgeDegree(const cpp2::RebuildEdgeDegreeRequest& req) override;
+
     folly::Future<cpp2::LookUpIndexResp>
     future_lookUpIndex(const cpp2::LookUpIndexRequest& req) override;
 
@@ -162,11 +174,14 @@ private:
     meta::SchemaManager* schemaMan_{nullptr};
     meta::IndexManager* indexMan_{nullptr};
     meta::MetaClient* metaClient_{nullptr};
+    // Owned by the server, nullptr if the edge cache is disabled
+    EdgeCache* edgeCache_{nullptr};
     VertexCache vertexCache_;
     std::shared_ptr<folly::Executor> readerPool_;
 
     stats::Stats getBoundQpsStat_;
     stats::Stats boundStatsQpsStat_;
+    stats::Stats traverseQpsStat_;
     stats::Stats vertexPropsQpsStat_;
     stats::Stats edgePropsQpsStat_;
     stats::Stats addVertexQpsStat_;
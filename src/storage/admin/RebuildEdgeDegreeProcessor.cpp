@@ -0,0 +1,131 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "storage/StorageFlags.h"
+#include "storage/admin/RebuildEdgeDegreeProcessor.h"
+
+namespace nebula {
+namespace storage {
+
+void RebuildEdgeDegreeProcessor::process(const cpp2::RebuildEdgeDegreeRequest& req) {
+    CHECK_NOTNULL(kvstore_);
+    auto space = req.get_space_id();
+    LOG(INFO) << "Rebuild Edge Degree Space " << space;
+    for (PartitionID part : req.get_parts()) {
+        auto ret = rebuildCounters(space, part);
+        if (ret == kvstore::ResultCode::SUCCEEDED) {
+            ret = removeObsoleteCounters(space, part);
+        }
+        if (ret != kvstore::ResultCode::SUCCEEDED) {
+            LOG(ERROR) << "Rebuild Part " << part << " Edge Degree Failed";
+            this->pushResultCode(to(ret), part);
+        }
+    }
+    onFinished();
+}
+
+kvstore::ResultCode RebuildEdgeDegreeProcessor::rebuildCounters(GraphSpaceID space,
+                                                                 PartitionID part) {
+    std::unique_ptr<kvstore::KVIterator> iter;
+    auto prefix = NebulaKeyUtils::prefix(part);
+    auto ret = kvstore_->prefix(space, part, prefix, &iter);
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        return ret;
+    }
+
+    std::vector<kvstore::KV> data;
+    data.reserve(FLAGS_rebuild_index_batch_num);
+    // The edges are in the order of (srcId, edgeType), count them one group by one group
+    VertexID currentSrc = 0;
+    EdgeType currentType = 0;
+    int64_t degree = 0;
+    std::string lastKey;
+    auto flushDegree = [&] () -> kvstore::ResultCode {
+        if (degree > 0) {
+            data.emplace_back(NebulaKeyUtils::degreeKey(part, currentSrc, currentType),
+                              NebulaKeyUtils::encodeDegree(degree));
+            degree = 0;
+        }
+        if (static_cast<int32_t>(data.size()) >= FLAGS_rebuild_index_batch_num) {
+            auto result = doSyncPut(space, part, std::move(data));
+            data.clear();
+            data.reserve(FLAGS_rebuild_index_batch_num);
+            return result;
+        }
+        return kvstore::ResultCode::SUCCEEDED;
+    };
+    for (; iter && iter->valid(); iter->next()) {
+        auto key = iter->key();
+        if (!NebulaKeyUtils::isEdge(key)) {
+            continue;
+        }
+        auto src = NebulaKeyUtils::getSrcId(key);
+        auto type = NebulaKeyUtils::getEdgeType(key);
+        if (degree > 0 && (src != currentSrc || type != currentType)) {
+            auto result = flushDegree();
+            if (result != kvstore::ResultCode::SUCCEEDED) {
+                return result;
+            }
+        }
+        currentSrc = src;
+        currentType = type;
+        auto noVersion = NebulaKeyUtils::keyWithNoVersion(key);
+        if (noVersion == folly::StringPiece(lastKey)) {
+            continue;
+        }
+        lastKey = noVersion.str();
+        degree++;
+    }
+    auto result = flushDegree();
+    if (result != kvstore::ResultCode::SUCCEEDED || data.empty()) {
+        return result;
+    }
+    return doSyncPut(space, part, std::move(data));
+}
+
+kvstore::ResultCode RebuildEdgeDegreeProcessor::removeObsoleteCounters(GraphSpaceID space,
+                                                                        PartitionID part) {
+    std::unique_ptr<kvstore::KVIterator> iter;
+    auto prefix = NebulaKeyUtils::degreePrefix(part);
+    auto ret = kvstore_->prefix(space, part, prefix, &iter);
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        return ret;
+    }
+
+    std::vector<std::string> keys;
+    for (; iter && iter->valid(); iter->next()) {
+        auto key = iter->key();
+        if (!NebulaKeyUtils::isDegreeKey(key)) {
+            continue;
+        }
+        auto edgePrefix = NebulaKeyUtils::edgePrefix(part,
+                                                     NebulaKeyUtils::getDegreeVertexId(key),
+                                                     NebulaKeyUtils::getDegreeEdgeType(key));
+        std::unique_ptr<kvstore::KVIterator> edgeIter;
+        ret = kvstore_->prefix(space, part, edgePrefix, &edgeIter);
+        if (ret != kvstore::ResultCode::SUCCEEDED) {
+            return ret;
+        }
+        if (edgeIter && edgeIter->valid()) {
+            continue;
+        }
+        keys.emplace_back(key.str());
+        if (static_cast<int32_t>(keys.size()) >= FLAGS_rebuild_index_batch_num) {
+            ret = doSyncRemove(space, part, std::move(keys));
+            if (ret != kvstore::ResultCode::SUCCEEDED) {
+                return ret;
+            }
+            keys.clear();
+        }
+    }
+    if (keys.empty()) {
+        return kvstore::ResultCode::SUCCEEDED;
+    }
+    return doSyncRemove(space, part, std::move(keys));
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,47 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef STORAGE_ADMIN_REBUILDEDGEDEGREEPROCESSOR_H_
+#define STORAGE_ADMIN_REBUILDEDGEDEGREEPROCESSOR_H_
+
+#include "kvstore/KVStore.h"
+#include "kvstore/KVIterator.h"
+#include "meta/SchemaManager.h"
+#include "storage/BaseProcessor.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * Rebuild the edge counters of the parts from the edges, for the edges written
+ * before enable_edge_degree is on, or the counters drifted by TTL expiry.
+ * The writes of the space should be blocked during rebuilding, as the offline
+ * index rebuilding.
+ * */
+class RebuildEdgeDegreeProcessor : public BaseProcessor<cpp2::AdminExecResp> {
+public:
+    static RebuildEdgeDegreeProcessor* instance(kvstore::KVStore* kvstore,
+                                                meta::SchemaManager* schemaMan) {
+        return new RebuildEdgeDegreeProcessor(kvstore, schemaMan);
+    }
+
+    void process(const cpp2::RebuildEdgeDegreeRequest& req);
+
+private:
+    explicit RebuildEdgeDegreeProcessor(kvstore::KVStore* kvstore,
+                                        meta::SchemaManager* schemaMan)
+            : BaseProcessor<cpp2::AdminExecResp>(kvstore, schemaMan, nullptr) {}
+
+    // Overwrite the counters with the number of the edges without versions
+    kvstore::ResultCode rebuildCounters(GraphSpaceID space, PartitionID part);
+
+    // Remove the counters of (vertex, edgeType) which have no edges any more
+    kvstore::ResultCode removeObsoleteCounters(GraphSpaceID space, PartitionID part);
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // STORAGE_ADMIN_REBUILDEDGEDEGREEPROCESSOR_H_
@@ -83,8 +83,9 @@ void RebuildTagIndexProcessor::process(const cpp2::RebuildIndexRequest& req) {
                     iter->next();
                     continue;
                 }
-                auto values = collectIndexValues(reader.get(), item->get_fields());
+                auto values = collectIndexValues(reader.get(), *item);
                 if (!values.ok()) {
+                    iter->next();
                     continue;
                 }
                 auto indexKey = NebulaKeyUtils::vertexIndexKey(part, indexID,
@@ -107,6 +107,7 @@ folly::SemiFuture<StorageRpcResponse<cpp2::QueryResponse>> StorageClient::getNei
         const std::vector<EdgeType> &edgeTypes,
         std::string filter,
         std::vector<cpp2::PropDef> returnCols,
+        bool profile,
         folly::EventBase* evb) {
     auto status = clusterIdsToHosts(space, vertices, [](const VertexID& v) { return v; });
 
@@ -126,6 +127,7 @@ folly::SemiFuture<StorageRpcResponse<cpp2::QueryResponse>> StorageClient::getNei
         req.set_edge_types(edgeTypes);
         req.set_filter(filter);
         req.set_return_columns(returnCols);
+        req.set_profile(profile);
     }
 
     return collectResponse(
@@ -139,6 +141,105 @@ folly::SemiFuture<StorageRpcResponse<cpp2::QueryResponse>> StorageClient::getNei
 }
 
 
+folly::SemiFuture<StorageRpcResponse<cpp2::QueryResponse>> StorageClient::getNeighborsByPage(
+        GraphSpaceID space,
+        const std::unordered_map<VertexID, std::string> &cursors,
+        const std::vector<EdgeType> &edgeTypes,
+        std::string filter,
+        std::vector<cpp2::PropDef> returnCols,
+        int32_t limit,
+        bool profile,
+        folly::EventBase* evb) {
+    std::vector<VertexID> vertices;
+    vertices.reserve(cursors.size());
+    for (auto& cursor : cursors) {
+        vertices.emplace_back(cursor.first);
+    }
+    auto status = clusterIdsToHosts(space, vertices, [](const VertexID& v) { return v; });
+
+    if (!status.ok()) {
+        return folly::makeFuture<StorageRpcResponse<cpp2::QueryResponse>>(
+            std::runtime_error(status.status().toString()));
+    }
+
+    auto& clusters = status.value();
+
+    std::unordered_map<HostAddr, cpp2::GetNeighborsRequest> requests;
+    for (auto& c : clusters) {
+        auto& host = c.first;
+        auto& req = requests[host];
+        decltype(req.cursors) hostCursors;
+        for (auto& p : c.second) {
+            for (auto& v : p.second) {
+                auto& cursor = cursors.at(v);
+                if (!cursor.empty()) {
+                    hostCursors.emplace(v, cursor);
+                }
+            }
+        }
+        req.set_space_id(space);
+        req.set_parts(std::move(c.second));
+        req.set_edge_types(edgeTypes);
+        req.set_filter(filter);
+        req.set_return_columns(returnCols);
+        req.set_cursors(std::move(hostCursors));
+        req.set_limit(limit);
+        req.set_profile(profile);
+    }
+
+    return collectResponse(
+        evb, std::move(requests),
+        [](cpp2::StorageServiceAsyncClient* client, const cpp2::GetNeighborsRequest& r) {
+            return client->future_getBound(r); },
+        [](const std::pair<const PartitionID,
+                           std::vector<VertexID>>& p) {
+            return p.first;
+        });
+}
+
+
+folly::SemiFuture<StorageRpcResponse<cpp2::TraverseResponse>> StorageClient::traverse(
+        GraphSpaceID space,
+        const std::vector<VertexID> &vertices,
+        const std::vector<EdgeType> &edgeTypes,
+        int32_t steps,
+        folly::EventBase* evb) {
+    auto partsNum = this->partsNum(space);
+    if (!partsNum.ok()) {
+        return folly::makeFuture<StorageRpcResponse<cpp2::TraverseResponse>>(
+            std::runtime_error(partsNum.status().toString()));
+    }
+    auto status = clusterIdsToHosts(space, vertices, [](const VertexID& v) { return v; });
+
+    if (!status.ok()) {
+        return folly::makeFuture<StorageRpcResponse<cpp2::TraverseResponse>>(
+            std::runtime_error(status.status().toString()));
+    }
+
+    auto& clusters = status.value();
+
+    std::unordered_map<HostAddr, cpp2::TraverseRequest> requests;
+    for (auto& c : clusters) {
+        auto& host = c.first;
+        auto& req = requests[host];
+        req.set_space_id(space);
+        req.set_parts(std::move(c.second));
+        req.set_edge_types(edgeTypes);
+        req.set_steps(steps);
+        req.set_parts_num(partsNum.value());
+    }
+
+    return collectResponse(
+        evb, std::move(requests),
+        [](cpp2::StorageServiceAsyncClient* client, const cpp2::TraverseRequest& r) {
+            return client->future_traverse(r); },
+        [](const std::pair<const PartitionID,
+                           std::vector<VertexID>>& p) {
+            return p.first;
+        });
+}
+
+
 folly::SemiFuture<StorageRpcResponse<cpp2::QueryStatsResponse>> StorageClient::neighborStats(
         GraphSpaceID space,
         std::vector<VertexID> vertices,
@@ -181,6 +282,7 @@ folly::SemiFuture<StorageRpcResponse<cpp2::QueryResponse>> StorageClient::getVer
         GraphSpaceID space,
         std::vector<VertexID> vertices,
         std::vector<cpp2::PropDef> returnCols,
+        bool profile,
         folly::EventBase* evb) {
     auto status = clusterIdsToHosts(space, vertices, [](const VertexID& v) { return v; });
 
@@ -197,6 +299,7 @@ folly::SemiFuture<StorageRpcResponse<cpp2::QueryResponse>> StorageClient::getVer
         req.set_space_id(space);
         req.set_parts(std::move(c.second));
         req.set_return_columns(returnCols);
+        req.set_profile(profile);
     }
 
     return collectResponse(
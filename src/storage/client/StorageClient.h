@@ -127,6 +127,35 @@ public:
         const std::vector<EdgeType> &edgeTypes,
         std::string filter,
         std::vector<storage::cpp2::PropDef> returnCols,
+        bool profile = false,
+        folly::EventBase* evb = nullptr);
+
+    /**
+     * Get at most `limit' edges for each vertex, starting from its cursor.
+     * An empty cursor means starting from the first edge. The cursors of the
+     * next page are returned in VertexData.next_cursor.
+     * */
+    folly::SemiFuture<StorageRpcResponse<storage::cpp2::QueryResponse>> getNeighborsByPage(
+        GraphSpaceID space,
+        const std::unordered_map<VertexID, std::string> &cursors,
+        const std::vector<EdgeType> &edgeTypes,
+        std::string filter,
+        std::vector<storage::cpp2::PropDef> returnCols,
+        int32_t limit,
+        bool profile = false,
+        folly::EventBase* evb = nullptr);
+
+    /**
+     * Go `steps' steps from the vertices along the edge types inside storaged.
+     * The vertices reached after all the steps are returned in
+     * TraverseResponse.vertices, and the vertices which should go on in other
+     * hosts are returned in TraverseResponse.forwards, with the steps left.
+     * */
+    folly::SemiFuture<StorageRpcResponse<storage::cpp2::TraverseResponse>> traverse(
+        GraphSpaceID space,
+        const std::vector<VertexID> &vertices,
+        const std::vector<EdgeType> &edgeTypes,
+        int32_t steps,
         folly::EventBase* evb = nullptr);
 
     folly::SemiFuture<StorageRpcResponse<storage::cpp2::QueryStatsResponse>> neighborStats(
@@ -141,6 +170,7 @@ public:
         GraphSpaceID space,
         std::vector<VertexID> vertices,
         std::vector<storage::cpp2::PropDef> returnCols,
+        bool profile = false,
         folly::EventBase* evb = nullptr);
 
     folly::SemiFuture<StorageRpcResponse<storage::cpp2::EdgePropResponse>> getEdgeProps(
@@ -13,6 +13,15 @@
 namespace nebula {
 namespace storage {
 
+/**
+ * Rows collected from one part. Parts are scanned concurrently,
+ * so each part owns its rows until they are merged into the response.
+ */
+struct PartIndexRows {
+    std::vector<cpp2::VertexIndexData>     vertexRows_;
+    std::vector<cpp2::Edge>                edgeRows_;
+};
+
 template<typename RESP>
 class IndexExecutor : public BaseProcessor<RESP>
                     , public IndexPolicyMaker {
@@ -25,10 +34,12 @@ protected:
                            meta::IndexManager* indexMan,
                            stats::Stats* stats,
                            VertexCache* cache,
+                           folly::Executor* executor = nullptr,
                            bool isEdgeIndex = false)
         : BaseProcessor<RESP>(kvstore, schemaMan, stats)
         , IndexPolicyMaker(schemaMan, indexMan)
         , vertexCache_(cache)
+        , executor_(executor)
         , isEdgeIndex_(isEdgeIndex) {}
 
     void putResultCodes(cpp2::ErrorCode code, const std::vector<PartitionID>& parts) {
@@ -49,17 +60,54 @@ protected:
     cpp2::ErrorCode buildExecutionPlan(const std::string& filter);
 
     /**
-     * Details Scan index part as one by one.
+     * Details Scan index of one part, the rows are collected into the given container.
      **/
-    kvstore::ResultCode executeExecutionPlan(PartitionID part);
+    kvstore::ResultCode executeExecutionPlan(PartitionID part, PartIndexRows* rows);
+
+    /**
+     * Details Scan index of one part on the executor. If no executor is given,
+     *         the part is scanned in the calling thread. The part is skipped
+     *         once another part failed or the rows of all parts reach the limit.
+     **/
+    folly::Future<PartCode> asyncExecuteExecutionPlan(PartitionID part, PartIndexRows* rows);
+
+    /**
+     * Details Merge the rows of all parts, at most FLAGS_max_rows_returned_per_lookup
+     *         rows are kept.
+     **/
+    void mergeRows(std::vector<PartIndexRows>& partRows);
 
 private:
     cpp2::ErrorCode checkIndex(IndexID indexId);
 
     cpp2::ErrorCode checkReturnColumns(const std::vector<std::string> &cols);
 
-    kvstore::ResultCode getDataRow(PartitionID partId,
-                                   const folly::StringPiece& key);
+    /**
+     * Details Whether the parts should stop scanning, i.e. some part failed,
+     *         or FLAGS_max_rows_returned_per_lookup index keys have been
+     *         collected from all parts.
+     **/
+    bool stopScan() const;
+
+    /**
+     * Details Scan the cell ranges of the geo index, and check the point
+     *         of each vertex by the filter, e.g. for the exact distance.
+     **/
+    kvstore::ResultCode executeGeoPlan(PartitionID part, PartIndexRows* rows);
+
+    /**
+     * Details Read the latest row of the vertex, from the cache if enabled.
+     *         The row is empty if the vertex is not found.
+     **/
+    kvstore::ResultCode getVertexVal(PartitionID partId, VertexID vId, std::string* val);
+
+    kvstore::ResultCode getVertexRows(PartitionID partId,
+                                      const std::vector<std::string>& keys,
+                                      std::vector<cpp2::VertexIndexData>* rows);
+
+    kvstore::ResultCode getEdgeRows(PartitionID partId,
+                                    const std::vector<std::string>& keys,
+                                    std::vector<cpp2::Edge>* rows);
 
     kvstore::ResultCode getVertexRow(PartitionID partId,
                                      const folly::StringPiece& key,
@@ -69,8 +117,19 @@ private:
                                    const folly::StringPiece& key,
                                    cpp2::Edge* data);
 
+    kvstore::ResultCode getVertexRowFromVal(VertexID vId,
+                                            const folly::StringPiece& val,
+                                            cpp2::VertexIndexData* data);
+
     std::string getRowFromReader(RowReader* reader);
 
+    /**
+     * Details Build the row from the index key directly,
+     *         it only works when all return columns are index columns.
+     *         ERR_CORRUPT_DATA is returned if any column fails to be decoded.
+     **/
+    kvstore::ResultCode getRowFromIndexKey(const folly::StringPiece& key, std::string* row);
+
     bool conditionsCheck(const folly::StringPiece& key);
 
     OptVariantType decodeValue(const folly::StringPiece& key,
@@ -82,17 +141,21 @@ private:
 protected:
     GraphSpaceID                           spaceId_;
     VertexCache*                           vertexCache_{nullptr};
+    folly::Executor*                       executor_{nullptr};
     std::shared_ptr<SchemaWriter>          schema_{nullptr};
     std::vector<cpp2::VertexIndexData>     vertexRows_;
     std::vector<cpp2::Edge>                edgeRows_;
     bool                                   isEdgeIndex_{false};
 
 private:
-    int                                                rowNum_{0};
     int32_t                                            tagOrEdge_;
     int32_t                                            vColNum_{0};
     std::vector<PropContext>                           props_;
+    bool                                               coveredByIndex_{false};
     std::map<std::string, nebula::cpp2::SupportedType> indexCols_;
+    // The index keys collected by all parts, which are scanned concurrently
+    std::atomic<int64_t>                               keysCollected_{0};
+    std::atomic<bool>                                  failed_{false};
 };
 
 }  // namespace storage
@@ -8,6 +8,7 @@
 
 DECLARE_int32(max_rows_returned_per_lookup);
 DECLARE_bool(enable_vertex_cache);
+DECLARE_bool(enable_multi_versions);
 
 namespace nebula {
 namespace storage {
@@ -55,6 +56,10 @@ cpp2::ErrorCode IndexExecutor<RESP>::checkIndex(IndexID indexId) {
     index_ = std::move(index).value();
     tagOrEdge_ = (isEdgeIndex_) ? index_->get_schema_id().get_edge_type() :
                                   index_->get_schema_id().get_tag_id();
+    if (isGeoIndex()) {
+        // The key holds the cell of the point, not the value of the field
+        return cpp2::ErrorCode::SUCCEEDED;
+    }
     for (const auto& col : index_->get_fields()) {
         indexCols_[col.get_name()] = col.get_type().get_type();
         if (col.get_type().get_type() == nebula::cpp2::SupportedType::STRING) {
@@ -111,25 +116,36 @@ cpp2::ErrorCode IndexExecutor<RESP>::checkReturnColumns(const std::vector<std::s
             }
             schema_->appendCol(col, std::move(ftype).get_type());
         }   // end for
+        /**
+         * If all return columns are encoded in the index key,
+         * the data row needn't be read.
+         */
+        coveredByIndex_ = std::all_of(cols.begin(), cols.end(),
+                                      [this] (const auto& col) {
+                                          return indexCols_.find(col) != indexCols_.end();
+                                      });
     }
     return cpp2::ErrorCode::SUCCEEDED;
 }
 
 template <typename RESP>
-kvstore::ResultCode IndexExecutor<RESP>::executeExecutionPlan(PartitionID part) {
-    std::string prefix = NebulaKeyUtils::indexPrefix(part, index_->get_index_id())
-                        .append(prefix_);
+kvstore::ResultCode IndexExecutor<RESP>::executeExecutionPlan(PartitionID part,
+                                                              PartIndexRows* rows) {
+    if (isGeoIndex()) {
+        return executeGeoPlan(part, rows);
+    }
+    auto range = scanRange(NebulaKeyUtils::indexPrefix(part, index_->get_index_id()));
     std::unique_ptr<kvstore::KVIterator> iter;
     std::vector<std::string> keys;
-    auto ret = this->kvstore_->prefix(spaceId_,
-                                      part,
-                                      prefix,
-                                      &iter);
+    auto ret = this->kvstore_->range(spaceId_,
+                                     part,
+                                     range.first,
+                                     range.second,
+                                     &iter);
     if (ret != nebula::kvstore::SUCCEEDED) {
         return ret;
     }
-    while (iter->valid() &&
-           rowNum_ < FLAGS_max_rows_returned_per_lookup) {
+    while (iter->valid() && !stopScan()) {
         auto key = iter->key();
         /**
          * Need to filter result with expression if is not accurate scan.
@@ -139,37 +155,315 @@ kvstore::ResultCode IndexExecutor<RESP>::executeExecutionPlan(PartitionID part)
             continue;
         }
         keys.emplace_back(key);
+        keysCollected_++;
         iter->next();
     }
-    for (auto& item : keys) {
-        ret = getDataRow(part, item);
+    if (isEdgeIndex_) {
+        return getEdgeRows(part, keys, &rows->edgeRows_);
+    }
+    return getVertexRows(part, keys, &rows->vertexRows_);
+}
+
+template <typename RESP>
+kvstore::ResultCode IndexExecutor<RESP>::executeGeoPlan(PartitionID part, PartIndexRows* rows) {
+    auto ranges = geoScanRanges(NebulaKeyUtils::indexPrefix(part, index_->get_index_id()));
+    for (const auto& range : ranges) {
+        std::unique_ptr<kvstore::KVIterator> iter;
+        auto ret = this->kvstore_->range(spaceId_, part, range.first, range.second, &iter);
         if (ret != kvstore::ResultCode::SUCCEEDED) {
             return ret;
         }
+        for (; iter->valid() && !stopScan(); iter->next()) {
+            auto vId = NebulaKeyUtils::getIndexVertexID(iter->key());
+            std::string val;
+            ret = getVertexVal(part, vId, &val);
+            if (ret != kvstore::ResultCode::SUCCEEDED) {
+                return ret;
+            }
+            if (val.empty()) {
+                continue;
+            }
+            auto reader = RowReader::getTagPropReader(schemaMan_, val, spaceId_, tagOrEdge_);
+            if (reader == nullptr) {
+                LOG(ERROR) << "Bad row for vId " << vId << ", tagId " << tagOrEdge_;
+                return kvstore::ResultCode::ERR_CORRUPT_DATA;
+            }
+            Getters getters;
+            getters.getAliasProp = [&reader] (const std::string&,
+                                              const std::string& prop) -> OptVariantType {
+                auto res = RowReader::getPropByName(reader.get(), prop);
+                if (!ok(res)) {
+                    return Status::Error("Invalid Prop");
+                }
+                return value(std::move(res));
+            };
+            if (!exprEval(getters)) {
+                continue;
+            }
+            cpp2::VertexIndexData data;
+            data.set_vertex_id(vId);
+            if (schema_ != nullptr) {
+                data.set_props(getRowFromReader(reader.get()));
+            }
+            rows->vertexRows_.emplace_back(std::move(data));
+            keysCollected_++;
+        }
+    }
+    return kvstore::ResultCode::SUCCEEDED;
+}
+
+template <typename RESP>
+bool IndexExecutor<RESP>::stopScan() const {
+    return failed_ || keysCollected_ >= FLAGS_max_rows_returned_per_lookup;
+}
+
+template <typename RESP>
+kvstore::ResultCode IndexExecutor<RESP>::getVertexVal(PartitionID partId,
+                                                      VertexID vId,
+                                                      std::string* val) {
+    if (FLAGS_enable_vertex_cache && vertexCache_ != nullptr) {
+        auto result = vertexCache_->get(std::make_pair(vId, tagOrEdge_));
+        if (result.ok()) {
+            *val = std::move(result).value();
+            return kvstore::ResultCode::SUCCEEDED;
+        }
+    }
+    auto prefix = NebulaKeyUtils::vertexPrefix(partId, vId, tagOrEdge_);
+    std::unique_ptr<kvstore::KVIterator> iter;
+    auto ret = this->kvstore_->prefix(spaceId_, partId, prefix, &iter);
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        return ret;
+    }
+    if (iter && iter->valid()) {
+        *val = iter->val().str();
+        if (FLAGS_enable_vertex_cache && vertexCache_ != nullptr) {
+            vertexCache_->insert(std::make_pair(vId, tagOrEdge_), *val);
+        }
+    }
+    return kvstore::ResultCode::SUCCEEDED;
+}
+
+template <typename RESP>
+folly::Future<PartCode>
+IndexExecutor<RESP>::asyncExecuteExecutionPlan(PartitionID part, PartIndexRows* rows) {
+    auto execute = [this, part, rows] () {
+        if (stopScan()) {
+            return std::make_pair(part, kvstore::ResultCode::SUCCEEDED);
+        }
+        auto ret = executeExecutionPlan(part, rows);
+        if (ret != kvstore::ResultCode::SUCCEEDED) {
+            failed_ = true;
+        }
+        return std::make_pair(part, ret);
+    };
+    if (executor_ == nullptr) {
+        return folly::makeFuture<PartCode>(execute());
+    }
+    folly::Promise<PartCode> pro;
+    auto f = pro.getFuture();
+    executor_->add([p = std::move(pro), execute = std::move(execute)] () mutable {
+        p.setValue(execute());
+    });
+    return f;
+}
+
+template <typename RESP>
+void IndexExecutor<RESP>::mergeRows(std::vector<PartIndexRows>& partRows) {
+    auto limit = static_cast<size_t>(FLAGS_max_rows_returned_per_lookup);
+    for (auto& rows : partRows) {
+        auto& src = rows.vertexRows_;
+        auto num = std::min(src.size(), limit - std::min(limit, vertexRows_.size()));
+        std::move(src.begin(), src.begin() + num, std::back_inserter(vertexRows_));
+        auto& edges = rows.edgeRows_;
+        num = std::min(edges.size(), limit - std::min(limit, edgeRows_.size()));
+        std::move(edges.begin(), edges.begin() + num, std::back_inserter(edgeRows_));
     }
-    return ret;
 }
 
 template<typename RESP>
-kvstore::ResultCode IndexExecutor<RESP>::getDataRow(PartitionID partId,
-                                                    const folly::StringPiece& key) {
-    kvstore::ResultCode ret;
-    if (isEdgeIndex_) {
-        cpp2::Edge data;
-        ret = getEdgeRow(partId, key, &data);
-        if (ret == kvstore::SUCCEEDED) {
-            edgeRows_.emplace_back(std::move(data));
-            ++rowNum_;
+kvstore::ResultCode
+IndexExecutor<RESP>::getVertexRows(PartitionID partId,
+                                   const std::vector<std::string>& keys,
+                                   std::vector<cpp2::VertexIndexData>* rows) {
+    std::vector<cpp2::VertexIndexData> data(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        data[i].set_vertex_id(NebulaKeyUtils::getIndexVertexID(keys[i]));
+    }
+    if (schema_ == nullptr) {
+        std::move(data.begin(), data.end(), std::back_inserter(*rows));
+        return kvstore::ResultCode::SUCCEEDED;
+    }
+    if (coveredByIndex_) {
+        for (size_t i = 0; i < keys.size(); i++) {
+            std::string row;
+            auto code = getRowFromIndexKey(keys[i], &row);
+            if (code != kvstore::ResultCode::SUCCEEDED) {
+                return code;
+            }
+            data[i].set_props(std::move(row));
+        }
+        std::move(data.begin(), data.end(), std::back_inserter(*rows));
+        return kvstore::ResultCode::SUCCEEDED;
+    }
+
+    /**
+     * Rows not hit in cache. If multi versions is disabled, the data key is fixed,
+     * so they are fetched in batch, the rest falls back to prefix scan.
+     */
+    std::vector<size_t> missed;
+    for (size_t i = 0; i < keys.size(); i++) {
+        auto vId = data[i].get_vertex_id();
+        if (FLAGS_enable_vertex_cache && vertexCache_ != nullptr) {
+            auto result = vertexCache_->get(std::make_pair(vId, tagOrEdge_));
+            if (result.ok()) {
+                auto code = getVertexRowFromVal(vId, result.value(), &data[i]);
+                if (code != kvstore::ResultCode::SUCCEEDED) {
+                    return code;
+                }
+                VLOG(3) << "Hit cache for vId " << vId << ", tagId " << tagOrEdge_;
+                continue;
+            }
+            VLOG(3) << "Miss cache for vId " << vId << ", tagId " << tagOrEdge_;
+        }
+        missed.emplace_back(i);
+    }
+
+    if (!FLAGS_enable_multi_versions && !missed.empty()) {
+        std::vector<std::string> dataKeys;
+        dataKeys.reserve(missed.size());
+        for (auto i : missed) {
+            dataKeys.emplace_back(NebulaKeyUtils::vertexKey(partId,
+                                                            data[i].get_vertex_id(),
+                                                            tagOrEdge_,
+                                                            0));
+        }
+        std::vector<std::string> values;
+        auto ret = this->kvstore_->multiGet(spaceId_, partId, dataKeys, &values);
+        if (ret.first != kvstore::ResultCode::SUCCEEDED &&
+            ret.first != kvstore::ResultCode::ERR_PARTIAL_RESULT) {
+            return ret.first;
+        }
+        std::vector<size_t> left;
+        for (size_t j = 0; j < missed.size(); j++) {
+            auto i = missed[j];
+            if (!ret.second[j].ok()) {
+                left.emplace_back(i);
+                continue;
+            }
+            auto code = getVertexRowFromVal(data[i].get_vertex_id(), values[j], &data[i]);
+            if (code != kvstore::ResultCode::SUCCEEDED) {
+                return code;
+            }
+            if (FLAGS_enable_vertex_cache && vertexCache_ != nullptr) {
+                vertexCache_->insert(std::make_pair(data[i].get_vertex_id(), tagOrEdge_),
+                                     std::move(values[j]));
+            }
+        }
+        missed = std::move(left);
+    }
+
+    for (auto i : missed) {
+        auto code = getVertexRow(partId, keys[i], &data[i]);
+        if (code != kvstore::ResultCode::SUCCEEDED) {
+            return code;
+        }
+    }
+    std::move(data.begin(), data.end(), std::back_inserter(*rows));
+    return kvstore::ResultCode::SUCCEEDED;
+}
+
+template<typename RESP>
+kvstore::ResultCode
+IndexExecutor<RESP>::getEdgeRows(PartitionID partId,
+                                 const std::vector<std::string>& keys,
+                                 std::vector<cpp2::Edge>* rows) {
+    std::vector<cpp2::Edge> data(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        cpp2::EdgeKey edge;
+        edge.set_src(NebulaKeyUtils::getIndexSrcId(keys[i]));
+        edge.set_edge_type(tagOrEdge_);
+        edge.set_ranking(NebulaKeyUtils::getIndexRank(keys[i]));
+        edge.set_dst(NebulaKeyUtils::getIndexDstId(keys[i]));
+        data[i].set_key(std::move(edge));
+    }
+    if (schema_ == nullptr) {
+        std::move(data.begin(), data.end(), std::back_inserter(*rows));
+        return kvstore::ResultCode::SUCCEEDED;
+    }
+    if (coveredByIndex_) {
+        for (size_t i = 0; i < keys.size(); i++) {
+            std::string row;
+            auto code = getRowFromIndexKey(keys[i], &row);
+            if (code != kvstore::ResultCode::SUCCEEDED) {
+                return code;
+            }
+            data[i].set_props(std::move(row));
+        }
+        std::move(data.begin(), data.end(), std::back_inserter(*rows));
+        return kvstore::ResultCode::SUCCEEDED;
+    }
+
+    std::vector<size_t> missed;
+    if (!FLAGS_enable_multi_versions && !keys.empty()) {
+        std::vector<std::string> dataKeys;
+        dataKeys.reserve(keys.size());
+        for (const auto& row : data) {
+            const auto& edge = row.get_key();
+            dataKeys.emplace_back(NebulaKeyUtils::edgeKey(partId,
+                                                          edge.get_src(),
+                                                          tagOrEdge_,
+                                                          edge.get_ranking(),
+                                                          edge.get_dst(),
+                                                          0));
+        }
+        std::vector<std::string> values;
+        auto ret = this->kvstore_->multiGet(spaceId_, partId, dataKeys, &values);
+        if (ret.first != kvstore::ResultCode::SUCCEEDED &&
+            ret.first != kvstore::ResultCode::ERR_PARTIAL_RESULT) {
+            return ret.first;
+        }
+        for (size_t i = 0; i < keys.size(); i++) {
+            if (!ret.second[i].ok()) {
+                missed.emplace_back(i);
+                continue;
+            }
+            auto reader = RowReader::getEdgePropReader(schemaMan_,
+                                                       values[i],
+                                                       spaceId_,
+                                                       tagOrEdge_);
+            if (reader == nullptr) {
+                return kvstore::ResultCode::ERR_CORRUPT_DATA;
+            }
+            data[i].set_props(getRowFromReader(reader.get()));
         }
     } else {
-        cpp2::VertexIndexData data;
-        ret = getVertexRow(partId, key, &data);
-        if (ret == kvstore::SUCCEEDED) {
-            vertexRows_.emplace_back(std::move(data));
-            ++rowNum_;
+        missed.reserve(keys.size());
+        for (size_t i = 0; i < keys.size(); i++) {
+            missed.emplace_back(i);
         }
     }
-    return ret;
+
+    for (auto i : missed) {
+        auto code = getEdgeRow(partId, keys[i], &data[i]);
+        if (code != kvstore::ResultCode::SUCCEEDED) {
+            return code;
+        }
+    }
+    std::move(data.begin(), data.end(), std::back_inserter(*rows));
+    return kvstore::ResultCode::SUCCEEDED;
+}
+
+template<typename RESP>
+kvstore::ResultCode IndexExecutor<RESP>::getVertexRowFromVal(VertexID vId,
+                                                             const folly::StringPiece& val,
+                                                             cpp2::VertexIndexData* data) {
+    auto reader = RowReader::getTagPropReader(schemaMan_, val, spaceId_, tagOrEdge_);
+    if (reader == nullptr) {
+        LOG(ERROR) << "Bad row for vId " << vId << ", tagId " << tagOrEdge_;
+        return kvstore::ResultCode::ERR_CORRUPT_DATA;
+    }
+    data->set_props(getRowFromReader(reader.get()));
+    return kvstore::ResultCode::SUCCEEDED;
 }
 
 template<typename RESP>
@@ -181,22 +475,6 @@ kvstore::ResultCode IndexExecutor<RESP>::getVertexRow(PartitionID partId,
     if (schema_ == nullptr) {
         return kvstore::ResultCode::SUCCEEDED;
     }
-    if (FLAGS_enable_vertex_cache && vertexCache_ != nullptr) {
-        auto result = vertexCache_->get(std::make_pair(vId, tagOrEdge_));
-        if (result.ok()) {
-            auto v = std::move(result).value();
-            auto reader = RowReader::getTagPropReader(schemaMan_, v, spaceId_, tagOrEdge_);
-            if (reader == nullptr) {
-                return kvstore::ResultCode::ERR_CORRUPT_DATA;
-            }
-            auto row = getRowFromReader(reader.get());
-            data->set_props(std::move(row));
-            VLOG(3) << "Hit cache for vId " << vId << ", tagId " << tagOrEdge_;
-            return kvstore::ResultCode::SUCCEEDED;
-        } else {
-            VLOG(3) << "Miss cache for vId " << vId << ", tagId " << tagOrEdge_;
-        }
-    }
     auto prefix = NebulaKeyUtils::vertexPrefix(partId, vId, tagOrEdge_);
     std::unique_ptr<kvstore::KVIterator> iter;
     auto ret = this->kvstore_->prefix(spaceId_, partId, prefix, &iter);
@@ -205,15 +483,10 @@ kvstore::ResultCode IndexExecutor<RESP>::getVertexRow(PartitionID partId,
         return ret;
     }
     if (iter && iter->valid()) {
-        auto reader = RowReader::getTagPropReader(schemaMan_,
-                                                  iter->val(),
-                                                  spaceId_,
-                                                  tagOrEdge_);
-        if (reader == nullptr) {
-            return kvstore::ResultCode::ERR_CORRUPT_DATA;
+        ret = getVertexRowFromVal(vId, iter->val(), data);
+        if (ret != kvstore::ResultCode::SUCCEEDED) {
+            return ret;
         }
-        auto row = getRowFromReader(reader.get());
-        data->set_props(std::move(row));
         if (FLAGS_enable_vertex_cache && vertexCache_ != nullptr) {
             vertexCache_->insert(std::make_pair(vId, tagOrEdge_),
                                  iter->val().str());
@@ -276,6 +549,40 @@ std::string IndexExecutor<RESP>::getRowFromReader(RowReader* reader) {
     return writer.encode();
 }
 
+template<typename RESP>
+kvstore::ResultCode IndexExecutor<RESP>::getRowFromIndexKey(const folly::StringPiece& key,
+                                                            std::string* row) {
+    RowWriter writer;
+    for (const auto& prop : props_) {
+        auto res = decodeValue(key, prop.prop_.get_name());
+        if (!res.ok()) {
+            // The columns are written in order, skipping one shifts the rest
+            LOG(ERROR) << "Bad value of prop " << prop.prop_.get_name()
+                       << " in the index key, " << res.status();
+            return kvstore::ResultCode::ERR_CORRUPT_DATA;
+        }
+        auto&& v = res.value();
+        switch (v.which()) {
+            case VAR_INT64:
+                writer << boost::get<int64_t>(v);
+                break;
+            case VAR_DOUBLE:
+                writer << boost::get<double>(v);
+                break;
+            case VAR_BOOL:
+                writer << boost::get<bool>(v);
+                break;
+            case VAR_STR:
+                writer << boost::get<std::string>(v);
+                break;
+            default:
+                LOG(FATAL) << "Unknown VariantType: " << v.which();
+        }
+    }
+    *row = writer.encode();
+    return kvstore::ResultCode::SUCCEEDED;
+}
+
 template<typename RESP>
 bool IndexExecutor<RESP>::conditionsCheck(const folly::StringPiece& key) {
     Getters getters;
@@ -290,7 +597,11 @@ template<typename RESP>
 OptVariantType IndexExecutor<RESP>::decodeValue(const folly::StringPiece& key,
                                                 const folly::StringPiece& prop) {
     using nebula::cpp2::SupportedType;
-    auto type = indexCols_[prop.str()];
+    auto it = indexCols_.find(prop.str());
+    if (it == indexCols_.end()) {
+        return OptVariantType(Status::Error("Unknown index column %s", prop.str().c_str()));
+    }
+    auto type = it->second;
     /**
      * Here need a string copy to avoid memory change
      */
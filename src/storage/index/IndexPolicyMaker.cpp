@@ -6,6 +6,8 @@
 
 #include "storage/index/IndexPolicyMaker.h"
 #include "utils/NebulaKeyUtils.h"
+#include "filter/geo/GeoFilter.h"
+#include "filter/geo/GeoIndex.h"
 
 namespace nebula {
 namespace storage {
@@ -42,35 +44,211 @@ cpp2::ErrorCode IndexPolicyMaker::decodeExpression(const std::string &filter) {
 }
 
 void IndexPolicyMaker::buildPolicy() {
+    if (isGeoIndex()) {
+        // The rows in the cells are always checked for the exact region
+        return;
+    }
     prefix_.reserve(256);
     decltype(operatorList_.size()) hintNum = 0;
     bool hasStr = false;
+    bool inaccurate = false;
     for (auto& col : index_->get_fields()) {
         auto it = std::find_if(operatorList_.begin(), operatorList_.end(),
                                [&col] (const auto& tup) {
-                                   return col.get_name() == std::get<0>(tup);;
+                                   return col.get_name() == std::get<0>(tup) &&
+                                          std::get<2>(tup) == RelationalExpression::Operator::EQ;
                                });
         if (it != operatorList_.end()) {
-            if (std::get<2>(*it) == RelationalExpression::Operator::EQ) {
-                /**
-                 * TODO sky : drop the sub-exp from root expression tree.
-                 */
+            /**
+             * TODO sky : drop the sub-exp from root expression tree.
+             */
+            hintNum++;
+            auto v = std::get<1>(*it);
+            hasStr = hasStr || (v.which() == VAR_STR);
+            prefix_.append(NebulaKeyUtils::encodeVariant(v));
+        } else {
+            /**
+             * The equal prefix ends here, try to narrow the scan
+             * with the range predicates of current column.
+             * The string column has variable length, so the column
+             * followed by a string prefix can't be seeked.
+             */
+            if (optimizedPolicy_ && !hasStr) {
+                auto rangeNum = buildRange(col);
+                auto type = col.get_type().get_type();
+                if (rangeNum > 0 && (type == nebula::cpp2::SupportedType::DOUBLE ||
+                                     type == nebula::cpp2::SupportedType::FLOAT)) {
+                    // Keep the filter to handle the precision of encoded double.
+                    inaccurate = true;
+                }
+                hintNum += rangeNum;
+            }
+            break;
+        }
+    }
+    if (optimizedPolicy_ && hintNum == operatorList_.size() && !hasStr && !inaccurate) {
+        requiredFilter_ = false;
+    }
+}
+
+size_t IndexPolicyMaker::buildRange(const nebula::cpp2::ColumnDef& col) {
+    size_t hintNum = 0;
+    auto type = col.get_type().get_type();
+    if (type == nebula::cpp2::SupportedType::STRING) {
+        return hintNum;
+    }
+    for (const auto& item : operatorList_) {
+        if (std::get<0>(item) != col.get_name() ||
+            !isTypeMatched(type, std::get<1>(item))) {
+            continue;
+        }
+        auto op = std::get<2>(item);
+        auto raw = NebulaKeyUtils::encodeVariant(std::get<1>(item));
+        switch (op) {
+            case RelationalExpression::Operator::GT:
+            case RelationalExpression::Operator::GE: {
+                bool inclusive = (op == RelationalExpression::Operator::GE);
+                if (lowerBound_.empty() || raw > lowerBound_) {
+                    lowerBound_ = std::move(raw);
+                    lowerInclusive_ = inclusive;
+                } else if (raw == lowerBound_ && !inclusive) {
+                    lowerInclusive_ = false;
+                }
                 hintNum++;
-                auto v = std::get<1>(*it);
-                hasStr = (v.which() == VAR_STR);
-                prefix_.append(NebulaKeyUtils::encodeVariant(v));
-            } else {
                 break;
             }
+            case RelationalExpression::Operator::LT:
+            case RelationalExpression::Operator::LE: {
+                bool inclusive = (op == RelationalExpression::Operator::LE);
+                if (upperBound_.empty() || raw < upperBound_) {
+                    upperBound_ = std::move(raw);
+                    upperInclusive_ = inclusive;
+                } else if (raw == upperBound_ && !inclusive) {
+                    upperInclusive_ = false;
+                }
+                hintNum++;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return hintNum;
+}
+
+std::pair<std::string, std::string>
+IndexPolicyMaker::scanRange(const std::string& indexPrefix) const {
+    std::string prefix = indexPrefix + prefix_;
+    std::string start = prefix + lowerBound_;
+    if (!lowerBound_.empty() && !lowerInclusive_) {
+        start = nextPrefix(std::move(start));
+    }
+    std::string end;
+    if (upperBound_.empty()) {
+        end = nextPrefix(std::move(prefix));
+    } else {
+        end = prefix + upperBound_;
+        if (upperInclusive_) {
+            end = nextPrefix(std::move(end));
+        }
+    }
+    return std::make_pair(std::move(start), std::move(end));
+}
+
+std::vector<std::pair<std::string, std::string>>
+IndexPolicyMaker::geoScanRanges(const std::string& indexPrefix) const {
+    std::vector<std::pair<std::string, std::string>> ranges;
+    if (geoRanges_.empty()) {
+        ranges.emplace_back(indexPrefix, nextPrefix(indexPrefix));
+        return ranges;
+    }
+    ranges.reserve(geoRanges_.size());
+    for (const auto& range : geoRanges_) {
+        ranges.emplace_back(indexPrefix + encodeGeoCell(range.first),
+                            indexPrefix + encodeGeoCell(range.second + 1));
+    }
+    return ranges;
+}
+
+cpp2::ErrorCode IndexPolicyMaker::buildGeoRanges(const FunctionCallExpression* expr,
+                                                 Getters& getters) {
+    const auto& name = *expr->name();
+    auto args = expr->args();
+    bool isNear = (name == "near" && args.size() == 3);
+    bool isWithin = (name == "within" && args.size() == 2);
+    // Under OR, the rows out of the region could be matched, the whole index is scanned
+    if ((!isNear && !isWithin) || !geoRanges_.empty() || !optimizedPolicy_ ||
+        args[0]->kind() != nebula::Expression::kAliasProp) {
+        return cpp2::ErrorCode::SUCCEEDED;
+    }
+    auto* aExpr = dynamic_cast<const AliasPropertyExpression*>(args[0]);
+    if (*aExpr->prop() != index_->get_fields()[0].get_name()) {
+        return cpp2::ErrorCode::SUCCEEDED;
+    }
+    auto region = args[1]->eval(getters);
+    if (!region.ok() || region.value().which() != VAR_STR) {
+        VLOG(1) << "Can't evaluate the region " << args[1]->toString();
+        return cpp2::ErrorCode::E_INVALID_FILTER;
+    }
+    const auto& wkt = boost::get<std::string>(region.value());
+
+    geo::GeoIndex geoIndex;
+    std::vector<S2CellId> cells;
+    if (isNear) {
+        auto center = geo::GeoFilter::parsePoint(wkt);
+        auto distance = args[2]->eval(getters);
+        if (!center.ok() || !distance.ok()) {
+            VLOG(1) << "Can't evaluate the near region " << expr->toString();
+            return cpp2::ErrorCode::E_INVALID_FILTER;
+        }
+        geoIndex.coverCap(center.value(), Expression::toDouble(distance.value()), cells);
+    } else {
+        auto polygon = geo::GeoFilter::parsePolygon(wkt);
+        if (!polygon.ok() || !geoIndex.coverPolygon(polygon.value(), cells).ok()) {
+            VLOG(1) << "Can't cover the polygon " << wkt;
+            return cpp2::ErrorCode::E_INVALID_FILTER;
+        }
+    }
+    // The covering is sorted and disjoint, the adjacent cells are scanned in one range.
+    // The leaf cell ids are odd, so no leaf is in between range_max and range_min + 2.
+    for (const auto& cell : cells) {
+        auto min = cell.range_min().id();
+        auto max = cell.range_max().id();
+        if (!geoRanges_.empty() && min <= geoRanges_.back().second + 2) {
+            geoRanges_.back().second = std::max(geoRanges_.back().second, max);
         } else {
-            break;
+            geoRanges_.emplace_back(min, max);
         }
     }
-    if (optimizedPolicy_ && hintNum == operatorList_.size() && !hasStr) {
-        requiredFilter_ = false;
+    VLOG(2) << "Scan " << geoRanges_.size() << " ranges of " << cells.size() << " cells";
+    return cpp2::ErrorCode::SUCCEEDED;
+}
+
+bool IndexPolicyMaker::isTypeMatched(nebula::cpp2::SupportedType type, const VariantType& v) {
+    switch (type) {
+        case nebula::cpp2::SupportedType::BOOL:
+            return v.which() == VAR_BOOL;
+        case nebula::cpp2::SupportedType::INT:
+        case nebula::cpp2::SupportedType::TIMESTAMP:
+            return v.which() == VAR_INT64;
+        case nebula::cpp2::SupportedType::FLOAT:
+        case nebula::cpp2::SupportedType::DOUBLE:
+            return v.which() == VAR_DOUBLE;
+        default:
+            return false;
     }
 }
 
+std::string IndexPolicyMaker::nextPrefix(std::string prefix) {
+    while (!prefix.empty() && static_cast<uint8_t>(prefix.back()) == 0xFF) {
+        prefix.pop_back();
+    }
+    if (!prefix.empty()) {
+        prefix.back() = static_cast<char>(static_cast<uint8_t>(prefix.back()) + 1);
+    }
+    return prefix;
+}
+
 cpp2::ErrorCode IndexPolicyMaker::traversalExpression(const Expression *expr) {
     cpp2::ErrorCode code = cpp2::ErrorCode::SUCCEEDED;
     if (!optimizedPolicy_) {
@@ -106,6 +284,7 @@ cpp2::ErrorCode IndexPolicyMaker::traversalExpression(const Expression *expr) {
             std::string prop;
             VariantType v;
             auto* rExpr = dynamic_cast<const RelationalExpression*>(expr);
+            auto op = rExpr->op();
             auto* left = rExpr->left();
             auto* right = rExpr->right();
             if (left->kind() == nebula::Expression::kAliasProp) {
@@ -126,14 +305,20 @@ cpp2::ErrorCode IndexPolicyMaker::traversalExpression(const Expression *expr) {
                 v = value.value();
                 auto* aExpr = dynamic_cast<const AliasPropertyExpression*>(right);
                 prop = *aExpr->prop();
+                // Normalize "value op prop" as "prop op' value"
+                op = reverseOperator(op);
             } else {
                 optimizedPolicy_ = false;
                 break;
             }
-            operatorList_.emplace_back(std::make_tuple(std::move(prop), std::move(v), rExpr->op()));
+            operatorList_.emplace_back(std::make_tuple(std::move(prop), std::move(v), op));
             break;
         }
         case nebula::Expression::kFunctionCall : {
+            if (isGeoIndex()) {
+                auto* fExpr = dynamic_cast<const FunctionCallExpression*>(expr);
+                return buildGeoRanges(fExpr, getters);
+            }
             optimizedPolicy_ = false;
             break;
         }
@@ -144,6 +329,22 @@ cpp2::ErrorCode IndexPolicyMaker::traversalExpression(const Expression *expr) {
     return code;
 }
 
+RelationalExpression::Operator
+IndexPolicyMaker::reverseOperator(RelationalExpression::Operator op) {
+    switch (op) {
+        case RelationalExpression::Operator::LT:
+            return RelationalExpression::Operator::GT;
+        case RelationalExpression::Operator::LE:
+            return RelationalExpression::Operator::GE;
+        case RelationalExpression::Operator::GT:
+            return RelationalExpression::Operator::LT;
+        case RelationalExpression::Operator::GE:
+            return RelationalExpression::Operator::LE;
+        default:
+            return op;
+    }
+}
+
 bool IndexPolicyMaker::exprEval(Getters &getters) {
     if (exp_ != nullptr) {
         auto value = exp_->eval(getters);
@@ -50,6 +50,24 @@ protected:
      **/
     void buildPolicy();
 
+    /**
+     * Details Build the [start, end) key range of the index scan for given part.
+     *         If no range predicate was hinted, the range equals to the prefix scan.
+     **/
+    std::pair<std::string, std::string> scanRange(const std::string& indexPrefix) const;
+
+    bool isGeoIndex() const {
+        return index_ != nullptr && index_->get_index_type() == nebula::cpp2::IndexType::GEO;
+    }
+
+    /**
+     * Details Build the [start, end) key ranges of the geo index scan for given part,
+     *         one for each run of the cells covering the near() or within() region.
+     *         The whole index is scanned if no such predicate was hinted.
+     **/
+    std::vector<std::pair<std::string, std::string>>
+    geoScanRanges(const std::string& indexPrefix) const;
+
     /**
      * Details Evaluate filter conditions.
      */
@@ -64,16 +82,46 @@ private:
 
     cpp2::ErrorCode traversalExpression(const Expression *expr);
 
+    /**
+     * Details Collect the bounds of the first index column after the equal prefix.
+     *         Only fixed-length columns are supported, because the encoded string
+     *         column isn't order-preserving once followed by other columns.
+     *         Return the number of operators hinted by the range.
+     */
+    size_t buildRange(const nebula::cpp2::ColumnDef& col);
+
+    /**
+     * Details Cover the region of near(field, center, distance) or within(field, polygon)
+     *         on the field of the geo index with S2 cells, as the ranges of leaf cells.
+     *         The rows in the ranges are checked by the filter for the exact distance.
+     */
+    cpp2::ErrorCode buildGeoRanges(const FunctionCallExpression* expr, Getters& getters);
+
+    static RelationalExpression::Operator reverseOperator(RelationalExpression::Operator op);
+
+    static bool isTypeMatched(nebula::cpp2::SupportedType type, const VariantType& v);
+
+    /**
+     * Details The smallest string greater than all strings with the given prefix.
+     */
+    static std::string nextPrefix(std::string prefix);
+
 protected:
     meta::SchemaManager*                     schemaMan_{nullptr};
     meta::IndexManager*                      indexMan_{nullptr};
     std::unique_ptr<ExpressionContext>       expCtx_{nullptr};
     std::unique_ptr<Expression>              exp_{nullptr};
     std::string                              prefix_;
+    std::string                              lowerBound_;
+    std::string                              upperBound_;
+    bool                                     lowerInclusive_{true};
+    bool                                     upperInclusive_{true};
     std::shared_ptr<nebula::cpp2::IndexItem> index_{nullptr};
     bool                                     optimizedPolicy_{true};
     bool                                     requiredFilter_{true};
     std::vector<OperatorItem>                operatorList_;
+    // The [range_min, range_max] of the leaf cell ids to scan in the geo index
+    std::vector<std::pair<uint64_t, uint64_t>> geoRanges_;
 };
 }  // namespace storage
 }  // namespace nebula
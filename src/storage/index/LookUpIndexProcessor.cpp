@@ -31,27 +31,42 @@ void LookUpIndexProcessor::process(const cpp2::LookUpIndexRequest& req) {
     }
 
     /**
-     * step 3 : execute index scan.
+     * step 3 : execute index scan, parts are scanned concurrently.
      */
-    for (auto partId : req.get_parts()) {
-        auto code = executeExecutionPlan(partId);
-        if (code != kvstore::ResultCode::SUCCEEDED) {
-            LOG(ERROR) << "Execute Execution Plan! ret = " << static_cast<int32_t>(code)
-                       << ", spaceId = " << spaceId_
-                       << ", partId =  " << partId;
-            if (code == kvstore::ResultCode::ERR_LEADER_CHANGED) {
-                this->handleLeaderChanged(spaceId_, partId);
-            } else {
-                this->pushResultCode(this->to(code), partId);
+    const auto& parts = req.get_parts();
+    auto partRows = std::make_shared<std::vector<PartIndexRows>>(parts.size());
+    std::vector<folly::Future<PartCode>> results;
+    results.reserve(parts.size());
+    for (size_t i = 0; i < parts.size(); i++) {
+        results.emplace_back(asyncExecuteExecutionPlan(parts[i], &(*partRows)[i]));
+    }
+    folly::collectAll(results).thenTry([this, partRows] (auto&& t) {
+        CHECK(!t.hasException());
+        bool failed = false;
+        for (auto& partTry : t.value()) {
+            CHECK(!partTry.hasException());
+            auto& partCode = partTry.value();
+            if (partCode.second != kvstore::ResultCode::SUCCEEDED) {
+                LOG(ERROR) << "Execute Execution Plan! ret = "
+                           << static_cast<int32_t>(partCode.second)
+                           << ", spaceId = " << spaceId_
+                           << ", partId =  " << partCode.first;
+                this->handleErrorCode(partCode.second, spaceId_, partCode.first);
+                failed = true;
             }
-            this->onFinished();
-            return;
         }
-    }
+        /**
+         * step 4 : collect result, the rows of the other parts are
+         *          not returned if any part failed.
+         */
+        if (!failed) {
+            this->onProcessFinished(*partRows);
+        }
+        this->onFinished();
+    });
+}
 
-    /**
-     * step 4 : collect result.
-     */
+void LookUpIndexProcessor::onProcessFinished(std::vector<PartIndexRows>& partRows) {
     if (schema_ != nullptr) {
         decltype(resp_.schema) s;
         decltype(resp_.schema.columns) cols;
@@ -63,13 +78,12 @@ void LookUpIndexProcessor::process(const cpp2::LookUpIndexRequest& req) {
         this->resp_.set_schema(std::move(s));
     }
 
+    mergeRows(partRows);
     if (isEdgeIndex_) {
         this->resp_.set_edges(std::move(edgeRows_));
     } else {
         this->resp_.set_vertices(std::move(vertexRows_));
     }
-
-    this->onFinished();
 }
 
 }  // namespace storage
@@ -18,8 +18,9 @@ public:
                                           meta::SchemaManager* schemaMan,
                                           meta::IndexManager* indexMan,
                                           stats::Stats* stats,
-                                          VertexCache* cache = nullptr) {
-        return new LookUpIndexProcessor(kvstore, schemaMan, indexMan, stats, cache);
+                                          VertexCache* cache = nullptr,
+                                          folly::Executor* executor = nullptr) {
+        return new LookUpIndexProcessor(kvstore, schemaMan, indexMan, stats, cache, executor);
     }
 
     void process(const cpp2::LookUpIndexRequest& req);
@@ -29,8 +30,12 @@ private:
                                   meta::SchemaManager* schemaMan,
                                   meta::IndexManager* indexMan,
                                   stats::Stats* stats,
-                                  VertexCache* cache = nullptr)
-        : IndexExecutor<cpp2::LookUpIndexResp>(kvstore, schemaMan, indexMan, stats, cache) {}
+                                  VertexCache* cache = nullptr,
+                                  folly::Executor* executor = nullptr)
+        : IndexExecutor<cpp2::LookUpIndexResp>(kvstore, schemaMan, indexMan,
+                                               stats, cache, executor) {}
+
+    void onProcessFinished(std::vector<PartIndexRows>& partRows);
 };
 
 }  // namespace storage
@@ -25,7 +25,7 @@ void AddEdgesProcessor::process(const cpp2::AddEdgesRequest& req) {
         indexes_ = std::move(iRet).value();
     }
     CHECK_NOTNULL(kvstore_);
-    if (indexes_.empty()) {
+    if (indexes_.empty() && !FLAGS_enable_edge_degree) {
         std::for_each(req.parts.begin(), req.parts.end(), [&](auto& partEdges) {
             auto partId = partEdges.first;
             std::vector<kvstore::KV> data;
@@ -55,8 +55,9 @@ void AddEdgesProcessor::process(const cpp2::AddEdgesRequest& req) {
     }
 }
 
-std::string AddEdgesProcessor::addEdges(int64_t version, PartitionID partId,
-                                        const std::vector<cpp2::Edge>& edges) {
+folly::Optional<std::string>
+AddEdgesProcessor::addEdges(int64_t version, PartitionID partId,
+                            const std::vector<cpp2::Edge>& edges) {
     std::unique_ptr<kvstore::BatchHolder> batchHolder = std::make_unique<kvstore::BatchHolder>();
 
     /*
@@ -85,7 +86,21 @@ std::string AddEdgesProcessor::addEdges(int64_t version, PartitionID partId,
         auto key = NebulaKeyUtils::edgeKey(partId, srcId, type, rank, dstId, version);
         newEdges[key] = std::move(prop);
     });
+    // The edges not existed before, counted by (srcId, edgeType)
+    std::map<std::pair<VertexID, EdgeType>, int64_t> degrees;
     for (auto& e : newEdges) {
+        if (FLAGS_enable_edge_degree) {
+            bool exists = false;
+            auto ret = edgeExists(partId, e.first, &exists);
+            if (ret != kvstore::ResultCode::SUCCEEDED) {
+                // Could not tell whether the edge is a new one, the counter would be wrong
+                return folly::none;
+            }
+            if (!exists) {
+                auto src = NebulaKeyUtils::getSrcId(e.first);
+                degrees[std::make_pair(src, NebulaKeyUtils::getEdgeType(e.first))]++;
+            }
+        }
         std::string val;
         RowReader nReader = RowReader::getEmptyRowReader();
         auto edgeType = NebulaKeyUtils::getEdgeType(e.first);
@@ -137,10 +152,35 @@ std::string AddEdgesProcessor::addEdges(int64_t version, PartitionID partId,
         auto prop = e.second;
         batchHolder->put(std::move(key), std::move(prop));
     }
+    for (auto& degree : degrees) {
+        batchHolder->merge(NebulaKeyUtils::degreeKey(partId,
+                                                     degree.first.first,
+                                                     degree.first.second),
+                           NebulaKeyUtils::encodeDegree(degree.second));
+    }
 
     return encodeBatchValue(batchHolder->getBatch());
 }
 
+kvstore::ResultCode AddEdgesProcessor::edgeExists(PartitionID partId,
+                                                  const folly::StringPiece& rawKey,
+                                                  bool* exists) {
+    auto prefix = NebulaKeyUtils::edgePrefix(partId,
+                                             NebulaKeyUtils::getSrcId(rawKey),
+                                             NebulaKeyUtils::getEdgeType(rawKey),
+                                             NebulaKeyUtils::getRank(rawKey),
+                                             NebulaKeyUtils::getDstId(rawKey));
+    std::unique_ptr<kvstore::KVIterator> iter;
+    auto ret = kvstore_->prefix(this->spaceId_, partId, prefix, &iter);
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        LOG(ERROR) << "Error! ret = " << static_cast<int32_t>(ret)
+                   << ", spaceId " << this->spaceId_;
+        return ret;
+    }
+    *exists = iter && iter->valid();
+    return kvstore::ResultCode::SUCCEEDED;
+}
+
 std::string AddEdgesProcessor::findObsoleteIndex(PartitionID partId,
                                                  const folly::StringPiece& rawKey) {
     auto prefix = NebulaKeyUtils::edgePrefix(partId,
@@ -34,8 +34,12 @@ private:
             : BaseProcessor<cpp2::ExecResponse>(kvstore, schemaMan, stats)
             , indexMan_(indexMan) {}
 
-    std::string addEdges(int64_t version, PartitionID partId,
-                         const std::vector<cpp2::Edge>& edges);
+    folly::Optional<std::string> addEdges(int64_t version, PartitionID partId,
+                                          const std::vector<cpp2::Edge>& edges);
+
+    kvstore::ResultCode edgeExists(PartitionID partId,
+                                   const folly::StringPiece& rawKey,
+                                   bool* exists);
 
     std::string findObsoleteIndex(PartitionID partId,
                                   const folly::StringPiece& rawKey);
@@ -178,7 +178,7 @@ std::string AddVerticesProcessor::indexKey(PartitionID partId,
                                            VertexID vId,
                                            RowReader* reader,
                                            std::shared_ptr<nebula::cpp2::IndexItem> index) {
-    auto values = collectIndexValues(reader, index->get_fields());
+    auto values = collectIndexValues(reader, *index);
     if (!values.ok()) {
         return "";
     }
@@ -8,7 +8,7 @@
 #define STORAGE_MUTATE_ADDVERTICESPROCESSOR_H_
 
 #include "base/Base.h"
-#include "base/ConcurrentLRUCache.h"
+#include "base/ConcurrentClockCache.h"
 #include "storage/BaseProcessor.h"
 #include "storage/CommonUtils.h"
 #include "kvstore/LogEncoder.h"
@@ -19,7 +19,7 @@ void DeleteEdgesProcessor::process(const cpp2::DeleteEdgesRequest& req) {
         indexes_ = std::move(iRet).value();
     }
 
-    if (indexes_.empty()) {
+    if (indexes_.empty() && !FLAGS_enable_edge_degree) {
         std::for_each(req.parts.begin(), req.parts.end(), [this](auto &partEdges) {
             this->callingNum_ += partEdges.second.size();
         });
@@ -79,12 +79,18 @@ DeleteEdgesProcessor::deleteEdges(GraphSpaceID spaceId,
                                   PartitionID partId,
                                   const std::vector<cpp2::EdgeKey>& edges) {
     std::unique_ptr<kvstore::BatchHolder> batchHolder = std::make_unique<kvstore::BatchHolder>();
+    std::unordered_set<std::string> deleted;
+    std::map<std::pair<VertexID, EdgeType>, int64_t> degrees;
     for (auto& edge : edges) {
         auto type = edge.edge_type;
         auto srcId = edge.src;
         auto rank = edge.ranking;
         auto dstId = edge.dst;
         auto prefix = NebulaKeyUtils::edgePrefix(partId, srcId, type, rank, dstId);
+        if (!deleted.emplace(prefix).second) {
+            // The same edge has been deleted in this batch
+            continue;
+        }
         std::unique_ptr<kvstore::KVIterator> iter;
         auto ret = this->kvstore_->prefix(spaceId, partId, prefix, &iter);
         if (ret != kvstore::ResultCode::SUCCEEDED) {
@@ -93,6 +99,9 @@ DeleteEdgesProcessor::deleteEdges(GraphSpaceID spaceId,
             return folly::none;
         }
         bool isLatestVE = true;
+        if (FLAGS_enable_edge_degree && iter->valid()) {
+            degrees[std::make_pair(srcId, type)]--;
+        }
         while (iter->valid()) {
             /**
              * just get the latest version edge for index.
@@ -132,6 +141,12 @@ DeleteEdgesProcessor::deleteEdges(GraphSpaceID spaceId,
             iter->next();
         }
     }
+    for (auto& degree : degrees) {
+        batchHolder->merge(NebulaKeyUtils::degreeKey(partId,
+                                                     degree.first.first,
+                                                     degree.first.second),
+                           NebulaKeyUtils::encodeDegree(degree.second));
+    }
     return encodeBatchValue(batchHolder->getBatch());
 }
 }  // namespace storage
@@ -10,6 +10,7 @@
 #include "base/Base.h"
 #include "storage/BaseProcessor.h"
 #include "kvstore/LogEncoder.h"
+#include "storage/StorageFlags.h"
 
 namespace nebula {
 namespace storage {
@@ -133,8 +133,7 @@ DeleteVerticesProcessor::deleteVertices(GraphSpaceID spaceId,
                                 return folly::none;
                             }
                         }
-                        const auto& cols = index->get_fields();
-                        auto values = collectIndexValues(reader.get(), cols);
+                        auto values = collectIndexValues(reader.get(), *index);
                         if (!values.ok()) {
                             continue;
                         }
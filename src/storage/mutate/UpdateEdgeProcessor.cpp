@@ -448,6 +448,11 @@ folly::Optional<std::string> UpdateEdgeProcessor::updateAndWriteBack(PartitionID
             }
         }
     }
+    if (FLAGS_enable_edge_degree && val_.empty()) {
+        // The edge is inserted by upsert
+        batchHolder->merge(NebulaKeyUtils::degreeKey(partId, edgeKey.src, edgeKey.edge_type),
+                           NebulaKeyUtils::encodeDegree(1));
+    }
     batchHolder->put(std::move(key_), std::move(nVal));
     return encodeBatchValue(batchHolder->getBatch());
 }
@@ -421,8 +421,7 @@ folly::Optional<std::string> UpdateVertexProcessor::updateAndWriteBack(const Par
                                                                   spaceId_,
                                                                   u.first);
                         }
-                        const auto &oCols = index->get_fields();
-                        auto oValues = collectIndexValues(oReader.get(), oCols);
+                        auto oValues = collectIndexValues(oReader.get(), *index);
                         if (oValues.ok()) {
                             auto oIndexKey = NebulaKeyUtils::vertexIndexKey(partId,
                                                                             index->index_id,
@@ -437,8 +436,7 @@ folly::Optional<std::string> UpdateVertexProcessor::updateAndWriteBack(const Par
                                                              spaceId_,
                                                              u.first);
                     }
-                    const auto &cols = index->get_fields();
-                    auto values = collectIndexValues(reader.get(), cols);
+                    auto values = collectIndexValues(reader.get(), *index);
                     if (values.ok()) {
                         auto indexKey = NebulaKeyUtils::vertexIndexKey(partId,
                                                                        index->get_index_id(),
@@ -0,0 +1,1156 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "storage/query/CompiledExpression.h"
+#include "utils/NebulaKeyUtils.h"
+
+namespace nebula {
+namespace storage {
+
+namespace {
+
+void fromVariant(const VariantType& value, FilterValue* v) {
+    switch (value.which()) {
+        case VAR_INT64:
+            v->setInt(boost::get<int64_t>(value));
+            break;
+        case VAR_DOUBLE:
+            v->setDouble(boost::get<double>(value));
+            break;
+        case VAR_BOOL:
+            v->setBool(boost::get<bool>(value));
+            break;
+        case VAR_STR:
+            v->setString(folly::StringPiece(boost::get<std::string>(value)));
+            break;
+    }
+}
+
+VariantType toVariant(const FilterValue& v) {
+    switch (v.type_) {
+        case FilterValue::Type::INT:
+            return v.int_;
+        case FilterValue::Type::DOUBLE:
+            return v.double_;
+        case FilterValue::Type::BOOL:
+            return v.bool_;
+        case FilterValue::Type::STRING:
+            return v.sp_.str();
+    }
+    return v.int_;
+}
+
+double asDouble(const FilterValue& v) {
+    switch (v.type_) {
+        case FilterValue::Type::INT:
+            return static_cast<double>(v.int_);
+        case FilterValue::Type::DOUBLE:
+            return v.double_;
+        case FilterValue::Type::BOOL:
+            return v.bool_ ? 1.0 : 0.0;
+        case FilterValue::Type::STRING:
+            break;
+    }
+    return 0.0;
+}
+
+int64_t asInt(const FilterValue& v) {
+    switch (v.type_) {
+        case FilterValue::Type::INT:
+            return v.int_;
+        case FilterValue::Type::DOUBLE:
+            return static_cast<int64_t>(v.double_);
+        case FilterValue::Type::BOOL:
+            return v.bool_ ? 1 : 0;
+        case FilterValue::Type::STRING:
+            break;
+    }
+    return 0;
+}
+
+void mergeValid(const FilterColumn& l, const FilterColumn& r, FilterColumn* col) {
+    auto size = col->size();
+    const auto* lv = l.valid_.data();
+    const auto* rv = r.valid_.data();
+    auto* out = col->valid_.data();
+    for (size_t i = 0; i < size; i++) {
+        out[i] = lv[i] & rv[i];
+    }
+}
+
+
+class ErrorNode final : public CompiledExpression {
+public:
+    bool eval(const FilterRow&, FilterValue*) const override {
+        return false;
+    }
+};
+
+
+class ConstNode final : public CompiledExpression {
+public:
+    explicit ConstNode(const VariantType& value) : value_(value) {}
+
+    bool eval(const FilterRow&, FilterValue* v) const override {
+        fromVariant(value_, v);
+        return true;
+    }
+
+    void evalBatch(const std::vector<FilterRow>& rows, FilterColumn* col) const override {
+        auto size = rows.size();
+        switch (value_.which()) {
+            case VAR_INT64:
+                col->resetTyped(size, FilterValue::Type::INT);
+                std::fill(col->ints_.begin(), col->ints_.end(), boost::get<int64_t>(value_));
+                break;
+            case VAR_DOUBLE:
+                col->resetTyped(size, FilterValue::Type::DOUBLE);
+                std::fill(col->doubles_.begin(), col->doubles_.end(), boost::get<double>(value_));
+                break;
+            case VAR_BOOL:
+                col->resetTyped(size, FilterValue::Type::BOOL);
+                std::fill(col->bools_.begin(), col->bools_.end(), boost::get<bool>(value_));
+                break;
+            case VAR_STR:
+                col->resetTyped(size, FilterValue::Type::STRING);
+                std::fill(col->strs_.begin(), col->strs_.end(),
+                          folly::StringPiece(boost::get<std::string>(value_)));
+                break;
+        }
+        std::fill(col->valid_.begin(), col->valid_.end(), 1);
+    }
+
+private:
+    VariantType value_;
+};
+
+
+// _src, _dst, _rank and _type, read from the edge key
+class KeyNode final : public CompiledExpression {
+public:
+    enum class Field : uint8_t {
+        SRC, DST, RANK, TYPE,
+    };
+
+    KeyNode(EdgeType edgeType, Field field) : edgeType_(edgeType), field_(field) {}
+
+    bool eval(const FilterRow& row, FilterValue* v) const override {
+        if (std::abs(row.edgeType_) != edgeType_) {
+            return false;
+        }
+        switch (field_) {
+            case Field::SRC:
+                v->setInt(NebulaKeyUtils::getSrcId(row.key_));
+                break;
+            case Field::DST:
+                v->setInt(NebulaKeyUtils::getDstId(row.key_));
+                break;
+            case Field::RANK:
+                v->setInt(NebulaKeyUtils::getRank(row.key_));
+                break;
+            case Field::TYPE:
+                v->setInt(static_cast<int64_t>(NebulaKeyUtils::getEdgeType(row.key_)));
+                break;
+        }
+        return true;
+    }
+
+    void evalBatch(const std::vector<FilterRow>& rows, FilterColumn* col) const override {
+        auto size = rows.size();
+        col->resetTyped(size, FilterValue::Type::INT);
+        for (size_t i = 0; i < size; i++) {
+            FilterValue v;
+            if (eval(rows[i], &v)) {
+                col->valid_[i] = 1;
+                col->ints_[i] = v.int_;
+            }
+        }
+    }
+
+private:
+    EdgeType edgeType_;
+    Field    field_;
+};
+
+
+// The property of the edge, read by the field index of the row's schema version
+class PropNode final : public CompiledExpression {
+public:
+    struct FieldInfo {
+        // kNotFound if the prop doesn't exist in the version,
+        // kUnresolved if the version is unknown when compiling
+        int64_t                  index_{kUnresolved};
+        nebula::cpp2::SupportedType type_{nebula::cpp2::SupportedType::UNKNOWN};
+    };
+
+    static constexpr int64_t kNotFound = -1;
+    static constexpr int64_t kUnresolved = -2;
+
+    PropNode(EdgeType edgeType, std::string prop, std::vector<FieldInfo> fields)
+        : edgeType_(edgeType)
+        , prop_(std::move(prop))
+        , fields_(std::move(fields)) {}
+
+    bool eval(const FilterRow& row, FilterValue* v) const override {
+        if (std::abs(row.edgeType_) != edgeType_ || row.reader_ == nullptr) {
+            return false;
+        }
+        auto ver = row.reader_->schemaVer();
+        if (ver >= 0 && static_cast<size_t>(ver) < fields_.size()) {
+            const auto& field = fields_[ver];
+            if (field.index_ == kNotFound) {
+                return false;
+            }
+            if (field.index_ != kUnresolved) {
+                return readField(row.reader_, field, v);
+            }
+        }
+        // The schema has been altered after compiling
+        auto res = RowReader::getPropByName(row.reader_, prop_);
+        if (!ok(res)) {
+            return false;
+        }
+        auto value = nebula::value(std::move(res));
+        if (value.which() == VAR_STR) {
+            v->setString(std::move(boost::get<std::string>(value)));
+        } else {
+            fromVariant(value, v);
+        }
+        return true;
+    }
+
+private:
+    static bool readField(const RowReader* reader, const FieldInfo& field, FilterValue* v) {
+        switch (field.type_) {
+            case nebula::cpp2::SupportedType::BOOL: {
+                bool b;
+                if (reader->getBool(field.index_, b) != ResultType::SUCCEEDED) {
+                    return false;
+                }
+                v->setBool(b);
+                return true;
+            }
+            case nebula::cpp2::SupportedType::INT:
+            case nebula::cpp2::SupportedType::TIMESTAMP: {
+                int64_t i;
+                if (reader->getInt(field.index_, i) != ResultType::SUCCEEDED) {
+                    return false;
+                }
+                v->setInt(i);
+                return true;
+            }
+            case nebula::cpp2::SupportedType::VID: {
+                VertexID vid;
+                if (reader->getVid(field.index_, vid) != ResultType::SUCCEEDED) {
+                    return false;
+                }
+                v->setInt(vid);
+                return true;
+            }
+            case nebula::cpp2::SupportedType::FLOAT: {
+                float f;
+                if (reader->getFloat(field.index_, f) != ResultType::SUCCEEDED) {
+                    return false;
+                }
+                v->setDouble(static_cast<double>(f));
+                return true;
+            }
+            case nebula::cpp2::SupportedType::DOUBLE: {
+                double d;
+                if (reader->getDouble(field.index_, d) != ResultType::SUCCEEDED) {
+                    return false;
+                }
+                v->setDouble(d);
+                return true;
+            }
+            case nebula::cpp2::SupportedType::STRING: {
+                folly::StringPiece s;
+                if (reader->getString(field.index_, s) != ResultType::SUCCEEDED) {
+                    return false;
+                }
+                v->setString(s);
+                return true;
+            }
+            default:
+                VLOG(2) << "Unknown type: " << static_cast<int32_t>(field.type_);
+                return false;
+        }
+    }
+
+private:
+    EdgeType               edgeType_;
+    std::string            prop_;
+    std::vector<FieldInfo> fields_;
+};
+
+
+// $^.tag.prop, read from the tag filters collected for the source vertex
+class SrcPropNode final : public CompiledExpression {
+public:
+    SrcPropNode(const std::string& tag, const std::string& prop)
+        : tagProp_(tag, prop) {}
+
+    bool eval(const FilterRow& row, FilterValue* v) const override {
+        if (row.fcontext_ == nullptr) {
+            return false;
+        }
+        auto it = row.fcontext_->tagFilters_.find(tagProp_);
+        if (it == row.fcontext_->tagFilters_.end()) {
+            return false;
+        }
+        fromVariant(it->second, v);
+        return true;
+    }
+
+private:
+    TagProp tagProp_;
+};
+
+
+class UnaryNode final : public CompiledExpression {
+public:
+    UnaryNode(UnaryExpression::Operator op, std::unique_ptr<CompiledExpression> operand)
+        : op_(op)
+        , operand_(std::move(operand)) {}
+
+    bool eval(const FilterRow& row, FilterValue* v) const override {
+        if (!operand_->eval(row, v)) {
+            return false;
+        }
+        switch (op_) {
+            case UnaryExpression::PLUS:
+                return true;
+            case UnaryExpression::NEGATE:
+                if (v->type_ == FilterValue::Type::INT) {
+                    v->setInt(-v->int_);
+                    return true;
+                } else if (v->type_ == FilterValue::Type::DOUBLE) {
+                    v->setDouble(-v->double_);
+                    return true;
+                }
+                return false;
+            case UnaryExpression::NOT:
+                v->setBool(!v->asBool());
+                return true;
+        }
+        return false;
+    }
+
+private:
+    UnaryExpression::Operator           op_;
+    std::unique_ptr<CompiledExpression> operand_;
+};
+
+
+class TypeCastingNode final : public CompiledExpression {
+public:
+    TypeCastingNode(ColumnType type, std::unique_ptr<CompiledExpression> operand)
+        : type_(type)
+        , operand_(std::move(operand)) {}
+
+    bool eval(const FilterRow& row, FilterValue* v) const override {
+        FilterValue operand;
+        if (!operand_->eval(row, &operand)) {
+            return false;
+        }
+        // Casting is rare in filters, just reuse the conversions of Expression
+        auto value = toVariant(operand);
+        switch (type_) {
+            case ColumnType::INT:
+            case ColumnType::TIMESTAMP:
+                v->setInt(Expression::toInt(value));
+                return true;
+            case ColumnType::STRING:
+                v->setString(Expression::toString(value));
+                return true;
+            case ColumnType::DOUBLE:
+                v->setDouble(Expression::toDouble(value));
+                return true;
+            case ColumnType::BOOL:
+                v->setBool(Expression::toBool(value));
+                return true;
+        }
+        return false;
+    }
+
+private:
+    ColumnType                          type_;
+    std::unique_ptr<CompiledExpression> operand_;
+};
+
+
+class ArithmeticNode final : public CompiledExpression {
+public:
+    ArithmeticNode(ArithmeticExpression::Operator op,
+                   std::unique_ptr<CompiledExpression> left,
+                   std::unique_ptr<CompiledExpression> right)
+        : op_(op)
+        , left_(std::move(left))
+        , right_(std::move(right)) {}
+
+    bool eval(const FilterRow& row, FilterValue* v) const override {
+        FilterValue l, r;
+        if (!left_->eval(row, &l) || !right_->eval(row, &r)) {
+            return false;
+        }
+        return compute(l, r, v);
+    }
+
+    void evalBatch(const std::vector<FilterRow>& rows, FilterColumn* col) const override {
+        FilterColumn l, r;
+        left_->evalBatch(rows, &l);
+        right_->evalBatch(rows, &r);
+        auto size = rows.size();
+        if (l.isTyped(FilterValue::Type::INT) && r.isTyped(FilterValue::Type::INT)
+                && op_ != ArithmeticExpression::MOD) {
+            col->resetTyped(size, FilterValue::Type::INT);
+            computeInts(l, r, col);
+            return;
+        }
+        if (l.isArithmetic() && r.isArithmetic()
+                && op_ != ArithmeticExpression::MOD
+                && op_ != ArithmeticExpression::XOR) {
+            col->resetTyped(size, FilterValue::Type::DOUBLE);
+            computeDoubles(l, r, col);
+            return;
+        }
+        col->reset(size);
+        FilterValue lv, rv, v;
+        for (size_t i = 0; i < size; i++) {
+            if (l.get(i, &lv) && r.get(i, &rv) && compute(lv, rv, &v)) {
+                col->set(i, std::move(v));
+            }
+        }
+    }
+
+private:
+    bool compute(const FilterValue& l, const FilterValue& r, FilterValue* v) const {
+        if (!l.isArithmetic() || !r.isArithmetic()) {
+            if (op_ == ArithmeticExpression::ADD
+                    && l.type_ == FilterValue::Type::STRING
+                    && r.type_ == FilterValue::Type::STRING) {
+                v->setString(l.sp_.str() + r.sp_.str());
+                return true;
+            }
+            return false;
+        }
+        bool isDouble = l.type_ == FilterValue::Type::DOUBLE
+                        || r.type_ == FilterValue::Type::DOUBLE;
+        int64_t result;
+        switch (op_) {
+            case ArithmeticExpression::ADD:
+                if (isDouble) {
+                    v->setDouble(asDouble(l) + asDouble(r));
+                    return true;
+                }
+                if (__builtin_add_overflow(l.int_, r.int_, &result)) {
+                    // Out of range
+                    return false;
+                }
+                v->setInt(result);
+                return true;
+            case ArithmeticExpression::SUB:
+                if (isDouble) {
+                    v->setDouble(asDouble(l) - asDouble(r));
+                    return true;
+                }
+                if (__builtin_sub_overflow(l.int_, r.int_, &result)) {
+                    // Out of range
+                    return false;
+                }
+                v->setInt(result);
+                return true;
+            case ArithmeticExpression::MUL:
+                if (isDouble) {
+                    v->setDouble(asDouble(l) * asDouble(r));
+                    return true;
+                }
+                if (__builtin_mul_overflow(l.int_, r.int_, &result)) {
+                    // Out of range
+                    return false;
+                }
+                v->setInt(result);
+                return true;
+            case ArithmeticExpression::DIV:
+                if (isDouble) {
+                    if (std::abs(asDouble(r)) < 1e-8) {
+                        return false;
+                    }
+                    v->setDouble(asDouble(l) / asDouble(r));
+                    return true;
+                }
+                if (r.int_ == 0) {
+                    return false;
+                }
+                v->setInt(l.int_ / r.int_);
+                return true;
+            case ArithmeticExpression::MOD:
+                if (isDouble) {
+                    if (std::abs(asDouble(r)) < 1e-8) {
+                        return false;
+                    }
+                    v->setDouble(fmod(asDouble(l), asDouble(r)));
+                    return true;
+                }
+                if (r.int_ == 0) {
+                    return false;
+                }
+                v->setInt(l.int_ % r.int_);
+                return true;
+            case ArithmeticExpression::XOR:
+                if (isDouble) {
+                    v->setInt(static_cast<int64_t>(std::round(asDouble(l)))
+                              ^ static_cast<int64_t>(std::round(asDouble(r))));
+                    return true;
+                }
+                v->setInt(l.int_ ^ r.int_);
+                return true;
+        }
+        return false;
+    }
+
+    void computeInts(const FilterColumn& l, const FilterColumn& r, FilterColumn* col) const {
+        auto size = col->size();
+        const auto* lv = l.ints_.data();
+        const auto* rv = r.ints_.data();
+        auto* out = col->ints_.data();
+        auto* valid = col->valid_.data();
+        switch (op_) {
+            case ArithmeticExpression::ADD:
+                for (size_t i = 0; i < size; i++) {
+                    valid[i] = l.valid_[i] & r.valid_[i]
+                               & !__builtin_add_overflow(lv[i], rv[i], &out[i]);
+                }
+                break;
+            case ArithmeticExpression::SUB:
+                for (size_t i = 0; i < size; i++) {
+                    valid[i] = l.valid_[i] & r.valid_[i]
+                               & !__builtin_sub_overflow(lv[i], rv[i], &out[i]);
+                }
+                break;
+            case ArithmeticExpression::MUL:
+                for (size_t i = 0; i < size; i++) {
+                    valid[i] = l.valid_[i] & r.valid_[i]
+                               & !__builtin_mul_overflow(lv[i], rv[i], &out[i]);
+                }
+                break;
+            case ArithmeticExpression::DIV:
+                // The rows divided by zero are invalid, divide them by one instead
+                for (size_t i = 0; i < size; i++) {
+                    valid[i] = l.valid_[i] & r.valid_[i] & (rv[i] != 0);
+                    out[i] = lv[i] / (rv[i] != 0 ? rv[i] : 1);
+                }
+                break;
+            case ArithmeticExpression::XOR:
+                for (size_t i = 0; i < size; i++) {
+                    valid[i] = l.valid_[i] & r.valid_[i];
+                    out[i] = lv[i] ^ rv[i];
+                }
+                break;
+            case ArithmeticExpression::MOD:
+                LOG(FATAL) << "MOD is evaluated row by row";
+                break;
+        }
+    }
+
+    void computeDoubles(const FilterColumn& l, const FilterColumn& r, FilterColumn* col) const {
+        auto size = col->size();
+        std::vector<double> lDoubles, rDoubles;
+        l.toDoubles(&lDoubles);
+        r.toDoubles(&rDoubles);
+        const auto* lv = lDoubles.data();
+        const auto* rv = rDoubles.data();
+        auto* out = col->doubles_.data();
+        auto* valid = col->valid_.data();
+        for (size_t i = 0; i < size; i++) {
+            valid[i] = l.valid_[i] & r.valid_[i];
+        }
+        switch (op_) {
+            case ArithmeticExpression::ADD:
+                for (size_t i = 0; i < size; i++) {
+                    out[i] = lv[i] + rv[i];
+                }
+                break;
+            case ArithmeticExpression::SUB:
+                for (size_t i = 0; i < size; i++) {
+                    out[i] = lv[i] - rv[i];
+                }
+                break;
+            case ArithmeticExpression::MUL:
+                for (size_t i = 0; i < size; i++) {
+                    out[i] = lv[i] * rv[i];
+                }
+                break;
+            case ArithmeticExpression::DIV:
+                for (size_t i = 0; i < size; i++) {
+                    valid[i] &= std::abs(rv[i]) >= 1e-8;
+                    out[i] = lv[i] / rv[i];
+                }
+                break;
+            case ArithmeticExpression::MOD:
+            case ArithmeticExpression::XOR:
+                LOG(FATAL) << "MOD and XOR are evaluated row by row";
+                break;
+        }
+    }
+
+private:
+    ArithmeticExpression::Operator      op_;
+    std::unique_ptr<CompiledExpression> left_;
+    std::unique_ptr<CompiledExpression> right_;
+};
+
+
+class RelationalNode final : public CompiledExpression {
+public:
+    RelationalNode(RelationalExpression::Operator op,
+                   std::unique_ptr<CompiledExpression> left,
+                   std::unique_ptr<CompiledExpression> right)
+        : op_(op)
+        , left_(std::move(left))
+        , right_(std::move(right)) {}
+
+    bool eval(const FilterRow& row, FilterValue* v) const override {
+        FilterValue l, r;
+        if (!left_->eval(row, &l) || !right_->eval(row, &r)) {
+            return false;
+        }
+        return compute(l, r, v);
+    }
+
+    void evalBatch(const std::vector<FilterRow>& rows, FilterColumn* col) const override {
+        FilterColumn l, r;
+        left_->evalBatch(rows, &l);
+        right_->evalBatch(rows, &r);
+        auto size = rows.size();
+        if (op_ != RelationalExpression::CONTAINS) {
+            if (l.isTyped(FilterValue::Type::INT) && r.isTyped(FilterValue::Type::INT)) {
+                col->resetTyped(size, FilterValue::Type::BOOL);
+                compareArrays(l.ints_.data(), r.ints_.data(), col);
+                mergeValid(l, r, col);
+                return;
+            }
+            if (l.isArithmetic() && r.isArithmetic()) {
+                std::vector<double> lDoubles, rDoubles;
+                l.toDoubles(&lDoubles);
+                r.toDoubles(&rDoubles);
+                col->resetTyped(size, FilterValue::Type::BOOL);
+                compareDoubles(lDoubles.data(), rDoubles.data(), col);
+                mergeValid(l, r, col);
+                return;
+            }
+            if (l.isTyped(FilterValue::Type::STRING) && r.isTyped(FilterValue::Type::STRING)) {
+                col->resetTyped(size, FilterValue::Type::BOOL);
+                auto* out = col->bools_.data();
+                for (size_t i = 0; i < size; i++) {
+                    out[i] = compare(l.strs_[i].compare(r.strs_[i]), 0);
+                }
+                mergeValid(l, r, col);
+                return;
+            }
+        }
+        col->reset(size);
+        FilterValue lv, rv, v;
+        for (size_t i = 0; i < size; i++) {
+            if (l.get(i, &lv) && r.get(i, &rv) && compute(lv, rv, &v)) {
+                col->set(i, std::move(v));
+            }
+        }
+    }
+
+private:
+    bool compute(FilterValue& l, FilterValue& r, FilterValue* v) const {
+        if (l.type_ != r.type_ && !implicitCasting(l, r)) {
+            return false;
+        }
+        if (op_ == RelationalExpression::CONTAINS) {
+            if (l.type_ != FilterValue::Type::STRING) {
+                return false;
+            }
+            v->setBool(l.sp_.find(r.sp_) != folly::StringPiece::npos);
+            return true;
+        }
+        switch (l.type_) {
+            case FilterValue::Type::INT:
+                v->setBool(compare(l.int_, r.int_));
+                return true;
+            case FilterValue::Type::DOUBLE:
+                if (op_ == RelationalExpression::EQ) {
+                    v->setBool(Expression::almostEqual(l.double_, r.double_));
+                } else if (op_ == RelationalExpression::NE) {
+                    v->setBool(!Expression::almostEqual(l.double_, r.double_));
+                } else {
+                    v->setBool(compare(l.double_, r.double_));
+                }
+                return true;
+            case FilterValue::Type::BOOL:
+                v->setBool(compare(l.bool_, r.bool_));
+                return true;
+            case FilterValue::Type::STRING:
+                v->setBool(compare(l.sp_.compare(r.sp_), 0));
+                return true;
+        }
+        return false;
+    }
+
+    // Same rule as RelationalExpression::implicitCasting: bool -> int64_t -> double
+    static bool implicitCasting(FilterValue& l, FilterValue& r) {
+        if (l.type_ == FilterValue::Type::STRING || r.type_ == FilterValue::Type::STRING) {
+            return false;
+        } else if (l.type_ == FilterValue::Type::DOUBLE || r.type_ == FilterValue::Type::DOUBLE) {
+            l.setDouble(asDouble(l));
+            r.setDouble(asDouble(r));
+        } else {
+            l.setInt(asInt(l));
+            r.setInt(asInt(r));
+        }
+        return true;
+    }
+
+    template <typename T>
+    bool compare(const T& l, const T& r) const {
+        switch (op_) {
+            case RelationalExpression::LT:
+                return l < r;
+            case RelationalExpression::LE:
+                return l <= r;
+            case RelationalExpression::GT:
+                return l > r;
+            case RelationalExpression::GE:
+                return l >= r;
+            case RelationalExpression::EQ:
+                return l == r;
+            case RelationalExpression::NE:
+                return l != r;
+            case RelationalExpression::CONTAINS:
+                break;
+        }
+        return false;
+    }
+
+    // The operator is dispatched once for the whole array, so each loop is
+    // simple enough to be vectorized.
+    template <typename T>
+    void compareArrays(const T* l, const T* r, FilterColumn* col) const {
+        auto size = col->size();
+        auto* out = col->bools_.data();
+        switch (op_) {
+            case RelationalExpression::LT:
+                for (size_t i = 0; i < size; i++) {
+                    out[i] = l[i] < r[i];
+                }
+                break;
+            case RelationalExpression::LE:
+                for (size_t i = 0; i < size; i++) {
+                    out[i] = l[i] <= r[i];
+                }
+                break;
+            case RelationalExpression::GT:
+                for (size_t i = 0; i < size; i++) {
+                    out[i] = l[i] > r[i];
+                }
+                break;
+            case RelationalExpression::GE:
+                for (size_t i = 0; i < size; i++) {
+                    out[i] = l[i] >= r[i];
+                }
+                break;
+            case RelationalExpression::EQ:
+                for (size_t i = 0; i < size; i++) {
+                    out[i] = l[i] == r[i];
+                }
+                break;
+            case RelationalExpression::NE:
+                for (size_t i = 0; i < size; i++) {
+                    out[i] = l[i] != r[i];
+                }
+                break;
+            case RelationalExpression::CONTAINS:
+                break;
+        }
+    }
+
+    void compareDoubles(const double* l, const double* r, FilterColumn* col) const {
+        auto size = col->size();
+        auto* out = col->bools_.data();
+        // Same as Expression::almostEqual
+        if (op_ == RelationalExpression::EQ) {
+            for (size_t i = 0; i < size; i++) {
+                out[i] = std::abs(l[i] - r[i]) < 1e-8;
+            }
+        } else if (op_ == RelationalExpression::NE) {
+            for (size_t i = 0; i < size; i++) {
+                out[i] = std::abs(l[i] - r[i]) >= 1e-8;
+            }
+        } else {
+            compareArrays(l, r, col);
+        }
+    }
+
+private:
+    RelationalExpression::Operator      op_;
+    std::unique_ptr<CompiledExpression> left_;
+    std::unique_ptr<CompiledExpression> right_;
+};
+
+
+class LogicalNode final : public CompiledExpression {
+public:
+    LogicalNode(LogicalExpression::Operator op,
+                std::unique_ptr<CompiledExpression> left,
+                std::unique_ptr<CompiledExpression> right)
+        : op_(op)
+        , left_(std::move(left))
+        , right_(std::move(right)) {}
+
+    bool eval(const FilterRow& row, FilterValue* v) const override {
+        // Both sides are evaluated as Expression::eval does, the error of either
+        // side fails the whole expression.
+        FilterValue l, r;
+        if (!left_->eval(row, &l) || !right_->eval(row, &r)) {
+            return false;
+        }
+        v->setBool(compute(l.asBool(), r.asBool()));
+        return true;
+    }
+
+    void evalBatch(const std::vector<FilterRow>& rows, FilterColumn* col) const override {
+        FilterColumn l, r;
+        left_->evalBatch(rows, &l);
+        right_->evalBatch(rows, &r);
+        auto size = rows.size();
+        col->resetTyped(size, FilterValue::Type::BOOL);
+        auto* out = col->bools_.data();
+        if (l.isTyped(FilterValue::Type::BOOL) && r.isTyped(FilterValue::Type::BOOL)) {
+            const auto* lv = l.bools_.data();
+            const auto* rv = r.bools_.data();
+            switch (op_) {
+                case LogicalExpression::AND:
+                    for (size_t i = 0; i < size; i++) {
+                        out[i] = lv[i] & rv[i];
+                    }
+                    break;
+                case LogicalExpression::OR:
+                    for (size_t i = 0; i < size; i++) {
+                        out[i] = lv[i] | rv[i];
+                    }
+                    break;
+                case LogicalExpression::XOR:
+                    for (size_t i = 0; i < size; i++) {
+                        out[i] = lv[i] ^ rv[i];
+                    }
+                    break;
+            }
+            mergeValid(l, r, col);
+            return;
+        }
+        FilterValue lv, rv;
+        for (size_t i = 0; i < size; i++) {
+            if (l.get(i, &lv) && r.get(i, &rv)) {
+                col->valid_[i] = 1;
+                out[i] = compute(lv.asBool(), rv.asBool());
+            }
+        }
+    }
+
+private:
+    bool compute(bool l, bool r) const {
+        switch (op_) {
+            case LogicalExpression::AND:
+                return l && r;
+            case LogicalExpression::OR:
+                return l || r;
+            case LogicalExpression::XOR:
+                return l != r;
+        }
+        return false;
+    }
+
+private:
+    LogicalExpression::Operator         op_;
+    std::unique_ptr<CompiledExpression> left_;
+    std::unique_ptr<CompiledExpression> right_;
+};
+
+
+std::vector<PropNode::FieldInfo> resolveFields(GraphSpaceID spaceId,
+                                               meta::SchemaManager* schemaMan,
+                                               EdgeType edgeType,
+                                               const std::string& prop) {
+    std::vector<PropNode::FieldInfo> fields;
+    auto latest = schemaMan->getLatestEdgeSchemaVersion(spaceId, edgeType);
+    if (!latest.ok() || latest.value() < 0) {
+        return fields;
+    }
+    fields.resize(latest.value() + 1);
+    for (SchemaVer ver = 0; ver <= latest.value(); ver++) {
+        auto schema = schemaMan->getEdgeSchema(spaceId, edgeType, ver);
+        if (schema == nullptr) {
+            continue;
+        }
+        auto& field = fields[ver];
+        field.index_ = schema->getFieldIndex(prop);
+        if (field.index_ < 0) {
+            field.index_ = PropNode::kNotFound;
+            continue;
+        }
+        field.type_ = schema->getFieldType(field.index_).get_type();
+    }
+    return fields;
+}
+
+}  // namespace
+
+
+void FilterColumn::reset(size_t size) {
+    valid_.assign(size, 0);
+    ints_.clear();
+    doubles_.clear();
+    bools_.clear();
+    strs_.clear();
+    values_.clear();
+    typed_ = false;
+    mixed_ = false;
+}
+
+
+void FilterColumn::resetTyped(size_t size, FilterValue::Type type) {
+    reset(size);
+    allocate(type);
+}
+
+
+void FilterColumn::allocate(FilterValue::Type type) {
+    typed_ = true;
+    type_ = type;
+    switch (type) {
+        case FilterValue::Type::INT:
+            ints_.resize(size());
+            break;
+        case FilterValue::Type::DOUBLE:
+            doubles_.resize(size());
+            break;
+        case FilterValue::Type::BOOL:
+            bools_.resize(size());
+            break;
+        case FilterValue::Type::STRING:
+            strs_.resize(size());
+            break;
+    }
+}
+
+
+void FilterColumn::set(size_t i, FilterValue&& v) {
+    valid_[i] = 1;
+    if (!mixed_) {
+        if (!typed_) {
+            allocate(v.type_);
+        }
+        // The strings owned by the value have to be kept in values_
+        if (v.type_ == type_ && !v.ownsString()) {
+            switch (type_) {
+                case FilterValue::Type::INT:
+                    ints_[i] = v.int_;
+                    break;
+                case FilterValue::Type::DOUBLE:
+                    doubles_[i] = v.double_;
+                    break;
+                case FilterValue::Type::BOOL:
+                    bools_[i] = v.bool_;
+                    break;
+                case FilterValue::Type::STRING:
+                    strs_[i] = v.sp_;
+                    break;
+            }
+            return;
+        }
+        toMixed();
+    }
+    values_[i] = v;
+}
+
+
+bool FilterColumn::get(size_t i, FilterValue* v) const {
+    if (!valid_[i]) {
+        return false;
+    }
+    if (mixed_) {
+        *v = values_[i];
+        return true;
+    }
+    switch (type_) {
+        case FilterValue::Type::INT:
+            v->setInt(ints_[i]);
+            break;
+        case FilterValue::Type::DOUBLE:
+            v->setDouble(doubles_[i]);
+            break;
+        case FilterValue::Type::BOOL:
+            v->setBool(bools_[i]);
+            break;
+        case FilterValue::Type::STRING:
+            v->setString(strs_[i]);
+            break;
+    }
+    return true;
+}
+
+
+void FilterColumn::toDoubles(std::vector<double>* doubles) const {
+    if (isTyped(FilterValue::Type::DOUBLE)) {
+        *doubles = doubles_;
+        return;
+    }
+    DCHECK(isTyped(FilterValue::Type::INT));
+    doubles->resize(ints_.size());
+    for (size_t i = 0; i < ints_.size(); i++) {
+        (*doubles)[i] = static_cast<double>(ints_[i]);
+    }
+}
+
+
+void FilterColumn::toMixed() {
+    values_.resize(size());
+    if (typed_) {
+        mixed_ = false;
+        for (size_t i = 0; i < size(); i++) {
+            if (valid_[i]) {
+                get(i, &values_[i]);
+            }
+        }
+    }
+    mixed_ = true;
+}
+
+
+void CompiledExpression::evalBatch(const std::vector<FilterRow>& rows,
+                                   FilterColumn* col) const {
+    col->reset(rows.size());
+    FilterValue v;
+    for (size_t i = 0; i < rows.size(); i++) {
+        if (eval(rows[i], &v)) {
+            col->set(i, std::move(v));
+        }
+    }
+}
+
+
+void CompiledExpression::select(const std::vector<FilterRow>& rows,
+                                std::vector<uint8_t>* selected) const {
+    FilterColumn col;
+    evalBatch(rows, &col);
+    auto size = rows.size();
+    selected->resize(size);
+    if (col.isTyped(FilterValue::Type::BOOL)) {
+        for (size_t i = 0; i < size; i++) {
+            (*selected)[i] = col.valid_[i] & col.bools_[i];
+        }
+        return;
+    }
+    FilterValue v;
+    for (size_t i = 0; i < size; i++) {
+        (*selected)[i] = col.get(i, &v) && v.asBool();
+    }
+}
+
+
+// static
+std::unique_ptr<CompiledExpression>
+CompiledExpression::compile(const Expression* exp,
+                            GraphSpaceID spaceId,
+                            meta::SchemaManager* schemaMan,
+                            const std::unordered_map<std::string, EdgeType>& edgeMap) {
+    auto compileChild = [&] (const Expression* child) {
+        return compile(child, spaceId, schemaMan, edgeMap);
+    };
+    switch (exp->kind()) {
+        case Expression::kPrimary: {
+            auto* primary = static_cast<const PrimaryExpression*>(exp);
+            return std::make_unique<ConstNode>(primary->value());
+        }
+        case Expression::kUnary: {
+            auto* unary = static_cast<const UnaryExpression*>(exp);
+            auto operand = compileChild(unary->operand());
+            if (operand == nullptr) {
+                return nullptr;
+            }
+            return std::make_unique<UnaryNode>(unary->op(), std::move(operand));
+        }
+        case Expression::kTypeCasting: {
+            auto* casting = static_cast<const TypeCastingExpression*>(exp);
+            auto operand = compileChild(casting->operand());
+            if (operand == nullptr) {
+                return nullptr;
+            }
+            return std::make_unique<TypeCastingNode>(casting->getType(), std::move(operand));
+        }
+        case Expression::kArithmetic: {
+            auto* arith = static_cast<const ArithmeticExpression*>(exp);
+            auto left = compileChild(arith->left());
+            auto right = compileChild(arith->right());
+            if (left == nullptr || right == nullptr) {
+                return nullptr;
+            }
+            return std::make_unique<ArithmeticNode>(arith->op(), std::move(left), std::move(right));
+        }
+        case Expression::kRelational: {
+            auto* rel = static_cast<const RelationalExpression*>(exp);
+            auto left = compileChild(rel->left());
+            auto right = compileChild(rel->right());
+            if (left == nullptr || right == nullptr) {
+                return nullptr;
+            }
+            return std::make_unique<RelationalNode>(rel->op(), std::move(left), std::move(right));
+        }
+        case Expression::kLogical: {
+            auto* logic = static_cast<const LogicalExpression*>(exp);
+            auto left = compileChild(logic->left());
+            auto right = compileChild(logic->right());
+            if (left == nullptr || right == nullptr) {
+                return nullptr;
+            }
+            return std::make_unique<LogicalNode>(logic->op(), std::move(left), std::move(right));
+        }
+        case Expression::kSourceProp: {
+            auto* src = static_cast<const SourcePropertyExpression*>(exp);
+            return std::make_unique<SrcPropNode>(*src->alias(), *src->prop());
+        }
+        case Expression::kAliasProp:
+        case Expression::kEdgeType:
+        case Expression::kEdgeSrcId:
+        case Expression::kEdgeDstId:
+        case Expression::kEdgeRank: {
+            auto* alias = static_cast<const AliasPropertyExpression*>(exp);
+            auto edgeFound = edgeMap.find(*alias->alias());
+            if (edgeFound == edgeMap.end()) {
+                VLOG(3) << "Edge `" << *alias->alias() << "' not found when compiling.";
+                return std::make_unique<ErrorNode>();
+            }
+            auto edgeType = edgeFound->second;
+            const auto& prop = *alias->prop();
+            if (exp->kind() == Expression::kEdgeDstId || prop == _DST) {
+                return std::make_unique<KeyNode>(edgeType, KeyNode::Field::DST);
+            } else if (prop == _SRC) {
+                return std::make_unique<KeyNode>(edgeType, KeyNode::Field::SRC);
+            } else if (prop == _RANK) {
+                return std::make_unique<KeyNode>(edgeType, KeyNode::Field::RANK);
+            } else if (prop == _TYPE) {
+                return std::make_unique<KeyNode>(edgeType, KeyNode::Field::TYPE);
+            }
+            return std::make_unique<PropNode>(edgeType,
+                                              prop,
+                                              resolveFields(spaceId, schemaMan, edgeType, prop));
+        }
+        default:
+            // Function calls, input, variable and destination props are evaluated
+            // by Expression::eval
+            VLOG(3) << "Not compiled expression " << exp->toString();
+            return nullptr;
+    }
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,231 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef STORAGE_QUERY_COMPILEDEXPRESSION_H_
+#define STORAGE_QUERY_COMPILEDEXPRESSION_H_
+
+#include "base/Base.h"
+#include "filter/Expressions.h"
+#include "meta/SchemaManager.h"
+#include "dataman/RowReader.h"
+#include "storage/CommonUtils.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * The value produced by a compiled expression.
+ * A string value refers to the row, the constant or the tag filter it comes from,
+ * str_ only holds the strings computed during evaluation.
+ * */
+struct FilterValue {
+    enum class Type : uint8_t {
+        INT, DOUBLE, BOOL, STRING,
+    };
+
+    FilterValue() : int_(0) {}
+
+    FilterValue(const FilterValue& rhs) : int_(0) {
+        *this = rhs;
+    }
+
+    FilterValue& operator=(const FilterValue& rhs) {
+        if (this == &rhs) {
+            return *this;
+        }
+        switch (rhs.type_) {
+            case Type::INT:
+                setInt(rhs.int_);
+                break;
+            case Type::DOUBLE:
+                setDouble(rhs.double_);
+                break;
+            case Type::BOOL:
+                setBool(rhs.bool_);
+                break;
+            case Type::STRING:
+                if (rhs.ownsString()) {
+                    setString(std::string(rhs.str_));
+                } else {
+                    setString(rhs.sp_);
+                }
+                break;
+        }
+        return *this;
+    }
+
+    void setInt(int64_t v) {
+        type_ = Type::INT;
+        int_ = v;
+    }
+
+    void setDouble(double v) {
+        type_ = Type::DOUBLE;
+        double_ = v;
+    }
+
+    void setBool(bool v) {
+        type_ = Type::BOOL;
+        bool_ = v;
+    }
+
+    void setString(folly::StringPiece v) {
+        type_ = Type::STRING;
+        str_.clear();
+        sp_ = v;
+    }
+
+    void setString(std::string&& v) {
+        type_ = Type::STRING;
+        str_ = std::move(v);
+        sp_ = str_;
+    }
+
+    bool ownsString() const {
+        return !str_.empty() && sp_.data() == str_.data();
+    }
+
+    bool isArithmetic() const {
+        return type_ == Type::INT || type_ == Type::DOUBLE;
+    }
+
+    // Same as Expression::asBool
+    bool asBool() const {
+        switch (type_) {
+            case Type::INT:
+                return int_ != 0;
+            case Type::DOUBLE:
+                return double_ != 0.0;
+            case Type::BOOL:
+                return bool_;
+            case Type::STRING:
+                return sp_.empty();
+        }
+        return false;
+    }
+
+    Type type_{Type::INT};
+    union {
+        int64_t int_;
+        double  double_;
+        bool    bool_;
+    };
+    folly::StringPiece sp_;
+    std::string str_;
+};
+
+/**
+ * The edge which the filter is evaluated on.
+ * */
+struct FilterRow {
+    folly::StringPiece   key_;
+    EdgeType             edgeType_;
+    const RowReader     *reader_{nullptr};
+    const FilterContext *fcontext_{nullptr};
+};
+
+/**
+ * The values of an expression over a batch of rows, the i-th value exists only
+ * if valid_[i] is set. As long as all the values are of the same type, they are
+ * kept in the array of that type, so the operators could work on whole arrays.
+ * Otherwise they are kept in values_.
+ * */
+class FilterColumn {
+public:
+    void reset(size_t size);
+
+    // All the values are of the type, the caller fills the array and valid_
+    void resetTyped(size_t size, FilterValue::Type type);
+
+    void set(size_t i, FilterValue&& v);
+
+    bool get(size_t i, FilterValue* v) const;
+
+    bool isTyped(FilterValue::Type type) const {
+        return typed_ && !mixed_ && type_ == type;
+    }
+
+    bool isArithmetic() const {
+        return isTyped(FilterValue::Type::INT) || isTyped(FilterValue::Type::DOUBLE);
+    }
+
+    size_t size() const {
+        return valid_.size();
+    }
+
+    // Convert the INT or DOUBLE array to doubles
+    void toDoubles(std::vector<double>* doubles) const;
+
+public:
+    std::vector<uint8_t>            valid_;
+    std::vector<int64_t>            ints_;
+    std::vector<double>             doubles_;
+    std::vector<uint8_t>            bools_;
+    std::vector<folly::StringPiece> strs_;
+    std::vector<FilterValue>        values_;
+
+private:
+    void allocate(FilterValue::Type type);
+
+    void toMixed();
+
+private:
+    bool              typed_{false};
+    bool              mixed_{false};
+    FilterValue::Type type_{FilterValue::Type::INT};
+};
+
+/**
+ * The filter compiled once per request. The edge alias and the property name of
+ * each reference are resolved to the edge type and the field index of every schema
+ * version, so evaluating a row needs no std::function, no VariantType and no lookup
+ * by name.
+ *
+ * Only the expressions which could be evaluated on storage are compiled,
+ * compile() returns nullptr for the others and Expression::eval should be used.
+ * */
+class CompiledExpression {
+public:
+    virtual ~CompiledExpression() = default;
+
+    static std::unique_ptr<CompiledExpression>
+    compile(const Expression* exp,
+            GraphSpaceID spaceId,
+            meta::SchemaManager* schemaMan,
+            const std::unordered_map<std::string, EdgeType>& edgeMap);
+
+    /**
+     * Return false if the expression could not be evaluated on the row,
+     * in the cases Expression::eval returns an error.
+     * */
+    virtual bool eval(const FilterRow& row, FilterValue* v) const = 0;
+
+    bool test(const FilterRow& row, bool* passed) const {
+        FilterValue v;
+        if (!eval(row, &v)) {
+            return false;
+        }
+        *passed = v.asBool();
+        return true;
+    }
+
+    /**
+     * Evaluate the expression over a batch of rows. The operators override it
+     * to work on whole arrays when the values of their operands are of the same
+     * type, the default one evaluates the rows one by one.
+     * */
+    virtual void evalBatch(const std::vector<FilterRow>& rows, FilterColumn* col) const;
+
+    /**
+     * selected[i] is set if the i-th row passes the filter, the rows which the
+     * filter could not be evaluated on are not selected.
+     * */
+    void select(const std::vector<FilterRow>& rows, std::vector<uint8_t>* selected) const;
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // STORAGE_QUERY_COMPILEDEXPRESSION_H_
@@ -11,6 +11,11 @@ DEFINE_int32(min_vertices_per_bucket, 3, "The min vertices number in one bucket"
 DEFINE_int32(max_edge_returned_per_vertex, INT_MAX, "Max edge number returnred searching vertex");
 DEFINE_bool(enable_vertex_cache, true, "Enable vertex cache");
 DEFINE_bool(enable_reservoir_sampling, false, "Will do reservoir sampling if set true.");
+DEFINE_int32(filter_batch_size, 0, "The edges of one vertex are filtered in batches of "
+                                   "this size, 0 means filtering them one by one");
+DEFINE_int32(max_keys_scanned_per_page, 100000, "Max keys scanned for one vertex in one page "
+                                                "when paging, the page ends early with a cursor "
+                                                "once reached, 0 means no limit");
 
 namespace nebula {
 namespace storage {
@@ -13,9 +13,13 @@
 #include "storage/Collector.h"
 #include "filter/Expressions.h"
 #include "storage/CommonUtils.h"
+#include "storage/EdgeCache.h"
+#include "storage/query/CompiledExpression.h"
 #include "stats/Stats.h"
 #include <random>
 
+DECLARE_int32(max_keys_scanned_per_page);
+
 namespace nebula {
 namespace storage {
 
@@ -23,7 +27,8 @@ const std::unordered_map<std::string, PropContext::PropInKeyType> kPropsInKey_ =
     {"_src", PropContext::PropInKeyType::SRC},
     {"_dst", PropContext::PropInKeyType::DST},
     {"_type", PropContext::PropInKeyType::TYPE},
-    {"_rank", PropContext::PropInKeyType::RANK}
+    {"_rank", PropContext::PropInKeyType::RANK},
+    {"_degree", PropContext::PropInKeyType::DEGREE}
 };
 
 using EdgeProcessor = std::function<void(RowReader reader, folly::StringPiece key)>;
@@ -33,6 +38,37 @@ struct Bucket {
 
 using OneVertexResp = std::tuple<PartitionID, VertexID, kvstore::ResultCode>;
 
+/**
+ * Paging state of one vertex when its edges are returned page by page.
+ * */
+struct EdgeCursor {
+    // start key of current page, empty means from the first edge
+    std::string start_;
+    // edges could be returned in current page
+    int32_t     remaining_{0};
+    // start key of the next page, empty means no edges left
+    std::string next_;
+    // keys visited in current page, including the old versions and the filtered edges
+    int64_t     scanned_{0};
+
+    // Whether the page should end early, see FLAGS_max_keys_scanned_per_page
+    bool scanOut() const {
+        return FLAGS_max_keys_scanned_per_page > 0 && scanned_ > FLAGS_max_keys_scanned_per_page;
+    }
+};
+
+/**
+ * The counters of one part when the request is profiled, see cpp2::PartProfile.
+ * The vertices of a part could be processed by several handler threads at once.
+ * */
+struct PartCounters {
+    std::atomic<int64_t> keysScanned_{0};
+    std::atomic<int64_t> rowsFiltered_{0};
+    std::atomic<int64_t> cacheHits_{0};
+    std::atomic<int64_t> bytesDecoded_{0};
+    std::atomic<int64_t> latencyInUs_{0};
+};
+
 template<typename REQ, typename RESP>
 class QueryBaseProcessor : public BaseProcessor<RESP> {
 public:
@@ -45,10 +81,12 @@ protected:
                                 meta::SchemaManager* schemaMan,
                                 stats::Stats* stats,
                                 folly::Executor* executor = nullptr,
-                                VertexCache* cache = nullptr)
+                                VertexCache* cache = nullptr,
+                                EdgeCache* edgeCache = nullptr)
         : BaseProcessor<RESP>(kvstore, schemaMan, stats)
         , executor_(executor)
-        , vertexCache_(cache) {}
+        , vertexCache_(cache)
+        , edgeCache_(edgeCache) {}
 
     /**
      * Check whether current operation on the data is valid or not.
@@ -104,7 +142,30 @@ protected:
                                VertexID vId,
                                EdgeType edgeType,
                                FilterContext* fcontext,
-                               EdgeProcessor proc);
+                               EdgeProcessor proc,
+                               EdgeCursor* cursor = nullptr);
+
+    /**
+     * Same as collectEdgeProps, but the edges are decoded in batches of
+     * FLAGS_filter_batch_size, and the compiled filter is evaluated over
+     * each batch at once.
+     * */
+    kvstore::ResultCode collectEdgePropsInBatch(
+                               PartitionID partId,
+                               VertexID vId,
+                               EdgeType edgeType,
+                               FilterContext* fcontext,
+                               EdgeProcessor proc,
+                               EdgeCursor* cursor);
+
+    /**
+     * Iterate the edges of the vertex in the edge type, starting from the cursor if any.
+     * */
+    kvstore::ResultCode edgeIterator(PartitionID partId,
+                                     VertexID vId,
+                                     EdgeType edgeType,
+                                     EdgeCursor* cursor,
+                                     std::unique_ptr<kvstore::KVIterator>* iter);
 
     std::vector<Bucket> genBuckets(const cpp2::GetNeighborsRequest& req);
 
@@ -116,6 +177,26 @@ protected:
 
     void buildTTLInfoAndRespSchema();
 
+    /**
+     * Count on the parts of the request, the counters are returned in
+     * ResponseCommon.profiles.
+     * */
+    void initProfile(
+        const std::unordered_map<PartitionID, std::vector<VertexID>>& parts);
+
+    /**
+     * The counters of the part, nullptr if the request is not profiled.
+     * */
+    PartCounters* partCounters(PartitionID partId) {
+        if (!profile_) {
+            return nullptr;
+        }
+        auto it = partCounters_.find(partId);
+        return it == partCounters_.end() ? nullptr : &it->second;
+    }
+
+    std::vector<cpp2::PartProfile> partProfiles() const;
+
     folly::Optional<std::pair<std::string, int64_t>> getTagTTLInfo(TagID tagId);
 
     folly::Optional<std::pair<std::string, int64_t>> getEdgeTTLInfo(EdgeType edgeType);
@@ -124,6 +205,8 @@ protected:
     GraphSpaceID  spaceId_;
     std::unique_ptr<ExpressionContext> expCtx_;
     std::unique_ptr<Expression> exp_;
+    // exp_ compiled for the edge filter, nullptr if it could not be compiled
+    std::unique_ptr<CompiledExpression> compiledExp_;
     std::vector<TagContext> tagContexts_;
     std::unordered_map<EdgeType, std::vector<PropContext>> edgeContexts_;
 
@@ -137,12 +220,21 @@ protected:
 
     folly::Executor* executor_{nullptr};
     VertexCache* vertexCache_{nullptr};
+    EdgeCache* edgeCache_{nullptr};
     std::unordered_map<std::string, EdgeType> edgeMap_;
     bool compactDstIdProps_ = false;
 
     std::unordered_map<EdgeType, std::pair<std::string, int64_t>> edgeTTLInfo_;
 
     std::unordered_map<TagID, std::pair<std::string, int64_t>> tagTTLInfo_;
+
+    // Max edges returned for each vertex when paging, 0 means no paging.
+    int32_t pageLimit_{0};
+    std::unordered_map<VertexID, std::string> cursors_;
+
+    bool profile_{false};
+    // Built before the vertices are processed, and never changed after
+    std::unordered_map<PartitionID, PartCounters> partCounters_;
 };
 
 }  // namespace storage
@@ -18,6 +18,7 @@ DECLARE_int32(min_vertices_per_bucket);
 DECLARE_int32(max_edge_returned_per_vertex);
 DECLARE_bool(enable_vertex_cache);
 DECLARE_bool(enable_reservoir_sampling);
+DECLARE_int32(filter_batch_size);
 
 namespace nebula {
 namespace storage {
@@ -116,6 +117,12 @@ cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::checkAndBuildContexts(const REQ&
                 auto it = kPropsInKey_.find(col.name);
                 if (it != kPropsInKey_.end()) {
                     prop.pikType_ = it->second;
+                    if (prop.pikType_ == PropContext::PropInKeyType::DEGREE &&
+                        !col.__isset.stat) {
+                        // _degree is a value of the vertex, only could be aggregated
+                        VLOG(3) << "_degree is only supported in stats";
+                        return cpp2::ErrorCode::E_EDGE_PROP_NOT_FOUND;
+                    }
                     if (prop.pikType_ == PropContext::PropInKeyType::SRC ||
                         prop.pikType_ == PropContext::PropInKeyType::DST) {
                         prop.type_.type = nebula::cpp2::SupportedType::VID;
@@ -163,6 +170,10 @@ cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::checkAndBuildContexts(const REQ&
         }
         expCtx_ = std::make_unique<ExpressionContext>();
         exp_->setContext(expCtx_.get());
+        compiledExp_ = CompiledExpression::compile(exp_.get(),
+                                                   spaceId_,
+                                                   this->schemaMan_,
+                                                   edgeMap_);
     }
 
     buildTTLInfoAndRespSchema();
@@ -352,6 +363,9 @@ void QueryBaseProcessor<REQ, RESP>::collectProps(RowReader* reader,
                 case PropContext::PropInKeyType::RANK:
                     collector->collectInt64(NebulaKeyUtils::getRank(key), prop);
                     continue;
+                case PropContext::PropInKeyType::DEGREE:
+                    // Collected once per vertex by QueryStatsProcessor
+                    continue;
             }
         }
         if (reader != nullptr) {
@@ -411,6 +425,11 @@ kvstore::ResultCode QueryBaseProcessor<REQ, RESP>::collectVertexProps(
         auto result = vertexCache_->get(std::make_pair(vId, tagId));
         if (result.ok()) {
             auto v = std::move(result).value();
+            auto* counters = partCounters(partId);
+            if (counters != nullptr) {
+                ++counters->cacheHits_;
+                counters->bytesDecoded_ += v.size();
+            }
             auto reader = RowReader::getTagPropReader(this->schemaMan_, v, spaceId_, tagId);
             if (reader == nullptr) {
                 return kvstore::ResultCode::ERR_CORRUPT_DATA;
@@ -447,6 +466,11 @@ kvstore::ResultCode QueryBaseProcessor<REQ, RESP>::collectVertexProps(
     // Will decode the properties according to the schema version
     // stored along with the properties
     if (iter && iter->valid()) {
+        auto* counters = partCounters(partId);
+        if (counters != nullptr) {
+            ++counters->keysScanned_;
+            counters->bytesDecoded_ += iter->val().size();
+        }
         auto reader = RowReader::getTagPropReader(this->schemaMan_, iter->val(), spaceId_, tagId);
         if (reader == nullptr) {
             return kvstore::ResultCode::ERR_CORRUPT_DATA;
@@ -475,16 +499,42 @@ kvstore::ResultCode QueryBaseProcessor<REQ, RESP>::collectVertexProps(
     return ret;
 }
 
+template<typename REQ, typename RESP>
+kvstore::ResultCode QueryBaseProcessor<REQ, RESP>::edgeIterator(
+                                               PartitionID partId,
+                                               VertexID vId,
+                                               EdgeType edgeType,
+                                               EdgeCursor* cursor,
+                                               std::unique_ptr<kvstore::KVIterator>* iter) {
+    auto prefix = NebulaKeyUtils::edgePrefix(partId, vId, edgeType);
+    if (cursor != nullptr && !cursor->start_.empty()) {
+        return this->kvstore_->rangeWithPrefix(spaceId_, partId, cursor->start_, prefix, iter);
+    }
+    if (edgeCache_ != nullptr) {
+        bool hit = false;
+        auto ret = edgeCache_->prefix(this->kvstore_, spaceId_, partId, vId, edgeType, iter, &hit);
+        auto* counters = partCounters(partId);
+        if (hit && counters != nullptr) {
+            ++counters->cacheHits_;
+        }
+        return ret;
+    }
+    return this->kvstore_->prefix(spaceId_, partId, prefix, iter);
+}
+
 template<typename REQ, typename RESP>
 kvstore::ResultCode QueryBaseProcessor<REQ, RESP>::collectEdgeProps(
                                                PartitionID partId,
                                                VertexID vId,
                                                EdgeType edgeType,
                                                FilterContext* fcontext,
-                                               EdgeProcessor proc) {
-    auto prefix = NebulaKeyUtils::edgePrefix(partId, vId, edgeType);
+                                               EdgeProcessor proc,
+                                               EdgeCursor* cursor) {
+    if (compiledExp_ != nullptr && FLAGS_filter_batch_size > 1) {
+        return collectEdgePropsInBatch(partId, vId, edgeType, fcontext, proc, cursor);
+    }
     std::unique_ptr<kvstore::KVIterator> iter;
-    auto ret = this->kvstore_->prefix(spaceId_, partId, prefix, &iter);
+    auto ret = edgeIterator(partId, vId, edgeType, cursor, &iter);
     if (ret != kvstore::ResultCode::SUCCEEDED || !iter) {
         return ret;
     }
@@ -495,22 +545,37 @@ kvstore::ResultCode QueryBaseProcessor<REQ, RESP>::collectEdgeProps(
     int         cnt = 0;
     bool onlyStructure = onlyStructures_[edgeType];
     Getters getters;
+    // Counted locally, and added to the part counters once
+    int64_t scanned = 0;
+    int64_t filtered = 0;
+    int64_t decoded = 0;
 
     auto schema = this->schemaMan_->getEdgeSchema(spaceId_, std::abs(edgeType));
     auto retTTL = getEdgeTTLInfo(edgeType);
     for (; iter->valid(); iter->next()) {
-        if (!FLAGS_enable_reservoir_sampling
+        if (cursor == nullptr
+                && !FLAGS_enable_reservoir_sampling
                 && !(cnt < FLAGS_max_edge_returned_per_vertex)) {
             break;
         }
         auto key = iter->key();
         auto val = iter->val();
+        ++scanned;
+        if (cursor != nullptr) {
+            ++cursor->scanned_;
+        }
         auto rank = NebulaKeyUtils::getRank(key);
         auto dstId = NebulaKeyUtils::getDstId(key);
         if (!firstLoop && rank == lastRank && lastDstId == dstId) {
             VLOG(3) << "Only get the latest version for each edge.";
             continue;
         }
+        if (cursor != nullptr && (cursor->remaining_ <= 0 || cursor->scanOut())) {
+            // The page is full, or too many keys are scanned (e.g. most edges are filtered),
+            // the next page starts from the current edge.
+            cursor->next_ = key.str();
+            break;
+        }
         if (firstLoop) {
             firstLoop = false;
         }
@@ -526,6 +591,7 @@ kvstore::ResultCode QueryBaseProcessor<REQ, RESP>::collectEdgeProps(
                 LOG(WARNING) << "Skip the bad format row!";
                 continue;
             }
+            decoded += val.size();
             // Check if ttl data expired
             if (retTTL.has_value() && checkDataExpiredForTTL(schema.get(),
                                                              reader.get(),
@@ -535,7 +601,21 @@ kvstore::ResultCode QueryBaseProcessor<REQ, RESP>::collectEdgeProps(
                     continue;
             }
 
-            if (exp_ != nullptr) {
+            if (compiledExp_ != nullptr) {
+                FilterRow row{key, edgeType, reader.get(), fcontext};
+                bool passed = false;
+                if (!compiledExp_->test(row, &passed)) {
+                    VLOG(3) << "Failed to evaluate the filter on the edge "
+                            << vId << "-> " << dstId << "@" << rank << ":" << edgeType;
+                    continue;
+                }
+                if (!passed) {
+                    VLOG(1) << "Filter the edge "
+                            << vId << "-> " << dstId << "@" << rank << ":" << edgeType;
+                    ++filtered;
+                    continue;
+                }
+            } else if (exp_ != nullptr) {
                 getters.getAliasProp = [this, edgeType, &reader, &key](const std::string& edgeName,
                                            const std::string& prop) -> OptVariantType {
                     auto edgeFound = this->edgeMap_.find(edgeName);
@@ -597,6 +677,7 @@ kvstore::ResultCode QueryBaseProcessor<REQ, RESP>::collectEdgeProps(
                 if (value.ok() && !Expression::asBool(value.value())) {
                     VLOG(1) << "Filter the edge "
                             << vId << "-> " << dstId << "@" << rank << ":" << edgeType;
+                    ++filtered;
                     continue;
                 }
             }
@@ -604,8 +685,174 @@ kvstore::ResultCode QueryBaseProcessor<REQ, RESP>::collectEdgeProps(
 
         proc(std::move(reader), key);
         ++cnt;
+        if (cursor != nullptr) {
+            --cursor->remaining_;
+        }
     }
 
+    auto* counters = partCounters(partId);
+    if (counters != nullptr) {
+        counters->keysScanned_ += scanned;
+        counters->rowsFiltered_ += filtered;
+        counters->bytesDecoded_ += decoded;
+    }
+    return ret;
+}
+
+template<typename REQ, typename RESP>
+kvstore::ResultCode QueryBaseProcessor<REQ, RESP>::collectEdgePropsInBatch(
+                                               PartitionID partId,
+                                               VertexID vId,
+                                               EdgeType edgeType,
+                                               FilterContext* fcontext,
+                                               EdgeProcessor proc,
+                                               EdgeCursor* cursor) {
+    std::unique_ptr<kvstore::KVIterator> iter;
+    auto ret = edgeIterator(partId, vId, edgeType, cursor, &iter);
+    if (ret != kvstore::ResultCode::SUCCEEDED || !iter) {
+        return ret;
+    }
+
+    // The keys and values are copied out of the iterator, the vectors never
+    // grow beyond batchSize, so the readers and the filter rows could refer to them.
+    size_t batchSize = FLAGS_filter_batch_size;
+    std::vector<std::string> keys;
+    std::vector<std::string> vals;
+    std::vector<RowReader> readers;
+    // The index in the batch of the edges to be filtered
+    std::vector<size_t> filtered;
+    std::vector<FilterRow> rows;
+    std::vector<uint8_t> selected;
+    keys.reserve(batchSize);
+    vals.reserve(batchSize);
+    readers.reserve(batchSize);
+    filtered.reserve(batchSize);
+    rows.reserve(batchSize);
+
+    int cnt = 0;
+    // Counted locally, and added to the part counters once
+    int64_t scanned = 0;
+    int64_t filteredOut = 0;
+    int64_t decoded = 0;
+    auto count = [&] () {
+        auto* counters = partCounters(partId);
+        if (counters != nullptr) {
+            counters->keysScanned_ += scanned;
+            counters->rowsFiltered_ += filteredOut;
+            counters->bytesDecoded_ += decoded;
+        }
+    };
+    // Return false if no more edges are needed
+    auto flush = [&] () -> bool {
+        for (auto i : filtered) {
+            rows.emplace_back(FilterRow{keys[i], edgeType, readers[i].get(), fcontext});
+        }
+        if (!rows.empty()) {
+            compiledExp_->select(rows, &selected);
+        }
+        size_t next = 0;
+        for (size_t i = 0; i < keys.size(); i++) {
+            if (cursor == nullptr
+                    && !FLAGS_enable_reservoir_sampling
+                    && !(cnt < FLAGS_max_edge_returned_per_vertex)) {
+                return false;
+            }
+            if (cursor != nullptr && cursor->remaining_ <= 0) {
+                // The page is full, the next page starts from the current edge.
+                cursor->next_ = keys[i];
+                return false;
+            }
+            if (next < filtered.size() && filtered[next] == i) {
+                if (!selected[next++]) {
+                    VLOG(1) << "Filter the edge " << NebulaKeyUtils::getSrcId(keys[i])
+                            << "-> " << NebulaKeyUtils::getDstId(keys[i])
+                            << "@" << NebulaKeyUtils::getRank(keys[i]) << ":" << edgeType;
+                    ++filteredOut;
+                    continue;
+                }
+            }
+            proc(std::move(readers[i]), keys[i]);
+            ++cnt;
+            if (cursor != nullptr) {
+                --cursor->remaining_;
+            }
+        }
+        rows.clear();
+        filtered.clear();
+        readers.clear();
+        vals.clear();
+        keys.clear();
+        return true;
+    };
+
+    EdgeRanking lastRank  = -1;
+    VertexID    lastDstId = 0;
+    bool        firstLoop = true;
+    bool onlyStructure = onlyStructures_[edgeType];
+
+    auto schema = this->schemaMan_->getEdgeSchema(spaceId_, std::abs(edgeType));
+    auto retTTL = getEdgeTTLInfo(edgeType);
+    for (; iter->valid(); iter->next()) {
+        auto key = iter->key();
+        auto val = iter->val();
+        auto rank = NebulaKeyUtils::getRank(key);
+        auto dstId = NebulaKeyUtils::getDstId(key);
+        ++scanned;
+        if (cursor != nullptr) {
+            ++cursor->scanned_;
+        }
+        if (!firstLoop && rank == lastRank && lastDstId == dstId) {
+            VLOG(3) << "Only get the latest version for each edge.";
+            continue;
+        }
+        if (cursor != nullptr && cursor->scanOut()) {
+            // Too many keys are scanned, the edges batched are returned in this page,
+            // unless the page is full, the next page starts from the current edge.
+            if (flush()) {
+                cursor->next_ = key.str();
+            }
+            count();
+            return ret;
+        }
+        if (firstLoop) {
+            firstLoop = false;
+        }
+        lastRank = rank;
+        lastDstId = dstId;
+        if ((!onlyStructure || retTTL.has_value()) && !val.empty()) {
+            decoded += val.size();
+            vals.emplace_back(val.str());
+            auto reader = RowReader::getEdgePropReader(this->schemaMan_,
+                                                       vals.back(),
+                                                       spaceId_,
+                                                       std::abs(edgeType));
+            if (reader == nullptr) {
+                LOG(WARNING) << "Skip the bad format row!";
+                vals.pop_back();
+                continue;
+            }
+            // Check if ttl data expired
+            if (retTTL.has_value() && checkDataExpiredForTTL(schema.get(),
+                                                             reader.get(),
+                                                             retTTL.value().first,
+                                                             retTTL.value().second)) {
+                VLOG(3) << "Data expired.";
+                vals.pop_back();
+                continue;
+            }
+            filtered.emplace_back(keys.size());
+            readers.emplace_back(std::move(reader));
+        } else {
+            readers.emplace_back(RowReader::getEmptyRowReader());
+        }
+        keys.emplace_back(key.str());
+        if (keys.size() >= batchSize && !flush()) {
+            count();
+            return ret;
+        }
+    }
+    flush();
+    count();
     return ret;
 }
 
@@ -618,9 +865,17 @@ QueryBaseProcessor<REQ, RESP>::asyncProcessBucket(Bucket bucket) {
         std::vector<OneVertexResp> codes;
         codes.reserve(b.vertices_.size());
         for (auto& pv : b.vertices_) {
-            codes.emplace_back(pv.first,
-                               pv.second,
-                               processVertex(pv.first, pv.second));
+            auto* counters = partCounters(pv.first);
+            if (counters == nullptr) {
+                codes.emplace_back(pv.first,
+                                   pv.second,
+                                   processVertex(pv.first, pv.second));
+                continue;
+            }
+            time::Duration duration;
+            auto ret = processVertex(pv.first, pv.second);
+            counters->latencyInUs_ += duration.elapsedInUSec();
+            codes.emplace_back(pv.first, pv.second, ret);
         }
         p.setValue(std::move(codes));
     });
@@ -810,6 +1065,15 @@ void QueryBaseProcessor<REQ, RESP>::process(const cpp2::GetNeighborsRequest& req
         initEdgeContext(req.edge_types);
     }
 
+    if (req.get_limit() > 0) {
+        pageLimit_ = req.get_limit();
+        cursors_ = req.get_cursors();
+    }
+
+    if (req.get_profile()) {
+        initProfile(req.get_parts());
+    }
+
     auto retCode = checkAndBuildContexts(req);
     if (retCode != cpp2::ErrorCode::SUCCEEDED) {
         for (auto& p : req.get_parts()) {
@@ -846,10 +1110,40 @@ void QueryBaseProcessor<REQ, RESP>::process(const cpp2::GetNeighborsRequest& req
                 }
             }
         }
+        if (profile_) {
+            this->result_.set_profiles(partProfiles());
+        }
         this->onProcessFinished(returnColumnsNum);
         this->onFinished();
     });
 }
 
+template<typename REQ, typename RESP>
+void QueryBaseProcessor<REQ, RESP>::initProfile(
+        const std::unordered_map<PartitionID, std::vector<VertexID>>& parts) {
+    profile_ = true;
+    for (auto& p : parts) {
+        // PartCounters is not movable, so it's constructed in place
+        partCounters_[p.first];
+    }
+}
+
+template<typename REQ, typename RESP>
+std::vector<cpp2::PartProfile> QueryBaseProcessor<REQ, RESP>::partProfiles() const {
+    std::vector<cpp2::PartProfile> profiles;
+    profiles.reserve(partCounters_.size());
+    for (auto& p : partCounters_) {
+        cpp2::PartProfile profile;
+        profile.set_part_id(p.first);
+        profile.set_keys_scanned(p.second.keysScanned_.load());
+        profile.set_rows_filtered(p.second.rowsFiltered_.load());
+        profile.set_cache_hits(p.second.cacheHits_.load());
+        profile.set_bytes_decoded(p.second.bytesDecoded_.load());
+        profile.set_latency_in_us(p.second.latencyInUs_.load());
+        profiles.emplace_back(std::move(profile));
+    }
+    return profiles;
+}
+
 }  // namespace storage
 }  // namespace nebula
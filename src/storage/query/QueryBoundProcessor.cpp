@@ -20,7 +20,8 @@ kvstore::ResultCode QueryBoundProcessor::processEdgeImpl(const PartitionID partI
                                                          const EdgeType edgeType,
                                                          const std::vector<PropContext>& props,
                                                          FilterContext& fcontext,
-                                                         cpp2::VertexData& vdata) {
+                                                         cpp2::VertexData& vdata,
+                                                         EdgeCursor* cursor) {
     bool onlyStructure = onlyStructures_[edgeType];
     std::shared_ptr<meta::SchemaProviderIf> currEdgeSchema;
     if (!onlyStructure) {
@@ -49,7 +50,7 @@ kvstore::ResultCode QueryBoundProcessor::processEdgeImpl(const PartitionID partI
                 edge.set_dst(collector.getDstId());
             }
             edges.emplace_back(std::move(edge));
-        });
+        }, cursor);
     if (ret != kvstore::ResultCode::SUCCEEDED) {
         return ret;
     }
@@ -80,6 +81,53 @@ kvstore::ResultCode QueryBoundProcessor::processEdge(PartitionID partId, VertexI
     return kvstore::ResultCode::SUCCEEDED;
 }
 
+kvstore::ResultCode QueryBoundProcessor::processEdgePaging(const PartitionID partId,
+                                                           const VertexID vId,
+                                                           FilterContext& fcontext,
+                                                           cpp2::VertexData& vdata) {
+    EdgeCursor cursor;
+    cursor.remaining_ = pageLimit_;
+    bool hasCursor = false;
+    EdgeType startType = 0;
+    auto it = cursors_.find(vId);
+    if (it != cursors_.end() && !it->second.empty()) {
+        if (!NebulaKeyUtils::isEdge(it->second) ||
+            NebulaKeyUtils::getSrcId(it->second) != vId) {
+            LOG(ERROR) << "Invalid cursor for vertex " << vId;
+            return kvstore::ResultCode::ERR_INVALID_ARGUMENT;
+        }
+        hasCursor = true;
+        startType = NebulaKeyUtils::getEdgeType(it->second);
+    }
+
+    std::vector<EdgeType> edgeTypes;
+    for (const auto& ec : edgeContexts_) {
+        if (!ec.second.empty()) {
+            edgeTypes.emplace_back(ec.first);
+        }
+    }
+    std::sort(edgeTypes.begin(), edgeTypes.end());
+
+    for (auto edgeType : edgeTypes) {
+        if (hasCursor && edgeType < startType) {
+            // Returned in previous pages
+            continue;
+        }
+        CHECK(!onlyVertexProps_);
+        cursor.start_ = (hasCursor && edgeType == startType) ? it->second : "";
+        auto ret = processEdgeImpl(partId, vId, edgeType, edgeContexts_.at(edgeType),
+                                   fcontext, vdata, &cursor);
+        if (ret != kvstore::ResultCode::SUCCEEDED) {
+            return ret;
+        }
+        if (!cursor.next_.empty()) {
+            vdata.set_next_cursor(std::move(cursor.next_));
+            break;
+        }
+    }
+    return kvstore::ResultCode::SUCCEEDED;
+}
+
 kvstore::ResultCode QueryBoundProcessor::processEdgeSampling(const PartitionID partId,
                                                              const VertexID vId,
                                                              FilterContext& fcontext,
@@ -203,7 +251,9 @@ kvstore::ResultCode QueryBoundProcessor::processVertex(PartitionID partId, Verte
     }
 
     kvstore::ResultCode ret;
-    if (FLAGS_enable_reservoir_sampling) {
+    if (pageLimit_ > 0) {
+        ret = processEdgePaging(partId, vId, fcontext, vResp);
+    } else if (FLAGS_enable_reservoir_sampling) {
         ret = processEdgeSampling(partId, vId, fcontext, vResp);
     } else {
         ret = processEdge(partId, vId, fcontext, vResp);
@@ -213,8 +263,8 @@ kvstore::ResultCode QueryBoundProcessor::processVertex(PartitionID partId, Verte
         return ret;
     }
 
-    if (!vResp.edge_data.empty()) {
-        // Only return the vertex if edges existed.
+    if (!vResp.edge_data.empty() || vResp.__isset.next_cursor) {
+        // Only return the vertex if edges existed, or edges left in the next pages.
         std::lock_guard<std::mutex> lg(this->lock_);
         for (auto& edata : vResp.edge_data) {
             totalEdges_ += edata.edges.size();
@@ -24,8 +24,9 @@ public:
                                          meta::SchemaManager* schemaMan,
                                          stats::Stats* stats,
                                          folly::Executor* executor,
-                                         VertexCache* cache = nullptr) {
-        return new QueryBoundProcessor(kvstore, schemaMan, stats, executor, cache);
+                                         VertexCache* cache = nullptr,
+                                         EdgeCache* edgeCache = nullptr) {
+        return new QueryBoundProcessor(kvstore, schemaMan, stats, executor, cache, edgeCache);
     }
 
 protected:
@@ -33,9 +34,11 @@ protected:
                                  meta::SchemaManager* schemaMan,
                                  stats::Stats* stats,
                                  folly::Executor* executor,
-                                 VertexCache* cache)
+                                 VertexCache* cache,
+                                 EdgeCache* edgeCache)
         : QueryBaseProcessor<cpp2::GetNeighborsRequest,
-                             cpp2::QueryResponse>(kvstore, schemaMan, stats, executor, cache) {}
+                             cpp2::QueryResponse>(kvstore, schemaMan, stats, executor, cache,
+                                                  edgeCache) {}
 
     kvstore::ResultCode processVertex(PartitionID partId, VertexID vId) override;
 
@@ -52,10 +55,21 @@ private:
                                             FilterContext& fcontext,
                                             cpp2::VertexData& vdata);
 
+    /**
+     * Collect at most pageLimit_ edges of the vertex, starting from its cursor.
+     * The edge types are walked in ascending order, so the cursor could tell
+     * which edge types have been returned in previous pages.
+     * */
+    kvstore::ResultCode processEdgePaging(const PartitionID partId,
+                                          const VertexID vId,
+                                          FilterContext& fcontext,
+                                          cpp2::VertexData& vdata);
+
     kvstore::ResultCode processEdgeImpl(const PartitionID partId, const VertexID vId,
                                         const EdgeType edgeType,
                                         const std::vector<PropContext>& props,
-                                        FilterContext& fcontext, cpp2::VertexData& vdata);
+                                        FilterContext& fcontext, cpp2::VertexData& vdata,
+                                        EdgeCursor* cursor = nullptr);
 protected:
     // Indicate the request only get vertex props.
     bool onlyVertexProps_ = false;
@@ -8,6 +8,7 @@
 #include "time/Duration.h"
 #include "dataman/RowReader.h"
 #include "dataman/RowWriter.h"
+#include "storage/StorageFlags.h"
 
 
 namespace nebula {
@@ -84,7 +85,22 @@ kvstore::ResultCode QueryStatsProcessor::processVertex(PartitionID partId,
     for (auto& ec : this->edgeContexts_) {
         auto edgeType = ec.first;
         auto& props = ec.second;
-        if (!props.empty()) {
+        bool scan = false;
+        int64_t degree = -1;
+        for (auto& prop : props) {
+            if (prop.pikType_ != PropContext::PropInKeyType::DEGREE) {
+                scan = true;
+                continue;
+            }
+            if (degree < 0) {
+                auto ret = getDegree(partId, vId, edgeType, &degree);
+                if (ret != kvstore::ResultCode::SUCCEEDED) {
+                    return ret;
+                }
+            }
+            collector_.collectInt64(degree, prop);
+        }
+        if (scan) {
             auto r = this->collectEdgeProps(partId, vId, edgeType, &fcontext,
                                             [&, this](RowReader reader,
                                                       folly::StringPiece key) {
@@ -102,6 +118,45 @@ kvstore::ResultCode QueryStatsProcessor::processVertex(PartitionID partId,
 }
 
 
+kvstore::ResultCode QueryStatsProcessor::getDegree(PartitionID partId,
+                                                   VertexID vId,
+                                                   EdgeType edgeType,
+                                                   int64_t* degree) {
+    if (FLAGS_enable_edge_degree) {
+        std::string val;
+        auto key = NebulaKeyUtils::degreeKey(partId, vId, edgeType);
+        auto ret = this->kvstore_->get(spaceId_, partId, key, &val);
+        if (ret == kvstore::ResultCode::ERR_KEY_NOT_FOUND) {
+            *degree = 0;
+            return kvstore::ResultCode::SUCCEEDED;
+        } else if (ret != kvstore::ResultCode::SUCCEEDED) {
+            return ret;
+        }
+        *degree = NebulaKeyUtils::decodeDegree(val);
+        return kvstore::ResultCode::SUCCEEDED;
+    }
+
+    // No counter maintained, count the edges without the versions.
+    auto prefix = NebulaKeyUtils::edgePrefix(partId, vId, edgeType);
+    std::unique_ptr<kvstore::KVIterator> iter;
+    auto ret = this->kvstore_->prefix(spaceId_, partId, prefix, &iter);
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        return ret;
+    }
+    *degree = 0;
+    std::string lastKey;
+    for (; iter && iter->valid(); iter->next()) {
+        auto key = NebulaKeyUtils::keyWithNoVersion(iter->key());
+        if (key == folly::StringPiece(lastKey)) {
+            continue;
+        }
+        lastKey = key.str();
+        (*degree)++;
+    }
+    return kvstore::ResultCode::SUCCEEDED;
+}
+
+
 void QueryStatsProcessor::onProcessFinished(int32_t retNum) {
     std::vector<PropContext> props;
     props.reserve(retNum);
@@ -20,8 +20,9 @@ public:
                                          meta::SchemaManager* schemaMan,
                                          stats::Stats* stats,
                                          folly::Executor* executor,
-                                         VertexCache* cache = nullptr) {
-        return new QueryStatsProcessor(kvstore, schemaMan, stats, executor, cache);
+                                         VertexCache* cache = nullptr,
+                                         EdgeCache* edgeCache = nullptr) {
+        return new QueryStatsProcessor(kvstore, schemaMan, stats, executor, cache, edgeCache);
     }
 
 private:
@@ -29,13 +30,15 @@ private:
                                  meta::SchemaManager* schemaMan,
                                  stats::Stats* stats,
                                  folly::Executor* executor,
-                                 VertexCache* cache)
+                                 VertexCache* cache,
+                                 EdgeCache* edgeCache)
         : QueryBaseProcessor<cpp2::GetNeighborsRequest,
                              cpp2::QueryStatsResponse>(kvstore,
                                                        schemaMan,
                                                        stats,
                                                        executor,
-                                                       cache) {}
+                                                       cache,
+                                                       edgeCache) {}
 
     kvstore::ResultCode processVertex(PartitionID partId, VertexID vId) override;
 
@@ -43,6 +46,15 @@ private:
 
     void calcResult(std::vector<PropContext>&& props);
 
+    /**
+     * Read the number of edges of vId in edgeType, from the counter if
+     * enable_edge_degree is on, otherwise by iterating the edges.
+     * */
+    kvstore::ResultCode getDegree(PartitionID partId,
+                                  VertexID vId,
+                                  EdgeType edgeType,
+                                  int64_t* degree);
+
 private:
     StatsCollector collector_;
 };
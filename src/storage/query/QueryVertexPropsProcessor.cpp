@@ -26,17 +26,26 @@ void QueryVertexPropsProcessor::process(const cpp2::VertexPropRequest& vertexReq
             tmpColumns.emplace_back(std::move(col));
         }
         req.set_return_columns(std::move(tmpColumns));
+        req.set_profile(vertexReq.get_profile());
         this->onlyVertexProps_ = true;
         QueryBoundProcessor::process(req);
     } else {
+        if (vertexReq.get_profile()) {
+            initProfile(vertexReq.get_parts());
+        }
         std::vector<cpp2::VertexData> vertices;
         for (auto& part : vertexReq.get_parts()) {
             auto partId = part.first;
+            auto* counters = partCounters(partId);
             for (auto& vId : part.second) {
                 cpp2::VertexData vResp;
                 vResp.set_vertex_id(vId);
                 std::vector<cpp2::TagData> td;
+                time::Duration duration;
                 auto ret = collectVertexProps(partId, vId, td);
+                if (counters != nullptr) {
+                    counters->latencyInUs_ += duration.elapsedInUSec();
+                }
                 if (ret != kvstore::ResultCode::ERR_KEY_NOT_FOUND
                         && ret != kvstore::ResultCode::SUCCEEDED) {
                     if (ret == kvstore::ResultCode::ERR_LEADER_CHANGED) {
@@ -53,6 +62,9 @@ void QueryVertexPropsProcessor::process(const cpp2::VertexPropRequest& vertexReq
         }
         VLOG(3) << "Seek vertices num: " << vertices.size();
         resp_.set_vertices(std::move(vertices));
+        if (profile_) {
+            result_.set_profiles(partProfiles());
+        }
         onFinished();
     }
 }
@@ -109,9 +121,13 @@ kvstore::ResultCode QueryVertexPropsProcessor::collectVertexProps(
 
     bool missedKey = true;
     std::unordered_set<TagID> tagIds;
+    auto* counters = partCounters(partId);
     for (; iter && iter->valid(); iter->next()) {
         auto key = iter->key();
         auto val = iter->val();
+        if (counters != nullptr) {
+            ++counters->keysScanned_;
+        }
         if (!NebulaKeyUtils::isVertex(key)) {
             continue;
         }
@@ -140,6 +156,9 @@ kvstore::ResultCode QueryVertexPropsProcessor::collectVertexProps(
             VLOG(3) << "Skip the bad format row!";
             continue;
         }
+        if (counters != nullptr) {
+            counters->bytesDecoded_ += val.size();
+        }
         // Check if ttl data expired
         auto retTTL = getTagTTLInfo(tagId, schema.get());
         if (retTTL.has_value() && checkDataExpiredForTTL(schema.get(),
@@ -0,0 +1,189 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "storage/query/TraverseProcessor.h"
+#include "utils/NebulaKeyUtils.h"
+#include "kvstore/Part.h"
+#include "storage/CommonUtils.h"
+#include "dataman/RowReader.h"
+#include "meta/NebulaSchemaProvider.h"
+
+DECLARE_bool(check_leader);
+DECLARE_int32(max_edge_returned_per_vertex);
+
+namespace nebula {
+namespace storage {
+
+void TraverseProcessor::process(const cpp2::TraverseRequest& req) {
+    if (executor_ == nullptr) {
+        doProcess(req);
+        return;
+    }
+    executor_->add([this, req] () {
+        doProcess(req);
+    });
+}
+
+void TraverseProcessor::doProcess(const cpp2::TraverseRequest& req) {
+    spaceId_ = req.get_space_id();
+    auto partsNum = req.get_parts_num();
+    if (partsNum <= 0) {
+        for (auto& part : req.get_parts()) {
+            pushResultCode(cpp2::ErrorCode::E_SPACE_NOT_FOUND, part.first);
+        }
+        onFinished();
+        return;
+    }
+
+    std::unordered_set<VertexID> frontier;
+    for (auto& part : req.get_parts()) {
+        // The vertices requested should be in the parts led by this host
+        if (!isLocal(part.first)) {
+            handleLeaderChanged(spaceId_, part.first);
+            failedParts_.emplace(part.first);
+            continue;
+        }
+        frontier.insert(part.second.begin(), part.second.end());
+    }
+
+    std::unordered_map<int32_t, std::vector<VertexID>> forwards;
+    for (auto left = req.get_steps(); left > 0 && !frontier.empty(); left--) {
+        std::unordered_set<VertexID> next;
+        for (auto vId : frontier) {
+            PartitionID partId = ID_HASH(vId, partsNum);
+            if (failedParts_.count(partId) != 0) {
+                continue;
+            }
+            if (!isLocal(partId)) {
+                forwards[left].emplace_back(vId);
+                continue;
+            }
+            for (auto edgeType : req.get_edge_types()) {
+                auto ret = collectDsts(partId, vId, edgeType, &next);
+                if (ret != kvstore::ResultCode::SUCCEEDED) {
+                    VLOG(3) << "Failed to go from vId " << vId << ", edgeType " << edgeType
+                            << ", error " << static_cast<int32_t>(ret);
+                    handleErrorCode(ret, spaceId_, partId);
+                    failedParts_.emplace(partId);
+                    break;
+                }
+            }
+        }
+        frontier = std::move(next);
+    }
+
+    VLOG(1) << "Traverse " << req.get_steps() << " steps, reach " << frontier.size()
+            << " vertices, forward " << forwards.size() << " steps to other hosts";
+    resp_.set_vertices(std::vector<VertexID>(frontier.begin(), frontier.end()));
+    resp_.set_forwards(std::move(forwards));
+    onFinished();
+}
+
+kvstore::ResultCode TraverseProcessor::collectDsts(PartitionID partId,
+                                                   VertexID vId,
+                                                   EdgeType edgeType,
+                                                   std::unordered_set<VertexID>* dsts) {
+    std::unique_ptr<kvstore::KVIterator> iter;
+    kvstore::ResultCode ret;
+    if (edgeCache_ != nullptr) {
+        ret = edgeCache_->prefix(kvstore_, spaceId_, partId, vId, edgeType, &iter);
+    } else {
+        ret = kvstore_->prefix(spaceId_, partId,
+                               NebulaKeyUtils::edgePrefix(partId, vId, edgeType), &iter);
+    }
+    if (ret != kvstore::ResultCode::SUCCEEDED || !iter) {
+        return ret;
+    }
+
+    auto retTTL = getEdgeTTLInfo(edgeType);
+    std::shared_ptr<const meta::SchemaProviderIf> schema;
+    if (retTTL.has_value()) {
+        schema = schemaMan_->getEdgeSchema(spaceId_, std::abs(edgeType));
+    }
+    EdgeRanking lastRank  = -1;
+    VertexID    lastDstId = 0;
+    bool        firstLoop = true;
+    int         cnt = 0;
+    for (; iter->valid(); iter->next()) {
+        // Same as the queries, only the first edges of the vertex are gone through
+        if (!(cnt < FLAGS_max_edge_returned_per_vertex)) {
+            break;
+        }
+        auto key = iter->key();
+        auto rank = NebulaKeyUtils::getRank(key);
+        auto dstId = NebulaKeyUtils::getDstId(key);
+        if (!firstLoop && rank == lastRank && lastDstId == dstId) {
+            continue;
+        }
+        firstLoop = false;
+        lastRank = rank;
+        lastDstId = dstId;
+        if (retTTL.has_value() && schema != nullptr) {
+            auto reader = RowReader::getEdgePropReader(schemaMan_,
+                                                       iter->val(),
+                                                       spaceId_,
+                                                       std::abs(edgeType));
+            if (reader == nullptr) {
+                LOG(WARNING) << "Skip the bad format row!";
+                continue;
+            }
+            if (checkDataExpiredForTTL(schema.get(),
+                                       reader.get(),
+                                       retTTL.value().first,
+                                       retTTL.value().second)) {
+                continue;
+            }
+        }
+        dsts->emplace(dstId);
+        ++cnt;
+    }
+    return ret;
+}
+
+bool TraverseProcessor::isLocal(PartitionID partId) {
+    auto it = localParts_.find(partId);
+    if (it != localParts_.end()) {
+        return it->second;
+    }
+    // The same check as the reads in kvstore, a leader out of its lease might be stale
+    auto ret = kvstore_->part(spaceId_, partId);
+    auto local = ok(ret)
+              && (!FLAGS_check_leader
+                  || (nebula::value(ret)->isLeader() && nebula::value(ret)->leaseValid()));
+    localParts_.emplace(partId, local);
+    return local;
+}
+
+folly::Optional<std::pair<std::string, int64_t>>
+TraverseProcessor::getEdgeTTLInfo(EdgeType edgeType) {
+    auto it = edgeTTLInfo_.find(edgeType);
+    if (it != edgeTTLInfo_.end()) {
+        return it->second;
+    }
+    folly::Optional<std::pair<std::string, int64_t>> ret;
+    auto schema = schemaMan_->getEdgeSchema(spaceId_, std::abs(edgeType));
+    auto* nschema = dynamic_cast<const meta::NebulaSchemaProvider*>(schema.get());
+    if (nschema != nullptr) {
+        const auto& schemaProp = nschema->getProp();
+        int64_t ttlDuration = 0;
+        if (schemaProp.get_ttl_duration()) {
+            ttlDuration = *schemaProp.get_ttl_duration();
+        }
+        std::string ttlCol;
+        if (schemaProp.get_ttl_col()) {
+            ttlCol = *schemaProp.get_ttl_col();
+        }
+        // Same as the queries, only a positive ttl_duration on ttl_col takes effect
+        if (!ttlCol.empty() && ttlDuration > 0) {
+            ret.emplace(std::move(ttlCol), ttlDuration);
+        }
+    }
+    edgeTTLInfo_.emplace(edgeType, ret);
+    return ret;
+}
+
+}  // namespace storage
+}  // namespace nebula
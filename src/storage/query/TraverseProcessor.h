@@ -0,0 +1,76 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef STORAGE_QUERY_TRAVERSEPROCESSOR_H_
+#define STORAGE_QUERY_TRAVERSEPROCESSOR_H_
+
+#include "base/Base.h"
+#include <folly/Optional.h>
+#include "storage/BaseProcessor.h"
+#include "storage/EdgeCache.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * Go several steps from the vertices inside storaged, and return only the
+ * vertices reached. The traversal goes on locally as long as the vertices
+ * are in the parts led by this host, the other vertices are returned along
+ * with the steps left, so the caller could send them to their leaders.
+ * */
+class TraverseProcessor : public BaseProcessor<cpp2::TraverseResponse> {
+public:
+    static TraverseProcessor* instance(kvstore::KVStore* kvstore,
+                                       meta::SchemaManager* schemaMan,
+                                       stats::Stats* stats,
+                                       folly::Executor* executor = nullptr,
+                                       EdgeCache* edgeCache = nullptr) {
+        return new TraverseProcessor(kvstore, schemaMan, stats, executor, edgeCache);
+    }
+
+    /**
+     * The traversal runs on the executor if given, since it could go through
+     * lots of vertices, or in the caller's thread otherwise.
+     * */
+    void process(const cpp2::TraverseRequest& req);
+
+private:
+    explicit TraverseProcessor(kvstore::KVStore* kvstore,
+                               meta::SchemaManager* schemaMan,
+                               stats::Stats* stats,
+                               folly::Executor* executor,
+                               EdgeCache* edgeCache)
+            : BaseProcessor<cpp2::TraverseResponse>(kvstore, schemaMan, stats)
+            , executor_(executor)
+            , edgeCache_(edgeCache) {}
+
+    void doProcess(const cpp2::TraverseRequest& req);
+
+    /**
+     * Collect the dst of the latest version of each edge into dsts.
+     * */
+    kvstore::ResultCode collectDsts(PartitionID partId,
+                                    VertexID vId,
+                                    EdgeType edgeType,
+                                    std::unordered_set<VertexID>* dsts);
+
+    bool isLocal(PartitionID partId);
+
+    folly::Optional<std::pair<std::string, int64_t>> getEdgeTTLInfo(EdgeType edgeType);
+
+private:
+    GraphSpaceID spaceId_;
+    folly::Executor* executor_{nullptr};
+    EdgeCache* edgeCache_{nullptr};
+    std::unordered_map<PartitionID, bool> localParts_;
+    // Parts failed, the vertices in them are skipped
+    std::unordered_set<PartitionID> failedParts_;
+    std::unordered_map<EdgeType, folly::Optional<std::pair<std::string, int64_t>>> edgeTTLInfo_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // STORAGE_QUERY_TRAVERSEPROCESSOR_H_
@@ -0,0 +1,316 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <gtest/gtest.h>
+#include "utils/NebulaKeyUtils.h"
+#include "storage/test/TestUtils.h"
+#include "storage/query/CompiledExpression.h"
+
+namespace nebula {
+namespace storage {
+
+class CompiledExpressionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        schemaMan_ = TestUtils::mockSchemaMan();
+        key_ = NebulaKeyUtils::edgeKey(1, 11, 101, 7, 10007, 0);
+        val_ = TestUtils::setupEncode(10, 20);
+        reader_ = std::make_unique<RowReader>(
+            RowReader::getEdgePropReader(schemaMan_.get(), val_, 0, 101));
+        ASSERT_TRUE(*reader_ != nullptr);
+        fcontext_.tagFilters_.emplace(std::make_pair("tag_3001", "tag_3001_col_0"),
+                                      static_cast<int64_t>(5));
+    }
+
+    // Evaluate the expression in the same way as QueryBaseProcessor::collectEdgeProps
+    OptVariantType interpret(Expression* exp, EdgeType edgeType) {
+        Getters getters;
+        getters.getAliasProp = [&] (const std::string& edgeName,
+                                    const std::string& prop) -> OptVariantType {
+            auto edgeFound = edgeMap_.find(edgeName);
+            if (edgeFound == edgeMap_.end()) {
+                return Status::Error("Edge not found");
+            }
+            if (std::abs(edgeType) != edgeFound->second) {
+                return Status::Error("Ignore this edge");
+            }
+            if (prop == _SRC) {
+                return NebulaKeyUtils::getSrcId(key_);
+            } else if (prop == _DST) {
+                return NebulaKeyUtils::getDstId(key_);
+            } else if (prop == _RANK) {
+                return NebulaKeyUtils::getRank(key_);
+            } else if (prop == _TYPE) {
+                return static_cast<int64_t>(NebulaKeyUtils::getEdgeType(key_));
+            }
+            auto res = RowReader::getPropByName(reader_->get(), prop);
+            if (!ok(res)) {
+                return Status::Error("Invalid Prop");
+            }
+            return value(std::move(res));
+        };
+        getters.getEdgeDstId = [&] (const std::string& edgeName) -> OptVariantType {
+            auto edgeFound = edgeMap_.find(edgeName);
+            if (edgeFound == edgeMap_.end() || std::abs(edgeType) != edgeFound->second) {
+                return Status::Error("Ignore this edge");
+            }
+            return NebulaKeyUtils::getDstId(key_);
+        };
+        getters.getSrcTagProp = [&] (const std::string& tag,
+                                     const std::string& prop) -> OptVariantType {
+            auto it = fcontext_.tagFilters_.find(std::make_pair(tag, prop));
+            if (it == fcontext_.tagFilters_.end()) {
+                return Status::Error("Invalid Tag Filter");
+            }
+            return it->second;
+        };
+        return exp->eval(getters);
+    }
+
+    // Check the compiled expression gives the same result with Expression::eval
+    void check(Expression* exp, bool expectOk, bool expectPassed = false,
+               EdgeType edgeType = 101) {
+        std::unique_ptr<Expression> holder(exp);
+        auto compiled = CompiledExpression::compile(exp, 0, schemaMan_.get(), edgeMap_);
+        ASSERT_NE(nullptr, compiled) << exp->toString();
+
+        auto interpreted = interpret(exp, edgeType);
+        FilterRow row{key_, edgeType, reader_->get(), &fcontext_};
+        bool passed = false;
+        bool ret = compiled->test(row, &passed);
+        EXPECT_EQ(interpreted.ok(), ret) << exp->toString();
+        EXPECT_EQ(expectOk, ret) << exp->toString();
+        if (ret && interpreted.ok()) {
+            EXPECT_EQ(Expression::asBool(interpreted.value()), passed) << exp->toString();
+            EXPECT_EQ(expectPassed, passed) << exp->toString();
+        }
+
+        // The batch evaluation gives the same result with the row by row one
+        std::vector<FilterRow> rows(3, row);
+        rows[1].edgeType_ = 102;
+        std::vector<uint8_t> selected;
+        compiled->select(rows, &selected);
+        ASSERT_EQ(rows.size(), selected.size());
+        for (size_t i = 0; i < rows.size(); i++) {
+            passed = false;
+            ret = compiled->test(rows[i], &passed);
+            EXPECT_EQ(ret && passed, static_cast<bool>(selected[i])) << exp->toString();
+        }
+    }
+
+    static Expression* edgeProp(const std::string& alias, const std::string& prop) {
+        return new AliasPropertyExpression(new std::string(""),
+                                           new std::string(alias),
+                                           new std::string(prop));
+    }
+
+    static Expression* rel(Expression* left,
+                           RelationalExpression::Operator op,
+                           Expression* right) {
+        return new RelationalExpression(left, op, right);
+    }
+
+    static Expression* arith(Expression* left,
+                             ArithmeticExpression::Operator op,
+                             Expression* right) {
+        return new ArithmeticExpression(left, op, right);
+    }
+
+    static Expression* intValue(int64_t v) {
+        return new PrimaryExpression(v);
+    }
+
+protected:
+    std::unique_ptr<meta::SchemaManager> schemaMan_;
+    std::unordered_map<std::string, EdgeType> edgeMap_{{"e1", 101}, {"e2", 102}};
+    std::string key_;
+    std::string val_;
+    std::unique_ptr<RowReader> reader_;
+    FilterContext fcontext_;
+};
+
+
+TEST_F(CompiledExpressionTest, EdgePropTest) {
+    // col_5 is 5, col_12 is "string_col_12"
+    check(rel(edgeProp("e1", "col_5"), RelationalExpression::EQ, intValue(5)), true, true);
+    check(rel(edgeProp("e1", "col_5"), RelationalExpression::GT, intValue(5)), true, false);
+    check(rel(edgeProp("e1", "col_5"), RelationalExpression::LT,
+              new PrimaryExpression(5.5)), true, true);
+    check(rel(edgeProp("e1", "col_5"), RelationalExpression::GE,
+              new PrimaryExpression(true)), true, true);
+    check(rel(edgeProp("e1", "col_12"), RelationalExpression::EQ,
+              new PrimaryExpression(std::string("string_col_12"))), true, true);
+    check(rel(edgeProp("e1", "col_12"), RelationalExpression::CONTAINS,
+              new PrimaryExpression(std::string("col_1"))), true, true);
+    check(rel(edgeProp("e1", "col_12"), RelationalExpression::LT,
+              new PrimaryExpression(std::string("string_col_11"))), true, false);
+    // string compared with int
+    check(rel(edgeProp("e1", "col_12"), RelationalExpression::EQ, intValue(5)), false);
+    // Not existed prop
+    check(rel(edgeProp("e1", "col_100"), RelationalExpression::EQ, intValue(5)), false);
+    // Not existed edge
+    check(rel(edgeProp("e3", "col_5"), RelationalExpression::EQ, intValue(5)), false);
+    // The edge is not the one referred
+    check(rel(edgeProp("e2", "col_5"), RelationalExpression::EQ, intValue(5)), false);
+    check(rel(edgeProp("e1", "col_5"), RelationalExpression::EQ, intValue(5)), true, true, -101);
+}
+
+
+TEST_F(CompiledExpressionTest, KeyPropTest) {
+    check(rel(edgeProp("e1", _SRC), RelationalExpression::EQ, intValue(11)), true, true);
+    check(rel(edgeProp("e1", _DST), RelationalExpression::EQ, intValue(10007)), true, true);
+    check(rel(edgeProp("e1", _RANK), RelationalExpression::NE, intValue(7)), true, false);
+    check(rel(edgeProp("e1", _TYPE), RelationalExpression::EQ, intValue(101)), true, true);
+    check(rel(new EdgeDstIdExpression(new std::string("e1")),
+              RelationalExpression::EQ, intValue(10007)), true, true);
+    check(rel(new EdgeDstIdExpression(new std::string("e2")),
+              RelationalExpression::EQ, intValue(10007)), false);
+}
+
+
+TEST_F(CompiledExpressionTest, SrcPropTest) {
+    check(rel(new SourcePropertyExpression(new std::string("tag_3001"),
+                                           new std::string("tag_3001_col_0")),
+              RelationalExpression::EQ, intValue(5)), true, true);
+    check(rel(new SourcePropertyExpression(new std::string("tag_3001"),
+                                           new std::string("tag_3001_col_1")),
+              RelationalExpression::EQ, intValue(5)), false);
+}
+
+
+TEST_F(CompiledExpressionTest, ArithmeticTest) {
+    check(rel(arith(edgeProp("e1", "col_5"), ArithmeticExpression::ADD, intValue(1)),
+              RelationalExpression::EQ, intValue(6)), true, true);
+    check(rel(arith(edgeProp("e1", "col_5"), ArithmeticExpression::MUL,
+                    new PrimaryExpression(0.5)),
+              RelationalExpression::EQ, new PrimaryExpression(2.5)), true, true);
+    check(rel(arith(edgeProp("e1", "col_5"), ArithmeticExpression::MOD, intValue(3)),
+              RelationalExpression::EQ, intValue(2)), true, true);
+    check(rel(arith(edgeProp("e1", "col_5"), ArithmeticExpression::XOR,
+                    new PrimaryExpression(1.2)),
+              RelationalExpression::EQ, intValue(4)), true, true);
+    check(rel(arith(edgeProp("e1", "col_12"), ArithmeticExpression::ADD,
+                    new PrimaryExpression(std::string("_x"))),
+              RelationalExpression::EQ,
+              new PrimaryExpression(std::string("string_col_12_x"))), true, true);
+    // Division by zero
+    check(rel(arith(edgeProp("e1", "col_5"), ArithmeticExpression::DIV, intValue(0)),
+              RelationalExpression::EQ, intValue(0)), false);
+    // Overflow
+    check(rel(arith(intValue(std::numeric_limits<int64_t>::max()),
+                    ArithmeticExpression::ADD, edgeProp("e1", "col_5")),
+              RelationalExpression::EQ, intValue(0)), false);
+    check(rel(arith(edgeProp("e1", "col_12"), ArithmeticExpression::SUB, intValue(1)),
+              RelationalExpression::EQ, intValue(0)), false);
+}
+
+
+TEST_F(CompiledExpressionTest, LogicalTest) {
+    auto* yes = rel(edgeProp("e1", "col_5"), RelationalExpression::EQ, intValue(5));
+    auto* no = rel(edgeProp("e1", "col_6"), RelationalExpression::EQ, intValue(5));
+    check(new LogicalExpression(yes, LogicalExpression::AND, no), true, false);
+
+    yes = rel(edgeProp("e1", "col_5"), RelationalExpression::EQ, intValue(5));
+    no = rel(edgeProp("e1", "col_6"), RelationalExpression::EQ, intValue(5));
+    check(new LogicalExpression(yes, LogicalExpression::OR, no), true, true);
+
+    yes = rel(edgeProp("e1", "col_5"), RelationalExpression::EQ, intValue(5));
+    no = rel(edgeProp("e1", "col_6"), RelationalExpression::EQ, intValue(5));
+    check(new LogicalExpression(yes, LogicalExpression::XOR, no), true, true);
+
+    // The error of either side fails the expression
+    yes = rel(edgeProp("e1", "col_5"), RelationalExpression::EQ, intValue(5));
+    auto* error = rel(edgeProp("e2", "col_5"), RelationalExpression::EQ, intValue(5));
+    check(new LogicalExpression(yes, LogicalExpression::OR, error), false);
+
+    no = rel(edgeProp("e1", "col_5"), RelationalExpression::EQ, intValue(5));
+    check(new UnaryExpression(UnaryExpression::NOT, no), true, false);
+    check(rel(new UnaryExpression(UnaryExpression::NEGATE, edgeProp("e1", "col_5")),
+              RelationalExpression::EQ, intValue(-5)), true, true);
+    check(new UnaryExpression(UnaryExpression::NEGATE, edgeProp("e1", "col_12")), false);
+}
+
+
+TEST_F(CompiledExpressionTest, BatchTest) {
+    // col_0 ... col_9 of the i-th row are i ... i + 9
+    std::vector<std::string> vals;
+    std::vector<std::string> keys;
+    for (int32_t i = 0; i < 100; i++) {
+        RowWriter writer;
+        for (int32_t j = 0; j < 10; j++) {
+            writer << i + j;
+        }
+        for (int32_t j = 10; j < 20; j++) {
+            writer << folly::stringPrintf("string_col_%d_%d", j, i);
+        }
+        vals.emplace_back(writer.encode());
+        keys.emplace_back(NebulaKeyUtils::edgeKey(1, 11, 101, i, 10000 + i, 0));
+    }
+    std::vector<RowReader> readers;
+    std::vector<FilterRow> rows;
+    readers.reserve(vals.size());
+    for (size_t i = 0; i < vals.size(); i++) {
+        readers.emplace_back(RowReader::getEdgePropReader(schemaMan_.get(), vals[i], 0, 101));
+        rows.emplace_back(FilterRow{keys[i], 101, readers.back().get(), &fcontext_});
+    }
+
+    // (e1.col_5 - e1._rank) * 2 == 10 && e1.col_3 % 7 > 2
+    // || e1.col_12 CONTAINS "_5" && e1.col_0 / 3 < 20
+    auto* left = new LogicalExpression(
+        rel(arith(arith(edgeProp("e1", "col_5"), ArithmeticExpression::SUB,
+                        edgeProp("e1", _RANK)),
+                  ArithmeticExpression::MUL, intValue(2)),
+            RelationalExpression::EQ, intValue(10)),
+        LogicalExpression::AND,
+        rel(arith(edgeProp("e1", "col_3"), ArithmeticExpression::MOD, intValue(7)),
+            RelationalExpression::GT, intValue(2)));
+    auto* right = new LogicalExpression(
+        rel(edgeProp("e1", "col_12"), RelationalExpression::CONTAINS,
+            new PrimaryExpression(std::string("_5"))),
+        LogicalExpression::AND,
+        rel(arith(edgeProp("e1", "col_0"), ArithmeticExpression::DIV,
+                  new PrimaryExpression(3.0)),
+            RelationalExpression::LT, intValue(20)));
+    std::unique_ptr<Expression> exp(new LogicalExpression(left, LogicalExpression::OR, right));
+    auto compiled = CompiledExpression::compile(exp.get(), 0, schemaMan_.get(), edgeMap_);
+    ASSERT_NE(nullptr, compiled);
+
+    std::vector<uint8_t> selected;
+    compiled->select(rows, &selected);
+    ASSERT_EQ(rows.size(), selected.size());
+    int32_t count = 0;
+    for (size_t i = 0; i < rows.size(); i++) {
+        bool passed = false;
+        bool ret = compiled->test(rows[i], &passed);
+        EXPECT_EQ(ret && passed, static_cast<bool>(selected[i])) << i;
+        // (i + 5 - i) * 2 == 10 always, so (i + 3) % 7 > 2,
+        // or i starts with 5 and i / 3.0 < 20
+        bool expected = (i + 3) % 7 > 2
+                        || (folly::to<std::string>(i)[0] == '5' && i < 60);
+        EXPECT_EQ(expected, static_cast<bool>(selected[i])) << i;
+        count += selected[i];
+    }
+    EXPECT_LT(0, count);
+}
+
+
+TEST_F(CompiledExpressionTest, NotCompiledTest) {
+    auto* exp = new InputPropertyExpression(new std::string("col_0"));
+    std::unique_ptr<Expression> holder(exp);
+    EXPECT_EQ(nullptr, CompiledExpression::compile(exp, 0, schemaMan_.get(), edgeMap_));
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,142 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "utils/NebulaKeyUtils.h"
+#include <gtest/gtest.h>
+#include <rocksdb/db.h>
+#include "fs/TempDir.h"
+#include "storage/test/TestUtils.h"
+#include "storage/EdgeCache.h"
+
+namespace nebula {
+namespace storage {
+
+void putEdges(kvstore::KVStore* kv, std::vector<kvstore::KV> data) {
+    folly::Baton<true, std::atomic> baton;
+    kv->asyncMultiPut(0, 0, std::move(data), [&](kvstore::ResultCode code) {
+        EXPECT_EQ(code, kvstore::ResultCode::SUCCEEDED);
+        baton.post();
+    });
+    baton.wait();
+}
+
+void removeEdge(kvstore::KVStore* kv, std::string key) {
+    folly::Baton<true, std::atomic> baton;
+    kv->asyncRemove(0, 0, std::move(key), [&](kvstore::ResultCode code) {
+        EXPECT_EQ(code, kvstore::ResultCode::SUCCEEDED);
+        baton.post();
+    });
+    baton.wait();
+}
+
+/**
+ * Return the dst of the edges, and check the edges in the same order as they are stored.
+ * */
+std::vector<VertexID> readEdges(EdgeCache* cache, kvstore::KVStore* kv, VertexID vId) {
+    std::unique_ptr<kvstore::KVIterator> iter;
+    EXPECT_EQ(kvstore::ResultCode::SUCCEEDED, cache->prefix(kv, 0, 0, vId, 101, &iter));
+    std::vector<VertexID> dsts;
+    for (; iter->valid(); iter->next()) {
+        EXPECT_EQ(vId, NebulaKeyUtils::getSrcId(iter->key()));
+        EXPECT_EQ(101, NebulaKeyUtils::getEdgeType(iter->key()));
+        auto dst = NebulaKeyUtils::getDstId(iter->key());
+        EXPECT_EQ(folly::stringPrintf("%ld_%ld", vId, dst), iter->val().str());
+        dsts.emplace_back(dst);
+    }
+    return dsts;
+}
+
+TEST(EdgeCacheTest, SimpleTest) {
+    fs::TempDir rootPath("/tmp/EdgeCacheTest.XXXXXX");
+    auto cache = std::make_shared<EdgeCache>(1024 * 1024, 0);
+    auto kv = TestUtils::initKV(rootPath.path(), 1, {0, network::NetworkUtils::getAvailablePort()},
+                                nullptr, false, nullptr, cache);
+    std::vector<kvstore::KV> data;
+    for (VertexID dst = 0; dst < 10; dst++) {
+        // Two versions for each edge, only the latest one should be cached
+        for (EdgeVersion version = 0; version < 2; version++) {
+            data.emplace_back(NebulaKeyUtils::edgeKey(0, 1, 101, 0, dst, version),
+                              folly::stringPrintf("1_%ld", dst));
+        }
+    }
+    putEdges(kv.get(), std::move(data));
+
+    std::vector<VertexID> expected{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    EXPECT_EQ(expected, readEdges(cache.get(), kv.get(), 1));
+    EXPECT_EQ(0, cache->cache().hits());
+    EXPECT_EQ(expected, readEdges(cache.get(), kv.get(), 1));
+    EXPECT_EQ(1, cache->cache().hits());
+    EXPECT_TRUE(readEdges(cache.get(), kv.get(), 2).empty());
+
+    LOG(INFO) << "Add an edge, the cached edges should be invalidated...";
+    putEdges(kv.get(), {{NebulaKeyUtils::edgeKey(0, 1, 101, 0, 10, 0), "1_10"}});
+    expected.emplace_back(10);
+    EXPECT_EQ(expected, readEdges(cache.get(), kv.get(), 1));
+    EXPECT_EQ(1, cache->cache().hits());
+    EXPECT_EQ(expected, readEdges(cache.get(), kv.get(), 1));
+    EXPECT_EQ(2, cache->cache().hits());
+
+    LOG(INFO) << "Edges of other types or vertices do not invalidate the cached edges...";
+    putEdges(kv.get(), {{NebulaKeyUtils::edgeKey(0, 1, 102, 0, 10, 0), "1_10"},
+                        {NebulaKeyUtils::edgeKey(0, 2, 101, 0, 10, 0), "2_10"}});
+    EXPECT_EQ(expected, readEdges(cache.get(), kv.get(), 1));
+    EXPECT_EQ(3, cache->cache().hits());
+
+    LOG(INFO) << "Remove an edge...";
+    removeEdge(kv.get(), NebulaKeyUtils::edgeKey(0, 1, 101, 0, 10, 0));
+    expected.pop_back();
+    EXPECT_EQ(expected, readEdges(cache.get(), kv.get(), 1));
+    EXPECT_EQ(3, cache->cache().hits());
+    EXPECT_EQ(expected, readEdges(cache.get(), kv.get(), 1));
+    EXPECT_EQ(4, cache->cache().hits());
+}
+
+TEST(EdgeCacheTest, TooManyEdgesTest) {
+    fs::TempDir rootPath("/tmp/EdgeCacheTest.XXXXXX");
+    auto cache = std::make_shared<EdgeCache>(1024 * 1024, 0);
+    auto kv = TestUtils::initKV(rootPath.path(), 1, {0, network::NetworkUtils::getAvailablePort()},
+                                nullptr, false, nullptr, cache);
+    std::vector<kvstore::KV> data;
+    for (VertexID dst = 0; dst < 10; dst++) {
+        data.emplace_back(NebulaKeyUtils::edgeKey(0, 1, 101, 0, dst, 0),
+                          folly::stringPrintf("1_%ld", dst));
+    }
+    putEdges(kv.get(), std::move(data));
+
+    gflags::FlagSaver flagSaver;
+    FLAGS_edge_cache_max_edges_per_vertex = 5;
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(10, readEdges(cache.get(), kv.get(), 1).size());
+    }
+    // Only the vertex is remembered, the edges are read from the kvstore
+    EXPECT_EQ(2, cache->cache().hits());
+    EXPECT_LT(0, cache->cache().usage());
+    std::unique_ptr<kvstore::KVIterator> iter;
+    bool hit = false;
+    EXPECT_EQ(kvstore::ResultCode::SUCCEEDED, cache->prefix(kv.get(), 0, 0, 1, 101, &iter, &hit));
+    EXPECT_FALSE(hit);
+
+    LOG(INFO) << "Remove the edges, then the rest edges could be cached...";
+    for (VertexID dst = 0; dst < 6; dst++) {
+        removeEdge(kv.get(), NebulaKeyUtils::edgeKey(0, 1, 101, 0, dst, 0));
+    }
+    std::vector<VertexID> expected{6, 7, 8, 9};
+    EXPECT_EQ(expected, readEdges(cache.get(), kv.get(), 1));
+    EXPECT_EQ(kvstore::ResultCode::SUCCEEDED, cache->prefix(kv.get(), 0, 0, 1, 101, &iter, &hit));
+    EXPECT_TRUE(hit);
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+    return RUN_ALL_TESTS();
+}
@@ -9,6 +9,7 @@
 #include <gtest/gtest.h>
 #include <rocksdb/db.h>
 #include <limits>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include "fs/TempDir.h"
 #include "storage/test/TestUtils.h"
 #include "storage/index/LookUpIndexProcessor.h"
@@ -16,6 +17,7 @@
 #include "dataman/RowReader.h"
 
 DECLARE_uint32(raft_heartbeat_interval_secs);
+DECLARE_int32(max_rows_returned_per_lookup);
 
 namespace nebula {
 namespace storage {
@@ -1453,6 +1455,388 @@ TEST(IndexScanTest, VertexDoubleTest) {
     }
 }
 
+TEST(IndexScanTest, RangeScanTest) {
+    auto relExp = [] (const std::string& col,
+                      RelationalExpression::Operator op,
+                      int64_t val,
+                      bool reversed = false) -> RelationalExpression* {
+        auto* ape = new AliasPropertyExpression(new std::string(""),
+                                                new std::string("3001"),
+                                                new std::string(col));
+        auto* pe = new PrimaryExpression(val);
+        if (reversed) {
+            return new RelationalExpression(pe, op, ape);
+        }
+        return new RelationalExpression(ape, op, pe);
+    };
+    {
+        /**
+         * where tag_3001_col_0 > 0 and tag_3001_col_0 < 2
+         */
+        auto logExp = std::make_unique<LogicalExpression>(
+            relExp("tag_3001_col_0", RelationalExpression::Operator::GT, 0),
+            LogicalExpression::AND,
+            relExp("tag_3001_col_0", RelationalExpression::Operator::LT, 2));
+        auto resp = execLookupVertices(Expression::encode(logExp.get()));
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        EXPECT_EQ(30, resp.get_vertices()->size());
+    }
+    {
+        /**
+         * where tag_3001_col_0 > 1
+         */
+        std::unique_ptr<Expression> exp(
+            relExp("tag_3001_col_0", RelationalExpression::Operator::GT, 1));
+        auto resp = execLookupVertices(Expression::encode(exp.get()));
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        EXPECT_EQ(0, resp.get_vertices()->size());
+    }
+    {
+        /**
+         * where tag_3001_col_0 >= 1 and tag_3001_col_0 <= 1
+         */
+        auto logExp = std::make_unique<LogicalExpression>(
+            relExp("tag_3001_col_0", RelationalExpression::Operator::GE, 1),
+            LogicalExpression::AND,
+            relExp("tag_3001_col_0", RelationalExpression::Operator::LE, 1));
+        auto resp = execLookupVertices(Expression::encode(logExp.get()));
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        EXPECT_EQ(30, resp.get_vertices()->size());
+    }
+    {
+        /**
+         * where tag_3001_col_0 == 1 and 2 > tag_3001_col_1
+         */
+        auto logExp = std::make_unique<LogicalExpression>(
+            relExp("tag_3001_col_0", RelationalExpression::Operator::EQ, 1),
+            LogicalExpression::AND,
+            relExp("tag_3001_col_1", RelationalExpression::Operator::GT, 2, true));
+        auto resp = execLookupVertices(Expression::encode(logExp.get()));
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        EXPECT_EQ(0, resp.get_vertices()->size());
+    }
+    {
+        /**
+         * where tag_3001_col_0 == 1 and 1 < tag_3001_col_1
+         */
+        auto logExp = std::make_unique<LogicalExpression>(
+            relExp("tag_3001_col_0", RelationalExpression::Operator::EQ, 1),
+            LogicalExpression::AND,
+            relExp("tag_3001_col_1", RelationalExpression::Operator::LT, 1, true));
+        auto resp = execLookupVertices(Expression::encode(logExp.get()));
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        EXPECT_EQ(30, resp.get_vertices()->size());
+    }
+}
+
+TEST(IndexScanTest, CoveringIndexTest) {
+    fs::TempDir rootPath("/tmp/CoveringIndexTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(rootPath.path());
+    GraphSpaceID spaceId = 0;
+    TagID tagId = 3001;
+    EdgeType type = 101;
+    auto schemaMan = mockSchemaMan(spaceId, type, tagId);
+    auto indexMan = mockIndexMan(spaceId, tagId, type);
+    mockData(kv.get(), schemaMan.get(), indexMan.get(), type, tagId, spaceId);
+    /**
+     * Remove all vertex rows, the return columns are all index columns,
+     * so the result only comes from the index.
+     */
+    for (auto partId = 0; partId < 3; partId++) {
+        std::vector<std::string> keys;
+        for (auto vertexId = partId * 10; vertexId < (partId + 1) * 10; vertexId++) {
+            keys.emplace_back(NebulaKeyUtils::vertexKey(partId, vertexId, tagId, 0));
+        }
+        folly::Baton<true, std::atomic> baton;
+        kv->asyncMultiRemove(spaceId, partId, std::move(keys),
+                             [&](kvstore::ResultCode code) {
+                                 EXPECT_EQ(code, kvstore::ResultCode::SUCCEEDED);
+                                 baton.post();
+                             });
+        baton.wait();
+    }
+    auto* processor = LookUpIndexProcessor::instance(kv.get(),
+                                                     schemaMan.get(),
+                                                     indexMan.get(),
+                                                     nullptr);
+    cpp2::LookUpIndexRequest req;
+    decltype(req.return_columns) cols;
+    cols.emplace_back("tag_3001_col_0");
+    cols.emplace_back("tag_3001_col_1");
+    cols.emplace_back("tag_3001_col_3");
+    cols.emplace_back("tag_3001_col_4");
+    req.set_return_columns(std::move(cols));
+    req.set_space_id(spaceId);
+    std::vector<int32_t> parts = {0, 1, 2};
+    req.set_parts(std::move(parts));
+    req.set_index_id(tagId);
+    req.set_is_edge(false);
+    /**
+     * where tag_3001_col_0 == 1
+     */
+    auto* ape = new AliasPropertyExpression(new std::string(""),
+                                            new std::string("3001"),
+                                            new std::string("tag_3001_col_0"));
+    auto relExp = std::make_unique<RelationalExpression>(ape,
+                                                         RelationalExpression::Operator::EQ,
+                                                         new PrimaryExpression(1L));
+    req.set_filter(Expression::encode(relExp.get()));
+    auto f = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(f).get();
+
+    EXPECT_EQ(0, resp.result.failed_codes.size());
+    EXPECT_EQ(4, resp.get_schema()->get_columns().size());
+    EXPECT_EQ(30, resp.get_vertices()->size());
+    RowWriter writer;
+    writer << static_cast<int64_t>(1) << static_cast<int64_t>(2)
+           << "tag_string_col_3" << "tag_string_col_4";
+    auto expected = writer.encode();
+    for (const auto& row : *resp.get_vertices()) {
+        EXPECT_EQ(expected, row.get_props());
+    }
+}
+
+TEST(IndexScanTest, ConcurrentPartsTest) {
+    fs::TempDir rootPath("/tmp/ConcurrentPartsTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(rootPath.path());
+    GraphSpaceID spaceId = 0;
+    TagID tagId = 3001;
+    EdgeType type = 101;
+    auto schemaMan = mockSchemaMan(spaceId, type, tagId);
+    auto indexMan = mockIndexMan(spaceId, tagId, type);
+    mockData(kv.get(), schemaMan.get(), indexMan.get(), type, tagId, spaceId);
+    auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(3);
+    /**
+     * where tag_3001_col_0 == 1, all the vertices in parts 0, 1 and 2 are matched,
+     * and the parts 3, 4 and 5 are empty.
+     */
+    auto* ape = new AliasPropertyExpression(new std::string(""),
+                                            new std::string("3001"),
+                                            new std::string("tag_3001_col_0"));
+    auto relExp = std::make_unique<RelationalExpression>(ape,
+                                                         RelationalExpression::Operator::EQ,
+                                                         new PrimaryExpression(1L));
+    auto lookup = [&] (std::vector<PartitionID> parts) {
+        auto* processor = LookUpIndexProcessor::instance(kv.get(),
+                                                         schemaMan.get(),
+                                                         indexMan.get(),
+                                                         nullptr,
+                                                         nullptr,
+                                                         executor.get());
+        cpp2::LookUpIndexRequest req;
+        decltype(req.return_columns) cols;
+        cols.emplace_back("tag_3001_col_0");
+        cols.emplace_back("tag_3001_col_5");
+        req.set_return_columns(std::move(cols));
+        req.set_space_id(spaceId);
+        req.set_parts(std::move(parts));
+        req.set_index_id(tagId);
+        req.set_is_edge(false);
+        req.set_filter(Expression::encode(relExp.get()));
+        auto f = processor->getFuture();
+        processor->process(req);
+        return std::move(f).get();
+    };
+    {
+        LOG(INFO) << "Scan all parts concurrently";
+        auto resp = lookup({0, 1, 2, 3, 4, 5});
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        EXPECT_EQ(2, resp.get_schema()->get_columns().size());
+        ASSERT_EQ(30, resp.get_vertices()->size());
+        std::set<VertexID> vIds;
+        for (const auto& row : *resp.get_vertices()) {
+            vIds.emplace(row.get_vertex_id());
+        }
+        EXPECT_EQ(30, vIds.size());
+        EXPECT_EQ(0, *vIds.begin());
+        EXPECT_EQ(29, *vIds.rbegin());
+    }
+    {
+        LOG(INFO) << "The parts stop once the limit is reached";
+        gflags::FlagSaver flagSaver;
+        FLAGS_max_rows_returned_per_lookup = 5;
+        auto resp = lookup({0, 1, 2, 3, 4, 5});
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        EXPECT_EQ(5, resp.get_vertices()->size());
+    }
+    {
+        LOG(INFO) << "The lookup fails if any part fails";
+        auto resp = lookup({0, 1, 2, 10});
+        ASSERT_EQ(1, resp.result.failed_codes.size());
+        EXPECT_EQ(10, resp.result.failed_codes[0].get_part_id());
+        EXPECT_EQ(cpp2::ErrorCode::E_PART_NOT_FOUND, resp.result.failed_codes[0].get_code());
+        EXPECT_FALSE(resp.__isset.vertices);
+    }
+}
+
+TEST(IndexScanTest, GeoTest) {
+    fs::TempDir rootPath("/tmp/GeoIndexScanTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(rootPath.path());
+    GraphSpaceID spaceId = 0;
+    TagID tagId = 3001;
+    IndexID indexId = 3002;
+    nebula::cpp2::Schema schema;
+    {
+        nebula::cpp2::ColumnDef column;
+        column.name = "name";
+        column.type.type = nebula::cpp2::SupportedType::STRING;
+        schema.columns.emplace_back(std::move(column));
+    }
+    {
+        nebula::cpp2::ColumnDef column;
+        column.name = "loc";
+        column.type.type = nebula::cpp2::SupportedType::STRING;
+        schema.columns.emplace_back(std::move(column));
+    }
+    auto* sm = new AdHocSchemaManager();
+    sm->addTagSchema(spaceId, tagId, std::make_shared<ResultSchemaProvider>(std::move(schema)));
+    std::unique_ptr<meta::SchemaManager> schemaMan(sm);
+
+    auto* im = new AdHocIndexManager();
+    {
+        std::vector<nebula::cpp2::ColumnDef> cols;
+        nebula::cpp2::ColumnDef column;
+        column.name = "loc";
+        column.type.type = nebula::cpp2::SupportedType::STRING;
+        cols.emplace_back(std::move(column));
+        im->addTagIndex(spaceId, indexId, tagId, std::move(cols));
+    }
+    std::unique_ptr<meta::IndexManager> indexMan(im);
+    auto index = indexMan->getTagIndex(spaceId, indexId).value();
+    index->set_index_type(nebula::cpp2::IndexType::GEO);
+    sleep(FLAGS_raft_heartbeat_interval_secs);
+
+    /**
+     * The vertex i is at 0.0045 * i degrees north of (30.28, 120.15),
+     * i.e. about 500 meters apart one by one.
+     */
+    for (auto partId = 0; partId < 3; partId++) {
+        std::vector<kvstore::KV> data;
+        for (auto vertexId = partId * 10; vertexId < (partId + 1) * 10; vertexId++) {
+            auto key = NebulaKeyUtils::vertexKey(partId, vertexId, tagId, 0);
+            RowWriter writer(nullptr);
+            writer << folly::to<std::string>("v_", vertexId)
+                   << folly::stringPrintf("POINT(%f 120.15)", 30.28 + 0.0045 * vertexId);
+            auto val = writer.encode();
+            auto reader = RowReader::getTagPropReader(schemaMan.get(), val, spaceId, tagId);
+            auto cell = geoIndexValue(reader.get(), "loc");
+            ASSERT_TRUE(cell.ok());
+            IndexValues values;
+            values.emplace_back(nebula::cpp2::SupportedType::INT, std::move(cell).value());
+            data.emplace_back(NebulaKeyUtils::vertexIndexKey(partId, indexId, vertexId, values),
+                              "");
+            data.emplace_back(std::move(key), std::move(val));
+        }
+        folly::Baton<true, std::atomic> baton;
+        kv->asyncMultiPut(spaceId, partId, std::move(data),
+                          [&](kvstore::ResultCode code) {
+                              EXPECT_EQ(code, kvstore::ResultCode::SUCCEEDED);
+                              baton.post();
+                          });
+        baton.wait();
+    }
+    /**
+     * At high latitude, the geodesic edge between (70, -60) and (70, 60) bows up
+     * to about 79.7 degrees north at the longitude 0, so the vertex 100 is inside
+     * the polygon of them, and the vertex 101 is inside only in planar degrees.
+     */
+    {
+        std::vector<kvstore::KV> data;
+        for (auto vertexId : {100, 101}) {
+            auto key = NebulaKeyUtils::vertexKey(0, vertexId, tagId, 0);
+            RowWriter writer(nullptr);
+            writer << folly::to<std::string>("v_", vertexId)
+                   << std::string(vertexId == 100 ? "POINT(80.2 0)" : "POINT(70.5 0)");
+            auto val = writer.encode();
+            auto reader = RowReader::getTagPropReader(schemaMan.get(), val, spaceId, tagId);
+            auto cell = geoIndexValue(reader.get(), "loc");
+            ASSERT_TRUE(cell.ok());
+            IndexValues values;
+            values.emplace_back(nebula::cpp2::SupportedType::INT, std::move(cell).value());
+            data.emplace_back(NebulaKeyUtils::vertexIndexKey(0, indexId, vertexId, values), "");
+            data.emplace_back(std::move(key), std::move(val));
+        }
+        folly::Baton<true, std::atomic> baton;
+        kv->asyncMultiPut(spaceId, 0, std::move(data),
+                          [&](kvstore::ResultCode code) {
+                              EXPECT_EQ(code, kvstore::ResultCode::SUCCEEDED);
+                              baton.post();
+                          });
+        baton.wait();
+    }
+
+    auto lookup = [&] (Expression* expr) {
+        auto* processor = LookUpIndexProcessor::instance(kv.get(),
+                                                         schemaMan.get(),
+                                                         indexMan.get(),
+                                                         nullptr);
+        cpp2::LookUpIndexRequest req;
+        req.set_space_id(spaceId);
+        std::vector<int32_t> parts = {0, 1, 2};
+        req.set_parts(std::move(parts));
+        req.set_index_id(indexId);
+        std::vector<std::string> cols = {"name"};
+        req.set_return_columns(std::move(cols));
+        req.set_is_edge(false);
+        req.set_filter(Expression::encode(expr));
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        std::vector<VertexID> vIds;
+        for (const auto& row : *resp.get_vertices()) {
+            vIds.emplace_back(row.get_vertex_id());
+        }
+        std::sort(vIds.begin(), vIds.end());
+        return vIds;
+    };
+    {
+        /**
+         * where near(loc, "POINT(30.28 120.15)", 1200)
+         */
+        auto* args = new ArgumentList();
+        args->addArgument(new AliasPropertyExpression(new std::string(""),
+                                                      new std::string("3001"),
+                                                      new std::string("loc")));
+        args->addArgument(new PrimaryExpression(std::string("POINT(30.28 120.15)")));
+        args->addArgument(new PrimaryExpression(1200L));
+        auto expr = std::make_unique<FunctionCallExpression>(new std::string("near"), args);
+        std::vector<VertexID> expected = {0, 1, 2};
+        EXPECT_EQ(expected, lookup(expr.get()));
+    }
+    {
+        /**
+         * where within(loc, "POLYGON((...))"), the polygon is around the vertices 10 to 14
+         */
+        auto* args = new ArgumentList();
+        args->addArgument(new AliasPropertyExpression(new std::string(""),
+                                                      new std::string("3001"),
+                                                      new std::string("loc")));
+        args->addArgument(new PrimaryExpression(std::string(
+            "POLYGON((30.3225 120.14, 30.3225 120.16, 30.3455 120.16, "
+            "30.3455 120.14, 30.3225 120.14))")));
+        auto expr = std::make_unique<FunctionCallExpression>(new std::string("within"), args);
+        std::vector<VertexID> expected = {10, 11, 12, 13, 14};
+        EXPECT_EQ(expected, lookup(expr.get()));
+    }
+    {
+        /**
+         * where within(loc, "POLYGON((...))"), the polygon is wide from east to west
+         * at high latitude, its edges are geodesic rather than planar in degrees
+         */
+        auto* args = new ArgumentList();
+        args->addArgument(new AliasPropertyExpression(new std::string(""),
+                                                      new std::string("3001"),
+                                                      new std::string("loc")));
+        args->addArgument(new PrimaryExpression(std::string(
+            "POLYGON((70 -60, 70 60, 72 60, 72 -60, 70 -60))")));
+        auto expr = std::make_unique<FunctionCallExpression>(new std::string("within"), args);
+        std::vector<VertexID> expected = {100};
+        EXPECT_EQ(expected, lookup(expr.get()));
+    }
+}
+
 }  // namespace storage
 }  // namespace nebula
 
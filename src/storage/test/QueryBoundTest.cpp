@@ -17,6 +17,8 @@
 
 DECLARE_int32(max_handlers_per_req);
 DECLARE_int32(min_vertices_per_bucket);
+DECLARE_int32(filter_batch_size);
+DECLARE_int32(max_keys_scanned_per_page);
 
 namespace nebula {
 namespace storage {
@@ -442,6 +444,51 @@ TEST(QueryBoundTest, FilterTest_OnlyTagFilter) {
     checkResponse(resp, 10, 12, 10001, 7);
 }
 
+TEST(QueryBoundTest, FilterTest_BatchFilter) {
+    fs::TempDir rootPath("/tmp/QueryBoundTest.XXXXXX");
+    LOG(INFO) << "Prepare meta...";
+    std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    auto schemaMan = TestUtils::mockSchemaMan();
+    mockData(kv.get());
+
+    // 7 edges of each vertex are filtered in 3 batches
+    FLAGS_filter_batch_size = 3;
+    auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(3);
+    LOG(INFO) << "Build filter...";
+    auto* edgeExp = new AliasPropertyExpression(new std::string(""),
+                                                new std::string("101"),
+                                                new std::string("col_0"));
+    auto* srcExp = new SourcePropertyExpression(new std::string("3001"),
+                                                new std::string("tag_3001_col_0"));
+    // 101.col_0 >= 10007 && $^.3001.tag_3001_col_0 >= 3021
+    auto* left = new RelationalExpression(edgeExp,
+                                          RelationalExpression::Operator::GE,
+                                          new PrimaryExpression(10007L));
+    auto* right = new RelationalExpression(srcExp,
+                                           RelationalExpression::Operator::GE,
+                                           new PrimaryExpression(20 + 3001L));
+    auto logExp = std::make_unique<LogicalExpression>(left,
+                                                      LogicalExpression::Operator::AND,
+                                                      right);
+    cpp2::GetNeighborsRequest req;
+    std::vector<EdgeType> et = {101};
+    buildRequest(req, et);
+    req.set_filter(Expression::encode(logExp.get()));
+
+    LOG(INFO) << "Test QueryOutBoundRequest...";
+    auto* processor = QueryBoundProcessor::instance(kv.get(),
+                                                    schemaMan.get(),
+                                                    nullptr,
+                                                    executor.get());
+    auto f = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(f).get();
+
+    LOG(INFO) << "Check the results...";
+    checkResponse(resp, 10, 12, 10007, 1);
+    FLAGS_filter_batch_size = 0;
+}
+
 TEST(QueryBoundTest, GenBucketsTest) {
     {
         cpp2::GetNeighborsRequest req;
@@ -626,6 +673,180 @@ TEST(QueryBoundTest, MaxEdgesReturenedTest) {
     FLAGS_max_edge_returned_per_vertex = old_max_edge_returned;
 }
 
+TEST(QueryBoundTest, PagingTest) {
+    fs::TempDir rootPath("/tmp/QueryBoundTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(rootPath.path());
+
+    LOG(INFO) << "Prepare meta...";
+    auto schemaMan = TestUtils::mockSchemaMan();
+    mockData(kv.get());
+
+    auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(3);
+    std::vector<EdgeType> et = {101, 102};
+    std::unordered_map<VertexID, std::string> cursors;
+    // vertexId => edgeType => dsts
+    std::unordered_map<VertexID, std::unordered_map<EdgeType, std::vector<VertexID>>> edges;
+    int32_t pageNum = 0;
+    do {
+        cpp2::GetNeighborsRequest req;
+        buildRequest(req, et);
+        req.set_cursors(cursors);
+        req.set_limit(5);
+        auto* processor = QueryBoundProcessor::instance(kv.get(), schemaMan.get(),
+                                                        nullptr, executor.get());
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+
+        cursors.clear();
+        for (auto& vp : resp.vertices) {
+            int32_t edgeNum = 0;
+            for (auto& ep : vp.edge_data) {
+                for (auto& edge : ep.get_edges()) {
+                    edges[vp.vertex_id][ep.type].emplace_back(edge.get_dst());
+                    edgeNum++;
+                }
+            }
+            EXPECT_GE(5, edgeNum);
+            if (vp.get_next_cursor() != nullptr) {
+                EXPECT_EQ(5, edgeNum);
+                cursors.emplace(vp.vertex_id, *vp.get_next_cursor());
+            }
+        }
+        pageNum++;
+    } while (!cursors.empty() && pageNum < 10);
+
+    // 14 edges for each vertex, returned in 3 pages
+    EXPECT_EQ(3, pageNum);
+    EXPECT_EQ(30, edges.size());
+    for (auto& vertex : edges) {
+        EXPECT_EQ(2, vertex.second.size());
+        for (auto& edgeType : vertex.second) {
+            std::vector<VertexID> expected = {10001, 10002, 10003, 10004, 10005, 10006, 10007};
+            EXPECT_EQ(expected, edgeType.second);
+        }
+    }
+}
+
+TEST(QueryBoundTest, PagingScanBudgetTest) {
+    auto oldBudget = FLAGS_max_keys_scanned_per_page;
+    // Each edge has 3 versions, so at most 2 edges could be returned in one page
+    FLAGS_max_keys_scanned_per_page = 4;
+    fs::TempDir rootPath("/tmp/QueryBoundTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(rootPath.path());
+
+    LOG(INFO) << "Prepare meta...";
+    auto schemaMan = TestUtils::mockSchemaMan();
+    mockData(kv.get());
+
+    auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(3);
+    std::vector<EdgeType> et = {101, 102};
+    std::unordered_map<VertexID, std::string> cursors;
+    // vertexId => edgeType => dsts
+    std::unordered_map<VertexID, std::unordered_map<EdgeType, std::vector<VertexID>>> edges;
+    int32_t pageNum = 0;
+    do {
+        cpp2::GetNeighborsRequest req;
+        buildRequest(req, et);
+        req.set_cursors(cursors);
+        req.set_limit(5);
+        auto* processor = QueryBoundProcessor::instance(kv.get(), schemaMan.get(),
+                                                        nullptr, executor.get());
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+
+        cursors.clear();
+        for (auto& vp : resp.vertices) {
+            int32_t edgeNum = 0;
+            for (auto& ep : vp.edge_data) {
+                for (auto& edge : ep.get_edges()) {
+                    edges[vp.vertex_id][ep.type].emplace_back(edge.get_dst());
+                    edgeNum++;
+                }
+            }
+            EXPECT_GE(2, edgeNum);
+            if (vp.get_next_cursor() != nullptr) {
+                cursors.emplace(vp.vertex_id, *vp.get_next_cursor());
+            }
+        }
+        pageNum++;
+    } while (!cursors.empty() && pageNum < 20);
+
+    // The pages end early, but all the edges are returned once
+    EXPECT_TRUE(cursors.empty());
+    EXPECT_LT(3, pageNum);
+    EXPECT_EQ(30, edges.size());
+    for (auto& vertex : edges) {
+        EXPECT_EQ(2, vertex.second.size());
+        for (auto& edgeType : vertex.second) {
+            std::vector<VertexID> expected = {10001, 10002, 10003, 10004, 10005, 10006, 10007};
+            EXPECT_EQ(expected, edgeType.second);
+        }
+    }
+    FLAGS_max_keys_scanned_per_page = oldBudget;
+}
+
+TEST(QueryBoundTest, ProfileTest) {
+    fs::TempDir rootPath("/tmp/QueryBoundTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    auto schemaMan = TestUtils::mockSchemaMan();
+    mockData(kv.get());
+
+    auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(3);
+    auto* edgeProp = new std::string("col_0");
+    auto* alias = new std::string("101");
+    auto* edgeExp = new AliasPropertyExpression(new std::string(""), alias, edgeProp);
+    auto* priExp = new PrimaryExpression(10007L);
+    // 101.col_0 >= 10007
+    auto relExp = std::make_unique<RelationalExpression>(edgeExp,
+                                                        RelationalExpression::Operator::GE,
+                                                        priExp);
+    {
+        cpp2::GetNeighborsRequest req;
+        std::vector<EdgeType> et = {101};
+        buildRequest(req, et);
+        req.set_filter(Expression::encode(relExp.get()));
+        req.set_profile(true);
+
+        auto* processor = QueryBoundProcessor::instance(kv.get(),
+                                                        schemaMan.get(),
+                                                        nullptr,
+                                                        executor.get());
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        checkResponse(resp, 30, 12, 10007, 1);
+
+        ASSERT_TRUE(resp.result.__isset.profiles);
+        ASSERT_EQ(3, resp.result.profiles.size());
+        for (auto& profile : resp.result.profiles) {
+            // 10 vertices in each part, each has 7 out-edges in 3 versions
+            EXPECT_LE(210, profile.get_keys_scanned());
+            // Only the edges to 10007 pass the filter
+            EXPECT_EQ(60, profile.get_rows_filtered());
+            EXPECT_LT(0, profile.get_bytes_decoded());
+            EXPECT_EQ(0, profile.get_cache_hits());
+        }
+    }
+    {
+        // Not profiled
+        cpp2::GetNeighborsRequest req;
+        std::vector<EdgeType> et = {101};
+        buildRequest(req, et);
+        auto* processor = QueryBoundProcessor::instance(kv.get(),
+                                                        schemaMan.get(),
+                                                        nullptr,
+                                                        executor.get());
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        EXPECT_FALSE(resp.result.__isset.profiles);
+    }
+}
+
 TEST(QueryBoundTest, SamplingTest) {
     int old_max_edge_returned = FLAGS_max_edge_returned_per_vertex;
     FLAGS_max_edge_returned_per_vertex = 5;
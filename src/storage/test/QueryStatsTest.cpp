@@ -11,6 +11,9 @@
 #include "fs/TempDir.h"
 #include "storage/test/TestUtils.h"
 #include "storage/query/QueryStatsProcessor.h"
+#include "storage/mutate/AddEdgesProcessor.h"
+#include "storage/mutate/DeleteEdgesProcessor.h"
+#include "storage/admin/RebuildEdgeDegreeProcessor.h"
 #include "dataman/RowSetReader.h"
 #include "dataman/RowReader.h"
 
@@ -140,6 +143,155 @@ TEST(QueryStatsTest, StatsSimpleTest) {
     checkResponse(resp);
 }
 
+void checkDegree(kvstore::KVStore* kv,
+                 meta::SchemaManager* schemaMan,
+                 folly::CPUThreadPoolExecutor* executor,
+                 int64_t expectedSum,
+                 double expectedAvg) {
+    cpp2::GetNeighborsRequest req;
+    req.set_space_id(0);
+    decltype(req.parts) tmpIds;
+    for (auto partId = 0; partId < 3; partId++) {
+        for (auto vertexId =  partId * 10; vertexId < (partId + 1) * 10; vertexId++) {
+            tmpIds[partId].emplace_back(vertexId);
+        }
+    }
+    req.set_parts(std::move(tmpIds));
+    std::vector<EdgeType> et = {101};
+    req.set_edge_types(et);
+    decltype(req.return_columns) tmpColumns;
+    tmpColumns.emplace_back(TestUtils::edgePropDef("_degree", cpp2::StatType::SUM, 101));
+    tmpColumns.emplace_back(TestUtils::edgePropDef("_degree", cpp2::StatType::AVG, 101));
+    req.set_return_columns(std::move(tmpColumns));
+
+    auto* processor = QueryStatsProcessor::instance(kv, schemaMan, nullptr, executor);
+    auto f = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(f).get();
+    EXPECT_EQ(0, resp.result.failed_codes.size());
+    EXPECT_EQ(2, resp.schema.columns.size());
+
+    auto provider = std::make_shared<ResultSchemaProvider>(resp.schema);
+    auto reader = RowReader::getRowReader(resp.data, provider);
+    int64_t sum;
+    EXPECT_EQ(ResultType::SUCCEEDED, reader->getInt<int64_t>(0, sum));
+    EXPECT_EQ(expectedSum, sum);
+    double avg;
+    EXPECT_EQ(ResultType::SUCCEEDED, reader->getDouble(1, avg));
+    EXPECT_DOUBLE_EQ(expectedAvg, avg);
+}
+
+TEST(QueryStatsTest, DegreeTest) {
+    fs::TempDir rootPath("/tmp/QueryStatsDegreeTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(rootPath.path());
+    auto schemaMan = TestUtils::mockSchemaMan();
+    auto indexMan = TestUtils::mockIndexMan();
+    FLAGS_enable_edge_degree = true;
+
+    LOG(INFO) << "Insert 7 edges for each vertex, twice, the counter should not be doubled";
+    for (int32_t round = 0; round < 2; round++) {
+        cpp2::AddEdgesRequest req;
+        req.space_id = 0;
+        req.overwritable = true;
+        for (PartitionID partId = 0; partId < 3; partId++) {
+            std::vector<cpp2::Edge> edges;
+            for (VertexID vId = partId * 10; vId < (partId + 1) * 10; vId++) {
+                for (VertexID dstId = 10001; dstId <= 10007; dstId++) {
+                    cpp2::EdgeKey key;
+                    key.set_src(vId);
+                    key.set_edge_type(101);
+                    key.set_ranking(dstId - 10001);
+                    key.set_dst(dstId);
+                    edges.emplace_back();
+                    edges.back().set_key(std::move(key));
+                    edges.back().set_props(TestUtils::setupEncode(10, 20));
+                }
+            }
+            req.parts.emplace(partId, std::move(edges));
+        }
+        auto* processor = AddEdgesProcessor::instance(kv.get(), schemaMan.get(),
+                                                      indexMan.get(), nullptr);
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+    }
+
+    LOG(INFO) << "Delete 2 edges for each vertex, one of them appears twice";
+    {
+        cpp2::DeleteEdgesRequest req;
+        req.set_space_id(0);
+        for (PartitionID partId = 0; partId < 3; partId++) {
+            std::vector<cpp2::EdgeKey> keys;
+            for (VertexID vId = partId * 10; vId < (partId + 1) * 10; vId++) {
+                for (VertexID dstId : {10001, 10002, 10001}) {
+                    cpp2::EdgeKey key;
+                    key.set_src(vId);
+                    key.set_edge_type(101);
+                    key.set_ranking(dstId - 10001);
+                    key.set_dst(dstId);
+                    keys.emplace_back(std::move(key));
+                }
+            }
+            req.parts.emplace(partId, std::move(keys));
+        }
+        auto* processor = DeleteEdgesProcessor::instance(kv.get(), schemaMan.get(),
+                                                         indexMan.get());
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+    }
+
+    auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(3);
+    LOG(INFO) << "Read the degree from the counters";
+    checkDegree(kv.get(), schemaMan.get(), executor.get(), 30 * 5, 5.0);
+
+    LOG(INFO) << "Count the degree by iterating the edges";
+    FLAGS_enable_edge_degree = false;
+    checkDegree(kv.get(), schemaMan.get(), executor.get(), 30 * 5, 5.0);
+}
+
+TEST(QueryStatsTest, RebuildDegreeTest) {
+    fs::TempDir rootPath("/tmp/QueryStatsRebuildDegreeTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(rootPath.path());
+    auto schemaMan = TestUtils::mockSchemaMan();
+    auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(3);
+
+    LOG(INFO) << "Write the edges without counters, and an obsolete counter";
+    mockData(kv.get());
+    auto obsolete = NebulaKeyUtils::degreeKey(0, 100, 101);
+    {
+        std::vector<kvstore::KV> data;
+        data.emplace_back(obsolete, NebulaKeyUtils::encodeDegree(3));
+        folly::Baton<true, std::atomic> baton;
+        kv->asyncMultiPut(0, 0, std::move(data), [&](kvstore::ResultCode code) {
+            EXPECT_EQ(code, kvstore::ResultCode::SUCCEEDED);
+            baton.post();
+        });
+        baton.wait();
+    }
+
+    LOG(INFO) << "Rebuild the counters of all parts";
+    {
+        cpp2::RebuildEdgeDegreeRequest req;
+        req.set_space_id(0);
+        req.set_parts({0, 1, 2});
+        auto* processor = RebuildEdgeDegreeProcessor::instance(kv.get(), schemaMan.get());
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+    }
+    std::string val;
+    EXPECT_EQ(kvstore::ResultCode::ERR_KEY_NOT_FOUND, kv->get(0, 0, obsolete, &val));
+
+    LOG(INFO) << "Read the degree from the counters rebuilt";
+    FLAGS_enable_edge_degree = true;
+    checkDegree(kv.get(), schemaMan.get(), executor.get(), 30 * 7, 7.0);
+    FLAGS_enable_edge_degree = false;
+}
+
 }  // namespace storage
 }  // namespace nebula
 
@@ -18,6 +18,7 @@
 #include "dataman/ResultSchemaProvider.h"
 #include "meta/NebulaSchemaProvider.h"
 #include "storage/StorageServiceHandler.h"
+#include "storage/MergeOperator.h"
 #include <thrift/lib/cpp2/server/ThriftServer.h>
 #include <folly/synchronization/Baton.h>
 #include <folly/executors/ThreadPoolExecutor.h>
@@ -38,7 +39,8 @@ public:
            HostAddr localhost = {0, network::NetworkUtils::getAvailablePort()},
            meta::MetaClient* mClient = nullptr,
            bool useMetaServer = false,
-           std::unique_ptr<kvstore::CompactionFilterFactoryBuilder> cffBuilder = nullptr) {
+           std::unique_ptr<kvstore::CompactionFilterFactoryBuilder> cffBuilder = nullptr,
+           std::shared_ptr<kvstore::CommitListener> listener = nullptr) {
         auto ioPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
         auto workers = apache::thrift::concurrency::PriorityThreadManager::newPriorityThreadManager(
                                  1, true /*stats*/);
@@ -69,6 +71,8 @@ public:
         // Prepare KVStore
         options.dataPaths_ = std::move(paths);
         options.cffBuilder_ = std::move(cffBuilder);
+        options.mergeOp_ = std::make_shared<NebulaOperator>();
+        options.commitListener_ = std::move(listener);
         auto store = std::make_unique<kvstore::NebulaStore>(std::move(options),
                                                             ioPool,
                                                             localhost,
@@ -0,0 +1,140 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "utils/NebulaKeyUtils.h"
+#include <gtest/gtest.h>
+#include <rocksdb/db.h>
+#include "fs/TempDir.h"
+#include "storage/test/TestUtils.h"
+#include "storage/query/TraverseProcessor.h"
+
+DECLARE_int32(max_edge_returned_per_vertex);
+
+namespace nebula {
+namespace storage {
+
+// The vertices are hashed into part 1, 2 and 3, while this host leads only part 0, 1 and 2.
+static constexpr int32_t kPartsNum = 3;
+
+void mockData(kvstore::KVStore* kv) {
+    // src => dsts
+    std::unordered_map<VertexID, std::vector<VertexID>> edges = {
+        {1, {4, 2}},
+        {4, {7, 6}},
+        {7, {10}},
+        {6, {9}},
+    };
+    for (auto& e : edges) {
+        auto partId = static_cast<PartitionID>(ID_HASH(e.first, kPartsNum));
+        std::vector<kvstore::KV> data;
+        for (auto dst : e.second) {
+            // Two versions for each edge
+            for (EdgeVersion version = 0; version < 2; version++) {
+                data.emplace_back(NebulaKeyUtils::edgeKey(partId, e.first, 101, 0, dst, version),
+                                  "");
+            }
+        }
+        folly::Baton<true, std::atomic> baton;
+        kv->asyncMultiPut(0, partId, std::move(data), [&](kvstore::ResultCode code) {
+            EXPECT_EQ(code, kvstore::ResultCode::SUCCEEDED);
+            baton.post();
+        });
+        baton.wait();
+    }
+}
+
+cpp2::TraverseResponse traverse(kvstore::KVStore* kv,
+                                meta::SchemaManager* schemaMan,
+                                std::unordered_map<PartitionID, std::vector<VertexID>> parts,
+                                int32_t steps,
+                                folly::Executor* executor = nullptr) {
+    cpp2::TraverseRequest req;
+    req.set_space_id(0);
+    req.set_parts(std::move(parts));
+    req.set_edge_types({101});
+    req.set_steps(steps);
+    req.set_parts_num(kPartsNum);
+    auto* processor = TraverseProcessor::instance(kv, schemaMan, nullptr, executor);
+    auto f = processor->getFuture();
+    processor->process(req);
+    return std::move(f).get();
+}
+
+std::vector<VertexID> sorted(std::vector<VertexID> vertices) {
+    std::sort(vertices.begin(), vertices.end());
+    return vertices;
+}
+
+TEST(TraverseTest, SimpleTest) {
+    fs::TempDir rootPath("/tmp/TraverseTest.XXXXXX");
+    auto kv = TestUtils::initKV(rootPath.path(), kPartsNum);
+    auto schemaMan = TestUtils::mockSchemaMan();
+    mockData(kv.get());
+
+    {
+        LOG(INFO) << "Go one step...";
+        auto resp = traverse(kv.get(), schemaMan.get(), {{2, {1}}}, 1);
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        EXPECT_EQ(std::vector<VertexID>({2, 4}), sorted(*resp.get_vertices()));
+        EXPECT_TRUE(resp.get_forwards()->empty());
+    }
+    {
+        LOG(INFO) << "Go two steps, vertex 2 is forwarded since it is in part 3...";
+        auto resp = traverse(kv.get(), schemaMan.get(), {{2, {1}}}, 2);
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        EXPECT_EQ(std::vector<VertexID>({6, 7}), sorted(*resp.get_vertices()));
+        auto* forwards = resp.get_forwards();
+        ASSERT_EQ(1, forwards->size());
+        EXPECT_EQ(std::vector<VertexID>({2}), forwards->at(1));
+    }
+    {
+        LOG(INFO) << "Go three steps...";
+        auto resp = traverse(kv.get(), schemaMan.get(), {{2, {1}}}, 3);
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        EXPECT_EQ(std::vector<VertexID>({9, 10}), sorted(*resp.get_vertices()));
+        auto* forwards = resp.get_forwards();
+        ASSERT_EQ(1, forwards->size());
+        EXPECT_EQ(std::vector<VertexID>({2}), forwards->at(2));
+    }
+    {
+        LOG(INFO) << "The vertices in the parts not led by this host...";
+        auto resp = traverse(kv.get(), schemaMan.get(), {{2, {1}}, {3, {2}}}, 1);
+        ASSERT_EQ(1, resp.result.failed_codes.size());
+        EXPECT_EQ(3, resp.result.failed_codes[0].part_id);
+        EXPECT_EQ(std::vector<VertexID>({2, 4}), sorted(*resp.get_vertices()));
+    }
+}
+
+TEST(TraverseTest, MaxEdgesTest) {
+    fs::TempDir rootPath("/tmp/TraverseTest.XXXXXX");
+    auto kv = TestUtils::initKV(rootPath.path(), kPartsNum);
+    auto schemaMan = TestUtils::mockSchemaMan();
+    mockData(kv.get());
+    auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(3);
+
+    auto maxEdges = FLAGS_max_edge_returned_per_vertex;
+    FLAGS_max_edge_returned_per_vertex = 1;
+    {
+        LOG(INFO) << "Go one step on the executor, only the first edge of vertex 1 is gone...";
+        auto resp = traverse(kv.get(), schemaMan.get(), {{2, {1}}}, 1, executor.get());
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        EXPECT_EQ(std::vector<VertexID>({2}), sorted(*resp.get_vertices()));
+        EXPECT_TRUE(resp.get_forwards()->empty());
+    }
+    FLAGS_max_edge_returned_per_vertex = maxEdges;
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+    return RUN_ALL_TESTS();
+}
@@ -43,20 +43,24 @@ void checkCache(VertexCache* cache, uint64_t evicts, uint64_t hits, uint64_t tot
     EXPECT_EQ(total, cache->total());
 }
 
+std::string encodeVertex() {
+    RowWriter writer;
+    for (int64_t numInt = 0; numInt < 3; numInt++) {
+        writer << numInt;
+    }
+    for (int32_t numString = 3; numString < 6; numString++) {
+        writer << folly::stringPrintf("tag_string_col_%d", numString);
+    }
+    return writer.encode();
+}
+
 void prepareData(kvstore::KVStore* kv) {
     LOG(INFO) << "Prepare data...";
     std::vector<kvstore::KV> data;
     TagID tagId = 3001;
     for (int32_t vertexId = 0; vertexId < 10000; vertexId++) {
         auto key = NebulaKeyUtils::vertexKey(0, vertexId, tagId, 0);
-        RowWriter writer;
-        for (int64_t numInt = 0; numInt < 3; numInt++) {
-            writer << numInt;
-        }
-        for (int32_t numString = 3; numString < 6; numString++) {
-            writer << folly::stringPrintf("tag_string_col_%d", numString);
-        }
-        auto val = writer.encode();
+        auto val = encodeVertex();
         data.emplace_back(std::move(key), std::move(val));
     }
     folly::Baton<true, std::atomic> baton;
@@ -131,18 +135,30 @@ TEST(VertexCacheTest, SimpleTest) {
     auto indexMan = std::make_unique<AdHocIndexManager>();
     auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(1);
     prepareData(kv.get());
-    VertexCache cache(1000, 0);
+    // The cache could hold 1000 vertices
+    auto charge = VertexCache::charge(std::make_pair(0, 3001), encodeVertex());
+    VertexCache cache(1000 * charge, 0);
 
     LOG(INFO) << "Fetch some vertices...";
     fetchVertices(kv.get(), schemaMan.get(), executor.get(), &cache, 0, 1000);
     checkCache(&cache, 0, 0, 1000);
+    EXPECT_EQ(1000 * charge, cache.usage());
 
-    fetchVertices(kv.get(), schemaMan.get(), executor.get(), &cache, 500, 1500);
-    checkCache(&cache, 500, 500, 2000);
+    fetchVertices(kv.get(), schemaMan.get(), executor.get(), &cache, 0, 1000);
+    checkCache(&cache, 0, 1000, 2000);
+
+    LOG(INFO) << "Scan vertices accessed only once, the hot ones are kept";
+    fetchVertices(kv.get(), schemaMan.get(), executor.get(), &cache, 1000, 2000);
+    checkCache(&cache, 0, 1000, 3000);
+    EXPECT_EQ(1000, cache.rejects());
+
+    fetchVertices(kv.get(), schemaMan.get(), executor.get(), &cache, 0, 1000);
+    checkCache(&cache, 0, 2000, 4000);
 
     LOG(INFO) << "Insert vertices from 0 to 1000";
     addVertices(kv.get(), schemaMan.get(), indexMan.get(), &cache, 1000);
-    checkCache(&cache, 1000, 500, 2000);
+    checkCache(&cache, 1000, 2000, 4000);
+    EXPECT_EQ(0, cache.usage());
 }
 
 }  // namespace storage
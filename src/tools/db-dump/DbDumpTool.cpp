@@ -26,11 +26,30 @@ optional:
          Default: 127.0.0.1:45500
 
        --mode= scan | stat
-         scan: print to screen when records meet the condition, and also print statistics
-               to screen in final.
-         stat: print statistics to screen.
+         scan: output the records meet the condition in the format given, and also print
+               statistics to screen in final.
+         stat: print statistics to screen, i.e. the rows, the row sizes and the versions
+               of each tag and edge, and the out degree histogram of each edge.
          Defualt: scan
 
+       --format= text | csv | sst
+         text: print the records to screen.
+         csv: write the records decoded into <output>/<part id>.csv, a vertex in
+              "vertex,vid,tag,version,props..." and an edge in
+              "edge,src,edge,rank,dst,version,props...".
+         sst: write all the raw keys of each partition dumped into <output>/<part id>.sst,
+              i.e. the vertices, the edges of both directions, the indexes, the uuid
+              mappings and the edge counters, which could be ingested. --vids, --tags,
+              --edges and --limit only apply to the statistics then.
+         Default: text
+
+       --output=<directory>
+         The directory of the output files, required for csv and sst.
+
+       --threads=<N>
+         The threads to dump the partitions in parallel, each partition by one thread.
+         Default: 0, i.e. one thread per core
+
        --vids=<list of vid>
          A list of vid seperated by comma. This parameter means vertex_id/edge_src_id
          Would scan the whole space's records if it is not given.
@@ -65,6 +84,9 @@ void printParams() {
     std::cout << "tags: " << FLAGS_tags << "\n";
     std::cout << "edges: " << FLAGS_edges << "\n";
     std::cout << "limit: " << FLAGS_limit << "\n";
+    std::cout << "format: " << FLAGS_format << "\n";
+    std::cout << "output: " << FLAGS_output << "\n";
+    std::cout << "threads: " << FLAGS_threads << "\n";
     std::cout << "===========================PARAMS============================\n\n";
 }
 
@@ -10,6 +10,7 @@
 #include "fs/FileUtils.h"
 #include "kvstore/RocksEngine.h"
 #include "time/Duration.h"
+#include <folly/Bits.h>
 
 DEFINE_string(space, "", "The space name.");
 DEFINE_string(db_path, "./", "Path to rocksdb.");
@@ -20,6 +21,9 @@ DEFINE_string(vids, "", "A list of vertex ids seperated by comma.");
 DEFINE_string(tags, "", "A list of tag name seperated by comma.");
 DEFINE_string(edges, "", "A list of edge name seperated by comma.");
 DEFINE_int64(limit, 1000, "Limit to output.");
+DEFINE_int32(threads, 0, "The threads to dump the partitions, 0 for one per core.");
+DEFINE_string(format, "text", "Output format in scan mode, text | csv | sst");
+DEFINE_string(output, "", "The directory of the output files, for csv and sst.");
 
 namespace nebula {
 namespace storage {
@@ -114,6 +118,21 @@ Status DbDumper::initParams() {
     if (FLAGS_mode.compare("scan") != 0 && FLAGS_mode.compare("stat") != 0) {
         return Status::Error("Unkown mode '%s'.", FLAGS_mode.c_str());
     }
+    if (FLAGS_format != "text" && FLAGS_format != "csv" && FLAGS_format != "sst") {
+        return Status::Error("Unkown format '%s'.", FLAGS_format.c_str());
+    }
+    if (FLAGS_format != "text" && FLAGS_mode == "scan") {
+        if (FLAGS_output.empty()) {
+            return Status::Error("Output directory is not given for '%s'.",
+                                 FLAGS_format.c_str());
+        }
+        if (!fs::FileUtils::makeDir(FLAGS_output)) {
+            return Status::Error("Unable to create directory '%s'.", FLAGS_output.c_str());
+        }
+    }
+    if (FLAGS_threads < 0) {
+        return Status::Error("Bad threads %d.", FLAGS_threads);
+    }
     return Status::OK();
 }
 
@@ -141,6 +160,46 @@ Status DbDumper::openDb() {
     return Status::OK();
 }
 
+void SchemaStat::addDegree(int64_t degree) {
+    size_t bucket = folly::findLastSet(static_cast<uint64_t>(degree)) - 1;
+    if (degrees_.size() <= bucket) {
+        degrees_.resize(bucket + 1, 0);
+    }
+    ++degrees_[bucket];
+    maxDegree_ = std::max(maxDegree_, degree);
+}
+
+void SchemaStat::merge(const SchemaStat& other) {
+    rows_ += other.rows_;
+    keys_ += other.keys_;
+    bytes_ += other.bytes_;
+    maxBytes_ = std::max(maxBytes_, other.maxBytes_);
+    maxVersions_ = std::max(maxVersions_, other.maxVersions_);
+    if (degrees_.size() < other.degrees_.size()) {
+        degrees_.resize(other.degrees_.size(), 0);
+    }
+    for (size_t i = 0; i < other.degrees_.size(); ++i) {
+        degrees_[i] += other.degrees_[i];
+    }
+    maxDegree_ = std::max(maxDegree_, other.maxDegree_);
+}
+
+void DbDumper::addPrefix(PartitionID part, std::string prefix) {
+    prefixes_[part].emplace(std::move(prefix));
+}
+
+void DbDumper::addAllParts() {
+    if (parts_.empty()) {
+        for (PartitionID part = 1; part <= partNum_; ++part) {
+            addPrefix(part, NebulaKeyUtils::prefix(part));
+        }
+    } else {
+        for (auto part : parts_) {
+            addPrefix(part, NebulaKeyUtils::prefix(part));
+        }
+    }
+}
+
 void DbDumper::run() {
     time::Duration dur;
     auto noPrint = [] (const folly::StringPiece& key) -> bool {
@@ -164,38 +223,41 @@ void DbDumper::run() {
         | (tags_.empty() ? 0 : 1 << 1)
         | (edges_.empty() ? 0 : 1);
     switch (bitmap) {
-        case 0b0000: {
-            // nothing specified,seek to first and print them all
-            seekToFirst();
+        case 0b0000:
+        case 0b1000: {
+            // nothing but parts specified, seek to the parts and print them all
+            addAllParts();
             break;
         }
-        case 0b0001: {
-            // specified edges, seek to first and only print edges if found.
+        case 0b0001:
+        case 0b1001: {
+            // specified edges, seek to the parts and only print edges if found.
             beforePrintVertex_.emplace_back(noPrint);
             beforePrintEdge_.emplace_back(printIfEdgeFound);
-            seekToFirst();
+            addAllParts();
             break;
         }
-        case 0b0010: {
-            // specified tags, seek to first and only print vertices if found.
+        case 0b0010:
+        case 0b1010: {
+            // specified tags, seek to the parts and only print vertices if found.
             beforePrintVertex_.emplace_back(printIfTagFound);
             beforePrintEdge_.emplace_back(noPrint);
-            seekToFirst();
+            addAllParts();
             break;
         }
-        case 0b0011: {
-            // specified tags and edges, seek to first and print if found.
+        case 0b0011:
+        case 0b1011: {
+            // specified tags and edges, seek to the parts and print if found.
             beforePrintVertex_.emplace_back(printIfTagFound);
             beforePrintEdge_.emplace_back(printIfEdgeFound);
-            seekToFirst();
+            addAllParts();
             break;
         }
         case 0b0100: {
             // specified vids, seek with prefix and print.
             for (auto vid : vids_) {
                 auto part = ID_HASH(vid, partNum_);
-                auto prefix = NebulaKeyUtils::vertexPrefix(part, vid);
-                seek(prefix);
+                addPrefix(part, NebulaKeyUtils::vertexPrefix(part, vid));
             }
             break;
         }
@@ -204,8 +266,7 @@ void DbDumper::run() {
             for (auto vid : vids_) {
                 auto part = ID_HASH(vid, partNum_);
                 for (auto edge : edges_) {
-                    auto prefix = NebulaKeyUtils::edgePrefix(part, vid, edge);
-                    seek(prefix);
+                    addPrefix(part, NebulaKeyUtils::edgePrefix(part, vid, edge));
                 }
             }
             break;
@@ -215,84 +276,29 @@ void DbDumper::run() {
             for (auto vid : vids_) {
                 auto part = ID_HASH(vid, partNum_);
                 for (auto tag : tags_) {
-                    auto prefix = NebulaKeyUtils::vertexPrefix(part, vid, tag);
-                    seek(prefix);
+                    addPrefix(part, NebulaKeyUtils::vertexPrefix(part, vid, tag));
                 }
             }
             break;
         }
         case 0b0111: {
-            // specified vids and edges, seek with prefix and print.
+            // specified vids, edges and tags, seek with prefix and print.
             for (auto vid : vids_) {
                 auto part = ID_HASH(vid, partNum_);
                 for (auto edge : edges_) {
-                    auto prefix = NebulaKeyUtils::edgePrefix(part, vid, edge);
-                    seek(prefix);
+                    addPrefix(part, NebulaKeyUtils::edgePrefix(part, vid, edge));
                 }
-            }
-            // specified vids and tags, seek with prefix and print.
-            for (auto vid : vids_) {
-                auto part = ID_HASH(vid, partNum_);
                 for (auto tag : tags_) {
-                    auto prefix = NebulaKeyUtils::vertexPrefix(part, vid, tag);
-                    seek(prefix);
+                    addPrefix(part, NebulaKeyUtils::vertexPrefix(part, vid, tag));
                 }
             }
             break;
         }
-        case 0b1000: {
-            // specified part, seek with prefix and print them all
-            for (auto part : parts_) {
-                auto prefix = NebulaKeyUtils::prefix(part);
-                seek(prefix);
-            }
-            break;
-        }
-        case 0b1001: {
-            // specified part and edge, seek with prefix and print edge if found
-            beforePrintVertex_.emplace_back(noPrint);
-            beforePrintEdge_.emplace_back(printIfEdgeFound);
-            for (auto part : parts_) {
-                auto prefix = NebulaKeyUtils::prefix(part);
-                seek(prefix);
-            }
-            break;
-        }
-        case 0b1010: {
-            // specified part and tag, seek with prefix and print vertex if found
-            beforePrintVertex_.emplace_back(printIfTagFound);
-            beforePrintEdge_.emplace_back(noPrint);
-            for (auto part : parts_) {
-                auto prefix = NebulaKeyUtils::prefix(part);
-                seek(prefix);
-            }
-            break;
-        }
-        case 0b1011: {
-            // specified part/tag/edge, with prefix and print
-            beforePrintVertex_.emplace_back(noPrint);
-            beforePrintEdge_.emplace_back(printIfEdgeFound);
-            for (auto part : parts_) {
-                auto prefix = NebulaKeyUtils::prefix(part);
-                seek(prefix);
-            }
-
-            beforePrintVertex_.clear();
-            beforePrintEdge_.clear();
-            beforePrintVertex_.emplace_back(printIfTagFound);
-            beforePrintEdge_.emplace_back(noPrint);
-            for (auto part : parts_) {
-                auto prefix = NebulaKeyUtils::prefix(part);
-                seek(prefix);
-            }
-            break;
-        }
         case 0b1100: {
             // specified part and vid
             for (auto part : parts_) {
                 for (auto vid : vids_) {
-                    auto prefix = NebulaKeyUtils::vertexPrefix(part, vid);
-                    seek(prefix);
+                    addPrefix(part, NebulaKeyUtils::vertexPrefix(part, vid));
                 }
             }
             break;
@@ -302,8 +308,7 @@ void DbDumper::run() {
             for (auto part : parts_) {
                 for (auto vid : vids_) {
                     for (auto edge : edges_) {
-                        auto prefix = NebulaKeyUtils::edgePrefix(part, vid, edge);
-                        seek(prefix);
+                        addPrefix(part, NebulaKeyUtils::edgePrefix(part, vid, edge));
                     }
                 }
             }
@@ -314,8 +319,7 @@ void DbDumper::run() {
             for (auto part : parts_) {
                 for (auto vid : vids_) {
                     for (auto tag : tags_) {
-                        auto prefix = NebulaKeyUtils::vertexPrefix(part, vid, tag);
-                        seek(prefix);
+                        addPrefix(part, NebulaKeyUtils::vertexPrefix(part, vid, tag));
                     }
                 }
             }
@@ -326,17 +330,10 @@ void DbDumper::run() {
             for (auto part : parts_) {
                 for (auto vid : vids_) {
                     for (auto edge : edges_) {
-                        auto prefix = NebulaKeyUtils::edgePrefix(part, vid, edge);
-                        seek(prefix);
+                        addPrefix(part, NebulaKeyUtils::edgePrefix(part, vid, edge));
                     }
-                }
-            }
-
-            for (auto part : parts_) {
-                for (auto vid : vids_) {
                     for (auto tag : tags_) {
-                        auto prefix = NebulaKeyUtils::vertexPrefix(part, vid, tag);
-                        seek(prefix);
+                        addPrefix(part, NebulaKeyUtils::vertexPrefix(part, vid, tag));
                     }
                 }
             }
@@ -347,37 +344,154 @@ void DbDumper::run() {
         }
     }
 
+    // The partitions are dumped in parallel, each by one thread at a time
+    for (auto& prefixes : prefixes_) {
+        partsToDump_.emplace_back(prefixes.first);
+    }
+    size_t threadNum = FLAGS_threads > 0 ? FLAGS_threads : std::thread::hardware_concurrency();
+    threadNum = std::max<size_t>(1, std::min(threadNum, partsToDump_.size()));
+    std::vector<DumpContext> contexts(threadNum);
+    std::vector<std::thread> threads;
+    threads.reserve(threadNum);
+    for (size_t i = 0; i < threadNum; ++i) {
+        threads.emplace_back(&DbDumper::dumpParts, this, &contexts[i]);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    DumpContext total;
+    for (auto& ctx : contexts) {
+        if (!ctx.status_.ok()) {
+            std::cerr << "Error: " << ctx.status_ << "\n";
+        }
+        total.vertexCount_ += ctx.vertexCount_;
+        total.edgeCount_ += ctx.edgeCount_;
+        for (auto& t : ctx.tagStat_) {
+            total.tagStat_[t.first].merge(t.second);
+        }
+        for (auto& e : ctx.edgeStat_) {
+            total.edgeStat_[e.first].merge(e.second);
+        }
+    }
+
     std::cout << "===========================STATISTICS============================\n";
-    std::cout << "COUNT: " << count_ << "\n";
-    std::cout << "VERTEX COUNT: " << vertexCount_ << "\n";
-    std::cout << "EDGE COUNT: " << edgeCount_ << "\n";
+    std::cout << "COUNT: " << total.vertexCount_ + total.edgeCount_ << "\n";
+    std::cout << "VERTEX COUNT: " << total.vertexCount_ << "\n";
+    std::cout << "EDGE COUNT: " << total.edgeCount_ << "\n";
     std::cout << "TAG STATISTICS: \n";
-    for (auto &t : tagStat_) {
-        std::cout << "\t" << getTagName(t.first) << " : " << t.second << "\n";
+    for (auto &t : total.tagStat_) {
+        printStat(getTagName(t.first), t.second, false);
     }
     std::cout << "EDGE STATISTICS: \n";
-    for (auto &e : edgeStat_) {
-        std::cout << "\t" << getEdgeName(e.first) << " : " << e.second << "\n";
+    for (auto &e : total.edgeStat_) {
+        printStat(getEdgeName(e.first), e.second, true);
     }
     std::cout << "============================STATISTICS===========================\n";
     std::cout << "Time cost: " << dur.elapsedInUSec() << " us\n\n";
 }
 
-void DbDumper::seekToFirst() {
-    const auto it = db_->NewIterator(rocksdb::ReadOptions());
-    it->SeekToFirst();
-    const auto prefixIt = std::make_unique<kvstore::RocksPrefixIter>(it, "");
-    iterates(prefixIt.get());
+void DbDumper::printStat(const std::string& name, const SchemaStat& stat, bool isEdge) {
+    std::cout << "\t" << name << " : " << stat.rows_ << "\n";
+    std::cout << "\t\t" << (isEdge ? "edges: " : "vertices: ") << stat.keys_
+              << ", max versions: " << stat.maxVersions_ << "\n";
+    std::cout << "\t\trow size avg: " << (stat.rows_ > 0 ? stat.bytes_ / stat.rows_ : 0)
+              << ", max: " << stat.maxBytes_ << ", total: " << stat.bytes_ << "\n";
+    if (!isEdge) {
+        return;
+    }
+    std::cout << "\t\tout degree max: " << stat.maxDegree_ << "\n";
+    for (size_t i = 0; i < stat.degrees_.size(); ++i) {
+        if (stat.degrees_[i] == 0) {
+            continue;
+        }
+        std::cout << "\t\t\t[" << (1UL << i) << ", " << (1UL << (i + 1)) << ") : "
+                  << stat.degrees_[i] << "\n";
+    }
 }
 
-void DbDumper::seek(std::string& prefix) {
-    const auto it = db_->NewIterator(rocksdb::ReadOptions());
-    it->Seek(rocksdb::Slice(prefix));
-    const auto prefixIt = std::make_unique<kvstore::RocksPrefixIter>(it, prefix);
-    iterates(prefixIt.get());
+void DbDumper::dumpParts(DumpContext* ctx) {
+    while (ctx->status_.ok()) {
+        auto index = nextPart_++;
+        if (index >= partsToDump_.size()) {
+            break;
+        }
+        ctx->status_ = dumpPart(partsToDump_[index], ctx);
+    }
 }
 
-void DbDumper::iterates(kvstore::RocksPrefixIter* it) {
+Status DbDumper::dumpPart(PartitionID part, DumpContext* ctx) {
+    auto status = openOutput(part, ctx);
+    if (!status.ok()) {
+        return status;
+    }
+    if (FLAGS_mode == "scan" && FLAGS_format == "sst") {
+        status = dumpRawPart(part, ctx);
+        if (!status.ok()) {
+            closeOutput(ctx);
+            return status;
+        }
+    }
+    for (auto& prefix : prefixes_.at(part)) {
+        std::unique_ptr<rocksdb::Iterator> it(db_->NewIterator(rocksdb::ReadOptions()));
+        it->Seek(rocksdb::Slice(prefix));
+        const auto prefixIt = std::make_unique<kvstore::RocksPrefixIter>(it.release(), prefix);
+        status = iterates(prefixIt.get(), ctx);
+        flushDegree(ctx);
+        ctx->lastKey_.clear();
+        if (!status.ok()) {
+            closeOutput(ctx);
+            return status;
+        }
+    }
+    return closeOutput(ctx);
+}
+
+Status DbDumper::dumpRawPart(PartitionID part, DumpContext* ctx) {
+    // The types of the keys are in order, so are the keys written into the sst file
+    std::vector<std::string> prefixes = {NebulaKeyUtils::prefix(part),
+                                         NebulaKeyUtils::indexPrefix(part),
+                                         NebulaKeyUtils::uuidKey(part, ""),
+                                         NebulaKeyUtils::degreePrefix(part)};
+    for (auto& prefix : prefixes) {
+        std::unique_ptr<rocksdb::Iterator> it(db_->NewIterator(rocksdb::ReadOptions()));
+        it->Seek(rocksdb::Slice(prefix));
+        for (; it->Valid() && it->key().starts_with(prefix); it->Next()) {
+            auto status = writeSst(it->key(), it->value(), ctx);
+            if (!status.ok()) {
+                return status;
+            }
+        }
+        if (!it->status().ok()) {
+            return Status::Error("Failed to read part %d: %s",
+                                 part, it->status().ToString().c_str());
+        }
+    }
+    return Status::OK();
+}
+
+Status DbDumper::writeSst(const rocksdb::Slice& key,
+                          const rocksdb::Slice& value,
+                          DumpContext* ctx) {
+    // The writer is opened with the first row, an empty sst file is not allowed
+    if (ctx->sst_ == nullptr) {
+        ctx->sst_ = std::make_unique<rocksdb::SstFileWriter>(rocksdb::EnvOptions(), options_);
+        auto status = ctx->sst_->Open(ctx->sstPath_);
+        if (!status.ok()) {
+            ctx->sst_.reset();
+            return Status::Error("Unable to open '%s': %s",
+                                 ctx->sstPath_.c_str(), status.ToString().c_str());
+        }
+    }
+    auto status = ctx->sst_->Put(key, value);
+    if (!status.ok()) {
+        return Status::Error("Failed to write '%s': %s",
+                             ctx->sstPath_.c_str(), status.ToString().c_str());
+    }
+    return Status::OK();
+}
+
+Status DbDumper::iterates(kvstore::RocksPrefixIter* it, DumpContext* ctx) {
     for (; it->valid(); it->next()) {
         if (FLAGS_limit > 0 && count_ >= FLAGS_limit) {
             break;
@@ -400,22 +514,19 @@ void DbDumper::iterates(kvstore::RocksPrefixIter* it) {
             }
 
             auto tagId = NebulaKeyUtils::getTagId(key);
-            // only print to screen with scan mode
+            // only output with scan mode
             if (FLAGS_mode == "scan") {
-                printTagKey(key);
                 auto reader =
                     RowReader::getTagPropReader(schemaMng_.get(), value, spaceId_, tagId);
-                printValue(reader.get());
+                auto status = output(key, reader.get(), true, ctx);
+                if (!status.ok()) {
+                    return status;
+                }
             }
 
             // statistics
-            auto tagStat = tagStat_.find(NebulaKeyUtils::getTagId(key));
-            if (tagStat == tagStat_.end()) {
-                tagStat_.emplace(tagId, 1);
-            } else {
-                ++(tagStat->second);
-            }
-            ++vertexCount_;
+            countKey(key, value, &ctx->tagStat_[tagId], ctx);
+            ++ctx->vertexCount_;
             ++count_;
         } else if (NebulaKeyUtils::isEdge(key)) {
             // filts the data
@@ -435,73 +546,215 @@ void DbDumper::iterates(kvstore::RocksPrefixIter* it) {
                 // reverse edge will be discarded
                 continue;
             }
-            // only print to screen with scan mode
+            // only output with scan mode
             if (FLAGS_mode == "scan") {
-                printEdgeKey(key);
                 auto reader =
                     RowReader::getEdgePropReader(schemaMng_.get(), value, spaceId_, edgeType);
-                printValue(reader.get());
+                auto status = output(key, reader.get(), false, ctx);
+                if (!status.ok()) {
+                    return status;
+                }
             }
 
             // statistics
-            auto edgeStat = edgeStat_.find(edgeType);
-            if (edgeStat == edgeStat_.end()) {
-                edgeStat_.emplace(edgeType, 1);
-            } else {
-                ++(edgeStat->second);
+            if (countKey(key, value, &ctx->edgeStat_[edgeType], ctx)) {
+                auto src = NebulaKeyUtils::getSrcId(key);
+                if (ctx->degree_ > 0 && src == ctx->degreeSrc_ && edgeType == ctx->degreeType_) {
+                    ++ctx->degree_;
+                } else {
+                    flushDegree(ctx);
+                    ctx->degreeSrc_ = src;
+                    ctx->degreeType_ = edgeType;
+                    ctx->degree_ = 1;
+                }
             }
-            ++edgeCount_;
+            ++ctx->edgeCount_;
             ++count_;
         }
     }
+    return Status::OK();
 }
 
-inline void DbDumper::printTagKey(const folly::StringPiece& key) {
+bool DbDumper::countKey(const folly::StringPiece& key,
+                        const folly::StringPiece& value,
+                        SchemaStat* stat,
+                        DumpContext* ctx) {
+    int64_t size = key.size() + value.size();
+    ++stat->rows_;
+    stat->bytes_ += size;
+    stat->maxBytes_ = std::max(stat->maxBytes_, size);
+    // The versions of a key are next to each other, the latest first
+    auto keyNoVersion = NebulaKeyUtils::keyWithNoVersion(key);
+    bool isNew = keyNoVersion != folly::StringPiece(ctx->lastKey_);
+    if (isNew) {
+        ctx->lastKey_ = keyNoVersion.str();
+        ctx->versions_ = 0;
+        ++stat->keys_;
+    }
+    stat->maxVersions_ = std::max(stat->maxVersions_, ++ctx->versions_);
+    return isNew;
+}
+
+void DbDumper::flushDegree(DumpContext* ctx) {
+    if (ctx->degree_ > 0) {
+        ctx->edgeStat_[ctx->degreeType_].addDegree(ctx->degree_);
+        ctx->degree_ = 0;
+    }
+}
+
+Status DbDumper::openOutput(PartitionID part, DumpContext* ctx) {
+    if (FLAGS_mode != "scan") {
+        return Status::OK();
+    }
+    if (FLAGS_format == "csv") {
+        auto path = fs::FileUtils::joinPath(FLAGS_output, folly::stringPrintf("%d.csv", part));
+        ctx->csv_ = std::make_unique<std::ofstream>(path, std::ios::out | std::ios::trunc);
+        if (!ctx->csv_->is_open()) {
+            ctx->csv_.reset();
+            return Status::Error("Unable to open '%s'.", path.c_str());
+        }
+    } else if (FLAGS_format == "sst") {
+        ctx->sstPath_ =
+            fs::FileUtils::joinPath(FLAGS_output, folly::stringPrintf("%d.sst", part));
+    }
+    return Status::OK();
+}
+
+Status DbDumper::closeOutput(DumpContext* ctx) {
+    if (ctx->csv_ != nullptr) {
+        ctx->csv_->close();
+        bool failed = ctx->csv_->fail();
+        ctx->csv_.reset();
+        if (failed) {
+            return Status::Error("Failed to write the csv file.");
+        }
+    }
+    if (ctx->sst_ != nullptr) {
+        auto status = ctx->sst_->Finish();
+        ctx->sst_.reset();
+        if (!status.ok()) {
+            return Status::Error("Failed to finish '%s': %s",
+                                 ctx->sstPath_.c_str(), status.ToString().c_str());
+        }
+    }
+    return Status::OK();
+}
+
+Status DbDumper::output(const folly::StringPiece& key,
+                        const RowReader* reader,
+                        bool isVertex,
+                        DumpContext* ctx) {
+    if (FLAGS_format == "csv") {
+        *ctx->csv_ << csvStr(key, reader, isVertex) << "\n";
+    } else if (FLAGS_format == "sst") {
+        // All the raw keys of the part are written by dumpRawPart
+        return Status::OK();
+    } else {
+        auto line = isVertex ? tagKeyStr(key) : edgeKeyStr(key);
+        line += valueStr(reader);
+        std::lock_guard<std::mutex> g(printLock_);
+        std::cout << line;
+    }
+    return Status::OK();
+}
+
+std::string DbDumper::tagKeyStr(const folly::StringPiece& key) {
     auto part = NebulaKeyUtils::getPart(key);
     auto vid = NebulaKeyUtils::getVertexId(key);
     auto tagId = NebulaKeyUtils::getTagId(key);
-    std::cout << "[vertex] key: "
-            << part << ", "
-            << vid << ", "
-            << getTagName(tagId);
+    return folly::stringPrintf("[vertex] key: %d, %ld, %s",
+                               part, vid, getTagName(tagId).c_str());
 }
 
-inline void DbDumper::printEdgeKey(const folly::StringPiece& key) {
+std::string DbDumper::edgeKeyStr(const folly::StringPiece& key) {
     auto part = NebulaKeyUtils::getPart(key);
     auto edgeType = NebulaKeyUtils::getEdgeType(key);
     auto src = NebulaKeyUtils::getSrcId(key);
     auto dst = NebulaKeyUtils::getDstId(key);
     auto rank = NebulaKeyUtils::getRank(key);
-    std::cout << "[edge] key: "
-            << part << ", "
-            << src << ", "
-            << getEdgeName(edgeType) << ", "
-            << rank << ", "
-            << dst;
+    return folly::stringPrintf("[edge] key: %d, %ld, %s, %ld, %ld",
+                               part, src, getEdgeName(edgeType).c_str(), rank, dst);
 }
 
-void DbDumper::printValue(const RowReader* reader) {
-    if (reader == nullptr) {
-        return;
+std::string DbDumper::valueStr(const RowReader* reader) {
+    std::ostringstream os;
+    if (reader != nullptr) {
+        os << " value: ";
+        auto schema = reader->getSchema();
+        if (schema == nullptr) {
+            os << "schema not found.";
+        } else {
+            auto num = schema->getNumFields();
+            for (size_t index = 0; index < num; ++index) {
+                auto field = RowReader::getPropByIndex(reader, index);
+                if (!ok(field)) {
+                    continue;
+                }
+                os << value(field) << ", ";
+            }
+        }
     }
-    std::cout << " value: ";
-    auto schema = reader->getSchema();
-    if (schema == nullptr) {
-        std::cerr << "schema not found.";
-        return;
+    os << "\n";
+    return os.str();
+}
+
+/**
+ * A vertex is in "vertex,<vid>,<tag>,<version>,<props...>",
+ * an edge is in "edge,<src>,<edge>,<rank>,<dst>,<version>,<props...>".
+ * */
+std::string DbDumper::csvStr(const folly::StringPiece& key,
+                             const RowReader* reader,
+                             bool isVertex) {
+    std::string line;
+    auto version = NebulaKeyUtils::getVersion(key);
+    if (isVertex) {
+        line = folly::stringPrintf("vertex,%ld,%s,%ld",
+                                   NebulaKeyUtils::getVertexId(key),
+                                   getTagName(NebulaKeyUtils::getTagId(key)).c_str(),
+                                   version);
+    } else {
+        line = folly::stringPrintf("edge,%ld,%s,%ld,%ld,%ld",
+                                   NebulaKeyUtils::getSrcId(key),
+                                   getEdgeName(NebulaKeyUtils::getEdgeType(key)).c_str(),
+                                   NebulaKeyUtils::getRank(key),
+                                   NebulaKeyUtils::getDstId(key),
+                                   version);
+    }
+    if (reader == nullptr || reader->getSchema() == nullptr) {
+        return line;
     }
-    auto iter = schema->begin();
-    size_t index = 0;
-    while (iter) {
+    auto num = reader->getSchema()->getNumFields();
+    for (size_t index = 0; index < num; ++index) {
+        line += ",";
         auto field = RowReader::getPropByIndex(reader, index);
         if (!ok(field)) {
             continue;
         }
-        std::cout << value(field) << ", ";
-        ++iter;
-        ++index;
+        auto v = value(std::move(field));
+        switch (v.which()) {
+            case VAR_INT64:
+                line += folly::to<std::string>(boost::get<int64_t>(v));
+                break;
+            case VAR_DOUBLE:
+                line += folly::to<std::string>(boost::get<double>(v));
+                break;
+            case VAR_BOOL:
+                line += boost::get<bool>(v) ? "true" : "false";
+                break;
+            case VAR_STR: {
+                line += "\"";
+                for (auto c : boost::get<std::string>(v)) {
+                    if (c == '"') {
+                        line += "\"";
+                    }
+                    line += c;
+                }
+                line += "\"";
+                break;
+            }
+        }
     }
-    std::cout << "\n";
+    return line;
 }
 
 std::string DbDumper::getTagName(const TagID tagId) {
@@ -9,6 +9,7 @@
 
 #include "base/Base.h"
 #include <rocksdb/db.h>
+#include <rocksdb/sst_file_writer.h>
 #include "base/Status.h"
 #include "meta/client/MetaClient.h"
 #include "meta/ServerBasedSchemaManager.h"
@@ -24,9 +25,54 @@ DECLARE_string(vids);
 DECLARE_string(tags);
 DECLARE_string(edges);
 DECLARE_int64(limit);
+DECLARE_int32(threads);
+DECLARE_string(format);
+DECLARE_string(output);
 
 namespace nebula {
 namespace storage {
+/**
+ * The statistics of the rows of a tag or an edge type.
+ * */
+struct SchemaStat {
+    int64_t                     rows_{0};
+    // The keys without version, i.e. the vertices or the edges
+    int64_t                     keys_{0};
+    int64_t                     bytes_{0};
+    int64_t                     maxBytes_{0};
+    int64_t                     maxVersions_{0};
+    // Only for edges, the number of the source vertices by the out degree,
+    // the ith bucket is of the degree in [2^i, 2^(i+1))
+    std::vector<int64_t>        degrees_;
+    int64_t                     maxDegree_{0};
+
+    void addDegree(int64_t degree);
+
+    void merge(const SchemaStat& other);
+};
+
+/**
+ * The state of one dumping thread, the statistics are merged in the end.
+ * */
+struct DumpContext {
+    std::unordered_map<TagID, SchemaStat>       tagStat_;
+    std::unordered_map<EdgeType, SchemaStat>    edgeStat_;
+    int64_t                                     vertexCount_{0};
+    int64_t                                     edgeCount_{0};
+    // The last key without version, to count the versions of a key
+    std::string                                 lastKey_;
+    int64_t                                     versions_{0};
+    // The source vertex and the type of the edges counted for the degree
+    VertexID                                    degreeSrc_{0};
+    EdgeType                                    degreeType_{0};
+    int64_t                                     degree_{0};
+    // The output of the partition being dumped, for csv and sst
+    std::unique_ptr<std::ofstream>              csv_;
+    std::unique_ptr<rocksdb::SstFileWriter>     sst_;
+    std::string                                 sstPath_;
+    Status                                      status_;
+};
+
 class DbDumper {
 public:
     DbDumper() = default;
@@ -46,21 +92,59 @@ private:
 
     Status openDb();
 
-    void seekToFirst();
+    void addPrefix(PartitionID part, std::string prefix);
+
+    void addAllParts();
+
+    /**
+     * Dump the partitions taken from partsToDump_ one by one, until all are done.
+     * */
+    void dumpParts(DumpContext* ctx);
+
+    Status dumpPart(PartitionID part, DumpContext* ctx);
+
+    /**
+     * Write all the raw keys of the partition into its sst file, i.e. the vertices,
+     * the edges of both directions, the indexes, the uuid mappings and the edge
+     * counters, so the file could be ingested again. The filters only apply to the
+     * statistics.
+     * */
+    Status dumpRawPart(PartitionID part, DumpContext* ctx);
 
-    void seek(std::string& prefix);
+    Status writeSst(const rocksdb::Slice& key, const rocksdb::Slice& value, DumpContext* ctx);
 
-    void iterates(kvstore::RocksPrefixIter* it);
+    Status iterates(kvstore::RocksPrefixIter* it, DumpContext* ctx);
 
-    inline void printTagKey(const folly::StringPiece& key);
+    // Count the key in the statistics, return whether it is a new key rather than a version
+    bool countKey(const folly::StringPiece& key,
+                  const folly::StringPiece& value,
+                  SchemaStat* stat,
+                  DumpContext* ctx);
 
-    inline void printEdgeKey(const folly::StringPiece& key);
+    void flushDegree(DumpContext* ctx);
+
+    Status output(const folly::StringPiece& key,
+                  const RowReader* reader,
+                  bool isVertex,
+                  DumpContext* ctx);
+
+    Status openOutput(PartitionID part, DumpContext* ctx);
+
+    Status closeOutput(DumpContext* ctx);
+
+    std::string tagKeyStr(const folly::StringPiece& key);
+
+    std::string edgeKeyStr(const folly::StringPiece& key);
 
     std::string getTagName(const TagID tagId);
 
     std::string getEdgeName(const EdgeType edgeType);
 
-    void printValue(const RowReader* reader);
+    std::string valueStr(const RowReader* reader);
+
+    std::string csvStr(const folly::StringPiece& key, const RowReader* reader, bool isVertex);
+
+    void printStat(const std::string& name, const SchemaStat& stat, bool isEdge);
 
 private:
     std::unique_ptr<rocksdb::DB>                                   db_;
@@ -75,12 +159,13 @@ private:
     std::unordered_set<EdgeType>                                   edges_;
     std::vector<std::function<bool(const folly::StringPiece&)>>    beforePrintVertex_;
     std::vector<std::function<bool(const folly::StringPiece&)>>    beforePrintEdge_;
-    // For statistics
-    std::unordered_map<TagID, uint32_t>                            tagStat_;
-    std::unordered_map<EdgeType, uint32_t>                         edgeStat_;
-    int64_t                                                        count_{0};
-    int64_t                                                        vertexCount_{0};
-    int64_t                                                        edgeCount_{0};
+    // The prefixes to seek in each partition, in the order of the keys
+    std::map<PartitionID, std::set<std::string>>                   prefixes_;
+    std::vector<PartitionID>                                       partsToDump_;
+    std::atomic<size_t>                                            nextPart_{0};
+    std::mutex                                                     printLock_;
+    // The rows dumped of all threads, for the limit
+    std::atomic<int64_t>                                           count_{0};
 };
 }  // namespace storage
 }  // namespace nebula